@@ -0,0 +1,58 @@
+#ifndef EINSUM_IR_PY_DLPACK_H
+#define EINSUM_IR_PY_DLPACK_H
+
+#include <cstdint>
+
+/**
+ * Minimal declarations of the DLPack ABI (https://github.com/dmlc/dlpack).
+ * Only the unversioned structs exchanged through "dltensor" capsules are declared.
+ * The layouts have to match the DLPack specification exactly.
+ **/
+namespace einsum_ir {
+  namespace py {
+    namespace dlpack {
+      /// device types
+      enum device_type_t : int32_t {
+        cpu       = 1,
+        cuda_host = 3
+      };
+
+      /// type codes
+      enum type_code_t : uint8_t {
+        int_code    = 0,
+        uint_code   = 1,
+        float_code  = 2,
+        bfloat_code = 4
+      };
+
+      struct DLDevice {
+        int32_t device_type;
+        int32_t device_id;
+      };
+
+      struct DLDataType {
+        uint8_t  code;
+        uint8_t  bits;
+        uint16_t lanes;
+      };
+
+      struct DLTensor {
+        void       * data;
+        DLDevice     device;
+        int32_t      ndim;
+        DLDataType   dtype;
+        int64_t    * shape;
+        int64_t    * strides;
+        uint64_t     byte_offset;
+      };
+
+      struct DLManagedTensor {
+        DLTensor   dl_tensor;
+        void     * manager_ctx;
+        void    (* deleter)( DLManagedTensor * self );
+      };
+    }
+  }
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "TensorOperation.h"
+#include "DLPack.h"
 #include <einsum_ir/basic/threading.h>
+#include <einsum_ir/basic/Topology.h>
 #include <cstdint>
 #include <tuple>
 
@@ -213,6 +215,8 @@ int64_t einsum_ir::py::TensorOperation::dtype_to_num_bytes( dtype_t dtype ) {
   switch (dtype) {
     case dtype_t::fp32: return sizeof(float);
     case dtype_t::fp64: return sizeof(double);
+    case dtype_t::bf16: return sizeof(uint16_t);
+    case dtype_t::fp16: return sizeof(uint16_t);
     default:            return 0; // Undefined or unsupported type
   }
 }
@@ -265,6 +269,10 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::setup(
     }
     l_strides_out = strides[0][2];
 
+    m_dtype     = dtype;
+    m_dim_sizes = dim_sizes;
+    m_strides   = { l_strides_in0, l_strides_in1, l_strides_out };
+
     return setup_binary(dtype, prim_first, prim_main, prim_last,
                         dim_types, exec_types, dim_sizes, strides);
   }
@@ -281,6 +289,10 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::setup(
       return error_t::compilation_failed;
     }
 
+    m_dtype     = dtype;
+    m_dim_sizes = dim_sizes;
+    m_strides   = { l_strides_in0, l_strides_out };
+
     return setup_unary(dtype, prim_main, exec_types,
                        dim_sizes, l_strides_in0, l_strides_out);
   }
@@ -299,9 +311,15 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::setup_un
   switch (dtype) {
     case dtype_t::fp32: l_dtype_in = einsum_ir::basic::data_t::FP32; break;
     case dtype_t::fp64: l_dtype_in = einsum_ir::basic::data_t::FP64; break;
+    case dtype_t::bf16: l_dtype_in = einsum_ir::basic::data_t::BF16; break;
+    case dtype_t::fp16: l_dtype_in = einsum_ir::basic::data_t::FP16; break;
     default:            l_dtype_in = einsum_ir::basic::data_t::UNDEFINED_DTYPE; break;
   }
+  // low precision data is processed in FP32
   einsum_ir::basic::data_t l_dtype_comp = l_dtype_in;
+  if (dtype == dtype_t::bf16 || dtype == dtype_t::fp16) {
+    l_dtype_comp = einsum_ir::basic::data_t::FP32;
+  }
   einsum_ir::basic::data_t l_dtype_out  = l_dtype_in;
 
   // Convert kernel type
@@ -412,12 +430,19 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::setup_bi
   switch (dtype) {
     case dtype_t::fp32: l_dtype_left = einsum_ir::basic::data_t::FP32; break;
     case dtype_t::fp64: l_dtype_left = einsum_ir::basic::data_t::FP64; break;
+    case dtype_t::bf16: l_dtype_left = einsum_ir::basic::data_t::BF16; break;
+    case dtype_t::fp16: l_dtype_left = einsum_ir::basic::data_t::FP16; break;
     default:            l_dtype_left = einsum_ir::basic::data_t::UNDEFINED_DTYPE; break;
   }
   l_dtype_right = l_dtype_left;
   l_dtype_comp  = l_dtype_left;
   l_dtype_out   = l_dtype_left;
 
+  // low precision data is accumulated in FP32
+  if (dtype == dtype_t::bf16 || dtype == dtype_t::fp16) {
+    l_dtype_comp = einsum_ir::basic::data_t::FP32;
+  }
+
   l_ktype_first = convert_prim_to_kernel(prim_first);
   l_ktype_main = convert_prim_to_kernel(prim_main);
   l_ktype_last = convert_prim_to_kernel(prim_last);
@@ -459,6 +484,8 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::setup_bi
 void einsum_ir::py::TensorOperation::execute( void const * tensor_in0,
                                               void const * tensor_in1,
                                               void       * tensor_out) {
+  std::lock_guard< std::mutex > l_lock( m_mutex_execute );
+
   if (m_op_type == op_type_t::unary) {
     m_backend_unary.eval(tensor_in0, tensor_out);
   }
@@ -467,6 +494,97 @@ void einsum_ir::py::TensorOperation::execute( void const * tensor_in0,
   }
 }
 
+int64_t einsum_ir::py::TensorOperation::get_num_bytes() const {
+  return dtype_to_num_bytes(m_dtype);
+}
+
+bool einsum_ir::py::TensorOperation::check_dtype( int64_t dtype_code,
+                                                  int64_t dtype_bits ) const {
+  if( dtype_bits != get_num_bytes() * 8 ) {
+    return false;
+  }
+
+  if( m_dtype == dtype_t::bf16 ) {
+    return    dtype_code == dlpack::bfloat_code
+           || dtype_code == dlpack::uint_code;
+  }
+  return dtype_code == dlpack::float_code;
+}
+
+bool einsum_ir::py::TensorOperation::check_layout( std::size_t                    id_tensor,
+                                                   std::vector< int64_t > const & shape,
+                                                   std::vector< int64_t > const & strides ) const {
+  if( id_tensor >= m_strides.size() || shape.size() != strides.size() ) {
+    return false;
+  }
+
+  // empty operations do not access the tensor
+  for( std::size_t l_di = 0; l_di < m_dim_sizes.size(); l_di++ ) {
+    if( m_dim_sizes[l_di] == 0 ) {
+      return true;
+    }
+  }
+
+  // merge adjacent dimensions of the tensor which are contiguous w.r.t. each other
+  std::vector< int64_t > l_shape;
+  std::vector< int64_t > l_strides;
+  for( std::size_t l_di = 0; l_di < shape.size(); l_di++ ) {
+    if( shape[l_di] <= 0 ) {
+      return false;
+    }
+    if( shape[l_di] == 1 ) {
+      continue;
+    }
+    if( strides[l_di] < 0 ) {
+      return false;
+    }
+
+    if(    !l_shape.empty()
+        && l_strides.back() == strides[l_di] * shape[l_di] ) {
+      l_shape.back()  *= shape[l_di];
+      l_strides.back() = strides[l_di];
+    }
+    else {
+      l_shape.push_back( shape[l_di] );
+      l_strides.push_back( strides[l_di] );
+    }
+  }
+
+  int64_t l_max_offset_tensor = 0;
+  for( std::size_t l_di = 0; l_di < l_shape.size(); l_di++ ) {
+    l_max_offset_tensor += (l_shape[l_di] - 1) * l_strides[l_di];
+  }
+
+  int64_t l_max_offset_op = 0;
+  for( std::size_t l_di = 0; l_di < m_dim_sizes.size(); l_di++ ) {
+    int64_t l_size   = m_dim_sizes[l_di];
+    int64_t l_stride = m_strides[id_tensor][l_di];
+    if( l_size == 1 || l_stride == 0 ) {
+      continue;
+    }
+    if( l_stride < 0 ) {
+      return false;
+    }
+    l_max_offset_op += (l_size - 1) * l_stride;
+
+    // the dimension's steps have to be steps within a single dimension of the tensor
+    bool l_found = false;
+    for( std::size_t l_dt = 0; l_dt < l_shape.size(); l_dt++ ) {
+      if(    l_strides[l_dt] > 0
+          && l_stride % l_strides[l_dt] == 0
+          && (l_size - 1) * (l_stride / l_strides[l_dt]) < l_shape[l_dt] ) {
+        l_found = true;
+        break;
+      }
+    }
+    if( !l_found ) {
+      return false;
+    }
+  }
+
+  return l_max_offset_op <= l_max_offset_tensor;
+}
+
 einsum_ir::py::OptimizationConfig einsum_ir::py::TensorOperation::get_default_optimization_config() {
   OptimizationConfig config;
 
@@ -478,7 +596,11 @@ einsum_ir::py::OptimizationConfig einsum_ir::py::TensorOperation::get_default_op
   config.br_gemm_support     = true;
   config.packing_support     = true;
   config.sfc_support         = true;
-  config.l2_cache_size       = 1048576;  // 1 MiB
+
+  einsum_ir::basic::Topology const & l_topology = einsum_ir::basic::Topology::get_instance();
+  config.l1_cache_size       = l_topology.m_l1_cache_size;
+  config.l2_cache_size       = l_topology.m_l2_cache_size;
+  config.l3_cache_size       = l_topology.m_l3_cache_size;
 
   return config;
 }
@@ -514,7 +636,9 @@ std::tuple<
   bool    l_br_gemm_support     = optimization_config.br_gemm_support;
   bool    l_packing_support     = optimization_config.packing_support;
   bool    l_sfc_support         = optimization_config.sfc_support;
+  int64_t l_l1_cache_size       = optimization_config.l1_cache_size;
   int64_t l_l2_cache_size       = optimization_config.l2_cache_size;
+  int64_t l_l3_cache_size       = optimization_config.l3_cache_size;
 
   int64_t l_num_threads[3] = {1, 1, 1};
   l_num_threads[0] = get_num_threads(optimization_config.num_threads);
@@ -584,7 +708,8 @@ std::tuple<
                             l_opt_strides_out, l_opt_packing_in0, l_opt_packing_in1,
                             l_target_m, l_target_n, l_target_k, l_num_threads,
                             l_packed_gemm_support, l_br_gemm_support, l_packing_support,
-                            l_sfc_support, l_l2_cache_size);
+                            l_sfc_support, l_l1_cache_size, l_l2_cache_size,
+                            l_l3_cache_size);
   }
 
   if (l_err != error_t::success) {
@@ -708,7 +833,9 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::optimize
   bool                     br_gemm_support,
   bool                     packing_support,
   bool                     sfc_support,
-  int64_t                  l2_cache_size
+  int64_t                  l1_cache_size,
+  int64_t                  l2_cache_size,
+  int64_t                  l3_cache_size
 ) {
   // Create iter_properties from input parameters
   std::vector<einsum_ir::basic::iter_property> l_iters = create_iter_properties(
@@ -743,6 +870,8 @@ einsum_ir::py::TensorOperation::error_t einsum_ir::py::TensorOperation::optimize
                     &num_threads[0],
                     &num_threads[1],
                     &num_threads[2] );
+  l_optimizer.set_cache_sizes( l1_cache_size,
+                               l3_cache_size );
   
   // Run optimization
   l_optimizer.optimize();
@@ -2,6 +2,7 @@
 #define EINSUM_IR_PY_TENSOR_OPERATION_H
 
 #include <cstdint>
+#include <mutex>
 #include <vector>
 #include <einsum_ir/basic/unary/UnaryBackendTpp.h>
 #include <einsum_ir/basic/unary/UnaryOptimizer.h>
@@ -24,7 +25,9 @@ namespace einsum_ir {
       bool    packed_gemm_support = false;
       bool    packing_support     = false;
       bool    sfc_support         = false;
+      int64_t l1_cache_size       = 0;
       int64_t l2_cache_size       = 0;
+      int64_t l3_cache_size       = 0;
     };
   }
 }
@@ -70,7 +73,9 @@ class einsum_ir::py::TensorOperation {
     /// data type
     enum class dtype_t : uint32_t {
       fp32 = 0,
-      fp64 = 1
+      fp64 = 1,
+      bf16 = 2,
+      fp16 = 3
     };
 
     /// error codes
@@ -85,6 +90,16 @@ class einsum_ir::py::TensorOperation {
     einsum_ir::basic::UnaryBackendTpp m_backend_unary;
     einsum_ir::basic::ContractionBackendTpp m_backend_binary;
 
+    /// data type of the operation
+    dtype_t m_dtype = dtype_t::fp32;
+    /// sizes of the dimensions
+    std::vector< int64_t > m_dim_sizes;
+    /// level 0 strides of the tensors: [TENSOR][DIMENSION]
+    std::vector< std::vector< int64_t > > m_strides;
+
+    /// serializes concurrent executions since the backends keep per-thread state, e.g., packing memory
+    std::mutex m_mutex_execute;
+
     /**
      * Setup for a binary tensor contraction or a unary tensor operation.
      *
@@ -114,6 +129,7 @@ class einsum_ir::py::TensorOperation {
 
     /**
      * Execute the tensor operation.
+     * May be called concurrently: calls on the same object are serialized, calls on different objects run in parallel.
      *
      * @param tensor_in0 First input tensor.
      * @param tensor_in1 Second input tensor (use nullptr if unary).
@@ -123,6 +139,41 @@ class einsum_ir::py::TensorOperation {
                   void const * tensor_in1,
                   void       * tensor_out );
 
+    /**
+     * Gets the number of bytes of the operation's data type.
+     *
+     * @return Number of bytes per tensor element.
+     **/
+    int64_t get_num_bytes() const;
+
+    /**
+     * Checks if external elements of the given DLPack data type are stored in the operation's data type.
+     * bfloat16 operations also accept 16-bit unsigned integers as raw storage,
+     * all other operations require the floating point type of the operation.
+     *
+     * @param dtype_code DLPack type code of the elements.
+     * @param dtype_bits Number of bits per element.
+     * @return           true if the elements match the operation's data type, false otherwise.
+     **/
+    bool check_dtype( int64_t dtype_code,
+                      int64_t dtype_bits ) const;
+
+    /**
+     * Checks if an external tensor can be passed by pointer to the operation.
+     * The tensor's layout has to cover all elements accessed through the setup strides,
+     * i.e., every step in a dimension of the operation has to be a step in the tensor.
+     * Adjacent dimensions of the tensor which are contiguous w.r.t. each other are merged,
+     * e.g., every C-contiguous tensor with a sufficient number of elements is accepted.
+     *
+     * @param id_tensor Id of the tensor: 0=in0, 1=in1, 2=out (binary) or 0=in, 1=out (unary).
+     * @param shape     Shape of the tensor.
+     * @param strides   Strides of the tensor in elements.
+     * @return          true if the tensor's layout is compatible, false otherwise.
+     **/
+    bool check_layout( std::size_t                    id_tensor,
+                       std::vector< int64_t > const & shape,
+                       std::vector< int64_t > const & strides ) const;
+
     /**
      * Optimizes a tensor operation configuration.
      *
@@ -392,7 +443,9 @@ class einsum_ir::py::TensorOperation {
      * @param br_gemm_support     Whether to enable batch-reduce GEMM support.
      * @param packing_support     Whether to enable packing support.
      * @param sfc_support         Whether to enable SFC support.
+     * @param l1_cache_size       Size of L1 data cache in bytes.
      * @param l2_cache_size       Size of L2 cache in bytes.
+     * @param l3_cache_size       Size of L3 cache in bytes.
      * @return                    Appropriate error code.
      **/
     static error_t optimize_binary(
@@ -414,7 +467,9 @@ class einsum_ir::py::TensorOperation {
       bool                     br_gemm_support,
       bool                     packing_support,
       bool                     sfc_support,
-      int64_t                  l2_cache_size
+      int64_t                  l1_cache_size,
+      int64_t                  l2_cache_size,
+      int64_t                  l3_cache_size
     );
 };
 
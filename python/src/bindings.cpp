@@ -1,12 +1,198 @@
 #include <pybind11/stl.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <memory>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include "DLPack.h"
 #include "TensorOperation.h"
 
 namespace py  = pybind11;
 using einsum_ir::py::TensorOperation;
 
+namespace {
+  /**
+   * Zero-copy view of an external tensor.
+   * The view keeps the exporting object alive until it is destroyed.
+   **/
+  struct TensorView {
+    //! owner of the data, e.g., the DLPack capsule or the buffer
+    py::object m_owner;
+    //! exported buffer if the buffer protocol is used
+    std::unique_ptr< py::buffer_info > m_buffer_info;
+    //! pointer to the first element
+    void * m_data = nullptr;
+    //! DLPack type code of the elements, -1 if the type has no DLPack equivalent
+    int64_t m_dtype_code = -1;
+    //! number of bits per element
+    int64_t m_dtype_bits = 0;
+    //! format of the elements if the buffer protocol is used
+    std::string m_format;
+    //! shape of the tensor
+    std::vector< int64_t > m_shape;
+    //! strides of the tensor in elements
+    std::vector< int64_t > m_strides;
+  };
+
+  /**
+   * Derives the DLPack type code of a buffer protocol format.
+   *
+   * @param i_format format of the buffer's elements.
+   * @return DLPack type code, -1 if the format has no DLPack equivalent.
+   **/
+  int64_t format_to_dtype_code( std::string const & i_format ) {
+    // the first character may specify the byte order
+    std::string l_format = i_format;
+    if( !l_format.empty() && std::string( "<>=!@" ).find( l_format[0] ) != std::string::npos ) {
+      l_format.erase( 0, 1 );
+    }
+    if( l_format.size() != 1 ) {
+      return -1;
+    }
+
+    switch( l_format[0] ) {
+      case 'e': case 'f': case 'd':
+        return einsum_ir::py::dlpack::float_code;
+      case 'B': case 'H': case 'I': case 'L': case 'Q':
+        return einsum_ir::py::dlpack::uint_code;
+      case 'b': case 'h': case 'i': case 'l': case 'q':
+        return einsum_ir::py::dlpack::int_code;
+      default:
+        return -1;
+    }
+  }
+
+  /**
+   * Creates a view through DLPack (PyTorch, JAX, NumPy >= 1.22, ...) or the buffer protocol.
+   * Objects supporting the buffer protocol are exported through it since read-only NumPy arrays do not support DLPack.
+   *
+   * @param i_tensor tensor object or DLPack capsule.
+   * @param i_writable true if the tensor is written by the operation.
+   * @param i_name name of the tensor used in error messages.
+   * @return view of the tensor.
+   **/
+  TensorView create_view( py::object  const & i_tensor,
+                          bool                i_writable,
+                          std::string const & i_name ) {
+    TensorView l_view;
+
+    if( PyObject_CheckBuffer( i_tensor.ptr() ) ) {
+      l_view.m_buffer_info.reset( new py::buffer_info( py::reinterpret_borrow< py::buffer >( i_tensor ).request( i_writable ) ) );
+      py::buffer_info const & l_info = *l_view.m_buffer_info;
+
+      l_view.m_owner = i_tensor;
+      l_view.m_data = l_info.ptr;
+      l_view.m_format = l_info.format;
+      l_view.m_dtype_code = format_to_dtype_code( l_info.format );
+      l_view.m_dtype_bits = l_info.itemsize * 8;
+
+      for( py::ssize_t l_di = 0; l_di < l_info.ndim; l_di++ ) {
+        if( l_info.strides[l_di] % l_info.itemsize != 0 ) {
+          throw std::invalid_argument( i_name + ": strides have to be multiples of the element size" );
+        }
+        l_view.m_shape.push_back( l_info.shape[l_di] );
+        l_view.m_strides.push_back( l_info.strides[l_di] / l_info.itemsize );
+      }
+      return l_view;
+    }
+
+    py::object l_capsule = i_tensor;
+    if( !PyCapsule_CheckExact( i_tensor.ptr() ) ) {
+      if( !py::hasattr( i_tensor, "__dlpack__" ) ) {
+        throw std::invalid_argument( i_name + ": tensors have to support DLPack or the buffer protocol" );
+      }
+      l_capsule = i_tensor.attr( "__dlpack__" )();
+    }
+    if(    !PyCapsule_CheckExact( l_capsule.ptr() )
+        || !PyCapsule_IsValid( l_capsule.ptr(), "dltensor" ) ) {
+      throw std::invalid_argument( i_name + ": invalid or already consumed DLPack capsule" );
+    }
+
+    // the capsule is not consumed, i.e., its destructor releases the tensor
+    einsum_ir::py::dlpack::DLManagedTensor * l_managed = static_cast< einsum_ir::py::dlpack::DLManagedTensor * >( PyCapsule_GetPointer( l_capsule.ptr(), "dltensor" ) );
+    einsum_ir::py::dlpack::DLTensor const & l_dl_tensor = l_managed->dl_tensor;
+
+    if(    l_dl_tensor.device.device_type != einsum_ir::py::dlpack::cpu
+        && l_dl_tensor.device.device_type != einsum_ir::py::dlpack::cuda_host ) {
+      throw std::invalid_argument( i_name + ": tensors have to reside in host memory" );
+    }
+    if( l_dl_tensor.dtype.lanes != 1 || l_dl_tensor.dtype.bits % 8 != 0 ) {
+      throw std::invalid_argument( i_name + ": unsupported DLPack data type" );
+    }
+
+    l_view.m_owner = l_capsule;
+    l_view.m_data = static_cast< char * >( l_dl_tensor.data ) + l_dl_tensor.byte_offset;
+    l_view.m_dtype_code = l_dl_tensor.dtype.code;
+    l_view.m_dtype_bits = l_dl_tensor.dtype.bits;
+
+    // compact row-major layout if no strides are given
+    l_view.m_shape.assign( l_dl_tensor.shape, l_dl_tensor.shape + l_dl_tensor.ndim );
+    l_view.m_strides.resize( l_dl_tensor.ndim );
+    int64_t l_stride = 1;
+    for( int32_t l_di = l_dl_tensor.ndim - 1; l_di >= 0; l_di-- ) {
+      l_view.m_strides[l_di] = l_dl_tensor.strides != nullptr ? l_dl_tensor.strides[l_di] : l_stride;
+      l_stride *= l_dl_tensor.shape[l_di];
+    }
+
+    return l_view;
+  }
+
+  /**
+   * Describes the element type of a view in error messages.
+   *
+   * @param i_view view of the tensor.
+   * @return description of the element type.
+   **/
+  std::string describe_dtype( TensorView const & i_view ) {
+    if( !i_view.m_format.empty() ) {
+      return "buffer format '" + i_view.m_format + "' with " + std::to_string( i_view.m_dtype_bits ) + " bits";
+    }
+    return "DLPack type code " + std::to_string( i_view.m_dtype_code ) + " with " + std::to_string( i_view.m_dtype_bits ) + " bits";
+  }
+
+  /**
+   * Describes the data type of an operation in error messages.
+   *
+   * @param i_dtype data type of the operation.
+   * @return name of the data type.
+   **/
+  std::string describe_dtype( TensorOperation::dtype_t i_dtype ) {
+    switch( i_dtype ) {
+      case TensorOperation::dtype_t::fp32: return "float32";
+      case TensorOperation::dtype_t::fp64: return "float64";
+      case TensorOperation::dtype_t::bf16: return "bfloat16 (DLPack bfloat16 or uint16 storage)";
+      case TensorOperation::dtype_t::fp16: return "float16 (DLPack float16 or buffer format 'e')";
+      default:                             return "undefined";
+    }
+  }
+
+  /**
+   * Checks that a view matches the data type and the setup strides of an operation.
+   * bfloat16 data may also be passed as raw 16-bit storage, e.g., numpy.uint16.
+   *
+   * @param i_op tensor operation.
+   * @param i_view view of the tensor.
+   * @param i_id_tensor id of the tensor in the operation's strides.
+   * @param i_name name of the tensor used in error messages.
+   **/
+  void check_view( TensorOperation const & i_op,
+                   TensorView      const & i_view,
+                   std::size_t             i_id_tensor,
+                   std::string     const & i_name ) {
+    if( !i_op.check_dtype( i_view.m_dtype_code,
+                           i_view.m_dtype_bits ) ) {
+      throw std::invalid_argument(   i_name + ": " + describe_dtype( i_view )
+                                   + " does not match the operation's data type " + describe_dtype( i_op.m_dtype ) );
+    }
+    if( !i_op.check_layout( i_id_tensor,
+                            i_view.m_shape,
+                            i_view.m_strides ) ) {
+      throw std::invalid_argument( i_name + ": layout does not match the strides of the setup" );
+    }
+  }
+}
+
 PYBIND11_MODULE(_etops_core, m) {
   py::enum_<TensorOperation::error_t>(m, "ErrorType")
     .value("success", TensorOperation::error_t::success)
@@ -18,6 +204,8 @@ PYBIND11_MODULE(_etops_core, m) {
   py::enum_<TensorOperation::dtype_t>(m, "DataType" )
     .value("float32",  TensorOperation::dtype_t::fp32)
     .value("float64",  TensorOperation::dtype_t::fp64)
+    .value("bfloat16", TensorOperation::dtype_t::bf16)
+    .value("float16",  TensorOperation::dtype_t::fp16)
     .export_values();
 
   py::enum_<TensorOperation::prim_t>(m, "PrimType")
@@ -119,14 +307,34 @@ PYBIND11_MODULE(_etops_core, m) {
       "execute",
       [](
         TensorOperation & self,
-        py::array_t<float, py::array::c_style | py::array::forcecast> in0,
-        py::object                                                    in1,
-        py::array_t<float, py::array::c_style | py::array::forcecast> out
+        py::object         in0,
+        py::object         in1,
+        py::object         out
       ) {
+        // the data is passed by pointer, i.e., neither copies nor conversions take place
+        bool l_binary = self.m_op_type == TensorOperation::op_type_t::binary;
+
+        TensorView l_in0 = create_view( in0, false, "in0" );
+        check_view( self, l_in0, 0, "in0" );
+
+        TensorView l_in1;
+        if( l_binary ) {
+          if( in1.is_none() ) {
+            throw std::invalid_argument("in1: binary operations require a second input tensor");
+          }
+          l_in1 = create_view( in1, false, "in1" );
+          check_view( self, l_in1, 1, "in1" );
+        }
+
+        TensorView l_out = create_view( out, true, "out" );
+        check_view( self, l_out, l_binary ? 2 : 1, "out" );
+
+        // the views keep the tensors alive, the GIL is not needed while executing
+        py::gil_scoped_release l_release;
         self.execute(
-          in0.data(),
-          in1.is_none() ? nullptr : py::array(in1).data(),
-          out.mutable_data()
+          l_in0.m_data,
+          l_in1.m_data,
+          l_out.m_data
         );
       },
       R"doc(
@@ -135,6 +343,17 @@ PYBIND11_MODULE(_etops_core, m) {
         For binary operations: provide all three tensor arguments.
         For unary operations: pass None for in1 argument.
 
+        The GIL is released during the execution. Concurrent calls on the same
+        operation are serialized, calls on different operations run in parallel.
+
+        Tensors are passed by pointer without copies through DLPack (e.g., PyTorch,
+        JAX or NumPy) or the buffer protocol (e.g., NumPy). Strided views are
+        supported as long as their layout covers all elements addressed by the
+        strides of the setup. The element type has to match the data type of the
+        operation exactly, e.g., numpy.float16 or torch.float16 for float16 and
+        torch.bfloat16 for bfloat16. bfloat16 data may also be passed as raw
+        16-bit storage, e.g., a numpy.uint16 array.
+
         :param in0: First input tensor data.
         :param in1: Second input tensor data (pass None for unary operations).
         :param out: Output tensor data.
@@ -177,7 +396,7 @@ PYBIND11_MODULE(_etops_core, m) {
         std::set<std::string> valid_keys = {
           "target_m", "target_n", "target_k", "num_threads",
           "br_gemm_support", "packed_gemm_support", "packing_support",
-          "sfc_support", "l2_cache_size"
+          "sfc_support", "l1_cache_size", "l2_cache_size", "l3_cache_size"
         };
 
         try {
@@ -220,9 +439,15 @@ PYBIND11_MODULE(_etops_core, m) {
           if (optimization_config_dict.contains("sfc_support")) {
             l_optimization_config.sfc_support = optimization_config_dict["sfc_support"].cast<bool>();
           }
+          if (optimization_config_dict.contains("l1_cache_size")) {
+            l_optimization_config.l1_cache_size = optimization_config_dict["l1_cache_size"].cast<int64_t>();
+          }
           if (optimization_config_dict.contains("l2_cache_size")) {
             l_optimization_config.l2_cache_size = optimization_config_dict["l2_cache_size"].cast<int64_t>();
           }
+          if (optimization_config_dict.contains("l3_cache_size")) {
+            l_optimization_config.l3_cache_size = optimization_config_dict["l3_cache_size"].cast<int64_t>();
+          }
         } catch (...) {
           // Type casting failed
           std::vector<std::vector<std::vector<int64_t>>> empty_strides;
@@ -319,7 +544,9 @@ PYBIND11_MODULE(_etops_core, m) {
         result["br_gemm_support"]     = l_config.br_gemm_support;
         result["packing_support"]     = l_config.packing_support;
         result["sfc_support"]         = l_config.sfc_support;
+        result["l1_cache_size"]       = l_config.l1_cache_size;
         result["l2_cache_size"]       = l_config.l2_cache_size;
+        result["l3_cache_size"]       = l_config.l3_cache_size;
 
         return result;
       },
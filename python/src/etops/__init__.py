@@ -16,9 +16,12 @@ from ._etops_core import (
     ErrorType       as _ErrorType
 )
 
+from collections import OrderedDict
+from concurrent.futures import Future, ThreadPoolExecutor
 from dataclasses import dataclass
-from typing import Sequence, Union, Optional, Dict
+from typing import Any, Sequence, Tuple, Union, Optional, Dict
 import json
+import threading
 
 # Make _ErrorType the *single* public alias
 ErrorType = _ErrorType
@@ -36,6 +39,10 @@ dtype = DataType
 float32: _DataType = _DataType.float32
 #: Alias for DataType.float64
 float64: _DataType = _DataType.float64
+#: Alias for DataType.bfloat16
+bfloat16: _DataType = _DataType.bfloat16
+#: Alias for DataType.float16
+float16: _DataType = _DataType.float16
 
 class prim:
     """Namespace for primitive types used in tensor operations."""
@@ -412,6 +419,36 @@ class TensorOperation(_CppOp):
         if config is not None:
             config.apply(self)
 
+    def execute_async(self, in0: Any, in1: Any, out: Any) -> Future:
+        """
+        Execute the tensor operation in a background thread.
+
+        The GIL is released during the execution, i.e., Python code and other
+        operations can run concurrently. Concurrent executions of the same
+        operation are serialized, executions of different operations overlap.
+        The tensors must neither be modified nor freed before the future is done.
+
+        Args:
+            in0: First input tensor.
+            in1: Second input tensor (None for unary operations).
+            out: Output tensor.
+        Returns:
+            Future whose result is None once the output is written.
+            Errors of the execution are raised by Future.result().
+        """
+        return _get_executor().submit(self.execute, in0, in1, out)
+
+_executor: Optional[ThreadPoolExecutor] = None
+_executor_lock = threading.Lock()
+
+def _get_executor() -> ThreadPoolExecutor:
+    """Returns the executor of asynchronous tensor operations, created on first use."""
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            _executor = ThreadPoolExecutor(thread_name_prefix="etops")
+        return _executor
+
 # Backend namespace
 class _TPPBackend:
     """TPP (Tensor Processing Primitives) backend for tensor operations."""
@@ -431,7 +468,9 @@ class _TPPBackend:
             - br_gemm_support (bool): Batch-reduce GEMM support.
             - packing_support (bool): Packing support.
             - sfc_support (bool): SFC support.
-            - l2_cache_size (int): L2 cache size in bytes (default: 1048576)
+            - l1_cache_size (int): L1 data cache size in bytes (default: probed, 32768 if unknown)
+            - l2_cache_size (int): L2 cache size per core in bytes (default: probed, 1048576 if unknown)
+            - l3_cache_size (int): L3 cache size in bytes (default: probed, 0 if unknown)
         """
         return _CppOp.get_default_optimization_config("tpp")
 
@@ -460,7 +499,9 @@ def optimize(
                            - br_gemm_support (bool): Batch-reduce GEMM support
                            - packing_support (bool): Packing support
                            - sfc_support (bool): SFC support
+                           - l1_cache_size (int): L1 data cache size in bytes, 0 disables the L1 heuristic
                            - l2_cache_size (int): L2 cache size in bytes
+                           - l3_cache_size (int): L3 cache size in bytes, 0 disables the L3 heuristic
 
     Returns:
         Optimized TensorOperationConfig
@@ -512,6 +553,178 @@ def optimize(
         strides=opt_strides
     )
 
+#: Maximum number of compiled operations kept by einsum
+EINSUM_CACHE_SIZE: int = 256
+
+_einsum_cache: "OrderedDict[tuple, TensorOperation]" = OrderedDict()
+_einsum_cache_lock = threading.Lock()
+
+_einsum_dtypes = {
+    "float32":  float32,
+    "float64":  float64,
+    "bfloat16": bfloat16,
+    "float16":  float16
+}
+
+def _get_layout(tensor: Any) -> Tuple[Tuple[int, ...], Tuple[int, ...], str]:
+    """
+    Derives the shape, the strides in elements and the name of the data type of a tensor.
+    PyTorch tensors provide their strides through stride(), NumPy arrays in bytes through strides.
+    Tensors without stride information, e.g., JAX arrays, are assumed to be C-contiguous.
+    """
+    shape = tuple(int(size) for size in tensor.shape)
+    dtype_name = str(tensor.dtype).split(".")[-1]
+
+    if callable(getattr(tensor, "stride", None)):
+        strides = tuple(int(stride) for stride in tensor.stride())
+    elif getattr(tensor, "strides", None) is not None and hasattr(tensor, "itemsize"):
+        strides = tuple(int(stride) // int(tensor.itemsize) for stride in tensor.strides)
+    else:
+        strides = [1] * len(shape)
+        for di in range(len(shape) - 2, -1, -1):
+            strides[di] = strides[di + 1] * shape[di + 1]
+        strides = tuple(strides)
+
+    return shape, strides, dtype_name
+
+def _empty(like: Any, shape: Tuple[int, ...]) -> Any:
+    """Allocates an uninitialized C-contiguous tensor of the same kind and data type as the given one."""
+    if callable(getattr(like, "new_empty", None)):
+        return like.new_empty(shape)
+    import numpy
+    return numpy.empty(shape, dtype=like.dtype)
+
+def _create_einsum_config(
+    inputs: Sequence[str],
+    output: str,
+    layouts: Sequence[Tuple[Tuple[int, ...], Tuple[int, ...], str]]
+) -> TensorOperationConfig:
+    """
+    Creates the configuration of a binary contraction from the parsed einsum string and the tensors' layouts.
+
+    Dimension types are derived from the occurrence of the indices:
+      c: in0, in1 and out
+      m: in0 and out
+      n: in1 and out
+      k: in0 and in1
+    """
+    for term, (shape, _, _) in zip(list(inputs) + [output], layouts):
+        if len(set(term)) != len(term):
+            raise ValueError(f"Repeated index in '{term}' is not supported.")
+        if len(term) != len(shape):
+            raise ValueError(f"Term '{term}' does not match the tensor's rank {len(shape)}.")
+
+    if layouts[0][2] != layouts[1][2] or layouts[0][2] != layouts[2][2]:
+        raise ValueError("All tensors have to have the same data type.")
+    if layouts[0][2] not in _einsum_dtypes:
+        raise ValueError(f"Unsupported data type: {layouts[0][2]}.")
+
+    indices = list(output) + [index for index in inputs[0] if index not in output]
+
+    dim_types = []
+    dim_sizes = []
+    strides = [[], [], []]
+    for index in indices:
+        in_tensors = [index in term for term in (inputs[0], inputs[1], output)]
+        if in_tensors == [True, True, True]:
+            dim_types.append(DimType.c)
+        elif in_tensors == [True, False, True]:
+            dim_types.append(DimType.m)
+        elif in_tensors == [False, True, True]:
+            dim_types.append(DimType.n)
+        elif in_tensors == [True, True, False]:
+            dim_types.append(DimType.k)
+        else:
+            raise ValueError(f"Index '{index}' has to occur in at least two of the tensors.")
+
+        size = None
+        for te, term in enumerate((inputs[0], inputs[1], output)):
+            if index in term:
+                pos = term.index(index)
+                if size is not None and size != layouts[te][0][pos]:
+                    raise ValueError(f"Sizes of index '{index}' do not match.")
+                size = layouts[te][0][pos]
+                strides[te].append(layouts[te][1][pos])
+            else:
+                strides[te].append(0)
+        dim_sizes.append(size)
+
+    for index in inputs[1]:
+        if index not in indices:
+            raise ValueError(f"Index '{index}' has to occur in at least two of the tensors.")
+
+    return TensorOperationConfig(
+        backend="tpp",
+        data_type=_einsum_dtypes[layouts[0][2]],
+        prim_first=PrimType.zero,
+        prim_main=PrimType.gemm,
+        prim_last=PrimType.none,
+        dim_types=tuple(dim_types),
+        exec_types=tuple(ExecType.seq for _ in dim_types),
+        dim_sizes=tuple(dim_sizes),
+        strides=(tuple(tuple(tensor) for tensor in strides),)
+    )
+
+def einsum(expression: str, in0: Any, in1: Any, out: Any = None) -> Any:
+    """
+    Evaluates a binary einsum expression, e.g., etops.einsum("abk,kc->abc", a, b).
+
+    Dimension types and strides are derived from the tensors. The optimized and
+    compiled TensorOperation is cached w.r.t. the expression, shapes, strides and
+    data type, i.e., repeated calls with the same signature directly execute it.
+    Tensors are passed without copies, see TensorOperation.execute.
+
+    Args:
+        expression: Einsum string with two inputs and an explicit output, e.g., "km,nk->nm".
+        in0: First input tensor.
+        in1: Second input tensor.
+        out: Optional output tensor. If None, a C-contiguous tensor of the same kind as in0 is allocated.
+    Returns:
+        The output tensor.
+    Raises:
+        ValueError: If the expression or the tensors are not supported.
+        RuntimeError: If the optimization or the setup fails.
+    """
+    expression = expression.replace(" ", "")
+    if "->" not in expression or "." in expression:
+        raise ValueError("The einsum string requires an explicit output and must not contain an ellipsis.")
+    inputs, output = expression.split("->")
+    inputs = inputs.split(",")
+    if len(inputs) != 2:
+        raise ValueError("Only binary einsum expressions are supported.")
+
+    if out is None:
+        sizes = {}
+        for term, tensor in zip(inputs, (in0, in1)):
+            sizes.update(zip(term, tensor.shape))
+        if any(index not in sizes for index in output):
+            raise ValueError("Every index of the output has to occur in an input.")
+        out = _empty(in0, tuple(int(sizes[index]) for index in output))
+
+    layouts = tuple(_get_layout(tensor) for tensor in (in0, in1, out))
+    key = (expression, layouts)
+
+    with _einsum_cache_lock:
+        op = _einsum_cache.get(key)
+        if op is not None:
+            _einsum_cache.move_to_end(key)
+
+    if op is None:
+        config = _create_einsum_config(inputs, output, layouts)
+        op = TensorOperation(optimize(config))
+        with _einsum_cache_lock:
+            _einsum_cache[key] = op
+            while len(_einsum_cache) > EINSUM_CACHE_SIZE:
+                _einsum_cache.popitem(last=False)
+
+    op.execute(in0, in1, out)
+    return out
+
+def clear_einsum_cache() -> None:
+    """Removes all compiled operations cached by einsum."""
+    with _einsum_cache_lock:
+        _einsum_cache.clear()
+
 __all__ = [
     "TensorOperation",
     "TensorOperationConfig",
@@ -522,11 +735,15 @@ __all__ = [
     "dtype",
     "float32",
     "float64",
+    "bfloat16",
+    "float16",
     "prim",
     "etype",
     "exec",
     "dim",
     "backend",
     "optimize",
+    "einsum",
+    "clear_einsum_cache",
     "ErrorType"
 ]
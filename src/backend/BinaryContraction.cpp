@@ -1,4 +1,6 @@
 #include "BinaryContraction.h"
+#include "../basic/Topology.h"
+#include "../basic/binary/ContractionBackend.h"
 #include <list>
 #include <algorithm>
 #include <cassert>
@@ -341,12 +343,50 @@ void einsum_ir::backend::BinaryContraction::init( int64_t
   m_ktype_first_touch = i_ktype_first_touch;
   m_ktype_main        = i_ktype_main;
   m_ktype_last_touch  = i_ktype_last_touch;
+  m_ktypes_epilogue.clear();
 
   m_memory = i_memory;
 
   m_num_threads = i_num_threads;
   
-  m_l2_cache_size = 1024 * 1024; // default to 1MB L2 cache size
+  basic::Topology const & l_topology = basic::Topology::get_instance();
+  m_l1_cache_size = l_topology.m_l1_cache_size;
+  m_l2_cache_size = l_topology.m_l2_cache_size;
+  m_l3_cache_size = l_topology.m_l3_cache_size;
+}
+
+void einsum_ir::backend::BinaryContraction::set_epilogue( std::vector< kernel_t > const & i_ktypes,
+                                                          double                          i_alpha,
+                                                          double                          i_beta ) {
+  m_ktypes_epilogue = i_ktypes;
+  m_epilogue_alpha = i_alpha;
+  m_epilogue_beta = i_beta;
+  m_ktype_last_touch = i_ktypes.empty() ? kernel_t::UNDEFINED_KTYPE : kernel_t::EPILOGUE;
+}
+
+void einsum_ir::backend::BinaryContraction::set_streamed_inputs( bool i_streamed_left,
+                                                                 bool i_streamed_right ) {
+  m_streamed_left  = i_streamed_left;
+  m_streamed_right = i_streamed_right;
+}
+
+void einsum_ir::backend::BinaryContraction::set_contraction_memory( int64_t i_id ) {
+  m_id_contraction_memory = i_id;
+}
+
+einsum_ir::basic::ContractionMemoryManager * einsum_ir::backend::BinaryContraction::contraction_memory() {
+  if( m_memory == nullptr ) {
+    return nullptr;
+  }
+  return m_memory->get_contraction_memory_manager( m_id_contraction_memory );
+}
+
+std::vector< einsum_ir::basic::kernel_t > einsum_ir::backend::BinaryContraction::ktypes_epilogue_basic() const {
+  std::vector< basic::kernel_t > l_ktypes;
+  for( kernel_t l_ktype : m_ktypes_epilogue ) {
+    l_ktypes.push_back( ce_kernelt_to_basic( l_ktype ) );
+  }
+  return l_ktypes;
 }
 
 einsum_ir::err_t einsum_ir::backend::BinaryContraction::compile_base() {
@@ -431,6 +471,69 @@ einsum_ir::err_t einsum_ir::backend::BinaryContraction::compile_base() {
   return einsum_ir::SUCCESS;
 }
 
+int64_t einsum_ir::backend::BinaryContraction::num_ops( int64_t                              i_num_dims_left,
+                                                        int64_t                              i_num_dims_right,
+                                                        int64_t                              i_num_dims_out,
+                                                        int64_t                      const * i_dim_ids_left,
+                                                        int64_t                      const * i_dim_ids_right,
+                                                        int64_t                      const * i_dim_ids_out,
+                                                        std::map< int64_t, int64_t > const * i_dim_sizes,
+                                                        kernel_t                             i_ktype_first_touch,
+                                                        kernel_t                             i_ktype_main ) {
+  std::vector< dim_t > l_dim_types_out;
+  std::vector< int64_t > l_dim_ids_c;
+  std::vector< int64_t > l_dim_ids_m;
+  std::vector< int64_t > l_dim_ids_n;
+  std::vector< int64_t > l_dim_ids_k;
+  std::vector< int64_t > l_dim_ids_i;
+  std::vector< int64_t > l_dim_ids_j;
+
+  dim_types_ids( i_num_dims_left,
+                 i_num_dims_right,
+                 i_num_dims_out,
+                 i_dim_ids_left,
+                 i_dim_ids_right,
+                 i_dim_ids_out,
+                 &l_dim_types_out,
+                 &l_dim_ids_c,
+                 &l_dim_ids_m,
+                 &l_dim_ids_n,
+                 &l_dim_ids_k,
+                 &l_dim_ids_i,
+                 &l_dim_ids_j );
+
+  int64_t l_size_c = 1;
+  int64_t l_size_m = 1;
+  int64_t l_size_n = 1;
+  int64_t l_size_k = 1;
+
+  for( std::size_t l_c = 0; l_c < l_dim_ids_c.size(); l_c++ ) {
+    l_size_c *= i_dim_sizes->at( l_dim_ids_c[l_c] );
+  }
+  for( std::size_t l_m = 0; l_m < l_dim_ids_m.size(); l_m++ ) {
+    l_size_m *= i_dim_sizes->at( l_dim_ids_m[l_m] );
+  }
+  for( std::size_t l_n = 0; l_n < l_dim_ids_n.size(); l_n++ ) {
+    l_size_n *= i_dim_sizes->at( l_dim_ids_n[l_n] );
+  }
+  for( std::size_t l_k = 0; l_k < l_dim_ids_k.size(); l_k++ ) {
+    l_size_k *= i_dim_sizes->at( l_dim_ids_k[l_k] );
+  }
+
+  int64_t l_num_ops = l_size_c * l_size_m * l_size_n * l_size_k * 2;
+
+  if( i_ktype_main == kernel_t::CPX_MADD ) {
+    l_num_ops *= 2; // four matrix mults ignoring previously counted batch dim
+  }
+
+  if(    i_ktype_first_touch == ZERO
+      || i_ktype_first_touch == CPX_ZERO ) {
+    l_num_ops -= l_size_c * l_size_m * l_size_n;
+  }
+
+  return l_num_ops;
+}
+
 int64_t einsum_ir::backend::BinaryContraction::num_ops() {
   int64_t l_size_c = 1;
   int64_t l_size_m = 1;
@@ -462,4 +565,20 @@ int64_t einsum_ir::backend::BinaryContraction::num_ops() {
   }
 
   return l_num_ops;
-}
\ No newline at end of file
+}
+
+void einsum_ir::backend::BinaryContraction::set_profiling( bool i_profiling ) {
+  basic::ContractionBackend * l_backend = contraction_backend();
+  if( l_backend != nullptr ) {
+    l_backend->set_profiling( i_profiling );
+  }
+}
+
+double einsum_ir::backend::BinaryContraction::time_packing() {
+  basic::ContractionBackend * l_backend = contraction_backend();
+  if( l_backend == nullptr ) {
+    return 0;
+  }
+
+  return l_backend->time_packing();
+}
@@ -11,6 +11,9 @@ namespace einsum_ir {
   namespace backend {
     class BinaryContraction;
   }
+  namespace basic {
+    class ContractionBackend;
+  }
 }
 
 class einsum_ir::backend::BinaryContraction {
@@ -117,6 +120,15 @@ class einsum_ir::backend::BinaryContraction {
     //! type of the last touch kernel
     kernel_t m_ktype_last_touch = UNDEFINED_KTYPE;
 
+    //! element-wise operations of the last touch if its type is EPILOGUE
+    std::vector< kernel_t > m_ktypes_epilogue;
+
+    //! factor of the SCALE operation in the epilogue
+    double m_epilogue_alpha = 1.0;
+
+    //! factor of the auxiliary tensor in the epilogue's ADD operation
+    double m_epilogue_beta = 1.0;
+
     //! true if the binary contraction was compiled
     bool m_compiled = false;
 
@@ -135,9 +147,31 @@ class einsum_ir::backend::BinaryContraction {
     //! number of threads for the contraction
     int64_t m_num_threads = 1;
 
+    //! size of the L1 data cache in bytes
+    int64_t m_l1_cache_size = 0;
+
     //! size of the L2 cache in bytes
     int64_t m_l2_cache_size = 1;
 
+    //! size of the L3 cache in bytes, zero if unknown
+    int64_t m_l3_cache_size = 0;
+
+    //! true if the left input is streamed from a memory-mapped file
+    bool m_streamed_left = false;
+
+    //! true if the right input is streamed from a memory-mapped file
+    bool m_streamed_right = false;
+
+    //! id of the contraction memory manager in the memory manager
+    int64_t m_id_contraction_memory = 0;
+
+    /**
+     * Gets the contraction memory manager providing the scratch memory.
+     *
+     * @return contraction memory manager, nullptr if no memory manager is used.
+     **/
+    basic::ContractionMemoryManager * contraction_memory();
+
     /**
      * Derives the dimension types of tensor t2 w.r.t. tensors t0 and t1.
      *
@@ -248,6 +282,30 @@ class einsum_ir::backend::BinaryContraction {
                          std::map< int64_t, int64_t > const * i_dim_sizes,
                          std::map< int64_t, int64_t >       * o_strides );
 
+    /**
+     * Derives the number of operations of a binary contraction without initializing it.
+     *
+     * @param i_num_dims_left number of dimensions of the left tensor.
+     * @param i_num_dims_right number of dimensions of the right tensor.
+     * @param i_num_dims_out number of dimensions of the output tensor.
+     * @param i_dim_ids_left dimension ids of the left tensor.
+     * @param i_dim_ids_right dimension ids of the right tensor.
+     * @param i_dim_ids_out dimensions ids of the output tensor.
+     * @param i_dim_sizes mapping from the dimension ids to the sizes.
+     * @param i_ktype_first_touch type of the first-touch kernel.
+     * @param i_ktype_main type of the main kernel.
+     * @return number of operations.
+     **/
+    static int64_t num_ops( int64_t                              i_num_dims_left,
+                            int64_t                              i_num_dims_right,
+                            int64_t                              i_num_dims_out,
+                            int64_t                      const * i_dim_ids_left,
+                            int64_t                      const * i_dim_ids_right,
+                            int64_t                      const * i_dim_ids_out,
+                            std::map< int64_t, int64_t > const * i_dim_sizes,
+                            kernel_t                             i_ktype_first_touch,
+                            kernel_t                             i_ktype_main );
+
     /**
      * Virtual destructor.
      **/
@@ -347,6 +405,45 @@ class einsum_ir::backend::BinaryContraction {
                kernel_t                             i_ktype_last_touch,
                int64_t                              i_num_threads  );
 
+    /**
+     * Sets a chain of element-wise operations as last touch, e.g., a bias addition followed by an activation function.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_ktypes operations of the chain: ADD, SCALE, RELU, GELU, SILU, SIGMOID or TANH.
+     * @param i_alpha factor of the SCALE operation.
+     * @param i_beta factor of the auxiliary tensor in the ADD operation.
+     **/
+    void set_epilogue( std::vector< kernel_t > const & i_ktypes,
+                       double                          i_alpha,
+                       double                          i_beta );
+
+    /**
+     * Gets the operations of the epilogue as kernel types of the basic backends.
+     *
+     * @return operations of the epilogue.
+     **/
+    std::vector< basic::kernel_t > ktypes_epilogue_basic() const;
+
+    /**
+     * Marks inputs as streamed from memory-mapped files.
+     * Backends based on the contraction optimizer traverse streamed inputs in storage order and prefetch their next tiles.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_streamed_left true if the left input is streamed.
+     * @param i_streamed_right true if the right input is streamed.
+     **/
+    void set_streamed_inputs( bool i_streamed_left,
+                              bool i_streamed_right );
+
+    /**
+     * Selects the contraction memory manager of the memory manager which provides the scratch memory.
+     * Contractions which are evaluated concurrently require different contraction memory managers.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_id id of the contraction memory manager, 0 by default.
+     **/
+    void set_contraction_memory( int64_t i_id );
+
     /**
      * Compiles the base data.
      *
@@ -390,6 +487,28 @@ class einsum_ir::backend::BinaryContraction {
      **/
     int64_t num_ops();
 
+    /**
+     * Gets the contraction backend which executes the compiled contraction.
+     *
+     * @return contraction backend, nullptr if the contraction is executed by an external library.
+     **/
+    virtual basic::ContractionBackend * contraction_backend(){ return nullptr; };
+
+    /**
+     * Enables or disables the measurement of the packing time.
+     * Contractions without a contraction backend ignore the call.
+     *
+     * @param i_profiling true if the packing time is measured.
+     **/
+    void set_profiling( bool i_profiling );
+
+    /**
+     * Gets the packing time of the last contraction.
+     *
+     * @return packing time in seconds, averaged over the threads. zero if the contraction has no contraction backend.
+     **/
+    double time_packing();
+
 };
 
 #endif
\ No newline at end of file
@@ -83,6 +83,13 @@ class einsum_ir::backend::BinaryContractionBlas: public BinaryContraction {
                    void const * i_tensor_right,
                    void const * i_tensor_out_aux,
                    void       * io_tensor_out );
+
+    /**
+     * Gets the contraction backend which executes the compiled contraction.
+     *
+     * @return contraction backend.
+     **/
+    basic::ContractionBackend * contraction_backend();
 };
 
 #endif
@@ -1,6 +1,7 @@
 #include "BinaryContractionFactory.h"
 
 #include "BinaryContractionScalar.h"
+#include "BinaryContractionSimd.h"
 
 #ifdef PP_EINSUM_IR_HAS_LIBXSMM
 #include "BinaryContractionTpp.h"
@@ -19,6 +20,10 @@ bool einsum_ir::backend::BinaryContractionFactory::supports( einsum_ir::backend_
     return true;
   }
 
+  if( i_backend == einsum_ir::backend_t::SIMD ) {
+    return true;
+  }
+
 #ifdef PP_EINSUM_IR_HAS_LIBXSMM
   if( i_backend == einsum_ir::backend_t::TPP ) {
     return true;
@@ -45,6 +50,10 @@ einsum_ir::backend::BinaryContraction * einsum_ir::backend::BinaryContractionFac
     return new BinaryContractionScalar();
   }
 
+  if( i_backend == einsum_ir::backend_t::SIMD ) {
+    return new BinaryContractionSimd();
+  }
+
 #ifdef PP_EINSUM_IR_HAS_LIBXSMM
   if( i_backend == einsum_ir::backend_t::TPP ) {
     return new BinaryContractionTpp();
@@ -1,5 +1,6 @@
 #include "BinaryContractionScalar.h"
 #include "../basic/binary/ContractionOptimizer.h"
+#include "../basic/binary/ContractionConfigStore.h"
 
 einsum_ir::err_t einsum_ir::backend::BinaryContractionScalar::compile() {
   err_t l_err = err_t::UNDEFINED_ERROR;
@@ -65,57 +66,73 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionScalar::compile() {
     l_loops[l_id].stride_out     = map_find_default<int64_t>(&l_strides_out,     l_dim_id, 0);
   }
 
-  //convert kernel to basic
-  basic::kernel_t l_ktype_first_touch = ce_kernelt_to_basic(m_ktype_first_touch);
-  basic::kernel_t l_ktype_main        = ce_kernelt_to_basic(m_ktype_main);
-  basic::kernel_t l_ktype_last_touch  = ce_kernelt_to_basic(m_ktype_last_touch);
-
-  //convert dtype
-  basic::data_t l_dtype_left  = ce_dtype_to_basic(m_dtype_left);
-  basic::data_t l_dtype_right = ce_dtype_to_basic(m_dtype_right);
-  basic::data_t l_dtype_comp  = ce_dtype_to_basic(m_dtype_comp);
-  basic::data_t l_dtype_out   = ce_dtype_to_basic(m_dtype_out);
-
-  //optimize loops
-  einsum_ir::basic::ContractionOptimizer l_optim;
-
-  int64_t l_num_threads_m = 1;
-  int64_t l_num_threads_n = 1;
-  int64_t l_num_threads_shared = m_num_threads;
-  l_optim.init(&l_loops,
-               &l_ktype_main,
-               m_target_prim_m,
-               m_target_prim_n,
-               m_target_prim_k,
-               true,
-               false,
-               false,
-               basic::packed_gemm_t::ALL_STRIDE_ONE,
-               ce_n_bytes(m_dtype_out),
-               m_l2_cache_size,
-               &l_num_threads_shared,
-               &l_num_threads_m,
-               &l_num_threads_n );
-  l_optim.optimize();
-
-  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = nullptr;
-  if( m_memory != nullptr ){
-    l_contraction_memory = m_memory->get_contraction_memory_manager();
+  //unoptimized configuration
+  basic::ContractionConfig l_config;
+  l_config.m_iterations         = l_loops;
+  l_config.m_dtype_left         = ce_dtype_to_basic(m_dtype_left);
+  l_config.m_dtype_right        = ce_dtype_to_basic(m_dtype_right);
+  l_config.m_dtype_comp         = ce_dtype_to_basic(m_dtype_comp);
+  l_config.m_dtype_out          = ce_dtype_to_basic(m_dtype_out);
+  l_config.m_ktype_first_touch  = ce_kernelt_to_basic(m_ktype_first_touch);
+  l_config.m_ktype_main         = ce_kernelt_to_basic(m_ktype_main);
+  l_config.m_ktype_last_touch   = ce_kernelt_to_basic(m_ktype_last_touch);
+  l_config.m_num_threads_shared = m_num_threads;
+  l_config.m_num_threads_sfc_m  = 1;
+  l_config.m_num_threads_sfc_n  = 1;
+
+  //optimize loops, unless an optimized configuration is stored
+  basic::ContractionConfigStore & l_store = basic::ContractionConfigStore::get_instance();
+  std::vector< int64_t > l_key = basic::ContractionConfigStore::key( l_config,
+                                                                     m_target_prim_m,
+                                                                     m_target_prim_n,
+                                                                     m_target_prim_k,
+                                                                     true,
+                                                                     false,
+                                                                     false,
+                                                                     basic::packed_gemm_t::ALL_STRIDE_ONE,
+                                                                     m_l1_cache_size,
+                                                                     m_l2_cache_size,
+                                                                     m_l3_cache_size,
+                                                                     m_streamed_left,
+                                                                     m_streamed_right );
+
+  if( !l_store.find( l_key, l_config ) ) {
+    einsum_ir::basic::ContractionOptimizer l_optim;
+    l_optim.init(&l_config.m_iterations,
+                 &l_config.m_ktype_main,
+                 m_target_prim_m,
+                 m_target_prim_n,
+                 m_target_prim_k,
+                 true,
+                 false,
+                 false,
+                 basic::packed_gemm_t::ALL_STRIDE_ONE,
+                 ce_n_bytes(m_dtype_out),
+                 m_l2_cache_size,
+                 &l_config.m_num_threads_shared,
+                 &l_config.m_num_threads_sfc_m,
+                 &l_config.m_num_threads_sfc_n );
+    l_optim.set_cache_sizes( m_l1_cache_size,
+                             m_l3_cache_size );
+    l_optim.set_streamed_inputs( m_streamed_left,
+                                 m_streamed_right );
+    l_optim.optimize();
+
+    l_store.insert( l_key, l_config );
   }
-  
+
+  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = contraction_memory();
+
   //compile backend
-  m_backend.init( l_loops,
-                  l_dtype_left,
-                  l_dtype_right,
-                  l_dtype_comp,
-                  l_dtype_out,
-                  l_ktype_first_touch,
-                  l_ktype_main,
-                  l_ktype_last_touch,
-                  l_num_threads_shared,
-                  l_num_threads_m,
-                  l_num_threads_n,
+  m_backend.init( l_config,
                   l_contraction_memory );
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    m_backend.set_epilogue( ktypes_epilogue_basic(),
+                            m_epilogue_alpha,
+                            m_epilogue_beta );
+  }
+  m_backend.set_streamed_inputs( m_streamed_left,
+                                 m_streamed_right );
   
   l_err = ce_basic_err_to_err(m_backend.compile());
   if( l_err != err_t::SUCCESS ) {
@@ -142,4 +159,8 @@ void einsum_ir::backend::BinaryContractionScalar::contract( void const * i_tenso
             i_tensor_right,
             nullptr,
             io_tensor_out );
-}
\ No newline at end of file
+}
+
+einsum_ir::basic::ContractionBackend * einsum_ir::backend::BinaryContractionScalar::contraction_backend() {
+  return &m_backend;
+}
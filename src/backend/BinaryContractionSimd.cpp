@@ -0,0 +1,166 @@
+#include "BinaryContractionSimd.h"
+#include "../basic/binary/ContractionOptimizer.h"
+#include "../basic/binary/ContractionConfigStore.h"
+
+einsum_ir::err_t einsum_ir::backend::BinaryContractionSimd::compile() {
+  err_t l_err = err_t::UNDEFINED_ERROR;
+
+  l_err = BinaryContraction::compile_base();
+  if( l_err != einsum_ir::SUCCESS ) {
+    return l_err;
+  }
+
+  // derive strides
+  std::map< int64_t, int64_t > l_strides_left;
+  std::map< int64_t, int64_t > l_strides_right;
+  std::map< int64_t, int64_t > l_strides_out;
+  std::map< int64_t, int64_t > l_strides_out_aux;
+
+  strides( m_num_dims_left,
+           m_dim_ids_left,
+           m_dim_sizes_outer_left,
+           &l_strides_left );
+
+  strides( m_num_dims_right,
+           m_dim_ids_right,
+           m_dim_sizes_outer_right,
+           &l_strides_right );
+
+  strides( m_num_dims_out,
+           m_dim_ids_out,
+           m_dim_sizes_outer_out,
+           &l_strides_out );
+
+  if( m_dim_sizes_outer_out_aux != nullptr ) {
+    strides( m_num_dims_out,
+             m_dim_ids_out,
+             m_dim_sizes_outer_out_aux,
+             &l_strides_out_aux );
+  }
+  else if(    m_ktype_first_touch == kernel_t::ADD
+           || m_ktype_first_touch == kernel_t::COPY ) { 
+    l_strides_out_aux = l_strides_out;
+  }
+
+  //get all dimension ids
+  std::vector<int64_t> l_all_dim_ids; 
+  l_all_dim_ids.reserve( m_dim_ids_c.size() + m_dim_ids_m.size() + m_dim_ids_n.size() + m_dim_ids_k.size() );
+  l_all_dim_ids.insert(l_all_dim_ids.end(), m_dim_ids_c.begin(), m_dim_ids_c.end());
+  l_all_dim_ids.insert(l_all_dim_ids.end(), m_dim_ids_m.begin(), m_dim_ids_m.end());
+  l_all_dim_ids.insert(l_all_dim_ids.end(), m_dim_ids_n.begin(), m_dim_ids_n.end());
+  l_all_dim_ids.insert(l_all_dim_ids.end(), m_dim_ids_k.begin(), m_dim_ids_k.end());
+
+
+  //lower to ContractionOptimizer data structure
+  std::vector<basic::iter_property> l_loops;
+  l_loops.resize(l_all_dim_ids.size());
+
+  for(std::size_t l_id = 0; l_id < l_all_dim_ids.size(); l_id++){
+    int64_t l_dim_id = l_all_dim_ids[l_id];
+    l_loops[l_id].dim_type       = ce_dimt_to_basic(m_dim_types[l_dim_id]);
+    l_loops[l_id].exec_type      = basic::exec_t::SEQ;
+    l_loops[l_id].size           = m_dim_sizes_inner->at(l_dim_id);
+    l_loops[l_id].stride_left    = map_find_default<int64_t>(&l_strides_left,    l_dim_id, 0);
+    l_loops[l_id].stride_right   = map_find_default<int64_t>(&l_strides_right,   l_dim_id, 0);
+    l_loops[l_id].stride_out_aux = map_find_default<int64_t>(&l_strides_out_aux, l_dim_id, 0);
+    l_loops[l_id].stride_out     = map_find_default<int64_t>(&l_strides_out,     l_dim_id, 0);
+  }
+
+  //unoptimized configuration
+  basic::ContractionConfig l_config;
+  l_config.m_iterations         = l_loops;
+  l_config.m_dtype_left         = ce_dtype_to_basic(m_dtype_left);
+  l_config.m_dtype_right        = ce_dtype_to_basic(m_dtype_right);
+  l_config.m_dtype_comp         = ce_dtype_to_basic(m_dtype_comp);
+  l_config.m_dtype_out          = ce_dtype_to_basic(m_dtype_out);
+  l_config.m_ktype_first_touch  = ce_kernelt_to_basic(m_ktype_first_touch);
+  l_config.m_ktype_main         = ce_kernelt_to_basic(m_ktype_main);
+  l_config.m_ktype_last_touch   = ce_kernelt_to_basic(m_ktype_last_touch);
+  l_config.m_num_threads_shared = m_num_threads;
+  l_config.m_num_threads_sfc_m  = 1;
+  l_config.m_num_threads_sfc_n  = 1;
+
+  //optimize loops, unless an optimized configuration is stored
+  basic::ContractionConfigStore & l_store = basic::ContractionConfigStore::get_instance();
+  std::vector< int64_t > l_key = basic::ContractionConfigStore::key( l_config,
+                                                                     m_target_prim_m,
+                                                                     m_target_prim_n,
+                                                                     m_target_prim_k,
+                                                                     true,
+                                                                     true,
+                                                                     false,
+                                                                     basic::packed_gemm_t::NONE,
+                                                                     m_l1_cache_size,
+                                                                     m_l2_cache_size,
+                                                                     m_l3_cache_size,
+                                                                     m_streamed_left,
+                                                                     m_streamed_right );
+
+  if( !l_store.find( l_key, l_config ) ) {
+    einsum_ir::basic::ContractionOptimizer l_optim;
+    l_optim.init(&l_config.m_iterations,
+                 &l_config.m_ktype_main,
+                 m_target_prim_m,
+                 m_target_prim_n,
+                 m_target_prim_k,
+                 true,
+                 true,
+                 false,
+                 basic::packed_gemm_t::NONE,
+                 ce_n_bytes(m_dtype_out),
+                 m_l2_cache_size,
+                 &l_config.m_num_threads_shared,
+                 &l_config.m_num_threads_sfc_m,
+                 &l_config.m_num_threads_sfc_n );
+    l_optim.set_cache_sizes( m_l1_cache_size,
+                             m_l3_cache_size );
+    l_optim.set_streamed_inputs( m_streamed_left,
+                                 m_streamed_right );
+    l_optim.optimize();
+
+    l_store.insert( l_key, l_config );
+  }
+
+  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = contraction_memory();
+
+  //compile backend
+  m_backend.init( l_config,
+                  l_contraction_memory );
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    m_backend.set_epilogue( ktypes_epilogue_basic(),
+                            m_epilogue_alpha,
+                            m_epilogue_beta );
+  }
+  m_backend.set_streamed_inputs( m_streamed_left,
+                                 m_streamed_right );
+  
+  l_err = ce_basic_err_to_err(m_backend.compile());
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::backend::BinaryContractionSimd::contract( void const * i_tensor_left,
+                                                            void const * i_tensor_right,
+                                                            void const * i_tensor_out_aux,
+                                                            void       * io_tensor_out ) {
+  m_backend.contract( i_tensor_left,
+                      i_tensor_right,
+                      i_tensor_out_aux,
+                      io_tensor_out );
+}
+
+void einsum_ir::backend::BinaryContractionSimd::contract( void const * i_tensor_left,
+                                                            void const * i_tensor_right,
+                                                            void       * io_tensor_out ) {
+  contract( i_tensor_left,
+            i_tensor_right,
+            nullptr,
+            io_tensor_out );
+}
+
+einsum_ir::basic::ContractionBackend * einsum_ir::backend::BinaryContractionSimd::contraction_backend() {
+  return &m_backend;
+}
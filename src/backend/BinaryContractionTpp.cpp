@@ -1,5 +1,7 @@
 #include "BinaryContractionTpp.h"
 #include "../basic/binary/ContractionOptimizer.h"
+#include "../basic/binary/ContractionConfigStore.h"
+#include "../basic/binary/ContractionTuner.h"
 
 einsum_ir::err_t einsum_ir::backend::BinaryContractionTpp::compile() {
   err_t l_err = err_t::UNDEFINED_ERROR;
@@ -65,57 +67,109 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionTpp::compile() {
     l_loops[l_id].stride_out     = map_find_default<int64_t>(&l_strides_out,     l_dim_id, 0);
   }
 
-  //convert kernel to basic
-  basic::kernel_t l_ktype_first_touch = ce_kernelt_to_basic(m_ktype_first_touch);
-  basic::kernel_t l_ktype_main        = ce_kernelt_to_basic(m_ktype_main);
-  basic::kernel_t l_ktype_last_touch  = ce_kernelt_to_basic(m_ktype_last_touch);
-
-  //convert dtype
-  basic::data_t l_dtype_left  = ce_dtype_to_basic(m_dtype_left);
-  basic::data_t l_dtype_right = ce_dtype_to_basic(m_dtype_right);
-  basic::data_t l_dtype_comp  = ce_dtype_to_basic(m_dtype_comp);
-  basic::data_t l_dtype_out   = ce_dtype_to_basic(m_dtype_out);
-
-  //optimize loops
-  einsum_ir::basic::ContractionOptimizer l_optim;
-
-  int64_t l_num_threads_m = 1;
-  int64_t l_num_threads_n = 1;
-  int64_t l_num_threads_shared = m_num_threads;
-  l_optim.init(&l_loops,
-               &l_ktype_main,
-               m_target_prim_m,
-               m_target_prim_n,
-               m_target_prim_k,
-               true,
-               true,
-               true,
-               basic::packed_gemm_t::ALL_STRIDE_ONE,
-               ce_n_bytes(m_dtype_out),
-               m_l2_cache_size,
-               &l_num_threads_shared,
-               &l_num_threads_m,
-               &l_num_threads_n );
-  l_optim.optimize();
-
-  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = nullptr;
-  if( m_memory != nullptr ){
-    l_contraction_memory = m_memory->get_contraction_memory_manager();
+  //unoptimized configuration
+  basic::ContractionConfig l_config;
+  l_config.m_iterations         = l_loops;
+  l_config.m_dtype_left         = ce_dtype_to_basic(m_dtype_left);
+  l_config.m_dtype_right        = ce_dtype_to_basic(m_dtype_right);
+  l_config.m_dtype_comp         = ce_dtype_to_basic(m_dtype_comp);
+  l_config.m_dtype_out          = ce_dtype_to_basic(m_dtype_out);
+  l_config.m_ktype_first_touch  = ce_kernelt_to_basic(m_ktype_first_touch);
+  l_config.m_ktype_main         = ce_kernelt_to_basic(m_ktype_main);
+  l_config.m_ktype_last_touch   = ce_kernelt_to_basic(m_ktype_last_touch);
+  l_config.m_num_threads_shared = m_num_threads;
+  l_config.m_num_threads_sfc_m  = 1;
+  l_config.m_num_threads_sfc_n  = 1;
+
+  //optimize or tune loops, unless an optimized configuration is stored
+  basic::ContractionConfigStore & l_store = basic::ContractionConfigStore::get_instance();
+  std::vector< int64_t > l_key = basic::ContractionConfigStore::key( l_config,
+                                                                     m_target_prim_m,
+                                                                     m_target_prim_n,
+                                                                     m_target_prim_k,
+                                                                     true,
+                                                                     true,
+                                                                     true,
+                                                                     basic::packed_gemm_t::ALL_STRIDE_ONE,
+                                                                     m_l1_cache_size,
+                                                                     m_l2_cache_size,
+                                                                     m_l3_cache_size,
+                                                                     m_streamed_left,
+                                                                     m_streamed_right );
+
+  basic::ContractionTuner::Settings const & l_tune = basic::ContractionTuner::get_settings();
+
+  bool l_stored = l_store.find( l_key, l_config );
+
+  if( !l_stored && l_tune.m_enabled ) {
+    // benchmark the candidates and persist the fastest configuration
+    basic::ContractionTuner l_tuner;
+    l_tuner.init( l_config,
+                  m_target_prim_m,
+                  m_target_prim_n,
+                  m_target_prim_k,
+                  true,
+                  true,
+                  true,
+                  basic::packed_gemm_t::ALL_STRIDE_ONE,
+                  m_l1_cache_size,
+                  m_l2_cache_size,
+                  m_l3_cache_size,
+                  l_tune.m_time_budget );
+
+    l_err = ce_basic_err_to_err( l_tuner.tune( []( basic::ContractionConfig const & i_config,
+                                                   double                         & o_time ) {
+                                                 basic::ContractionBackendTpp l_backend;
+                                                 return basic::ContractionTuner::benchmark( i_config,
+                                                                                            l_backend,
+                                                                                            3,
+                                                                                            o_time );
+                                               },
+                                               l_config ) );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    // the tuning database is written once the expression is compiled
+    l_store.insert( l_key, l_config, true );
   }
+  else if( !l_stored ) {
+    einsum_ir::basic::ContractionOptimizer l_optim;
+    l_optim.init(&l_config.m_iterations,
+                 &l_config.m_ktype_main,
+                 m_target_prim_m,
+                 m_target_prim_n,
+                 m_target_prim_k,
+                 true,
+                 true,
+                 true,
+                 basic::packed_gemm_t::ALL_STRIDE_ONE,
+                 ce_n_bytes(m_dtype_out),
+                 m_l2_cache_size,
+                 &l_config.m_num_threads_shared,
+                 &l_config.m_num_threads_sfc_m,
+                 &l_config.m_num_threads_sfc_n );
+    l_optim.set_cache_sizes( m_l1_cache_size,
+                             m_l3_cache_size );
+    l_optim.set_streamed_inputs( m_streamed_left,
+                                 m_streamed_right );
+    l_optim.optimize();
+
+    l_store.insert( l_key, l_config );
+  }
+
+  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = contraction_memory();
 
   //compile backend
-  m_backend.init( l_loops,
-                  l_dtype_left,
-                  l_dtype_right,
-                  l_dtype_comp,
-                  l_dtype_out,
-                  l_ktype_first_touch,
-                  l_ktype_main,
-                  l_ktype_last_touch,
-                  l_num_threads_shared,
-                  l_num_threads_m,
-                  l_num_threads_n,
+  m_backend.init( l_config,
                   l_contraction_memory );
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    m_backend.set_epilogue( ktypes_epilogue_basic(),
+                            m_epilogue_alpha,
+                            m_epilogue_beta );
+  }
+  m_backend.set_streamed_inputs( m_streamed_left,
+                                 m_streamed_right );
 
   
   l_err = ce_basic_err_to_err(m_backend.compile());
@@ -145,3 +199,6 @@ void einsum_ir::backend::BinaryContractionTpp::contract( void const * i_tensor_l
                       io_tensor_out );
 }
 
+einsum_ir::basic::ContractionBackend * einsum_ir::backend::BinaryContractionTpp::contraction_backend() {
+  return &m_backend;
+}
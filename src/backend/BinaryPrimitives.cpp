@@ -25,7 +25,10 @@ void einsum_ir::backend::BinaryPrimitives::init( int64_t i_size_cb_min,
 einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::init( data_t    i_data_type,
                                                              backend_t i_backend_type ) {
   if( i_backend_type == backend_t::TPP ) {
-    if( i_data_type == data_t::FP32 ) {
+    // low precision data types accumulate in FP32 and share its register blocking
+    if(    i_data_type == data_t::FP32
+        || i_data_type == data_t::BF16
+        || i_data_type == data_t::FP16 ) {
       init(  4,  16,
             32, 128,
             12,  64,
@@ -59,6 +62,24 @@ einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::init( data_t    i_data_ty
       return err_t::INVALID_DTYPE;
     }
   }
+  // SIMD, register blocking of the microkernels
+  else if( i_backend_type == backend_t::SIMD ) {
+    if( i_data_type == data_t::FP32 ) {
+      init(  4,  16,
+            32, 128,
+            12,  48,
+            32, 512 );
+    }
+    else if( i_data_type == data_t::FP64 ) {
+      init(  2,   8,
+            16,  64,
+             6,  24,
+            16, 256 );
+    }
+    else {
+      return err_t::INVALID_DTYPE;
+    }
+  }
   // TBLIS
   else if( i_backend_type == backend_t::TBLIS ) {
     if( i_data_type == data_t::FP32 ) {
@@ -1751,6 +1772,10 @@ einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::reorder( backend_t
   else if( i_backend_type == backend_t::TBLIS ) {
     l_tensor_ordering = tenord_t::LEFT_BC_BM_BK_BI_KB_MB_CB_RIGHT_BC_BN_BK_BJ_NB_KB_CB_OUT_NATIVE;
   }
+  // no packed GEMMs: C dimensions remain outer loops
+  else if( i_backend_type == backend_t::SIMD ) {
+    l_tensor_ordering = tenord_t::LEFT_BC_BM_BK_BI_KB_MB_RIGHT_BC_BN_BK_BJ_NB_KB_OUT_NATIVE;
+  }
   else {
     l_tensor_ordering = tenord_t::LEFT_NATIVE_RIGHT_NATIVE_OUT_NATIVE;
   }
@@ -3,8 +3,50 @@
 #include "Tensor.h"
 #include "BinaryContractionFactory.h"
 #include "BinaryPrimitives.h"
+#include "../basic/threading.h"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
+#include <functional>
+#include <thread>
+
+einsum_ir::backend_t einsum_ir::backend::EinsumNode::get_env_backend() {
+  backend_t l_btype = backend_t::AUTO;
+
+  char * l_env = std::getenv( "EINSUM_IR_BACKEND" );
+  if( l_env == nullptr ) {}
+  else if( strcmp( l_env, "AUTO") == 0 ) {
+    l_btype = backend_t::AUTO;
+  }
+  else if( strcmp( l_env, "TPP") == 0 ) {
+    l_btype = backend_t::TPP;
+  }
+  else if( strcmp( l_env, "BLAS") == 0 ) {
+    l_btype = backend_t::BLAS;
+  }
+  else if( strcmp( l_env, "TBLIS") == 0 ) {
+    l_btype = backend_t::TBLIS;
+  }
+  else if( strcmp( l_env, "SCALAR") == 0 ) {
+    l_btype = backend_t::SCALAR;
+  }
+  else if( strcmp( l_env, "SIMD") == 0 ) {
+    l_btype = backend_t::SIMD;
+  }
+
+  return l_btype;
+}
+
+bool einsum_ir::backend::EinsumNode::get_env_flag( char const * i_name,
+                                                   bool         i_default ) {
+  char * l_env = std::getenv( i_name );
+  if( l_env == nullptr ) {
+    return i_default;
+  }
+
+  return strcmp( l_env, "1" ) == 0 || strcmp( l_env, "true" ) == 0;
+}
 
 einsum_ir::backend::EinsumNode::~EinsumNode() {
   if( m_unary != nullptr ) {
@@ -57,53 +99,13 @@ void einsum_ir::backend::EinsumNode::init( int64_t
   m_data_ptr_ext        = i_data_ptr;
 
   m_btype_unary         = backend_t::AUTO;
-  m_btype_binary        = backend_t::AUTO;
-  char * l_btype = std::getenv( "EINSUM_IR_BACKEND" );
-  if( l_btype == nullptr ) {}
-  else if( strcmp( l_btype, "AUTO") == 0 ) {
-    m_btype_binary = backend_t::AUTO;
-  }
-  else if( strcmp( l_btype, "TPP") == 0 ) {
-    m_btype_binary = backend_t::TPP;
-  }
-  else if( strcmp( l_btype, "BLAS") == 0 ) {
-    m_btype_binary = backend_t::BLAS;
-  }
-  else if( strcmp( l_btype, "TBLIS") == 0 ) {
-    m_btype_binary = backend_t::TBLIS;
-  }
-  else if( strcmp( l_btype, "SCALAR") == 0 ) {
-    m_btype_binary = backend_t::SCALAR;
-  }
-
-  m_reorder_dims = true;
-  char * l_reorder_dims = std::getenv( "EINSUM_IR_REORDER_DIMS" );
-  if( l_reorder_dims != nullptr ) {
-    if( strcmp( l_reorder_dims, "1" ) == 0 ) {
-      m_reorder_dims = true;
-    }
-    else if( strcmp( l_reorder_dims, "true" ) == 0 ) {
-      m_reorder_dims = true;
-    }
-    else {
-      m_reorder_dims = false;
-    }
-  }
-
-  m_pack_inputs = false;
-  char * l_pack_inputs = std::getenv( "EINSUM_IR_PACK_INPUTS" );
-  if( l_pack_inputs != nullptr ) {
-    if( strcmp( l_pack_inputs, "1" ) == 0 ) {
-      m_pack_inputs = true;
-    }
-    else if( strcmp( l_pack_inputs, "true" ) == 0 ) {
-      m_pack_inputs = true;
-    }
-    else {
-      m_pack_inputs = false;
-    }
-  }
+  m_btype_binary        = get_env_backend();
 
+  m_reorder_dims        = get_env_flag( "EINSUM_IR_REORDER_DIMS", true );
+  m_pack_inputs         = get_env_flag( "EINSUM_IR_PACK_INPUTS",  false );
+  m_inter_op            = get_env_flag( "EINSUM_IR_INTER_OP",     false );
+  m_id_contraction_memory = 0;
+  m_children_concurrent = false;
 
   m_unary               = nullptr;
   m_cont                = nullptr;
@@ -182,6 +184,7 @@ void einsum_ir::backend::EinsumNode::init( int64_t
   m_ktype_first_touch   = i_ktype_first_touch;
   m_ktype_main          = i_ktype_main;
   m_ktype_last_touch    = i_ktype_last_touch;
+  m_ktypes_epilogue.clear();
 
   m_children.resize( 2 );
   m_children[0] = i_left;
@@ -191,6 +194,13 @@ void einsum_ir::backend::EinsumNode::init( int64_t
 }
 einsum_ir::err_t einsum_ir::backend::EinsumNode::compile(){
   err_t l_err = err_t::UNDEFINED_ERROR;
+
+  if( m_inter_op ) {
+    derive_num_ops();
+    partition_threads( m_num_threads,
+                       0 );
+  }
+
   l_err = compile_recursive();
   if( l_err != einsum_ir::SUCCESS ){
     return l_err;
@@ -201,6 +211,71 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile(){
   return einsum_ir::SUCCESS;
 }
 
+void einsum_ir::backend::EinsumNode::derive_num_ops() {
+  m_num_ops_node = 0;
+  m_num_ops_children = 0;
+
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    m_children[l_ch]->derive_num_ops();
+    m_num_ops_children += m_children[l_ch]->num_ops();
+  }
+
+  if( m_children.size() == 2 ) {
+    m_num_ops_node = BinaryContraction::num_ops( m_children[0]->m_num_dims,
+                                                 m_children[1]->m_num_dims,
+                                                 m_num_dims,
+                                                 m_children[0]->m_dim_ids_ext,
+                                                 m_children[1]->m_dim_ids_ext,
+                                                 m_dim_ids_ext,
+                                                 m_dim_sizes_inner,
+                                                 m_ktype_first_touch,
+                                                 m_ktype_main );
+  }
+}
+
+void einsum_ir::backend::EinsumNode::partition_threads( int64_t i_num_threads,
+                                                        int64_t i_id_contraction_memory ) {
+  m_num_threads = i_num_threads;
+  m_id_contraction_memory = i_id_contraction_memory;
+  m_children_concurrent = false;
+
+  int64_t l_num_threads_left = i_num_threads;
+  int64_t l_num_threads_right = i_num_threads;
+
+  if( m_children.size() == 2 && i_num_threads > 1 ) {
+    int64_t l_num_ops_left  = m_children[0]->num_ops();
+    int64_t l_num_ops_right = m_children[1]->num_ops();
+
+    if( l_num_ops_left > 0 && l_num_ops_right > 0 ) {
+      double l_ratio = (double) l_num_ops_left / (double) ( l_num_ops_left + l_num_ops_right );
+      int64_t l_num_threads_split = std::llround( l_ratio * i_num_threads );
+
+      // both subtrees require at least one thread
+      if( l_num_threads_split >= 1 && l_num_threads_split <= i_num_threads - 1 ) {
+        m_children_concurrent = true;
+        l_num_threads_left  = l_num_threads_split;
+        l_num_threads_right = i_num_threads - l_num_threads_split;
+      }
+    }
+  }
+
+  // the node's contraction runs after its children, i.e., the first child shares the node's scratch memory
+  if( m_children.size() == 2 ) {
+    int64_t l_id_contraction_memory_right = i_id_contraction_memory;
+    if( m_children_concurrent ) {
+      l_id_contraction_memory_right = m_memory->add_contraction_memory_manager();
+    }
+    m_children[0]->partition_threads( l_num_threads_left,
+                                      i_id_contraction_memory );
+    m_children[1]->partition_threads( l_num_threads_right,
+                                      l_id_contraction_memory_right );
+  }
+  else if( m_children.size() == 1 ) {
+    m_children[0]->partition_threads( i_num_threads,
+                                      i_id_contraction_memory );
+  }
+}
+
 einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
   err_t l_err = err_t::UNDEFINED_ERROR;
 
@@ -214,6 +289,10 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
     else if( BinaryContractionFactory::supports( backend_t::TPP ) ) {
       m_btype_binary = backend_t::TPP;
     }
+    // low precision storage is only supported by TPP and the scalar backend
+    else if( ce_dtype_comp( m_dtype ) != m_dtype ) {
+      m_btype_binary = backend_t::SCALAR;
+    }
     else if( BinaryContractionFactory::supports( backend_t::TBLIS ) ) {
       m_btype_binary = backend_t::TBLIS;
     }
@@ -221,7 +300,7 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
       m_btype_binary = backend_t::BLAS;
     }
     else {
-      m_btype_binary = backend_t::SCALAR;
+      m_btype_binary = backend_t::SIMD;
     }
   }
 
@@ -303,17 +382,34 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
                   m_memory,
                   m_children[0]->m_dtype,
                   m_children[1]->m_dtype,
-                  m_dtype,
+                  ce_dtype_comp( m_dtype ),
                   m_dtype,
                   m_ktype_first_touch,
                   m_ktype_main,
                   m_ktype_last_touch,
                   m_num_threads );
+    if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+      m_cont->set_epilogue( m_ktypes_epilogue,
+                            m_epilogue_alpha,
+                            m_epilogue_beta );
+    }
+    // mapped leaf data which is read in place is streamed by the contraction
+    bool l_streamed_left  =    m_children[0]->m_streamed
+                            && !m_children[0]->m_data_locked
+                            && !m_children[0]->requires_permutation();
+    bool l_streamed_right =    m_children[1]->m_streamed
+                            && !m_children[1]->m_data_locked
+                            && !m_children[1]->requires_permutation();
+    m_cont->set_streamed_inputs( l_streamed_left,
+                                 l_streamed_right );
+    // concurrently evaluated contractions use different scratch memory
+    m_cont->set_contraction_memory( m_id_contraction_memory );
 
     l_err = m_cont->compile();
     if( l_err != einsum_ir::SUCCESS ) {
       return l_err;
     }
+    m_cont->set_profiling( m_profiling );
   }
 
   // compile unary copy operation
@@ -333,7 +429,7 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
                    m_dim_ids_ext,
                    m_dim_ids_int.data(),
                    m_dtype,
-                   m_dtype,
+                   ce_dtype_comp( m_dtype ),
                    m_dtype,
                    kernel_t::COPY,
                    l_num_threads_unary );
@@ -344,7 +440,7 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
                    m_children[0]->m_dim_ids_ext,
                    m_dim_ids_ext,
                    m_dtype,
-                   m_dtype,
+                   ce_dtype_comp( m_dtype ),
                    m_dtype,
                    kernel_t::COPY,
                    l_num_threads_unary );
@@ -494,8 +590,22 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::unlock_data() {
 }
 
 void einsum_ir::backend::EinsumNode::eval() {
-  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
-    m_children[m_exec_order[l_ch]]->eval();
+  if( m_children_concurrent ) {
+    basic::execute_nested( 2, [&](int64_t l_ch) {
+      m_children[l_ch]->eval();
+    });
+  }
+  else {
+    for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+      m_children[m_exec_order[l_ch]]->eval();
+    }
+  }
+
+  std::chrono::steady_clock::time_point l_tp0;
+  std::chrono::steady_clock::time_point l_tp1;
+  int64_t l_num_bytes_permute = 0;
+  if( m_profiling ) {
+    l_tp0 = std::chrono::steady_clock::now();
   }
 
   if( m_data_locked ) {
@@ -515,11 +625,17 @@ void einsum_ir::backend::EinsumNode::eval() {
         && m_req_mem         != 0 ) {
       m_unary->eval( m_data_ptr_ext,
                      m_data_ptr_active );
+      l_num_bytes_permute = 2 * m_size;
     }
   }
   else {
     m_unary->eval( m_children[0]->m_data_ptr_active,
                    m_data_ptr_active );
+    l_num_bytes_permute = 2 * m_size;
+  }
+
+  if( m_profiling ) {
+    l_tp1 = std::chrono::steady_clock::now();
   }
 
   if( m_children.size() == 2 ) {
@@ -537,6 +653,60 @@ void einsum_ir::backend::EinsumNode::eval() {
                       l_data_aux,
                       l_data );
   }
+
+  if( m_profiling ) {
+    std::chrono::steady_clock::time_point l_tp2 = std::chrono::steady_clock::now();
+
+    m_profile.m_thread_id = static_cast< int64_t >( std::hash< std::thread::id >{}( std::this_thread::get_id() ) );
+    m_profile.m_num_threads = m_num_threads;
+    m_profile.m_time_start = std::chrono::duration< double >( l_tp0.time_since_epoch() ).count();
+    m_profile.m_time_permute = std::chrono::duration< double >( l_tp1 - l_tp0 ).count();
+    m_profile.m_time_contraction = 0;
+    m_profile.m_time_packing = 0;
+    m_profile.m_num_ops = 0;
+    m_profile.m_num_bytes_permute = l_num_bytes_permute;
+    m_profile.m_num_bytes_contraction = 0;
+
+    if( m_children.size() == 2 ) {
+      m_profile.m_time_contraction = std::chrono::duration< double >( l_tp2 - l_tp1 ).count();
+      m_profile.m_time_packing = m_cont->time_packing();
+      m_profile.m_num_ops = m_num_ops_node;
+      m_profile.m_num_bytes_contraction = m_children[0]->m_size + m_children[1]->m_size + m_size;
+    }
+  }
+}
+
+void einsum_ir::backend::EinsumNode::set_epilogue( std::vector< kernel_t > const & i_ktypes,
+                                                   double                          i_alpha,
+                                                   double                          i_beta ) {
+  m_ktypes_epilogue = i_ktypes;
+  m_epilogue_alpha = i_alpha;
+  m_epilogue_beta = i_beta;
+  m_ktype_last_touch = i_ktypes.empty() ? kernel_t::UNDEFINED_KTYPE : kernel_t::EPILOGUE;
+}
+
+void einsum_ir::backend::EinsumNode::set_profiling( bool i_profiling ) {
+  m_profiling = i_profiling;
+  if( m_cont != nullptr ) {
+    m_cont->set_profiling( i_profiling );
+  }
+
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    m_children[l_ch]->set_profiling( i_profiling );
+  }
+}
+
+void einsum_ir::backend::EinsumNode::profile( std::vector< NodeProfile > & io_profiles,
+                                              int64_t                      i_id_parent ) const {
+  int64_t l_id = io_profiles.size();
+  io_profiles.push_back( m_profile );
+  io_profiles.back().m_id = l_id;
+  io_profiles.back().m_id_parent = i_id_parent;
+
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    m_children[l_ch]->profile( io_profiles,
+                               l_id );
+  }
 }
 
 int64_t einsum_ir::backend::EinsumNode::num_ops( bool i_children ) {
@@ -560,9 +730,18 @@ void  einsum_ir::backend::EinsumNode::cancel_memory_reservation() {
 void einsum_ir::backend::EinsumNode::compile_memory_usage(){
   // compile children
   m_memory->m_layer_id++;
+  if( m_children_concurrent ) {
+    m_memory->begin_concurrent_section();
+  }
   for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    if( m_children_concurrent ) {
+      m_memory->begin_concurrent_branch();
+    }
     m_children[m_exec_order[l_ch]]->compile_memory_usage();
   }
+  if( m_children_concurrent ) {
+    m_memory->end_concurrent_section();
+  }
   m_memory->m_layer_id--;
 
   //reserve own mem
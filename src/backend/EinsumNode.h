@@ -5,6 +5,7 @@
 #include "Unary.h"
 #include "BinaryContraction.h"
 #include "MemoryManager.h"
+#include "NodeProfile.h"
 #include "../constants.h"
 
 namespace einsum_ir {
@@ -24,6 +25,12 @@ class einsum_ir::backend::EinsumNode {
     kernel_t m_ktype_main = kernel_t::UNDEFINED_KTYPE;
     //! type of the last-touch kernel
     kernel_t m_ktype_last_touch = kernel_t::UNDEFINED_KTYPE;
+    //! element-wise operations of the last touch if its type is EPILOGUE
+    std::vector< kernel_t > m_ktypes_epilogue;
+    //! factor of the SCALE operation in the epilogue
+    double m_epilogue_alpha = 1.0;
+    //! factor of the auxiliary tensor in the epilogue's ADD operation
+    double m_epilogue_beta = 1.0;
 
     //! size of the node's tensor in bytes
     int64_t m_size = 0;
@@ -75,6 +82,15 @@ class einsum_ir::backend::EinsumNode {
     //! true if packing is enabled
     bool m_pack_inputs = false;
 
+    //! true if independent subtrees are evaluated concurrently
+    bool m_inter_op = false;
+
+    //! id of the contraction memory manager, subtrees evaluated concurrently use different ones
+    int64_t m_id_contraction_memory = 0;
+
+    //! true if the children of the node are evaluated concurrently
+    bool m_children_concurrent = false;
+
     //! backend types
     backend_t m_btype_unary  = backend_t::UNDEFINED_BACKEND;
     backend_t m_btype_binary = backend_t::UNDEFINED_BACKEND;
@@ -119,9 +135,36 @@ class einsum_ir::backend::EinsumNode {
     //! true if the external data was copied and locked
     bool m_data_locked = false;
 
+    //! true if the external data is streamed from a memory-mapped file
+    bool m_streamed = false;
+
     //! number of threads for the evaluation
     int64_t m_num_threads = 1;
 
+    //! true if the evaluation is profiled
+    bool m_profiling = false;
+
+    //! profile of the last evaluation
+    NodeProfile m_profile;
+
+    /**
+     * Gets the binary backend selected through the environment variable EINSUM_IR_BACKEND.
+     *
+     * @return selected backend, AUTO if the variable is not set.
+     **/
+    static backend_t get_env_backend();
+
+    /**
+     * Gets a boolean compile mode set through the environment.
+     * The values "1" and "true" enable the mode, all other values disable it.
+     *
+     * @param i_name name of the environment variable.
+     * @param i_default value if the variable is not set.
+     * @return value of the mode.
+     **/
+    static bool get_env_flag( char const * i_name,
+                              bool         i_default );
+
     /**
      * Destructor.
      **/
@@ -214,6 +257,24 @@ class einsum_ir::backend::EinsumNode {
      **/    
     err_t compile();
 
+    /**
+     * Derives the number of operations of the node and all children before compilation.
+     * The derived numbers are estimates which are used to partition the threads.
+     **/
+    void derive_num_ops();
+
+    /**
+     * Assigns the threads to the node and recursively to all children.
+     * The threads of a node are split among its two children proportional to the children's operations,
+     * if both children have a non-zero number of operations.
+     * In this case the children are evaluated concurrently and the second child gets its own contraction memory manager.
+     *
+     * @param i_num_threads number of threads available to the node.
+     * @param i_id_contraction_memory id of the contraction memory manager of the node.
+     **/
+    void partition_threads( int64_t i_num_threads,
+                            int64_t i_id_contraction_memory );
+
     /**
      * recursive compilation call.
      * 
@@ -243,6 +304,36 @@ class einsum_ir::backend::EinsumNode {
      **/
     void eval();
 
+    /**
+     * Sets a chain of element-wise operations as last touch of the node's contraction,
+     * e.g., a bias addition followed by an activation function.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_ktypes operations of the chain: ADD, SCALE, RELU, GELU, SILU, SIGMOID or TANH.
+     * @param i_alpha factor of the SCALE operation.
+     * @param i_beta factor of the auxiliary tensor in the ADD operation.
+     **/
+    void set_epilogue( std::vector< kernel_t > const & i_ktypes,
+                       double                          i_alpha = 1.0,
+                       double                          i_beta = 1.0 );
+
+    /**
+     * Enables or disables the profiling of the node and recursively of all children.
+     * If disabled, the evaluation is not instrumented.
+     *
+     * @param i_profiling true if the evaluation is profiled.
+     **/
+    void set_profiling( bool i_profiling );
+
+    /**
+     * Appends the profiles of the last evaluation of the node and all children in depth-first order.
+     *
+     * @param io_profiles profiles to which the profiles of the tree are appended.
+     * @param i_id_parent id of the node's parent, -1 for the root.
+     **/
+    void profile( std::vector< NodeProfile > & io_profiles,
+                  int64_t                      i_id_parent = -1 ) const;
+
     /**
      * Gets the number of operations required to evaluate the node.
      *
@@ -0,0 +1,182 @@
+#include "MemoryArena.h"
+#include "../basic/threading.h"
+#include <algorithm>
+#include <new>
+
+einsum_ir::backend::MemoryArena::~MemoryArena() {
+  for( std::size_t l_sl = 0; l_sl < m_slots.size(); l_sl++ ) {
+    free_slot( *m_slots[l_sl] );
+  }
+}
+
+void einsum_ir::backend::MemoryArena::alloc_slot( int64_t                             i_num_bytes,
+                                                  int64_t                             i_num_bytes_thread,
+                                                  int64_t                             i_num_threads,
+                                                  einsum_ir::basic::Numa::placement_t i_placement,
+                                                  einsum_ir::basic::Numa::pages_t     i_pages,
+                                                  Slot                              & io_slot ) const {
+  using einsum_ir::basic::Numa;
+
+  // intermediate tensors
+  io_slot.m_num_bytes = i_num_bytes;
+  io_slot.m_pages = i_pages;
+  if( i_num_bytes > 0 ) {
+    io_slot.m_memory = Numa::alloc( i_num_bytes + m_alignment_page,
+                                    i_placement,
+                                    io_slot.m_pages );
+
+    int64_t l_align_offset = (unsigned long) io_slot.m_memory % m_alignment_page;
+    l_align_offset = l_align_offset ? m_alignment_page - l_align_offset : 0;
+    io_slot.m_aligned_memory = io_slot.m_memory + l_align_offset;
+  }
+
+  // scratch memory, first touched by the threads which use it
+  io_slot.m_num_bytes_thread = i_num_bytes_thread;
+  io_slot.m_thread_memory.assign( i_num_threads, nullptr );
+  io_slot.m_aligned_thread_memory.assign( i_num_threads, nullptr );
+  io_slot.m_thread_pages.assign( i_num_threads, i_pages );
+  if( i_num_bytes_thread > 0 ) {
+    einsum_ir::basic::execute_threaded( i_num_threads, [&]( int64_t l_thread_id ) {
+      char * l_ptr = Numa::alloc( i_num_bytes_thread + m_alignment_line,
+                                  Numa::FIRST_TOUCH,
+                                  io_slot.m_thread_pages[l_thread_id] );
+      io_slot.m_thread_memory[l_thread_id] = l_ptr;
+
+      int64_t l_align_offset = (unsigned long) l_ptr % m_alignment_line;
+      l_align_offset = l_align_offset ? m_alignment_line - l_align_offset : 0;
+      io_slot.m_aligned_thread_memory[l_thread_id] = l_ptr + l_align_offset;
+
+      Numa::touch( io_slot.m_aligned_thread_memory[l_thread_id],
+                   i_num_bytes_thread );
+    } );
+  }
+}
+
+void einsum_ir::backend::MemoryArena::free_slot( Slot & io_slot ) const {
+  using einsum_ir::basic::Numa;
+
+  Numa::free( io_slot.m_memory,
+              io_slot.m_num_bytes + m_alignment_page,
+              io_slot.m_pages );
+  io_slot.m_memory = nullptr;
+  io_slot.m_aligned_memory = nullptr;
+  io_slot.m_num_bytes = 0;
+
+  for( std::size_t l_th = 0; l_th < io_slot.m_thread_memory.size(); l_th++ ) {
+    Numa::free( io_slot.m_thread_memory[l_th],
+                io_slot.m_num_bytes_thread + m_alignment_line,
+                io_slot.m_thread_pages[l_th] );
+  }
+  io_slot.m_thread_memory.clear();
+  io_slot.m_aligned_thread_memory.clear();
+  io_slot.m_thread_pages.clear();
+  io_slot.m_num_bytes_thread = 0;
+}
+
+int64_t einsum_ir::backend::MemoryArena::get_num_bytes( Slot const & i_slot ) const {
+  using einsum_ir::basic::Numa;
+
+  int64_t l_num_bytes = 0;
+  if( i_slot.m_memory != nullptr ) {
+    l_num_bytes += Numa::get_num_bytes_mapped( i_slot.m_num_bytes + m_alignment_page,
+                                               i_slot.m_pages );
+  }
+  for( std::size_t l_th = 0; l_th < i_slot.m_thread_memory.size(); l_th++ ) {
+    if( i_slot.m_thread_memory[l_th] != nullptr ) {
+      l_num_bytes += Numa::get_num_bytes_mapped( i_slot.m_num_bytes_thread + m_alignment_line,
+                                                 i_slot.m_thread_pages[l_th] );
+    }
+  }
+  return l_num_bytes;
+}
+
+void einsum_ir::backend::MemoryArena::reserve( int64_t i_num_bytes,
+                                               int64_t i_num_bytes_thread,
+                                               int64_t i_num_threads ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  m_req_mem        = std::max( m_req_mem,        i_num_bytes );
+  m_req_thread_mem = std::max( m_req_thread_mem, i_num_bytes_thread );
+  m_num_threads    = std::max( m_num_threads,    i_num_threads );
+}
+
+void einsum_ir::backend::MemoryArena::set_memory_policy( einsum_ir::basic::Numa::placement_t i_placement,
+                                                         einsum_ir::basic::Numa::pages_t     i_pages ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  m_placement = i_placement;
+  m_pages = i_pages;
+}
+
+einsum_ir::backend::MemoryArena::Slot * einsum_ir::backend::MemoryArena::checkout() {
+  Slot * l_slot = nullptr;
+  int64_t l_req_mem = 0;
+  int64_t l_req_thread_mem = 0;
+  int64_t l_num_threads = 0;
+  einsum_ir::basic::Numa::placement_t l_placement = einsum_ir::basic::Numa::FIRST_TOUCH;
+  einsum_ir::basic::Numa::pages_t l_pages = einsum_ir::basic::Numa::SMALL;
+
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+
+    l_req_mem = m_req_mem;
+    l_req_thread_mem = m_req_thread_mem;
+    l_num_threads = m_num_threads;
+    l_placement = m_placement;
+    l_pages = m_pages;
+
+    if( m_slots_free.size() > 0 ) {
+      l_slot = m_slots_free.back();
+      m_slots_free.pop_back();
+    }
+    else {
+      m_slots.emplace_back( new Slot() );
+      l_slot = m_slots.back().get();
+    }
+  }
+
+  // the slot is owned exclusively from here on, slots which are too small for later reservations are reallocated
+  if(    l_slot->m_num_bytes < l_req_mem
+      || l_slot->m_num_bytes_thread < l_req_thread_mem
+      || (int64_t) l_slot->m_thread_memory.size() < l_num_threads ) {
+    int64_t l_num_bytes_old = get_num_bytes( *l_slot );
+    free_slot( *l_slot );
+    try {
+      alloc_slot( l_req_mem,
+                  l_req_thread_mem,
+                  l_num_threads,
+                  l_placement,
+                  l_pages,
+                  *l_slot );
+    }
+    catch( std::bad_alloc const & ) {
+      // return the emptied slot, a later checkout reallocates it
+      free_slot( *l_slot );
+
+      std::lock_guard< std::mutex > l_lock( m_mutex );
+      m_num_bytes -= l_num_bytes_old;
+      m_slots_free.push_back( l_slot );
+      throw;
+    }
+
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    m_num_bytes += get_num_bytes( *l_slot ) - l_num_bytes_old;
+  }
+
+  return l_slot;
+}
+
+void einsum_ir::backend::MemoryArena::checkin( Slot * i_slot ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_slots_free.push_back( i_slot );
+}
+
+int64_t einsum_ir::backend::MemoryArena::get_num_slots() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_slots.size();
+}
+
+int64_t einsum_ir::backend::MemoryArena::get_num_bytes() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_num_bytes;
+}
@@ -0,0 +1,169 @@
+#ifndef EINSUM_IR_BACKEND_MEMORY_ARENA
+#define EINSUM_IR_BACKEND_MEMORY_ARENA
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../constants.h"
+#include "../basic/Numa.h"
+
+namespace einsum_ir {
+  namespace backend {
+    class MemoryArena;
+  }
+}
+
+/**
+ * Memory shared by the memory managers of multiple compiled einsum trees or expressions.
+ *
+ * Every memory manager reserves its requirements in the compilation instead of allocating memory.
+ * An evaluation checks out a slot which holds the intermediate tensors and the threads' contraction scratch memory,
+ * and returns it afterwards.
+ * Slots are sized to the maximum requirement of all attached memory managers,
+ * i.e., the arena holds one slot per concurrently running evaluation instead of one allocation per compiled expression.
+ * Checking out and returning slots is thread-safe.
+ * The arena has to outlive all memory managers which are attached to it.
+ **/
+class einsum_ir::backend::MemoryArena {
+  public:
+    //! memory of a single evaluation
+    struct Slot {
+      //! memory of the intermediate tensors
+      char * m_memory = nullptr;
+      //! page-aligned memory of the intermediate tensors
+      char * m_aligned_memory = nullptr;
+      //! number of bytes of the intermediate tensors
+      int64_t m_num_bytes = 0;
+      //! page backing of the intermediate tensors
+      einsum_ir::basic::Numa::pages_t m_pages = einsum_ir::basic::Numa::SMALL;
+
+      //! scratch memory of the threads
+      std::vector< char * > m_thread_memory;
+      //! cache line-aligned scratch memory of the threads
+      std::vector< char * > m_aligned_thread_memory;
+      //! page backing of the threads' scratch memory
+      std::vector< einsum_ir::basic::Numa::pages_t > m_thread_pages;
+      //! number of bytes of every thread's scratch memory
+      int64_t m_num_bytes_thread = 0;
+    };
+
+  private:
+    //! alignment of the scratch memory to cache lines in bytes
+    int64_t m_alignment_line = 128;
+    //! alignment of the intermediate tensors to pages in bytes
+    int64_t m_alignment_page = 4096;
+
+    //! required memory of the intermediate tensors
+    int64_t m_req_mem = 0;
+    //! required scratch memory per thread
+    int64_t m_req_thread_mem = 0;
+    //! required number of threads
+    int64_t m_num_threads = 0;
+
+    //! placement of the intermediate tensors on the NUMA nodes
+    einsum_ir::basic::Numa::placement_t m_placement = einsum_ir::basic::Numa::get_placement();
+    //! requested page backing
+    einsum_ir::basic::Numa::pages_t m_pages = einsum_ir::basic::Numa::get_pages();
+
+    //! all slots of the arena
+    std::vector< std::unique_ptr< Slot > > m_slots;
+    //! slots which are not checked out
+    std::vector< Slot * > m_slots_free;
+    //! number of bytes allocated by all slots
+    int64_t m_num_bytes = 0;
+
+    //! protects the requirements and the slots
+    mutable std::mutex m_mutex;
+
+    /**
+     * Allocates the memory of a slot.
+     *
+     * @param i_num_bytes number of bytes of the intermediate tensors.
+     * @param i_num_bytes_thread number of bytes of every thread's scratch memory.
+     * @param i_num_threads number of threads.
+     * @param i_placement placement of the intermediate tensors.
+     * @param i_pages requested page backing.
+     * @param io_slot slot.
+     **/
+    void alloc_slot( int64_t                             i_num_bytes,
+                     int64_t                             i_num_bytes_thread,
+                     int64_t                             i_num_threads,
+                     einsum_ir::basic::Numa::placement_t i_placement,
+                     einsum_ir::basic::Numa::pages_t     i_pages,
+                     Slot                              & io_slot ) const;
+
+    /**
+     * Frees the memory of a slot.
+     *
+     * @param io_slot slot.
+     **/
+    void free_slot( Slot & io_slot ) const;
+
+    /**
+     * Gets the number of bytes allocated by a slot.
+     *
+     * @param i_slot slot.
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes( Slot const & i_slot ) const;
+
+  public:
+    /**
+     * Destructor.
+     **/
+    ~MemoryArena();
+
+    /**
+     * Reserves memory for the evaluations of a memory manager.
+     *
+     * @param i_num_bytes number of bytes of the intermediate tensors.
+     * @param i_num_bytes_thread number of bytes of every thread's scratch memory.
+     * @param i_num_threads number of threads.
+     **/
+    void reserve( int64_t i_num_bytes,
+                  int64_t i_num_bytes_thread,
+                  int64_t i_num_threads );
+
+    /**
+     * Sets the placement and page backing of the slots' memory.
+     * Applies to slots which are allocated afterwards.
+     *
+     * @param i_placement placement of the intermediate tensors.
+     * @param i_pages page backing of the intermediate tensors and scratch memory.
+     **/
+    void set_memory_policy( einsum_ir::basic::Numa::placement_t i_placement,
+                            einsum_ir::basic::Numa::pages_t     i_pages );
+
+    /**
+     * Checks out a slot satisfying all reservations.
+     * Idle slots are reused, a new slot is allocated if all slots are checked out.
+     * If the memory of the slot cannot be allocated, the empty slot is returned to the arena and std::bad_alloc is rethrown.
+     *
+     * @return slot, owned by the arena.
+     **/
+    Slot * checkout();
+
+    /**
+     * Returns a slot to the arena.
+     *
+     * @param i_slot slot obtained through checkout.
+     **/
+    void checkin( Slot * i_slot );
+
+    /**
+     * Gets the number of slots.
+     *
+     * @return number of slots.
+     **/
+    int64_t get_num_slots() const;
+
+    /**
+     * Gets the number of bytes allocated by all slots.
+     * Allocations are rounded up to the size of their pages.
+     *
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes() const;
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "catch.hpp"
+#include "MemoryArena.h"
+#include "MemoryManager.h"
+#include <new>
+
+TEST_CASE( "Memory managers sharing a memory arena.", "[memory_arena]" ) {
+  einsum_ir::backend::MemoryArena l_arena;
+
+  // two managers with different requirements, none of them allocates memory
+  einsum_ir::backend::MemoryManager l_memory_0;
+  einsum_ir::backend::MemoryManager l_memory_1;
+  l_memory_0.set_arena( &l_arena );
+  l_memory_1.set_arena( &l_arena );
+
+  int64_t l_id_0 = l_memory_0.reserve_memory( 1000 );
+  int64_t l_id_1 = l_memory_1.reserve_memory( 300 );
+  l_memory_0.remove_reservation( l_id_0 );
+  l_memory_1.remove_reservation( l_id_1 );
+  l_memory_0.get_contraction_memory_manager()->reserve_thread_memory( 512, 2 );
+  l_memory_1.get_contraction_memory_manager()->reserve_thread_memory( 2048, 1 );
+
+  l_memory_0.alloc_all_memory();
+  l_memory_1.alloc_all_memory();
+  REQUIRE( l_memory_0.get_num_bytes() == 0 );
+  REQUIRE( l_memory_1.get_num_bytes() == 0 );
+  REQUIRE( l_arena.get_num_slots() == 0 );
+  REQUIRE( l_arena.get_num_bytes() == 0 );
+
+  // concurrent evaluations use different slots sized to the maximum requirements
+  l_memory_0.checkout();
+  l_memory_1.checkout();
+  REQUIRE( l_arena.get_num_slots() == 2 );
+
+  char * l_ptr_0 = (char *) l_memory_0.get_mem_ptr( l_id_0 );
+  char * l_ptr_1 = (char *) l_memory_1.get_mem_ptr( l_id_1 );
+  REQUIRE( l_ptr_0 != nullptr );
+  REQUIRE( l_ptr_1 != nullptr );
+  REQUIRE( l_ptr_0 != l_ptr_1 );
+  for( int64_t l_by = 0; l_by < 1000; l_by++ ) {
+    l_ptr_0[l_by] = 1;
+    l_ptr_1[l_by] = 2;
+  }
+  REQUIRE( l_ptr_0[999] == 1 );
+
+  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = l_memory_0.get_contraction_memory_manager();
+  REQUIRE( l_contraction_memory->get_thread_memory( 0 ) != nullptr );
+  REQUIRE( l_contraction_memory->get_thread_memory( 1 ) != nullptr );
+  REQUIRE( l_contraction_memory->get_thread_memory( 0 ) != l_contraction_memory->get_thread_memory( 1 ) );
+  REQUIRE( (uintptr_t) l_contraction_memory->get_thread_memory( 1 ) % 128 == 0 );
+  for( int64_t l_by = 0; l_by < 2048; l_by++ ) {
+    l_contraction_memory->get_thread_memory( 1 )[l_by] = 3;
+  }
+
+  int64_t l_num_bytes = l_arena.get_num_bytes();
+  REQUIRE( l_num_bytes >= 2 * ( 1024 + 2 * 2048 ) );
+
+  l_memory_0.checkin();
+  l_memory_1.checkin();
+  REQUIRE( l_contraction_memory->get_thread_memory( 0 ) == nullptr );
+
+  // sequential evaluations reuse the slots
+  for( int64_t l_re = 0; l_re < 3; l_re++ ) {
+    l_memory_1.checkout();
+    l_memory_1.checkin();
+    l_memory_0.checkout();
+    l_memory_0.checkin();
+  }
+  REQUIRE( l_arena.get_num_slots() == 2 );
+  REQUIRE( l_arena.get_num_bytes() == l_num_bytes );
+}
+
+TEST_CASE( "Growing requirements of a memory arena.", "[memory_arena]" ) {
+  einsum_ir::backend::MemoryArena l_arena;
+
+  l_arena.reserve( 100, 0, 1 );
+  einsum_ir::backend::MemoryArena::Slot * l_slot = l_arena.checkout();
+  REQUIRE( l_slot->m_num_bytes == 100 );
+  REQUIRE( l_slot->m_thread_memory.size() == 1 );
+  l_arena.checkin( l_slot );
+
+  // idle slots are reallocated if a later reservation exceeds them
+  l_arena.reserve( 5000, 256, 3 );
+  l_slot = l_arena.checkout();
+  REQUIRE( l_slot->m_num_bytes == 5000 );
+  REQUIRE( l_slot->m_num_bytes_thread == 256 );
+  REQUIRE( l_slot->m_aligned_thread_memory.size() == 3 );
+  l_slot->m_aligned_memory[4999] = 1;
+  l_slot->m_aligned_thread_memory[2][255] = 1;
+  l_arena.checkin( l_slot );
+
+  REQUIRE( l_arena.get_num_slots() == 1 );
+}
+
+TEST_CASE( "Failed allocation of a memory arena's slot.", "[memory_arena]" ) {
+  einsum_ir::backend::MemoryArena l_arena;
+
+  l_arena.reserve( 100, 0, 1 );
+  einsum_ir::backend::MemoryArena::Slot * l_slot = l_arena.checkout();
+  l_arena.checkin( l_slot );
+  REQUIRE( l_arena.get_num_bytes() > 0 );
+
+  // the emptied slot is returned to the arena and reused by the next checkout
+  l_arena.reserve( int64_t(1) << 55, 0, 1 );
+  for( int64_t l_re = 0; l_re < 2; l_re++ ) {
+    REQUIRE_THROWS_AS( l_arena.checkout(), std::bad_alloc );
+    REQUIRE( l_arena.get_num_slots() == 1 );
+    REQUIRE( l_arena.get_num_bytes() == 0 );
+  }
+}
+
+TEST_CASE( "Scratch memory of concurrent branches in a memory arena.", "[memory_arena]" ) {
+  einsum_ir::backend::MemoryArena l_arena;
+
+  einsum_ir::backend::MemoryManager l_memory;
+  l_memory.set_arena( &l_arena );
+
+  int64_t l_id_cont = l_memory.add_contraction_memory_manager();
+  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory_0 = l_memory.get_contraction_memory_manager();
+  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory_1 = l_memory.get_contraction_memory_manager( l_id_cont );
+  l_contraction_memory_0->reserve_thread_memory( 200, 1 );
+  l_contraction_memory_1->reserve_thread_memory( 256, 2 );
+
+  // the branch's scratch memory is reserved in the arena instead of being allocated
+  l_memory.alloc_all_memory();
+  REQUIRE( l_memory.get_num_bytes() == 0 );
+  REQUIRE( l_contraction_memory_1->get_num_bytes() == 0 );
+
+  l_memory.checkout();
+  REQUIRE( l_arena.get_num_slots() == 1 );
+
+  // the branch's scratch memory follows the cache line-aligned scratch memory of the first branch
+  REQUIRE( l_contraction_memory_0->get_thread_memory( 0 ) != nullptr );
+  REQUIRE( l_contraction_memory_1->get_thread_memory( 0 ) == l_contraction_memory_0->get_thread_memory( 0 ) + 256 );
+  REQUIRE( l_contraction_memory_1->get_thread_memory( 1 ) != nullptr );
+  REQUIRE( (uintptr_t) l_contraction_memory_1->get_thread_memory( 1 ) % 128 == 0 );
+  for( int64_t l_by = 0; l_by < 256; l_by++ ) {
+    l_contraction_memory_1->get_thread_memory( 1 )[l_by] = 1;
+  }
+
+  l_memory.checkin();
+  REQUIRE( l_contraction_memory_1->get_thread_memory( 0 ) == nullptr );
+}
@@ -1,9 +1,13 @@
 #include "MemoryManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
 
 einsum_ir::backend::MemoryManager::~MemoryManager() {
-  if(  m_memory_ptr != nullptr ) {
-    delete [] (char *)  m_memory_ptr;
-  }
+  einsum_ir::basic::Numa::free( m_memory_ptr,
+                                m_num_bytes_alloc,
+                                m_pages );
 }
 
 int64_t einsum_ir::backend::MemoryManager::reserve_memory( int64_t i_size ){
@@ -13,6 +17,13 @@ int64_t einsum_ir::backend::MemoryManager::reserve_memory( int64_t i_size ){
   if( i_size % m_alignment_line != 0 ){
     i_size += m_alignment_line - ( i_size % m_alignment_line );
   }
+
+  //record the start of the live interval
+  m_tensor_size.push_back(i_size);
+  m_tensor_start.push_back(m_time);
+  m_tensor_end.push_back(-1);
+  m_tensor_branch.push_back(m_branch);
+  m_time++;
   
   //calculate new memory offset and append to allocation
   int64_t l_mem_id;
@@ -50,7 +61,20 @@ int64_t einsum_ir::backend::MemoryManager::reserve_memory( int64_t i_size ){
 }
 
 void einsum_ir::backend::MemoryManager::remove_reservation( int64_t i_id ){
+  //record the end of the live interval
+  m_tensor_end[std::abs(i_id) - 1] = m_time;
+  m_time++;
+
+  //the stack planner cannot separate concurrent branches
+  if( !m_open_sections.empty() ){
+    m_deferred_removals.push_back(i_id);
+    return;
+  }
+
+  release_stack( i_id );
+}
 
+void einsum_ir::backend::MemoryManager::release_stack( int64_t i_id ){
   //find offset and id in list of allocated and delete them
   std::list<int64_t>::iterator l_alloc_id_it;
   std::list<int64_t>::iterator l_alloc_offset_it;
@@ -78,10 +102,208 @@ void einsum_ir::backend::MemoryManager::remove_reservation( int64_t i_id ){
   }
 }
 
+void einsum_ir::backend::MemoryManager::begin_concurrent_section(){
+  m_open_sections.push_back( m_num_sections );
+  m_open_sections_branch.push_back( m_branch );
+  m_num_sections++;
+}
+
+void einsum_ir::backend::MemoryManager::begin_concurrent_branch(){
+  m_branch_parent.push_back( m_open_sections_branch.back() );
+  m_branch_section.push_back( m_open_sections.back() );
+  m_branch = m_branch_parent.size() - 1;
+}
+
+void einsum_ir::backend::MemoryManager::end_concurrent_section(){
+  m_branch = m_open_sections_branch.back();
+  m_open_sections.pop_back();
+  m_open_sections_branch.pop_back();
+
+  if( m_open_sections.empty() ){
+    for( std::size_t l_re = 0; l_re < m_deferred_removals.size(); l_re++ ){
+      release_stack( m_deferred_removals[l_re] );
+    }
+    m_deferred_removals.clear();
+  }
+}
+
+int64_t einsum_ir::backend::MemoryManager::add_contraction_memory_manager(){
+  m_contraction_memory_branches.emplace_back( new einsum_ir::basic::ContractionMemoryManager() );
+  m_contraction_memory_branches.back()->set_pages( m_pages_requested );
+
+  return m_contraction_memory_branches.size();
+}
+
+bool einsum_ir::backend::MemoryManager::concurrent( int64_t i_branch_0,
+                                                    int64_t i_branch_1 ) const {
+  //ancestors of the first branch, including the branch itself
+  std::vector<int64_t> l_path;
+  for( int64_t l_br = i_branch_0; l_br >= 0; l_br = m_branch_parent[l_br] ){
+    l_path.push_back( l_br );
+  }
+
+  //walk up from the second branch to the lowest common ancestor
+  int64_t l_child_1 = -1;
+  int64_t l_br = i_branch_1;
+  std::vector<int64_t>::iterator l_it = std::find( l_path.begin(), l_path.end(), l_br );
+  while( l_it == l_path.end() ){
+    l_child_1 = l_br;
+    l_br = m_branch_parent[l_br];
+    l_it = std::find( l_path.begin(), l_path.end(), l_br );
+  }
+  int64_t l_child_0 = ( l_it != l_path.begin() ) ? *(l_it - 1) : -1;
+
+  //children of the common ancestor in the same section run concurrently, different sections run one after another
+  return    l_child_0 >= 0
+         && l_child_1 >= 0
+         && m_branch_section[l_child_0] == m_branch_section[l_child_1];
+}
+
+void einsum_ir::backend::MemoryManager::plan_intervals(){
+  int64_t l_num_tensors = m_tensor_size.size();
+
+  //tensors which are never removed are live until the end
+  std::vector<int64_t> l_end( m_tensor_end );
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ){
+    if( l_end[l_te] < 0 ){
+      l_end[l_te] = m_time;
+    }
+  }
+
+  //lower bound: maximum size of all simultaneously live tensors
+  std::vector<int64_t> l_live( m_time + 1, 0 );
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ){
+    l_live[ m_tensor_start[l_te] ] += m_tensor_size[l_te];
+    l_live[ l_end[l_te] ]          -= m_tensor_size[l_te];
+  }
+  m_req_mem_lower_bound = 0;
+  int64_t l_size_live = 0;
+  for( int64_t l_ti = 0; l_ti <= m_time; l_ti++ ){
+    l_size_live += l_live[l_ti];
+    m_req_mem_lower_bound = std::max( m_req_mem_lower_bound, l_size_live );
+  }
+
+  //place large tensors first
+  std::vector<int64_t> l_order( l_num_tensors );
+  std::iota( l_order.begin(), l_order.end(), 0 );
+  std::stable_sort( l_order.begin(),
+                    l_order.end(),
+                    [&]( int64_t i_te_0, int64_t i_te_1 ){
+                      return m_tensor_size[i_te_0] > m_tensor_size[i_te_1];
+                    } );
+
+  //assign every tensor the smallest gap between the tensors with overlapping live intervals
+  m_tensor_offset_intervals.assign( l_num_tensors, 0 );
+  m_req_mem_intervals = 0;
+  std::vector<int64_t> l_placed;
+  for( int64_t l_or = 0; l_or < l_num_tensors; l_or++ ){
+    int64_t l_te = l_order[l_or];
+    int64_t l_size = m_tensor_size[l_te];
+
+    int64_t l_offset = -1;
+    int64_t l_size_gap_best = std::numeric_limits<int64_t>::max();
+    int64_t l_end_prev = 0;
+    for( std::size_t l_pl = 0; l_pl < l_placed.size(); l_pl++ ){
+      int64_t l_te_pl = l_placed[l_pl];
+      bool l_overlap =    (    m_tensor_start[l_te] < l_end[l_te_pl]
+                            && m_tensor_start[l_te_pl] < l_end[l_te] )
+                       || concurrent( m_tensor_branch[l_te],
+                                      m_tensor_branch[l_te_pl] );
+      if( !l_overlap ){
+        continue;
+      }
+
+      int64_t l_size_gap = m_tensor_offset_intervals[l_te_pl] - l_end_prev;
+      if( l_size_gap >= l_size && l_size_gap < l_size_gap_best ){
+        l_offset = l_end_prev;
+        l_size_gap_best = l_size_gap;
+      }
+      l_end_prev = std::max( l_end_prev, m_tensor_offset_intervals[l_te_pl] + m_tensor_size[l_te_pl] );
+    }
+    if( l_offset < 0 ){
+      l_offset = l_end_prev;
+    }
+    m_tensor_offset_intervals[l_te] = l_offset;
+    m_req_mem_intervals = std::max( m_req_mem_intervals, l_offset + l_size );
+
+    //keep placed tensors sorted by offset
+    std::vector<int64_t>::iterator l_it = std::upper_bound( l_placed.begin(),
+                                                            l_placed.end(),
+                                                            l_offset,
+                                                            [&]( int64_t i_offset, int64_t i_te_pl ){
+                                                              return i_offset < m_tensor_offset_intervals[i_te_pl];
+                                                            } );
+    l_placed.insert( l_it, l_te );
+  }
+}
+
+void einsum_ir::backend::MemoryManager::set_planner( planner_t i_planner ){
+  m_planner = i_planner;
+}
+
+void einsum_ir::backend::MemoryManager::set_placement( einsum_ir::basic::Numa::placement_t i_placement ){
+  m_placement = i_placement;
+}
+
+void einsum_ir::backend::MemoryManager::set_pages( einsum_ir::basic::Numa::pages_t i_pages ){
+  m_pages_requested = i_pages;
+  m_contraction_memory_manager.set_pages( i_pages );
+  for( std::size_t l_br = 0; l_br < m_contraction_memory_branches.size(); l_br++ ){
+    m_contraction_memory_branches[l_br]->set_pages( i_pages );
+  }
+}
+
+einsum_ir::basic::Numa::pages_t einsum_ir::backend::MemoryManager::get_pages() const {
+  return m_pages;
+}
+
+void einsum_ir::backend::MemoryManager::set_arena( MemoryArena * i_arena ){
+  m_arena = i_arena;
+}
+
 void einsum_ir::backend::MemoryManager::alloc_all_memory(){
-  if( m_req_mem ){
-    //allocate memory 
-    m_memory_ptr = new char[m_req_mem + m_alignment_page];
+  plan_intervals();
+
+  if( m_planner == planner_t::AUTO ){
+    m_use_intervals = m_req_mem_intervals < m_req_mem;
+  }
+  else{
+    m_use_intervals = m_planner == planner_t::INTERVALS;
+  }
+  int64_t l_req_mem = m_use_intervals ? m_req_mem_intervals : m_req_mem;
+
+  if( m_arena != nullptr ){
+    //scratch memory of the branches follows the one of the first branch in every thread's memory
+    int64_t l_req_thread_mem = m_contraction_memory_manager.get_num_bytes_thread();
+    int64_t l_num_threads = m_contraction_memory_manager.get_num_threads();
+    m_offsets_thread_branches.resize( m_contraction_memory_branches.size() );
+    for( std::size_t l_br = 0; l_br < m_contraction_memory_branches.size(); l_br++ ){
+      if( l_req_thread_mem % m_alignment_line != 0 ){
+        l_req_thread_mem += m_alignment_line - ( l_req_thread_mem % m_alignment_line );
+      }
+      m_offsets_thread_branches[l_br] = l_req_thread_mem;
+      l_req_thread_mem += m_contraction_memory_branches[l_br]->get_num_bytes_thread();
+      l_num_threads = std::max( l_num_threads,
+                                m_contraction_memory_branches[l_br]->get_num_threads() );
+    }
+
+    m_arena->reserve( l_req_mem,
+                      l_req_thread_mem,
+                      l_num_threads );
+    return;
+  }
+
+  for( std::size_t l_br = 0; l_br < m_contraction_memory_branches.size(); l_br++ ){
+    m_contraction_memory_branches[l_br]->alloc_all_memory();
+  }
+
+  if( l_req_mem ){
+    //allocate memory, the pages are placed by the first touch or interleaved
+    m_num_bytes_alloc = l_req_mem + m_alignment_page;
+    m_pages = m_pages_requested;
+    m_memory_ptr = einsum_ir::basic::Numa::alloc( m_num_bytes_alloc,
+                                                  m_placement,
+                                                  m_pages );
 
     //allign data in memory 
     int64_t l_align_offset = (unsigned long)m_memory_ptr % m_alignment_page;
@@ -92,10 +314,45 @@ void einsum_ir::backend::MemoryManager::alloc_all_memory(){
   m_contraction_memory_manager.alloc_all_memory();
 }
 
+void einsum_ir::backend::MemoryManager::checkout(){
+  if( m_arena == nullptr ){
+    return;
+  }
+
+  m_slot = m_arena->checkout();
+  m_aligned_memory_ptr = m_slot->m_aligned_memory;
+  m_contraction_memory_manager.bind_thread_memory( m_slot->m_aligned_thread_memory );
+
+  for( std::size_t l_br = 0; l_br < m_contraction_memory_branches.size(); l_br++ ){
+    std::vector< char * > l_thread_memory = m_slot->m_aligned_thread_memory;
+    for( std::size_t l_th = 0; l_th < l_thread_memory.size(); l_th++ ){
+      l_thread_memory[l_th] += m_offsets_thread_branches[l_br];
+    }
+    m_contraction_memory_branches[l_br]->bind_thread_memory( l_thread_memory );
+  }
+}
+
+void einsum_ir::backend::MemoryManager::checkin(){
+  if( m_slot == nullptr ){
+    return;
+  }
+
+  m_contraction_memory_manager.bind_thread_memory( {} );
+  for( std::size_t l_br = 0; l_br < m_contraction_memory_branches.size(); l_br++ ){
+    m_contraction_memory_branches[l_br]->bind_thread_memory( {} );
+  }
+  m_aligned_memory_ptr = nullptr;
+  m_arena->checkin( m_slot );
+  m_slot = nullptr;
+}
+
 void * einsum_ir::backend::MemoryManager::get_mem_ptr( int64_t i_id ){
 
   void * l_return_ptr;
-  if(i_id >= 0){
+  if( m_use_intervals ){
+    l_return_ptr = (void *) (m_aligned_memory_ptr + m_tensor_offset_intervals[std::abs(i_id) - 1]);
+  }
+  else if(i_id >= 0){
     l_return_ptr = (void *) (m_aligned_memory_ptr +  m_tensor_offset[i_id - 1]);
   }
   else{
@@ -105,6 +362,47 @@ void * einsum_ir::backend::MemoryManager::get_mem_ptr( int64_t i_id ){
 }
 
 
-einsum_ir::basic::ContractionMemoryManager * einsum_ir::backend::MemoryManager::get_contraction_memory_manager(){
+einsum_ir::basic::ContractionMemoryManager * einsum_ir::backend::MemoryManager::get_contraction_memory_manager( int64_t i_id ){
+  if( i_id > 0 ){
+    return m_contraction_memory_branches[i_id - 1].get();
+  }
   return &m_contraction_memory_manager;
 }
+
+int64_t einsum_ir::backend::MemoryManager::get_num_bytes() const {
+  int64_t l_num_bytes = 0;
+  l_num_bytes += einsum_ir::basic::Numa::get_num_bytes_mapped( m_num_bytes_alloc,
+                                                              m_pages );
+  l_num_bytes += m_contraction_memory_manager.get_num_bytes();
+  for( std::size_t l_br = 0; l_br < m_contraction_memory_branches.size(); l_br++ ){
+    l_num_bytes += m_contraction_memory_branches[l_br]->get_num_bytes();
+  }
+
+  return l_num_bytes;
+}
+
+int64_t einsum_ir::backend::MemoryManager::get_num_bytes_required() const {
+  int64_t l_num_bytes = m_use_intervals ? m_req_mem_intervals : m_req_mem;
+  l_num_bytes += m_contraction_memory_manager.get_num_bytes_thread() * m_contraction_memory_manager.get_num_threads();
+  for( std::size_t l_br = 0; l_br < m_contraction_memory_branches.size(); l_br++ ){
+    l_num_bytes += m_contraction_memory_branches[l_br]->get_num_bytes_thread() * m_contraction_memory_branches[l_br]->get_num_threads();
+  }
+
+  return l_num_bytes;
+}
+
+int64_t einsum_ir::backend::MemoryManager::get_num_bytes_stack() const {
+  return m_req_mem;
+}
+
+int64_t einsum_ir::backend::MemoryManager::get_num_bytes_intervals() const {
+  return m_req_mem_intervals;
+}
+
+int64_t einsum_ir::backend::MemoryManager::get_num_bytes_lower_bound() const {
+  return m_req_mem_lower_bound;
+}
+
+bool einsum_ir::backend::MemoryManager::uses_intervals() const {
+  return m_use_intervals;
+}
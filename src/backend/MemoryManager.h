@@ -3,8 +3,11 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 #include "../constants.h"
 #include "../basic/binary/ContractionMemoryManager.h"
+#include "../basic/Numa.h"
+#include "MemoryArena.h"
 
 namespace einsum_ir {
   namespace backend {
@@ -12,7 +15,36 @@ namespace einsum_ir {
   }
 }
 
+/**
+ * Memory manager for the intermediate tensors of an einsum tree.
+ *
+ * Reservations and their removals are recorded in execution order.
+ * Two planners derive the offsets of the tensors:
+ *   - a stack planner which places the tensors of alternating layers at the two ends of the memory,
+ *   - an interval planner which computes the live interval of every tensor and packs the intervals greedily by size.
+ * By default, the planner requiring less memory is used.
+ *
+ * Subtrees which are evaluated concurrently are recorded as branches of concurrent sections.
+ * The interval planner separates the tensors of concurrent branches and reuses memory within every branch,
+ * the stack planner keeps all tensors of a section until the section is closed.
+ * Every branch except the first one of a section uses its own contraction memory manager.
+ *
+ * The memory of the tensors is not touched at allocation,
+ * i.e., by default the pages are placed on the NUMA nodes of the threads which write the tensors first.
+ * Optionally, the memory is backed by huge pages to reduce TLB misses in strided accesses.
+ *
+ * If an arena is attached, no memory is allocated by the manager.
+ * Instead, the requirements are reserved in the arena and every evaluation checks out the memory of a slot.
+ **/
 class einsum_ir::backend::MemoryManager{
+  public:
+    //! planner of the tensor offsets
+    typedef enum {
+      AUTO      = 0, // planner with the smaller footprint
+      STACK     = 1, // two-ended stack
+      INTERVALS = 2  // interval packing of the live intervals
+    } planner_t;
+
   private:
     //! alignment of memory to cache lines in bytes 
     int64_t m_alignment_line = 128;
@@ -21,17 +53,52 @@ class einsum_ir::backend::MemoryManager{
 
     //! pointer to the start of all allocated memory
     char * m_memory_ptr = nullptr;
+    //! number of allocated bytes
+    int64_t m_num_bytes_alloc = 0;
     //! pointer to the start of aligend memory
     char * m_aligned_memory_ptr = nullptr;
     //! the required memory for all data
     int64_t m_req_mem = 0;
 
+    //! required memory of the interval planner
+    int64_t m_req_mem_intervals = 0;
+
+    //! lower bound of the required memory, i.e., the maximum size of all simultaneously live tensors
+    int64_t m_req_mem_lower_bound = 0;
+
+    //! selected planner
+    planner_t m_planner = planner_t::AUTO;
+
+    //! placement of the tensors on the NUMA nodes
+    einsum_ir::basic::Numa::placement_t m_placement = einsum_ir::basic::Numa::get_placement();
+
+    //! requested page backing of the tensors
+    einsum_ir::basic::Numa::pages_t m_pages_requested = einsum_ir::basic::Numa::get_pages();
+
+    //! obtained page backing of the tensors
+    einsum_ir::basic::Numa::pages_t m_pages = einsum_ir::basic::Numa::SMALL;
+
+    //! true if the offsets of the interval planner are used
+    bool m_use_intervals = false;
+
+    //! number of reservations and removals so far, used as time of the live intervals
+    int64_t m_time = 0;
+
     //! last id given to any tensor
     int64_t m_last_id = 0;
 
     //! offset of the tensor for pointer calculation
     std::vector<int64_t> m_tensor_offset;
 
+    //! aligned size of the tensors
+    std::vector<int64_t> m_tensor_size;
+    //! start of the tensors' live intervals
+    std::vector<int64_t> m_tensor_start;
+    //! end of the tensors' live intervals, -1 if the tensor is live until the end
+    std::vector<int64_t> m_tensor_end;
+    //! offset of the tensors derived by the interval planner
+    std::vector<int64_t> m_tensor_offset_intervals;
+
     //! propertys of allocated memory
     std::list<int64_t> m_allocated_id_left;
     std::list<int64_t> m_allocated_id_right;
@@ -41,6 +108,59 @@ class einsum_ir::backend::MemoryManager{
     //! memory manager for contractions
     einsum_ir::basic::ContractionMemoryManager m_contraction_memory_manager;
 
+    //! arena providing the memory, nullptr if the memory is owned
+    MemoryArena * m_arena = nullptr;
+
+    //! slot of the arena which is checked out
+    MemoryArena::Slot * m_slot = nullptr;
+
+    //! contraction memory managers of concurrent branches, the first branch uses m_contraction_memory_manager
+    std::vector< std::unique_ptr< einsum_ir::basic::ContractionMemoryManager > > m_contraction_memory_branches;
+
+    //! offsets of the branches' scratch memory in the scratch memory of every thread of an arena slot
+    std::vector< int64_t > m_offsets_thread_branches;
+
+    //! parent of every branch, branch 0 is the root which is not part of a concurrent section
+    std::vector<int64_t> m_branch_parent = { -1 };
+    //! concurrent section of every branch
+    std::vector<int64_t> m_branch_section = { -1 };
+    //! number of concurrent sections opened so far
+    int64_t m_num_sections = 0;
+    //! ids of the currently open sections, innermost last
+    std::vector<int64_t> m_open_sections;
+    //! branch which was active when the open sections were opened
+    std::vector<int64_t> m_open_sections_branch;
+    //! branch of the current reservations
+    int64_t m_branch = 0;
+    //! branch of every tensor
+    std::vector<int64_t> m_tensor_branch;
+
+    //! reservations whose removal from the stack is deferred until all concurrent sections are closed
+    std::vector<int64_t> m_deferred_removals;
+
+    /**
+     * Releases the memory of a reservation in the stack planner.
+     *
+     * @param i_id id of the memory reservation.
+     **/
+    void release_stack( int64_t i_id );
+
+    /**
+     * Checks if two branches are evaluated concurrently,
+     * i.e., if they descend from different branches of the same concurrent section.
+     *
+     * @param i_branch_0 first branch.
+     * @param i_branch_1 second branch.
+     * @return true if the branches are concurrent, false otherwise.
+     **/
+    bool concurrent( int64_t i_branch_0,
+                     int64_t i_branch_1 ) const;
+
+    /**
+     * Derives the offsets of the interval planner and the lower bound of the required memory.
+     **/
+    void plan_intervals();
+
   public:
     //! id of the current layer
     int64_t m_layer_id = 0;
@@ -67,10 +187,120 @@ class einsum_ir::backend::MemoryManager{
     void remove_reservation( int64_t i_size );
 
     /**
-     * Allocates the required memory.
+     * Opens a section in which subtrees are evaluated concurrently.
+     * Every subtree starts a branch of the section through begin_concurrent_branch.
+     * In the stack planner, removals of reservations are deferred until the outermost section is closed.
+     **/
+    void begin_concurrent_section();
+
+    /**
+     * Starts the next branch of the innermost concurrent section.
+     * Reservations until the next branch or the end of the section belong to the branch.
+     **/
+    void begin_concurrent_branch();
+
+    /**
+     * Closes a concurrent section and applies the deferred removals if it was the outermost one.
+     **/
+    void end_concurrent_section();
+
+    /**
+     * Adds a contraction memory manager for a subtree which is evaluated concurrently to the other users of the memory manager.
+     * The memory is allocated together with the memory of the tensors.
+     * If an arena is attached, the memory is placed behind the scratch memory of m_contraction_memory_manager in the threads' memory of a slot.
+     *
+     * @return id of the contraction memory manager.
+     **/
+    int64_t add_contraction_memory_manager();
+
+    /**
+     * Sets the planner of the tensor offsets.
+     * Has to be called before the memory is allocated.
+     *
+     * @param i_planner planner.
+     **/
+    void set_planner( planner_t i_planner );
+
+    /**
+     * Sets the placement of the tensors on the NUMA nodes.
+     * Has to be called before the memory is allocated.
+     *
+     * @param i_placement placement.
+     **/
+    void set_placement( einsum_ir::basic::Numa::placement_t i_placement );
+
+    /**
+     * Sets the requested page backing of the tensors and the contraction scratch memory.
+     * Has to be called before the memory is allocated.
+     *
+     * @param i_pages page backing.
+     **/
+    void set_pages( einsum_ir::basic::Numa::pages_t i_pages );
+
+    /**
+     * Gets the page backing which was obtained for the tensors.
+     * Only available after the memory was allocated.
+     *
+     * @return page backing.
+     **/
+    einsum_ir::basic::Numa::pages_t get_pages() const;
+
+    /**
+     * Attaches an arena which provides the memory.
+     * Has to be called before the memory is allocated.
+     *
+     * @param i_arena arena, nullptr to allocate the memory in the manager.
+     **/
+    void set_arena( MemoryArena * i_arena );
+
+    /**
+     * Allocates the required memory using the offsets of the selected planner.
+     * If an arena is attached, the required memory, including the scratch memory of all branches, is reserved in the arena.
      **/
     void alloc_all_memory();
 
+    /**
+     * Checks out a slot of the attached arena and binds its memory.
+     * Has to be called before an evaluation, no-op if no arena is attached.
+     **/
+    void checkout();
+
+    /**
+     * Returns the checked out slot to the attached arena.
+     * Has to be called after an evaluation, no-op if no arena is attached.
+     **/
+    void checkin();
+
+    /**
+     * Gets the memory required by the stack planner.
+     *
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes_stack() const;
+
+    /**
+     * Gets the memory required by the interval planner.
+     * Only available after the memory was allocated.
+     *
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes_intervals() const;
+
+    /**
+     * Gets the lower bound of the memory required by any planner.
+     * Only available after the memory was allocated.
+     *
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes_lower_bound() const;
+
+    /**
+     * Checks if the offsets of the interval planner are used.
+     *
+     * @return true if the interval planner is used, false if the stack planner is used.
+     **/
+    bool uses_intervals() const;
+
     /**
      * returns a pointer to requested memory
      *
@@ -83,9 +313,30 @@ class einsum_ir::backend::MemoryManager{
     /**
      * retruns a poiner to the ContractionMemoryManager
      *
+     * @param i_id id of the contraction memory manager, 0 for the one shared by sequentially evaluated contractions.
      * @return pointer to the ContractionMemoryManager
      **/
-    einsum_ir::basic::ContractionMemoryManager * get_contraction_memory_manager();
+    einsum_ir::basic::ContractionMemoryManager * get_contraction_memory_manager( int64_t i_id = 0 );
+
+    /**
+     * Gets the number of bytes allocated by the memory manager,
+     * including the scratch memory of all contraction memory managers.
+     * Allocations are rounded up to the size of their pages.
+     * Memory of an attached arena is not included.
+     *
+     * @return number of allocated bytes.
+     **/
+    int64_t get_num_bytes() const;
+
+    /**
+     * Gets the number of bytes required by the tensors in the layout of the selected planner
+     * and by the scratch memory of all contraction memory managers.
+     * The requirement is independent of an attached arena and does not include alignment or page padding.
+     * Only available after the memory was allocated.
+     *
+     * @return number of required bytes.
+     **/
+    int64_t get_num_bytes_required() const;
 
 };
 
@@ -1,6 +1,7 @@
 #include "catch.hpp"
 #include "MemoryManager.h"
 #include <algorithm>
+#include <cstdlib>
 
 TEST_CASE( "A complex memory allocation test", "[memory_manager]" ) {
   //     __18_           __3x6_
@@ -11,30 +12,30 @@ TEST_CASE( "A complex memory allocation test", "[memory_manager]" ) {
 
   //Memory Manager
   einsum_ir::backend::MemoryManager l_memory;
-  l_memory.increase_layer();
+  l_memory.m_layer_id++;
 
   //  | 12 | 20 | ... | 15 |
-  l_memory.increase_layer();
-  int64_t l_mem_id_1 = l_memory.request_memory(12 * 4);
-  int64_t l_mem_id_2 = l_memory.request_memory(20 * 4);
-  l_memory.decrease_layer();
-  int64_t l_mem_id_3 = l_memory.request_memory(15 * 4);
-  l_memory.remove_memory(l_mem_id_1);
-  l_memory.remove_memory(l_mem_id_2);
+  l_memory.m_layer_id++;
+  int64_t l_mem_id_1 = l_memory.reserve_memory(12 * 4);
+  int64_t l_mem_id_2 = l_memory.reserve_memory(20 * 4);
+  l_memory.m_layer_id--;
+  int64_t l_mem_id_3 = l_memory.reserve_memory(15 * 4);
+  l_memory.remove_reservation(l_mem_id_1);
+  l_memory.remove_reservation(l_mem_id_2);
 
   // | 30 | ... | 30 | 15 |
-  l_memory.increase_layer();
-  int64_t l_mem_id_4 = l_memory.request_memory(30 * 4);
-  l_memory.decrease_layer();
-  int64_t l_mem_id_5 = l_memory.request_memory(30 * 4);
-  l_memory.remove_memory(l_mem_id_4);
+  l_memory.m_layer_id++;
+  int64_t l_mem_id_4 = l_memory.reserve_memory(30 * 4);
+  l_memory.m_layer_id--;
+  int64_t l_mem_id_5 = l_memory.reserve_memory(30 * 4);
+  l_memory.remove_reservation(l_mem_id_4);
 
-  l_memory.decrease_layer();
+  l_memory.m_layer_id--;
 
   // | 18 | ... | 30 | 15 |
-  int64_t l_mem_id_6 = l_memory.request_memory(18 * 4);
-  l_memory.remove_memory(l_mem_id_3);
-  l_memory.remove_memory(l_mem_id_5);
+  int64_t l_mem_id_6 = l_memory.reserve_memory(18 * 4);
+  l_memory.remove_reservation(l_mem_id_3);
+  l_memory.remove_reservation(l_mem_id_5);
 
 
   //check that pointers are written to the correct memory side
@@ -46,12 +47,130 @@ TEST_CASE( "A complex memory allocation test", "[memory_manager]" ) {
   REQUIRE( l_mem_id_6 >= 0 );
 
   //check that right amount of memory gets allocated
-  REQUIRE( l_memory.m_req_mem >= ( 30 + 30 + 15 ) * 4 );
+  REQUIRE( l_memory.get_num_bytes_stack() >= 3 * 128 );
 
   //allocate memory and check some pointer
   l_memory.alloc_all_memory();
+  REQUIRE( l_memory.get_num_bytes_lower_bound() == 3 * 128 );
+  REQUIRE( l_memory.get_num_bytes_intervals() >= l_memory.get_num_bytes_lower_bound() );
+  int64_t l_num_bytes_planned = std::min( l_memory.get_num_bytes_stack(),
+                                          l_memory.get_num_bytes_intervals() );
+  REQUIRE( l_memory.get_num_bytes() == einsum_ir::basic::Numa::get_num_bytes_mapped( l_num_bytes_planned + 4096,
+                                                                                     l_memory.get_pages() ) );
+
   float * l_mem_1_ptr = (float*) l_memory.get_mem_ptr(l_mem_id_2);
   float * l_mem_2_ptr = (float*) l_memory.get_mem_ptr(l_mem_id_3);
   REQUIRE( l_mem_1_ptr != nullptr );
   REQUIRE( l_mem_2_ptr != nullptr);
-}
\ No newline at end of file
+  REQUIRE( l_mem_1_ptr != l_mem_2_ptr );
+}
+
+TEST_CASE( "Interval planner of the memory manager.", "[memory_manager]" ) {
+  // chain in which each tensor is live together with its predecessor,
+  // the stack planner does not reuse the memory below the top of the stack
+  auto l_reserve_chain = []( einsum_ir::backend::MemoryManager & io_memory,
+                             int64_t                             o_ids[4] ) {
+    o_ids[0] = io_memory.reserve_memory( 1024 );
+    o_ids[1] = io_memory.reserve_memory( 1024 );
+    io_memory.remove_reservation( o_ids[0] );
+    o_ids[2] = io_memory.reserve_memory( 1024 );
+    io_memory.remove_reservation( o_ids[1] );
+    o_ids[3] = io_memory.reserve_memory( 2048 );
+    io_memory.remove_reservation( o_ids[2] );
+  };
+
+  einsum_ir::backend::MemoryManager l_memory;
+  int64_t l_ids[4] = { 0 };
+  l_reserve_chain( l_memory, l_ids );
+  l_memory.alloc_all_memory();
+
+  REQUIRE( l_memory.get_num_bytes_stack() == 5120 );
+  REQUIRE( l_memory.get_num_bytes_lower_bound() == 3072 );
+  REQUIRE( l_memory.get_num_bytes_intervals() == 3072 );
+  REQUIRE( l_memory.uses_intervals() );
+  REQUIRE( l_memory.get_num_bytes() == einsum_ir::basic::Numa::get_num_bytes_mapped( 3072 + 4096,
+                                                                                     l_memory.get_pages() ) );
+
+  // tensors with overlapping live intervals do not overlap in memory
+  char * l_ptrs[4] = { nullptr };
+  for( int64_t l_te = 0; l_te < 4; l_te++ ) {
+    l_ptrs[l_te] = (char *) l_memory.get_mem_ptr( l_ids[l_te] );
+  }
+  REQUIRE( std::abs( l_ptrs[0] - l_ptrs[1] ) >= 1024 );
+  REQUIRE( std::abs( l_ptrs[1] - l_ptrs[2] ) >= 1024 );
+  REQUIRE( ( l_ptrs[2] + 1024 <= l_ptrs[3] || l_ptrs[3] + 2048 <= l_ptrs[2] ) );
+
+  // forced stack planner
+  einsum_ir::backend::MemoryManager l_memory_stack;
+  l_memory_stack.set_planner( einsum_ir::backend::MemoryManager::STACK );
+  l_reserve_chain( l_memory_stack, l_ids );
+  l_memory_stack.alloc_all_memory();
+  REQUIRE( !l_memory_stack.uses_intervals() );
+  REQUIRE( l_memory_stack.get_num_bytes() == einsum_ir::basic::Numa::get_num_bytes_mapped( 5120 + 4096,
+                                                                                           l_memory_stack.get_pages() ) );
+}
+
+TEST_CASE( "Interval planner of the memory manager with concurrent sections.", "[memory_manager]" ) {
+  einsum_ir::backend::MemoryManager l_memory;
+  l_memory.set_planner( einsum_ir::backend::MemoryManager::INTERVALS );
+
+  // memory is reused within a branch but not by the concurrently evaluated branch
+  l_memory.begin_concurrent_section();
+  l_memory.begin_concurrent_branch();
+  int64_t l_id_0 = l_memory.reserve_memory( 512 );
+  l_memory.remove_reservation( l_id_0 );
+  int64_t l_id_1 = l_memory.reserve_memory( 512 );
+  l_memory.remove_reservation( l_id_1 );
+  l_memory.begin_concurrent_branch();
+  int64_t l_id_2 = l_memory.reserve_memory( 512 );
+  l_memory.remove_reservation( l_id_2 );
+  l_memory.end_concurrent_section();
+
+  // memory is reused after the section
+  int64_t l_id_3 = l_memory.reserve_memory( 512 );
+
+  // the second branch has its own scratch memory
+  int64_t l_id_cont = l_memory.add_contraction_memory_manager();
+  REQUIRE( l_id_cont == 1 );
+  l_memory.get_contraction_memory_manager( l_id_cont )->reserve_thread_memory( 256,
+                                                                               2 );
+
+  l_memory.alloc_all_memory();
+  REQUIRE( l_memory.uses_intervals() );
+  REQUIRE( l_memory.get_num_bytes_lower_bound() == 512 );
+  REQUIRE( l_memory.get_num_bytes_intervals() == 1024 );
+  REQUIRE( l_memory.get_mem_ptr( l_id_0 ) == l_memory.get_mem_ptr( l_id_1 ) );
+  REQUIRE( l_memory.get_mem_ptr( l_id_0 ) != l_memory.get_mem_ptr( l_id_2 ) );
+  REQUIRE( l_memory.get_mem_ptr( l_id_3 ) != nullptr );
+
+  REQUIRE( l_memory.get_contraction_memory_manager( l_id_cont ) != l_memory.get_contraction_memory_manager() );
+  REQUIRE( l_memory.get_contraction_memory_manager( l_id_cont )->get_num_bytes() >= 512 );
+  REQUIRE( l_memory.get_num_bytes() >= 1024 + 512 );
+}
+
+TEST_CASE( "Huge page backing of the memory manager.", "[memory_manager]" ) {
+  using einsum_ir::basic::Numa;
+
+  // a single tensor spanning multiple huge pages
+  einsum_ir::backend::MemoryManager l_memory_large;
+  int64_t l_num_bytes = 5 * 1024 * 1024;
+  int64_t l_mem_id = l_memory_large.reserve_memory( l_num_bytes );
+  l_memory_large.set_pages( Numa::HUGE_2M );
+  l_memory_large.alloc_all_memory();
+
+  // the obtained backing depends on the configuration of the host
+  REQUIRE( l_memory_large.get_pages() <= Numa::HUGE_2M );
+  char * l_ptr = (char *) l_memory_large.get_mem_ptr( l_mem_id );
+  for( int64_t l_by = 0; l_by < l_num_bytes; l_by++ ) {
+    l_ptr[l_by] = 1;
+  }
+  REQUIRE( l_ptr[l_num_bytes - 1] == 1 );
+
+  // tensors smaller than a huge page fall back to base pages
+  einsum_ir::backend::MemoryManager l_memory_small;
+  l_memory_small.reserve_memory( 1024 );
+  l_memory_small.set_pages( Numa::HUGE_1G );
+  l_memory_small.alloc_all_memory();
+  REQUIRE( l_memory_small.get_pages() == Numa::SMALL );
+  REQUIRE( l_memory_small.get_contraction_memory_manager()->get_pages() == Numa::SMALL );
+}
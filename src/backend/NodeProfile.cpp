@@ -0,0 +1,78 @@
+#include "NodeProfile.h"
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+double einsum_ir::backend::NodeProfile::gflops() const {
+  if( m_time_contraction <= 0 ) {
+    return 0;
+  }
+
+  return 1.0E-9 * m_num_ops / m_time_contraction;
+}
+
+std::string einsum_ir::backend::NodeProfile::to_chrome_trace( std::vector< NodeProfile > const & i_profiles ) {
+  // timestamps are relative to the first evaluated node
+  double l_time_first = 0;
+  for( std::size_t l_pr = 0; l_pr < i_profiles.size(); l_pr++ ) {
+    if( l_pr == 0 || i_profiles[l_pr].m_time_start < l_time_first ) {
+      l_time_first = i_profiles[l_pr].m_time_start;
+    }
+  }
+
+  // map thread ids to consecutive trace ids
+  std::map< int64_t, int64_t > l_tids;
+  for( std::size_t l_pr = 0; l_pr < i_profiles.size(); l_pr++ ) {
+    l_tids.emplace( i_profiles[l_pr].m_thread_id,
+                    l_tids.size() );
+  }
+
+  std::ostringstream l_stream;
+  l_stream << std::fixed << std::setprecision( 3 );
+  l_stream << "{\"traceEvents\":[";
+
+  bool l_first_event = true;
+  for( std::size_t l_pr = 0; l_pr < i_profiles.size(); l_pr++ ) {
+    NodeProfile const & l_prof = i_profiles[l_pr];
+    int64_t l_tid = l_tids.at( l_prof.m_thread_id );
+
+    // timestamps and durations are given in microseconds
+    double l_ts = 1.0E6 * ( l_prof.m_time_start - l_time_first );
+
+    if( l_prof.m_time_permute > 0 ) {
+      if( !l_first_event ) l_stream << ",";
+      l_first_event = false;
+
+      l_stream << "\n{\"name\":\"node " << l_prof.m_id << " permute\","
+               << "\"cat\":\"permute\",\"ph\":\"X\","
+               << "\"ts\":" << l_ts << ","
+               << "\"dur\":" << 1.0E6 * l_prof.m_time_permute << ","
+               << "\"pid\":0,\"tid\":" << l_tid << ","
+               << "\"args\":{\"node\":" << l_prof.m_id << ","
+               << "\"parent\":" << l_prof.m_id_parent << ","
+               << "\"bytes\":" << l_prof.m_num_bytes_permute << "}}";
+    }
+
+    if( l_prof.m_time_contraction > 0 ) {
+      if( !l_first_event ) l_stream << ",";
+      l_first_event = false;
+
+      l_stream << "\n{\"name\":\"node " << l_prof.m_id << " contraction\","
+               << "\"cat\":\"contraction\",\"ph\":\"X\","
+               << "\"ts\":" << l_ts + 1.0E6 * l_prof.m_time_permute << ","
+               << "\"dur\":" << 1.0E6 * l_prof.m_time_contraction << ","
+               << "\"pid\":0,\"tid\":" << l_tid << ","
+               << "\"args\":{\"node\":" << l_prof.m_id << ","
+               << "\"parent\":" << l_prof.m_id_parent << ","
+               << "\"threads\":" << l_prof.m_num_threads << ","
+               << "\"ops\":" << l_prof.m_num_ops << ","
+               << "\"gflops\":" << l_prof.gflops() << ","
+               << "\"packing_us\":" << 1.0E6 * l_prof.m_time_packing << ","
+               << "\"bytes\":" << l_prof.m_num_bytes_contraction << "}}";
+    }
+  }
+
+  l_stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  return l_stream.str();
+}
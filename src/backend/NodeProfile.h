@@ -0,0 +1,66 @@
+#ifndef EINSUM_IR_BACKEND_NODE_PROFILE
+#define EINSUM_IR_BACKEND_NODE_PROFILE
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace einsum_ir {
+  namespace backend {
+    struct NodeProfile;
+  }
+}
+
+/**
+ * Profile of the last evaluation of an einsum node.
+ *
+ * The node's time is split into the permutation of the node's tensor and the binary contraction.
+ * The packing of the contraction's input tensors is part of the contraction time.
+ * Times of the children are not included.
+ **/
+struct einsum_ir::backend::NodeProfile {
+  //! id of the node, the nodes of a tree are numbered in depth-first order
+  int64_t m_id = -1;
+  //! id of the parent node, -1 for the root
+  int64_t m_id_parent = -1;
+
+  //! id of the thread which evaluated the node
+  int64_t m_thread_id = 0;
+  //! number of threads available to the node
+  int64_t m_num_threads = 1;
+
+  //! start of the evaluation in seconds, measured by a steady clock
+  double m_time_start = 0;
+  //! time of the permutation in seconds
+  double m_time_permute = 0;
+  //! time of the packing in seconds, averaged over the threads
+  double m_time_packing = 0;
+  //! time of the binary contraction in seconds, including the packing
+  double m_time_contraction = 0;
+
+  //! number of operations of the binary contraction
+  int64_t m_num_ops = 0;
+
+  //! number of bytes read and written by the permutation
+  int64_t m_num_bytes_permute = 0;
+  //! number of bytes of the contraction's input and output tensors
+  int64_t m_num_bytes_contraction = 0;
+
+  /**
+   * Gets the floating point rate of the binary contraction.
+   *
+   * @return GFLOPS, zero if the node has no contraction.
+   **/
+  double gflops() const;
+
+  /**
+   * Converts profiles to the Chrome trace event format.
+   * The result is viewed in chrome://tracing or Perfetto.
+   *
+   * @param i_profiles profiles of the nodes.
+   * @return trace in JSON.
+   **/
+  static std::string to_chrome_trace( std::vector< NodeProfile > const & i_profiles );
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "catch.hpp"
+#include "NodeProfile.h"
+
+TEST_CASE( "Floating point rate of a node profile.", "[node_profile]" ) {
+  einsum_ir::backend::NodeProfile l_prof;
+  REQUIRE( l_prof.gflops() == 0 );
+
+  l_prof.m_num_ops = 4000000000;
+  l_prof.m_time_contraction = 2;
+  REQUIRE( l_prof.gflops() == Approx( 2.0 ) );
+}
+
+TEST_CASE( "Export of node profiles to the Chrome trace format.", "[node_profile]" ) {
+  std::vector< einsum_ir::backend::NodeProfile > l_profiles( 3 );
+
+  // root: permutation and contraction
+  l_profiles[0].m_id = 0;
+  l_profiles[0].m_id_parent = -1;
+  l_profiles[0].m_thread_id = 1234;
+  l_profiles[0].m_time_start = 10.5;
+  l_profiles[0].m_time_permute = 0.25;
+  l_profiles[0].m_time_contraction = 0.5;
+  l_profiles[0].m_time_packing = 0.125;
+  l_profiles[0].m_num_ops = 1000000000;
+  l_profiles[0].m_num_bytes_contraction = 4096;
+
+  // leaf with permutation on another thread
+  l_profiles[1].m_id = 1;
+  l_profiles[1].m_id_parent = 0;
+  l_profiles[1].m_thread_id = 5678;
+  l_profiles[1].m_time_start = 10.0;
+  l_profiles[1].m_time_permute = 0.001;
+  l_profiles[1].m_num_bytes_permute = 1024;
+
+  // leaf without work
+  l_profiles[2].m_id = 2;
+  l_profiles[2].m_id_parent = 0;
+  l_profiles[2].m_thread_id = 1234;
+  l_profiles[2].m_time_start = 10.4;
+
+  std::string l_trace = einsum_ir::backend::NodeProfile::to_chrome_trace( l_profiles );
+
+  REQUIRE( l_trace.find( "{\"traceEvents\":[" ) == 0 );
+  REQUIRE( l_trace.find( "\"name\":\"node 0 permute\",\"cat\":\"permute\",\"ph\":\"X\",\"ts\":500000.000,\"dur\":250000.000,\"pid\":0,\"tid\":0" ) != std::string::npos );
+  REQUIRE( l_trace.find( "\"name\":\"node 0 contraction\",\"cat\":\"contraction\",\"ph\":\"X\",\"ts\":750000.000,\"dur\":500000.000,\"pid\":0,\"tid\":0" ) != std::string::npos );
+  REQUIRE( l_trace.find( "\"gflops\":2.000,\"packing_us\":125000.000,\"bytes\":4096" ) != std::string::npos );
+  REQUIRE( l_trace.find( "\"name\":\"node 1 permute\",\"cat\":\"permute\",\"ph\":\"X\",\"ts\":0.000,\"dur\":1000.000,\"pid\":0,\"tid\":1" ) != std::string::npos );
+  REQUIRE( l_trace.find( "node 2" ) == std::string::npos );
+  REQUIRE( l_trace.find( "node 1 contraction" ) == std::string::npos );
+  REQUIRE( l_trace.find( "],\"displayTimeUnit\":\"ms\"}" ) != std::string::npos );
+}
@@ -0,0 +1,135 @@
+#include "MappedFile.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  //! size of a page in bytes
+  constexpr int64_t g_num_bytes_page = 4096;
+}
+
+einsum_ir::basic::MappedFile::~MappedFile() {
+  unmap();
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::MappedFile::map( std::string const & i_path,
+                                                          int64_t             i_num_bytes,
+                                                          bool                i_writable ) {
+  unmap();
+
+  if( i_num_bytes <= 0 ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+#if defined(__linux__) || defined(__APPLE__)
+  int l_fd = i_writable ? open( i_path.c_str(), O_RDWR | O_CREAT, 0644 )
+                        : open( i_path.c_str(), O_RDONLY );
+  if( l_fd < 0 ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  struct stat l_stat;
+  bool l_valid = fstat( l_fd, &l_stat ) == 0;
+  if( l_valid && i_writable ) {
+    l_valid = ftruncate( l_fd, i_num_bytes ) == 0;
+  }
+  else if( l_valid ) {
+    l_valid = l_stat.st_size >= i_num_bytes;
+  }
+
+  void * l_ptr = MAP_FAILED;
+  if( l_valid ) {
+    l_ptr = mmap( nullptr,
+                  i_num_bytes,
+                  i_writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                  MAP_SHARED,
+                  l_fd,
+                  0 );
+  }
+  // the mapping keeps its own reference of the file
+  close( l_fd );
+  if( l_ptr == MAP_FAILED ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  // tensors are streamed tile by tile, a larger read-ahead window pays off
+  madvise( l_ptr,
+           i_num_bytes,
+           MADV_SEQUENTIAL );
+
+  m_data = (char *) l_ptr;
+  m_num_bytes = i_num_bytes;
+  m_writable = i_writable;
+
+  return err_t::SUCCESS;
+#else
+  (void) i_path;
+  (void) i_writable;
+  return err_t::UNDEFINED_ERROR;
+#endif
+}
+
+void einsum_ir::basic::MappedFile::unmap() {
+  if( m_data == nullptr ) {
+    return;
+  }
+
+#if defined(__linux__) || defined(__APPLE__)
+  if( m_writable ) {
+    sync();
+  }
+  munmap( m_data,
+          m_num_bytes );
+#endif
+
+  m_data = nullptr;
+  m_num_bytes = 0;
+  m_writable = false;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::MappedFile::sync() {
+  if( m_data == nullptr || !m_writable ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+#if defined(__linux__) || defined(__APPLE__)
+  if( msync( m_data, m_num_bytes, MS_SYNC ) != 0 ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+#endif
+
+  return err_t::SUCCESS;
+}
+
+char * einsum_ir::basic::MappedFile::get_data() const {
+  return m_data;
+}
+
+int64_t einsum_ir::basic::MappedFile::get_num_bytes() const {
+  return m_num_bytes;
+}
+
+bool einsum_ir::basic::MappedFile::is_writable() const {
+  return m_writable;
+}
+
+void einsum_ir::basic::MappedFile::prefetch( void const * i_ptr,
+                                             int64_t      i_num_bytes ) {
+  if( i_ptr == nullptr || i_num_bytes <= 0 ) {
+    return;
+  }
+
+#if defined(__linux__) || defined(__APPLE__)
+  uintptr_t l_first = (uintptr_t) i_ptr;
+  uintptr_t l_last  = l_first + i_num_bytes;
+  l_first -= l_first % g_num_bytes_page;
+
+  madvise( (void *) l_first,
+           l_last - l_first,
+           MADV_WILLNEED );
+#endif
+}
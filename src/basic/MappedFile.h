@@ -0,0 +1,105 @@
+#ifndef EINSUM_IR_BASIC_MAPPED_FILE
+#define EINSUM_IR_BASIC_MAPPED_FILE
+
+#include <cstdint>
+#include <string>
+#include "constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class MappedFile;
+  }
+}
+
+/**
+ * Tensor data backed by a memory-mapped file.
+ *
+ * Read-only mappings serve input tensors which do not fit comfortably in memory:
+ * pages are read on demand and may be dropped by the operating system since they are clean.
+ * Writable mappings are shared with the file, i.e., an output tensor is written to the file directly.
+ * The page cache is advised of sequential accesses, prefetch requests the pages of upcoming tiles ahead of the computation.
+ **/
+class einsum_ir::basic::MappedFile {
+  private:
+    //! mapped data, nullptr if no file is mapped
+    char * m_data = nullptr;
+
+    //! number of mapped bytes
+    int64_t m_num_bytes = 0;
+
+    //! true if the mapping is writable
+    bool m_writable = false;
+
+  public:
+    /**
+     * Constructor.
+     **/
+    MappedFile() = default;
+
+    /**
+     * Destructor, unmaps the file.
+     **/
+    ~MappedFile();
+
+    MappedFile( MappedFile const & ) = delete;
+    MappedFile & operator=( MappedFile const & ) = delete;
+
+    /**
+     * Maps a file.
+     * A read-only file has to hold at least the given number of bytes.
+     * A writable file is created if missing and resized to the given number of bytes.
+     *
+     * @param i_path path of the file.
+     * @param i_num_bytes number of bytes which are mapped.
+     * @param i_writable true if the mapping is writable.
+     * @return SUCCESS if the file was mapped, UNDEFINED_ERROR otherwise.
+     **/
+    err_t map( std::string const & i_path,
+               int64_t             i_num_bytes,
+               bool                i_writable );
+
+    /**
+     * Unmaps the file, writable mappings are synchronized before.
+     **/
+    void unmap();
+
+    /**
+     * Writes the modified pages of a writable mapping back to the file.
+     *
+     * @return SUCCESS if successful, UNDEFINED_ERROR otherwise.
+     **/
+    err_t sync();
+
+    /**
+     * Gets the mapped data.
+     *
+     * @return pointer to the data, nullptr if no file is mapped.
+     **/
+    char * get_data() const;
+
+    /**
+     * Gets the number of mapped bytes.
+     *
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes() const;
+
+    /**
+     * Checks if the mapping is writable.
+     *
+     * @return true if writable, false otherwise.
+     **/
+    bool is_writable() const;
+
+    /**
+     * Requests the pages of the given memory range ahead of their use.
+     * The range is widened to full pages, the request is a hint and never blocks on I/O.
+     *
+     * @param i_ptr pointer to the first byte of the range.
+     * @param i_num_bytes number of bytes in the range.
+     **/
+    static void prefetch( void const * i_ptr,
+                          int64_t      i_num_bytes );
+};
+
+#endif
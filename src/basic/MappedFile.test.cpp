@@ -0,0 +1,49 @@
+#include "catch.hpp"
+#include "MappedFile.h"
+#include <cstdio>
+#include <string>
+
+TEST_CASE( "Writing and reading tensor data through memory-mapped files.", "[mapped_file]" ) {
+  using einsum_ir::basic::MappedFile;
+  using einsum_ir::basic::err_t;
+
+  std::string l_path = "einsum_ir_mapped_file.test.bin";
+  int64_t l_num_values = 3 * 1024 + 5;
+  int64_t l_num_bytes = l_num_values * sizeof(float);
+
+  // the writable mapping creates the file
+  {
+    MappedFile l_file;
+    REQUIRE( l_file.map( l_path, l_num_bytes, true ) == err_t::SUCCESS );
+    REQUIRE( l_file.is_writable() );
+    REQUIRE( l_file.get_num_bytes() == l_num_bytes );
+
+    float * l_data = (float *) l_file.get_data();
+    for( int64_t l_va = 0; l_va < l_num_values; l_va++ ) {
+      l_data[l_va] = l_va * 0.5f;
+    }
+    REQUIRE( l_file.sync() == err_t::SUCCESS );
+  }
+
+  MappedFile l_file;
+  REQUIRE( l_file.map( l_path, l_num_bytes, false ) == err_t::SUCCESS );
+  REQUIRE( !l_file.is_writable() );
+  REQUIRE( l_file.sync() == err_t::UNDEFINED_ERROR );
+
+  float const * l_data = (float const *) l_file.get_data();
+  MappedFile::prefetch( l_data + 1000,
+                        4096 );
+  for( int64_t l_va = 0; l_va < l_num_values; l_va++ ) {
+    REQUIRE( l_data[l_va] == l_va * 0.5f );
+  }
+
+  // read-only files have to hold the requested bytes
+  MappedFile l_file_large;
+  REQUIRE( l_file_large.map( l_path, l_num_bytes + 1, false ) == err_t::UNDEFINED_ERROR );
+  REQUIRE( l_file_large.get_data() == nullptr );
+  REQUIRE( l_file_large.map( l_path + ".missing", 4, false ) == err_t::UNDEFINED_ERROR );
+
+  l_file.unmap();
+  REQUIRE( l_file.get_data() == nullptr );
+  std::remove( l_path.c_str() );
+}
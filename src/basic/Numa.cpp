@@ -0,0 +1,307 @@
+#include "Numa.h"
+#include "Topology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  //! size of a page in bytes
+  constexpr int64_t g_num_bytes_page = 4096;
+
+  //! size of a 2 MiB huge page in bytes
+  constexpr int64_t g_num_bytes_page_2m = int64_t(1) << 21;
+
+  //! size of a 1 GiB huge page in bytes
+  constexpr int64_t g_num_bytes_page_1g = int64_t(1) << 30;
+
+  //! memory policy of the mbind system call which interleaves pages over the nodes
+  constexpr int g_mpol_interleave = 3;
+}
+
+einsum_ir::basic::Numa::placement_t einsum_ir::basic::Numa::get_placement() {
+  char * l_env = std::getenv( "EINSUM_IR_NUMA_PLACEMENT" );
+  if( l_env != nullptr && std::string( l_env ) == "INTERLEAVE" ) {
+    return placement_t::INTERLEAVE;
+  }
+  return placement_t::FIRST_TOUCH;
+}
+
+einsum_ir::basic::Numa::pages_t einsum_ir::basic::Numa::get_pages() {
+  char * l_env = std::getenv( "EINSUM_IR_HUGE_PAGES" );
+  if( l_env != nullptr ) {
+    std::string l_pages( l_env );
+    if(      l_pages == "THP" ) return pages_t::TRANSPARENT;
+    else if( l_pages == "2M"  ) return pages_t::HUGE_2M;
+    else if( l_pages == "1G"  ) return pages_t::HUGE_1G;
+  }
+  return pages_t::SMALL;
+}
+
+char const * einsum_ir::basic::Numa::to_string( pages_t i_pages ) {
+  if(      i_pages == pages_t::TRANSPARENT ) return "THP";
+  else if( i_pages == pages_t::HUGE_2M     ) return "2M";
+  else if( i_pages == pages_t::HUGE_1G     ) return "1G";
+  return "NONE";
+}
+
+int64_t einsum_ir::basic::Numa::get_num_bytes_mapped( int64_t i_num_bytes,
+                                                      pages_t i_pages ) {
+  int64_t l_num_bytes_page = g_num_bytes_page;
+  if(      i_pages == pages_t::HUGE_1G ) l_num_bytes_page = g_num_bytes_page_1g;
+  else if( i_pages != pages_t::SMALL   ) l_num_bytes_page = g_num_bytes_page_2m;
+
+  return ( (i_num_bytes + l_num_bytes_page - 1) / l_num_bytes_page ) * l_num_bytes_page;
+}
+
+bool einsum_ir::basic::Numa::get_pinning() {
+  char * l_env = std::getenv( "EINSUM_IR_PIN_THREADS" );
+  return l_env != nullptr && std::atoi( l_env ) != 0;
+}
+
+std::vector< int64_t > const & einsum_ir::basic::Numa::get_cpus() {
+  static std::vector< int64_t > s_cpus = [](){
+    std::vector< int64_t > const & l_cpus_ordered = Topology::get_instance().m_cpus_ordered;
+    std::vector< int64_t > l_cpus;
+
+#if defined(__linux__)
+    // respect restrictions of the process, e.g., through taskset or cgroups
+    cpu_set_t l_set;
+    CPU_ZERO( &l_set );
+    if( sched_getaffinity( 0, sizeof(l_set), &l_set ) == 0 ) {
+      for( std::size_t l_cp = 0; l_cp < l_cpus_ordered.size(); l_cp++ ) {
+        if(    l_cpus_ordered[l_cp] < CPU_SETSIZE
+            && CPU_ISSET( l_cpus_ordered[l_cp], &l_set ) ) {
+          l_cpus.push_back( l_cpus_ordered[l_cp] );
+        }
+      }
+    }
+#endif
+
+    if( l_cpus.size() == 0 ) {
+      l_cpus = l_cpus_ordered;
+    }
+    return l_cpus;
+  }();
+
+  return s_cpus;
+}
+
+int64_t einsum_ir::basic::Numa::get_num_nodes() {
+  return Topology::get_instance().m_numa_node_ids.size();
+}
+
+char * einsum_ir::basic::Numa::alloc( int64_t       i_num_bytes,
+                                      placement_t   i_placement,
+                                      pages_t     & io_pages ) {
+  if( i_num_bytes <= 0 ) {
+    io_pages = pages_t::SMALL;
+    return nullptr;
+  }
+
+#if defined(__linux__)
+  void * l_ptr = MAP_FAILED;
+  pages_t l_pages = io_pages;
+  while( true ) {
+    // huge pages are only used if the allocation spans at least one of them
+    int64_t l_num_bytes_page = get_num_bytes_mapped( 1, l_pages );
+    int64_t l_num_bytes_mapped = get_num_bytes_mapped( i_num_bytes, l_pages );
+
+    if( l_pages == pages_t::SMALL ) {
+      l_ptr = mmap( nullptr,
+                    l_num_bytes_mapped,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS,
+                    -1,
+                    0 );
+    }
+    else if(    i_num_bytes < l_num_bytes_page
+             || ( l_pages == pages_t::TRANSPARENT && !get_thp_enabled() ) ) {
+      l_ptr = MAP_FAILED;
+    }
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    else if( l_pages == pages_t::HUGE_1G || l_pages == pages_t::HUGE_2M ) {
+      int l_log_num_bytes_page = ( l_pages == pages_t::HUGE_1G ) ? 30 : 21;
+      l_ptr = mmap( nullptr,
+                    l_num_bytes_mapped,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | ( l_log_num_bytes_page << MAP_HUGE_SHIFT ),
+                    -1,
+                    0 );
+    }
+#endif
+#if defined(MADV_HUGEPAGE)
+    else if( l_pages == pages_t::TRANSPARENT ) {
+      // over-allocate and trim to obtain a mapping aligned to the huge page size
+      char * l_ptr_raw = (char *) mmap( nullptr,
+                                        l_num_bytes_mapped + l_num_bytes_page,
+                                        PROT_READ | PROT_WRITE,
+                                        MAP_PRIVATE | MAP_ANONYMOUS,
+                                        -1,
+                                        0 );
+      if( l_ptr_raw != MAP_FAILED ) {
+        int64_t l_offset = (uintptr_t) l_ptr_raw % l_num_bytes_page;
+        l_offset = l_offset ? l_num_bytes_page - l_offset : 0;
+        if( l_offset > 0 ) {
+          munmap( l_ptr_raw,
+                  l_offset );
+        }
+        munmap( l_ptr_raw + l_offset + l_num_bytes_mapped,
+                l_num_bytes_page - l_offset );
+        l_ptr = l_ptr_raw + l_offset;
+
+        if( madvise( l_ptr, l_num_bytes_mapped, MADV_HUGEPAGE ) != 0 ) {
+          munmap( l_ptr,
+                  l_num_bytes_mapped );
+          l_ptr = MAP_FAILED;
+        }
+      }
+    }
+#endif
+
+    if( l_ptr != MAP_FAILED || l_pages == pages_t::SMALL ) {
+      break;
+    }
+    l_pages = (pages_t) ( l_pages - 1 );
+  }
+
+  if( l_ptr == MAP_FAILED ) {
+    throw std::bad_alloc();
+  }
+  io_pages = l_pages;
+
+  std::vector< int64_t > const & l_node_ids = Topology::get_instance().m_numa_node_ids;
+  if( i_placement == placement_t::INTERLEAVE && l_node_ids.size() > 1 ) {
+    int64_t l_num_bits = 8 * sizeof(unsigned long);
+    int64_t l_max_node = 0;
+    for( std::size_t l_no = 0; l_no < l_node_ids.size(); l_no++ ) {
+      l_max_node = std::max( l_max_node, l_node_ids[l_no] );
+    }
+
+    std::vector< unsigned long > l_mask( l_max_node / l_num_bits + 1, 0 );
+    for( std::size_t l_no = 0; l_no < l_node_ids.size(); l_no++ ) {
+      l_mask[ l_node_ids[l_no] / l_num_bits ] |= 1UL << ( l_node_ids[l_no] % l_num_bits );
+    }
+
+    // the kernel reads one bit less than the given number of nodes
+    syscall( SYS_mbind,
+             l_ptr,
+             (unsigned long) get_num_bytes_mapped( i_num_bytes, l_pages ),
+             g_mpol_interleave,
+             l_mask.data(),
+             (unsigned long) ( l_mask.size() * l_num_bits + 1 ),
+             0 );
+  }
+
+  return (char *) l_ptr;
+#else
+  (void) i_placement;
+  io_pages = pages_t::SMALL;
+  return new char[i_num_bytes];
+#endif
+}
+
+char * einsum_ir::basic::Numa::alloc( int64_t     i_num_bytes,
+                                      placement_t i_placement ) {
+  pages_t l_pages = pages_t::SMALL;
+  return alloc( i_num_bytes,
+                i_placement,
+                l_pages );
+}
+
+void einsum_ir::basic::Numa::free( char    * i_ptr,
+                                   int64_t   i_num_bytes,
+                                   pages_t   i_pages ) {
+  if( i_ptr == nullptr ) {
+    return;
+  }
+
+#if defined(__linux__)
+  munmap( i_ptr,
+          get_num_bytes_mapped( i_num_bytes, i_pages ) );
+#else
+  (void) i_num_bytes;
+  (void) i_pages;
+  delete [] i_ptr;
+#endif
+}
+
+void einsum_ir::basic::Numa::touch( char    * io_ptr,
+                                    int64_t   i_num_bytes ) {
+  if( io_ptr == nullptr || i_num_bytes <= 0 ) {
+    return;
+  }
+
+  // first byte of every page and the last byte
+  for( int64_t l_by = 0; l_by < i_num_bytes; l_by += g_num_bytes_page ) {
+    io_ptr[l_by] = 0;
+  }
+  io_ptr[i_num_bytes - 1] = 0;
+}
+
+bool einsum_ir::basic::Numa::get_thp_enabled() {
+  static bool s_enabled = [](){
+    // the active mode is given in brackets, e.g., "always [madvise] never"
+    std::ifstream l_file( "/sys/kernel/mm/transparent_hugepage/enabled" );
+    std::string l_modes;
+    std::getline( l_file, l_modes );
+    return    l_modes.find( "[always]"  ) != std::string::npos
+           || l_modes.find( "[madvise]" ) != std::string::npos;
+  }();
+
+  return s_enabled;
+}
+
+int64_t einsum_ir::basic::Numa::get_num_bytes_huge( char const * i_ptr,
+                                                    int64_t      i_num_bytes ) {
+  uintptr_t l_first = (uintptr_t) i_ptr;
+  uintptr_t l_last  = l_first + i_num_bytes;
+  int64_t l_num_bytes_huge = 0;
+
+  // every mapping starts with a line "first-last perms ...", followed by its statistics
+  std::ifstream l_file( "/proc/self/smaps" );
+  std::string l_line;
+  bool l_overlap = false;
+  while( std::getline( l_file, l_line ) ) {
+    uintptr_t l_map_first = 0;
+    uintptr_t l_map_last = 0;
+    char l_dash = 0;
+    std::istringstream l_stream( l_line );
+    if(    l_stream >> std::hex >> l_map_first >> l_dash >> l_map_last
+        && l_dash == '-' ) {
+      l_overlap = l_map_first < l_last && l_first < l_map_last;
+    }
+    else if(    l_overlap
+             && l_line.compare( 0, 14, "AnonHugePages:" ) == 0 ) {
+      l_num_bytes_huge += std::atoll( l_line.c_str() + 14 ) * 1024;
+    }
+  }
+
+  return l_num_bytes_huge;
+}
+
+bool einsum_ir::basic::Numa::pin_thread( int64_t i_cpu ) {
+#if defined(__linux__)
+  if( i_cpu < 0 || i_cpu >= CPU_SETSIZE ) {
+    return false;
+  }
+
+  cpu_set_t l_set;
+  CPU_ZERO( &l_set );
+  CPU_SET( i_cpu, &l_set );
+
+  return sched_setaffinity( 0, sizeof(l_set), &l_set ) == 0;
+#else
+  (void) i_cpu;
+  return false;
+#endif
+}
@@ -0,0 +1,170 @@
+#ifndef EINSUM_IR_BASIC_NUMA
+#define EINSUM_IR_BASIC_NUMA
+
+#include <cstdint>
+#include <vector>
+
+namespace einsum_ir {
+  namespace basic {
+    class Numa;
+  }
+}
+
+/**
+ * NUMA-aware allocation with optional huge page backing, and thread pinning.
+ *
+ * Memory is mapped from the operating system without touching it,
+ * i.e., the pages are placed on the node of the thread which writes them first unless interleaving is requested.
+ * Interleaving and pinning are best effort and silently skipped on hosts without support.
+ * Huge pages are only used for allocations spanning at least one huge page,
+ * unavailable backings fall back to the next smaller one: 1 GiB, 2 MiB, transparent, base pages.
+ * Transparent huge pages are only reported if the kernel's THP mode permits them for the range;
+ * the kernel still decides on first touch which pages are backed by huge pages, see get_num_bytes_huge.
+ *
+ * The environment variable EINSUM_IR_NUMA_PLACEMENT (FIRST_TOUCH or INTERLEAVE) selects the placement of intermediate tensors,
+ * EINSUM_IR_HUGE_PAGES (NONE, THP, 2M or 1G) their page backing and the one of the contraction scratch memory.
+ * EINSUM_IR_PIN_THREADS=1 pins the workers of the thread pool to the cpus in placement order.
+ **/
+class einsum_ir::basic::Numa {
+  public:
+    //! placement of memory pages
+    typedef enum {
+      FIRST_TOUCH = 0, // node of the first writing thread
+      INTERLEAVE  = 1  // round-robin over all nodes
+    } placement_t;
+
+    //! backing of memory, ordered by the size of the pages
+    typedef enum {
+      SMALL       = 0, // base pages of the operating system
+      TRANSPARENT = 1, // transparent huge pages enabled for the range through madvise
+      HUGE_2M     = 2, // explicit 2 MiB huge pages
+      HUGE_1G     = 3  // explicit 1 GiB huge pages
+    } pages_t;
+
+    /**
+     * Gets the placement of intermediate tensors.
+     * Respects the environment variable EINSUM_IR_NUMA_PLACEMENT if set.
+     *
+     * @return placement.
+     **/
+    static placement_t get_placement();
+
+    /**
+     * Gets the requested page backing of intermediate tensors and scratch memory.
+     * Respects the environment variable EINSUM_IR_HUGE_PAGES if set.
+     *
+     * @return page backing.
+     **/
+    static pages_t get_pages();
+
+    /**
+     * Gets the name of a page backing.
+     *
+     * @param i_pages page backing.
+     * @return name.
+     **/
+    static char const * to_string( pages_t i_pages );
+
+    /**
+     * Gets the number of bytes mapped for an allocation with the given backing.
+     *
+     * @param i_num_bytes number of requested bytes.
+     * @param i_pages page backing.
+     * @return number of bytes rounded up to the page size.
+     **/
+    static int64_t get_num_bytes_mapped( int64_t i_num_bytes,
+                                         pages_t i_pages );
+
+    /**
+     * Checks if worker threads are pinned to cpus.
+     * Respects the environment variable EINSUM_IR_PIN_THREADS if set.
+     *
+     * @return true if threads are pinned, false otherwise.
+     **/
+    static bool get_pinning();
+
+    /**
+     * Gets the cpus available to the process in placement order.
+     * Thread i is pinned to cpu i modulo the number of cpus.
+     *
+     * @return ids of the cpus.
+     **/
+    static std::vector< int64_t > const & get_cpus();
+
+    /**
+     * Gets the number of NUMA nodes of the host.
+     *
+     * @return number of nodes (always >= 1).
+     **/
+    static int64_t get_num_nodes();
+
+    /**
+     * Allocates page-aligned memory which was not touched before.
+     *
+     * @param i_num_bytes number of bytes.
+     * @param i_placement placement of the pages.
+     * @param io_pages requested page backing, set to the obtained one.
+     * @return pointer to the memory, throws std::bad_alloc on failure.
+     **/
+    static char * alloc( int64_t       i_num_bytes,
+                         placement_t   i_placement,
+                         pages_t     & io_pages );
+
+    /**
+     * Allocates page-aligned memory backed by base pages which was not touched before.
+     *
+     * @param i_num_bytes number of bytes.
+     * @param i_placement placement of the pages.
+     * @return pointer to the memory, throws std::bad_alloc on failure.
+     **/
+    static char * alloc( int64_t     i_num_bytes,
+                         placement_t i_placement );
+
+    /**
+     * Frees memory allocated through alloc.
+     *
+     * @param i_ptr pointer to the memory.
+     * @param i_num_bytes number of bytes which were requested.
+     * @param i_pages obtained page backing.
+     **/
+    static void free( char    * i_ptr,
+                      int64_t   i_num_bytes,
+                      pages_t   i_pages = pages_t::SMALL );
+
+    /**
+     * Touches every page of the given memory by the calling thread.
+     *
+     * @param io_ptr pointer to the memory.
+     * @param i_num_bytes number of bytes.
+     **/
+    static void touch( char    * io_ptr,
+                       int64_t   i_num_bytes );
+
+    /**
+     * Checks if the kernel backs ranges advised through madvise with transparent huge pages.
+     *
+     * @return true if the THP mode is always or madvise, false otherwise.
+     **/
+    static bool get_thp_enabled();
+
+    /**
+     * Gets the number of bytes of the mappings covering the given memory which are backed by transparent huge pages.
+     * Only touched pages are backed, i.e., the result reflects the state at the time of the call.
+     *
+     * @param i_ptr pointer to the memory.
+     * @param i_num_bytes number of bytes.
+     * @return number of bytes backed by huge pages, 0 if unknown.
+     **/
+    static int64_t get_num_bytes_huge( char const * i_ptr,
+                                       int64_t      i_num_bytes );
+
+    /**
+     * Pins the calling thread to a cpu.
+     *
+     * @param i_cpu id of the cpu.
+     * @return true if the thread was pinned, false otherwise.
+     **/
+    static bool pin_thread( int64_t i_cpu );
+};
+
+#endif
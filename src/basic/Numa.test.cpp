@@ -0,0 +1,111 @@
+#include "catch.hpp"
+#include "Numa.h"
+#include <set>
+#include <string>
+#include <thread>
+
+TEST_CASE( "Allocation of untouched memory with NUMA placements.", "[numa]" ) {
+  using einsum_ir::basic::Numa;
+
+  REQUIRE( Numa::get_num_nodes() >= 1 );
+
+  for( Numa::placement_t l_placement : { Numa::FIRST_TOUCH,
+                                         Numa::INTERLEAVE } ) {
+    int64_t l_num_bytes = 3 * 4096 + 17;
+    char * l_ptr = Numa::alloc( l_num_bytes,
+                                l_placement );
+    REQUIRE( l_ptr != nullptr );
+
+    Numa::touch( l_ptr,
+                 l_num_bytes );
+    for( int64_t l_by = 0; l_by < l_num_bytes; l_by++ ) {
+      l_ptr[l_by] = (char) ( l_by % 101 );
+    }
+    for( int64_t l_by = 0; l_by < l_num_bytes; l_by++ ) {
+      REQUIRE( l_ptr[l_by] == (char) ( l_by % 101 ) );
+    }
+
+    Numa::free( l_ptr,
+                l_num_bytes );
+  }
+
+  REQUIRE( Numa::alloc( 0, Numa::FIRST_TOUCH ) == nullptr );
+}
+
+TEST_CASE( "Allocation of memory backed by huge pages.", "[numa]" ) {
+  using einsum_ir::basic::Numa;
+
+  REQUIRE( Numa::get_num_bytes_mapped( 1,             Numa::SMALL       ) == 4096 );
+  REQUIRE( Numa::get_num_bytes_mapped( 4096,          Numa::SMALL       ) == 4096 );
+  REQUIRE( Numa::get_num_bytes_mapped( 3 << 20,       Numa::TRANSPARENT ) == 4 << 20 );
+  REQUIRE( Numa::get_num_bytes_mapped( 2 << 20,       Numa::HUGE_2M     ) == 2 << 20 );
+  REQUIRE( Numa::get_num_bytes_mapped( (1 << 30) + 1, Numa::HUGE_1G     ) == int64_t(2) << 30 );
+
+  for( Numa::pages_t l_pages_requested : { Numa::TRANSPARENT,
+                                           Numa::HUGE_2M,
+                                           Numa::HUGE_1G } ) {
+    // the obtained backing depends on the configuration of the host
+    int64_t l_num_bytes = 5 * 1024 * 1024 + 3;
+    Numa::pages_t l_pages = l_pages_requested;
+    char * l_ptr = Numa::alloc( l_num_bytes,
+                                Numa::FIRST_TOUCH,
+                                l_pages );
+    REQUIRE( l_ptr != nullptr );
+    REQUIRE( l_pages <= l_pages_requested );
+    REQUIRE( l_pages != Numa::HUGE_1G );
+    if( l_pages != Numa::SMALL ) {
+      REQUIRE( (uintptr_t) l_ptr % ( 2 << 20 ) == 0 );
+    }
+
+    if( l_pages == Numa::TRANSPARENT ) {
+      REQUIRE( Numa::get_thp_enabled() );
+    }
+
+    for( int64_t l_by = 0; l_by < l_num_bytes; l_by += 1024 ) {
+      l_ptr[l_by] = 7;
+    }
+    REQUIRE( l_ptr[1024] == 7 );
+
+    // touched transparent huge pages are only backed if the kernel could provide them
+    REQUIRE( Numa::get_num_bytes_huge( l_ptr,
+                                       l_num_bytes ) >= 0 );
+
+    Numa::free( l_ptr,
+                l_num_bytes,
+                l_pages );
+  }
+
+  // allocations smaller than a huge page use base pages
+  Numa::pages_t l_pages = Numa::HUGE_2M;
+  char * l_ptr = Numa::alloc( 4096,
+                              Numa::INTERLEAVE,
+                              l_pages );
+  REQUIRE( l_pages == Numa::SMALL );
+  Numa::free( l_ptr,
+              4096,
+              l_pages );
+
+  REQUIRE( std::string( Numa::to_string( Numa::HUGE_2M ) ) == "2M" );
+}
+
+TEST_CASE( "Placement order and pinning of threads.", "[numa]" ) {
+  using einsum_ir::basic::Numa;
+
+  std::vector< int64_t > const & l_cpus = Numa::get_cpus();
+  REQUIRE( l_cpus.size() > 0 );
+  REQUIRE( std::set< int64_t >( l_cpus.begin(), l_cpus.end() ).size() == l_cpus.size() );
+
+  // pin a separate thread to keep the affinity of the test runner
+  bool l_pinned = false;
+  std::thread l_thread( [&](){
+    l_pinned = Numa::pin_thread( l_cpus.back() );
+  } );
+  l_thread.join();
+#if defined(__linux__)
+  REQUIRE( l_pinned );
+#else
+  REQUIRE( !l_pinned );
+#endif
+
+  REQUIRE( !Numa::pin_thread( -1 ) );
+}
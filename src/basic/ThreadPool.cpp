@@ -0,0 +1,225 @@
+#include "ThreadPool.h"
+#include "Numa.h"
+#include <cstdlib>
+#include <vector>
+
+namespace {
+  //! ids of the workers claimed by the current call of the calling thread
+  thread_local std::vector< int64_t > tl_claimed;
+
+  /**
+   * Gets the default number of spin iterations before idle workers park.
+   * Respects the environment variable EINSUM_IR_POOL_SPINS if set.
+   *
+   * @return number of spin iterations.
+   **/
+  int64_t get_num_spins_default() {
+    char * l_env_spins = std::getenv( "EINSUM_IR_POOL_SPINS" );
+    if( l_env_spins != nullptr ) {
+      return std::atoll( l_env_spins );
+    }
+    return 1 << 14;
+  }
+
+  /**
+   * Hints the processor that the calling thread is in a spin-wait loop.
+   **/
+  inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile( "yield" ::: "memory" );
+#endif
+  }
+}
+
+einsum_ir::basic::ThreadPool::~ThreadPool() {
+  stop();
+}
+
+einsum_ir::basic::ThreadPool & einsum_ir::basic::ThreadPool::get_instance() {
+  static ThreadPool l_pool;
+  static bool l_initialized = ( l_pool.init( get_num_threads_hardware(),
+                                             get_num_spins_default() ), true );
+  (void) l_initialized;
+
+  return l_pool;
+}
+
+int64_t einsum_ir::basic::ThreadPool::get_num_threads_hardware() {
+  char * l_env_threads = std::getenv( "EINSUM_IR_NUM_THREADS" );
+  if( l_env_threads != nullptr ) {
+    int64_t l_num_threads = std::atoll( l_env_threads );
+    if( l_num_threads > 0 ) {
+      return l_num_threads;
+    }
+  }
+
+  int64_t l_num_threads = std::thread::hardware_concurrency();
+
+  return l_num_threads > 0 ? l_num_threads : 1;
+}
+
+void einsum_ir::basic::ThreadPool::init( int64_t i_num_threads,
+                                         int64_t i_num_spins ) {
+  stop();
+
+  m_num_workers = i_num_threads > 1 ? i_num_threads - 1 : 0;
+  m_num_spins   = i_num_spins   > 0 ? i_num_spins       : 0;
+
+  // spinning only pays off if every thread has its own core
+  int64_t l_num_cores = std::thread::hardware_concurrency();
+  if( l_num_cores > 0 && i_num_threads > l_num_cores ) {
+    m_num_spins = 0;
+  }
+
+  start();
+}
+
+int64_t einsum_ir::basic::ThreadPool::get_num_threads() const {
+  return m_num_workers + 1;
+}
+
+void einsum_ir::basic::ThreadPool::start() {
+  m_stop.store( false );
+
+  m_cpus_pinned.clear();
+  if( Numa::get_pinning() ) {
+    m_cpus_pinned = Numa::get_cpus();
+  }
+
+  m_workers.reset( new Worker[m_num_workers] );
+  for( int64_t l_wo = 0; l_wo < m_num_workers; l_wo++ ) {
+    m_workers[l_wo].m_thread = std::thread( &ThreadPool::worker_loop,
+                                            this,
+                                            l_wo );
+  }
+}
+
+void einsum_ir::basic::ThreadPool::stop() {
+  if( !m_workers ) {
+    return;
+  }
+
+  m_stop.store( true );
+  for( int64_t l_wo = 0; l_wo < m_num_workers; l_wo++ ) {
+    std::lock_guard< std::mutex > l_lock( m_workers[l_wo].m_mutex );
+    m_workers[l_wo].m_cond.notify_one();
+  }
+
+  for( int64_t l_wo = 0; l_wo < m_num_workers; l_wo++ ) {
+    if( m_workers[l_wo].m_thread.joinable() ) {
+      m_workers[l_wo].m_thread.join();
+    }
+  }
+
+  m_workers.reset();
+}
+
+void einsum_ir::basic::ThreadPool::run_participant( Job const & i_job,
+                                                    int64_t     i_participant ) {
+  for( int64_t l_id = i_participant; l_id < i_job.m_num_tasks; l_id += i_job.m_num_participants ) {
+    i_job.m_work( i_job.m_context,
+                  l_id );
+  }
+}
+
+void einsum_ir::basic::ThreadPool::worker_loop( int64_t i_worker_id ) {
+  Worker & l_worker = m_workers[i_worker_id];
+  uint64_t l_job_id_seen = 0;
+
+  // the calling thread is participant 0
+  if( m_cpus_pinned.size() > 0 ) {
+    Numa::pin_thread( m_cpus_pinned[ (i_worker_id + 1) % m_cpus_pinned.size() ] );
+  }
+
+  while( true ) {
+    // spin, then park until a new job arrives
+    uint64_t l_job_id = l_worker.m_job_id.load( std::memory_order_acquire );
+    int64_t l_spin = 0;
+    while(    l_job_id == l_job_id_seen
+           && m_stop.load( std::memory_order_relaxed ) == false ) {
+      if( l_spin < m_num_spins ) {
+        cpu_relax();
+        l_spin++;
+      }
+      else {
+        std::unique_lock< std::mutex > l_lock( l_worker.m_mutex );
+        l_worker.m_parked.store( true );
+        l_worker.m_cond.wait( l_lock, [&](){
+          return    l_worker.m_job_id.load() != l_job_id_seen
+                 || m_stop.load();
+        } );
+        l_worker.m_parked.store( false, std::memory_order_relaxed );
+      }
+      l_job_id = l_worker.m_job_id.load( std::memory_order_acquire );
+    }
+
+    if( l_job_id == l_job_id_seen ) {
+      break;
+    }
+    l_job_id_seen = l_job_id;
+
+    Job * l_job = l_worker.m_job;
+    run_participant( *l_job,
+                     l_worker.m_participant );
+
+    // release the worker before signaling completion, the job may be destroyed afterwards
+    l_worker.m_busy.store( false, std::memory_order_release );
+    l_job->m_num_done.fetch_add( 1, std::memory_order_release );
+  }
+}
+
+void einsum_ir::basic::ThreadPool::execute( int64_t   i_num_threads,
+                                            work_t    i_work,
+                                            void    * i_context ) {
+  Job l_job;
+  l_job.m_work      = i_work;
+  l_job.m_context   = i_context;
+  l_job.m_num_tasks = i_num_threads;
+
+  // claim idle workers
+  tl_claimed.clear();
+  for( int64_t l_wo = 0; l_wo < m_num_workers; l_wo++ ) {
+    if( (int64_t) tl_claimed.size() + 1 >= i_num_threads ) {
+      break;
+    }
+    bool l_idle = false;
+    if(    m_workers[l_wo].m_busy.load( std::memory_order_relaxed ) == false
+        && m_workers[l_wo].m_busy.compare_exchange_strong( l_idle,
+                                                           true,
+                                                           std::memory_order_acquire ) ) {
+      tl_claimed.push_back( l_wo );
+    }
+  }
+  int64_t l_num_claimed = tl_claimed.size();
+  l_job.m_num_participants = l_num_claimed + 1;
+
+  // assign job and wake up claimed workers
+  for( int64_t l_cl = 0; l_cl < l_num_claimed; l_cl++ ) {
+    Worker & l_worker = m_workers[ tl_claimed[l_cl] ];
+    l_worker.m_job         = &l_job;
+    l_worker.m_participant = l_cl + 1;
+    l_worker.m_job_id.fetch_add( 1 );
+    if( l_worker.m_parked.load() ) {
+      std::lock_guard< std::mutex > l_lock( l_worker.m_mutex );
+      l_worker.m_cond.notify_one();
+    }
+  }
+
+  // participate as thread 0
+  run_participant( l_job,
+                   0 );
+
+  // wait for workers
+  int64_t l_spin = 0;
+  while( l_job.m_num_done.load( std::memory_order_acquire ) < l_num_claimed ) {
+    if( l_spin < m_num_spins ) {
+      cpu_relax();
+      l_spin++;
+    }
+    else {
+      std::this_thread::yield();
+    }
+  }
+}
@@ -0,0 +1,168 @@
+#ifndef EINSUM_IR_BASIC_THREAD_POOL
+#define EINSUM_IR_BASIC_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace einsum_ir {
+  namespace basic {
+    class ThreadPool;
+  }
+}
+
+/**
+ * Persistent pool of worker threads.
+ *
+ * Workers are created once and wait for work by spinning for a configurable number of
+ * iterations before parking on a condition variable.
+ * A call claims idle workers in the order of their ids and participates in the execution as thread 0.
+ * Thread ids are statically mapped to participants and every worker is released before its call returns,
+ * i.e., consecutive calls with the same number of threads execute every id on the same thread
+ * as long as no other call occupies workers at the same time.
+ * Concurrent and nested calls share the workers, every call uses the workers which are idle at
+ * the time of the call. Such calls get no stable mapping: workers claimed elsewhere are skipped
+ * and their ids move to other participants, e.g., memory first touched by an id may be owned by another thread.
+ * If pinning is enabled (EINSUM_IR_PIN_THREADS=1), worker i is pinned to cpu i+1 in placement order,
+ * the calling thread keeps its affinity.
+ **/
+class einsum_ir::basic::ThreadPool {
+  public:
+    //! type of the work function: context and thread id
+    typedef void (* work_t)( void    * i_context,
+                             int64_t   i_thread_id );
+
+  private:
+    //! job of a single call to execute
+    struct Job {
+      //! work function
+      work_t m_work = nullptr;
+      //! context passed to the work function
+      void * m_context = nullptr;
+      //! number of thread ids
+      int64_t m_num_tasks = 0;
+      //! number of participants, including the calling thread
+      int64_t m_num_participants = 0;
+      //! number of workers which finished the job
+      std::atomic< int64_t > m_num_done{0};
+    };
+
+    //! state of a single worker, padded to avoid false sharing
+    struct alignas(64) Worker {
+      //! thread of the worker
+      std::thread m_thread;
+      //! id of the last job assigned to the worker
+      std::atomic< uint64_t > m_job_id{0};
+      //! true if the worker is claimed by a call
+      std::atomic< bool > m_busy{false};
+      //! true if the worker is parked on the condition variable
+      std::atomic< bool > m_parked{false};
+      //! job assigned to the worker
+      Job * m_job = nullptr;
+      //! participant id of the worker in the assigned job
+      int64_t m_participant = 0;
+      //! mutex guarding the condition variable
+      std::mutex m_mutex;
+      //! condition variable used for parking
+      std::condition_variable m_cond;
+    };
+
+    //! number of worker threads (excluding the calling thread)
+    int64_t m_num_workers = 0;
+
+    //! number of spin iterations before a worker parks
+    int64_t m_num_spins = 0;
+
+    //! cpus of the threads in placement order, empty if the workers are not pinned
+    std::vector< int64_t > m_cpus_pinned;
+
+    //! workers of the pool
+    std::unique_ptr< Worker[] > m_workers;
+
+    //! true if the pool is shutting down
+    std::atomic< bool > m_stop{false};
+
+    /**
+     * Main loop of a worker.
+     *
+     * @param i_worker_id id of the worker.
+     **/
+    void worker_loop( int64_t i_worker_id );
+
+    /**
+     * Executes all thread ids of a job which are assigned to the given participant.
+     *
+     * @param i_job job.
+     * @param i_participant id of the participant.
+     **/
+    static void run_participant( Job const & i_job,
+                                 int64_t     i_participant );
+
+    /**
+     * Starts the worker threads.
+     **/
+    void start();
+
+    /**
+     * Stops and joins the worker threads.
+     **/
+    void stop();
+
+  public:
+    /**
+     * Destructor.
+     **/
+    ~ThreadPool();
+
+    /**
+     * Gets the process-wide pool.
+     * The pool is initialized on first use with all available threads.
+     *
+     * @return thread pool.
+     **/
+    static ThreadPool & get_instance();
+
+    /**
+     * Gets the number of hardware threads.
+     * Respects the environment variable EINSUM_IR_NUM_THREADS if set.
+     *
+     * @return number of threads (always >= 1).
+     **/
+    static int64_t get_num_threads_hardware();
+
+    /**
+     * (Re-)initializes the pool.
+     * Must not be called concurrently with execute.
+     * Spinning is disabled if the number of threads exceeds the number of hardware threads.
+     *
+     * @param i_num_threads total number of threads, including the calling thread.
+     * @param i_num_spins number of spin iterations before idle workers park.
+     **/
+    void init( int64_t i_num_threads,
+               int64_t i_num_spins );
+
+    /**
+     * Gets the total number of threads of the pool, including the calling thread.
+     *
+     * @return number of threads.
+     **/
+    int64_t get_num_threads() const;
+
+    /**
+     * Executes the work function once for every thread id in [0, i_num_threads).
+     * The ids are executed sequentially by the calling thread if no worker is idle.
+     *
+     * @param i_num_threads number of thread ids.
+     * @param i_work work function.
+     * @param i_context context which is passed to the work function.
+     **/
+    void execute( int64_t   i_num_threads,
+                  work_t    i_work,
+                  void    * i_context );
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include "ThreadPool.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE( "Every thread id is executed exactly once by the thread pool.", "[thread_pool]" ) {
+  einsum_ir::basic::ThreadPool l_pool;
+  l_pool.init( 4, 128 );
+  REQUIRE( l_pool.get_num_threads() == 4 );
+
+  // fewer, equal and more ids than threads
+  for( int64_t l_num_ids : { 1, 3, 4, 17 } ) {
+    std::vector< std::atomic< int64_t > > l_counts( l_num_ids );
+    for( int64_t l_id = 0; l_id < l_num_ids; l_id++ ) {
+      l_counts[l_id] = 0;
+    }
+
+    for( int64_t l_re = 0; l_re < 100; l_re++ ) {
+      l_pool.execute( l_num_ids,
+                      []( void * i_context, int64_t i_thread_id ) {
+                        std::vector< std::atomic< int64_t > > * l_counts = static_cast< std::vector< std::atomic< int64_t > > * >( i_context );
+                        (*l_counts)[i_thread_id]++;
+                      },
+                      &l_counts );
+    }
+
+    for( int64_t l_id = 0; l_id < l_num_ids; l_id++ ) {
+      REQUIRE( l_counts[l_id] == 100 );
+    }
+  }
+}
+
+TEST_CASE( "Consecutive calls of the thread pool execute every thread id on the same thread.", "[thread_pool]" ) {
+  einsum_ir::basic::ThreadPool l_pool;
+  l_pool.init( 4, 0 );
+
+  std::vector< std::thread::id > l_ids_first( 6 );
+  std::vector< std::thread::id > l_ids( 6 );
+  l_pool.execute( 6,
+                  []( void * i_context, int64_t i_thread_id ) {
+                    (*static_cast< std::vector< std::thread::id > * >( i_context ))[i_thread_id] = std::this_thread::get_id();
+                  },
+                  &l_ids_first );
+
+  for( int64_t l_re = 0; l_re < 20; l_re++ ) {
+    l_pool.execute( 6,
+                    []( void * i_context, int64_t i_thread_id ) {
+                      (*static_cast< std::vector< std::thread::id > * >( i_context ))[i_thread_id] = std::this_thread::get_id();
+                    },
+                    &l_ids );
+    REQUIRE( l_ids == l_ids_first );
+  }
+
+  // ids 0 and 4 belong to the calling thread
+  REQUIRE( l_ids_first[0] == std::this_thread::get_id() );
+  REQUIRE( l_ids_first[4] == std::this_thread::get_id() );
+  REQUIRE( l_ids_first[1] != std::this_thread::get_id() );
+}
+
+TEST_CASE( "Nested calls of the thread pool execute every thread id exactly once.", "[thread_pool]" ) {
+  einsum_ir::basic::ThreadPool l_pool;
+  l_pool.init( 3, 0 );
+
+  struct context {
+    einsum_ir::basic::ThreadPool * pool;
+    std::atomic< int64_t > count;
+  } l_context;
+  l_context.pool = &l_pool;
+  l_context.count = 0;
+
+  l_pool.execute( 3,
+                  []( void * i_context, int64_t ) {
+                    context * l_context = static_cast< context * >( i_context );
+                    l_context->pool->execute( 5,
+                                              []( void * i_context_inner, int64_t ) {
+                                                static_cast< context * >( i_context_inner )->count++;
+                                              },
+                                              l_context );
+                  },
+                  &l_context );
+
+  REQUIRE( l_context.count == 15 );
+}
+
+TEST_CASE( "Concurrent calls of the thread pool share the workers.", "[thread_pool]" ) {
+  einsum_ir::basic::ThreadPool l_pool;
+  l_pool.init( 4, 16 );
+
+  std::atomic< int64_t > l_counts[2];
+  l_counts[0] = 0;
+  l_counts[1] = 0;
+
+  std::vector< std::thread > l_callers;
+  for( int64_t l_ca = 0; l_ca < 2; l_ca++ ) {
+    l_callers.push_back( std::thread( [&l_pool, &l_counts, l_ca](){
+      for( int64_t l_re = 0; l_re < 100; l_re++ ) {
+        l_pool.execute( 4,
+                        []( void * i_context, int64_t ) {
+                          (*static_cast< std::atomic< int64_t > * >( i_context ))++;
+                        },
+                        &l_counts[l_ca] );
+      }
+    } ) );
+  }
+  for( std::size_t l_ca = 0; l_ca < l_callers.size(); l_ca++ ) {
+    l_callers[l_ca].join();
+  }
+
+  REQUIRE( l_counts[0] == 400 );
+  REQUIRE( l_counts[1] == 400 );
+}
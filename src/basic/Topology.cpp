@@ -0,0 +1,351 @@
+#include "Topology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+einsum_ir::basic::Topology const & einsum_ir::basic::Topology::get_instance() {
+  static Topology s_topology = [](){
+    Topology l_topology;
+    l_topology.probe();
+
+    char const * l_envs[3] = { "EINSUM_IR_L1_CACHE_BYTES",
+                               "EINSUM_IR_L2_CACHE_BYTES",
+                               "EINSUM_IR_L3_CACHE_BYTES" };
+    int64_t * l_sizes[3] = { &l_topology.m_l1_cache_size,
+                             &l_topology.m_l2_cache_size,
+                             &l_topology.m_l3_cache_size };
+    for( int64_t l_ca = 0; l_ca < 3; l_ca++ ) {
+      char * l_env = std::getenv( l_envs[l_ca] );
+      if( l_env != nullptr ) {
+        *l_sizes[l_ca] = std::max< int64_t >( 0, std::atoll( l_env ) );
+      }
+    }
+
+    return l_topology;
+  }();
+
+  return s_topology;
+}
+
+int64_t einsum_ir::basic::Topology::parse_size( std::string const & i_size ) {
+  std::istringstream l_stream( i_size );
+  int64_t l_size = 0;
+  if( !( l_stream >> l_size ) || l_size < 0 ) {
+    return 0;
+  }
+
+  char l_unit = 0;
+  if( l_stream >> l_unit ) {
+    if(      l_unit == 'K' || l_unit == 'k' ) l_size *= 1024;
+    else if( l_unit == 'M' || l_unit == 'm' ) l_size *= 1024 * 1024;
+    else if( l_unit == 'G' || l_unit == 'g' ) l_size *= 1024 * 1024 * 1024;
+    else                                      return 0;
+  }
+
+  return l_size;
+}
+
+int64_t einsum_ir::basic::Topology::count_cpus( std::string const & i_list ) {
+  return parse_cpus( i_list ).size();
+}
+
+std::vector< int64_t > einsum_ir::basic::Topology::parse_cpus( std::string const & i_list ) {
+  std::vector< int64_t > l_cpus;
+
+  std::istringstream l_stream( i_list );
+  std::string l_range;
+  while( std::getline( l_stream, l_range, ',' ) ) {
+    if( l_range.find_first_not_of( " \n" ) == std::string::npos ) {
+      continue;
+    }
+
+    int64_t l_first = 0;
+    int64_t l_last = 0;
+    char l_sep = 0;
+    std::istringstream l_range_stream( l_range );
+    if( !( l_range_stream >> l_first ) || l_first < 0 ) {
+      return {};
+    }
+    l_last = l_first;
+    if( l_range_stream >> l_sep ) {
+      if( l_sep != '-' || !( l_range_stream >> l_last ) ) {
+        return {};
+      }
+    }
+    if( l_last < l_first ) {
+      return {};
+    }
+    for( int64_t l_cpu = l_first; l_cpu <= l_last; l_cpu++ ) {
+      l_cpus.push_back( l_cpu );
+    }
+  }
+
+  return l_cpus;
+}
+
+bool einsum_ir::basic::Topology::probe_sysfs() {
+  std::string l_path_cpu = "/sys/devices/system/cpu/";
+
+  std::ifstream l_online( l_path_cpu + "online" );
+  std::string l_list;
+  if( l_online >> l_list ) {
+    m_num_cpus = count_cpus( l_list );
+  }
+
+  // sizes and number of sharing cpus of the L1 data, L2 and L3 caches
+  int64_t l_sizes[3] = { 0, 0, 0 };
+  int64_t l_num_sharing[3] = { 1, 1, 1 };
+  for( int64_t l_id = 0; ; l_id++ ) {
+    std::string l_path = l_path_cpu + "cpu0/cache/index" + std::to_string( l_id ) + "/";
+
+    std::ifstream l_file_level( l_path + "level" );
+    int64_t l_level = 0;
+    if( !( l_file_level >> l_level ) ) {
+      break;
+    }
+
+    std::ifstream l_file_type( l_path + "type" );
+    std::string l_type;
+    l_file_type >> l_type;
+    if(    ( l_type != "Data" && l_type != "Unified" )
+        || l_level < 1
+        || l_level > 3 ) {
+      continue;
+    }
+
+    std::ifstream l_file_size( l_path + "size" );
+    std::string l_size;
+    l_file_size >> l_size;
+
+    std::ifstream l_file_shared( l_path + "shared_cpu_list" );
+    std::string l_shared;
+    l_file_shared >> l_shared;
+
+    l_sizes[l_level-1] = parse_size( l_size );
+    l_num_sharing[l_level-1] = std::max< int64_t >( 1, count_cpus( l_shared ) );
+  }
+
+  if( l_sizes[0] == 0 && l_sizes[1] == 0 ) {
+    return false;
+  }
+
+  // the L1 cache is shared by the hardware threads of a core
+  int64_t l_num_threads_core = l_num_sharing[0];
+  int64_t l_num_cores_l2 = std::max< int64_t >( 1, l_num_sharing[1] / l_num_threads_core );
+
+  m_l1_cache_size = l_sizes[0];
+  m_l2_cache_size = l_sizes[1] / l_num_cores_l2;
+  m_l3_cache_size = l_sizes[2];
+  if( m_num_cpus > 0 ) {
+    m_num_cores = std::max< int64_t >( 1, m_num_cpus / l_num_threads_core );
+  }
+
+  return true;
+}
+
+bool einsum_ir::basic::Topology::probe_cpuid() {
+#if defined(__x86_64__) || defined(__i386__)
+  // deterministic cache parameters: leaf 4 on Intel, leaf 0x8000001D on AMD
+  unsigned int l_leaves[2] = { 4, 0x8000001D };
+
+  for( int64_t l_le = 0; l_le < 2; l_le++ ) {
+    unsigned int l_max_leaf = __get_cpuid_max( l_leaves[l_le] & 0x80000000, nullptr );
+    if( l_max_leaf < l_leaves[l_le] ) {
+      continue;
+    }
+
+    int64_t l_sizes[3] = { 0, 0, 0 };
+    int64_t l_num_sharing[3] = { 1, 1, 1 };
+    for( unsigned int l_sub = 0; l_sub < 16; l_sub++ ) {
+      unsigned int l_eax = 0, l_ebx = 0, l_ecx = 0, l_edx = 0;
+      __cpuid_count( l_leaves[l_le], l_sub, l_eax, l_ebx, l_ecx, l_edx );
+
+      unsigned int l_type = l_eax & 0x1F;
+      if( l_type == 0 ) {
+        break;
+      }
+      unsigned int l_level = (l_eax >> 5) & 0x7;
+      // data or unified caches
+      if( l_type == 2 || l_level < 1 || l_level > 3 ) {
+        continue;
+      }
+
+      int64_t l_ways       = ( (l_ebx >> 22) & 0x3FF ) + 1;
+      int64_t l_partitions = ( (l_ebx >> 12) & 0x3FF ) + 1;
+      int64_t l_line_size  = (  l_ebx        & 0xFFF ) + 1;
+      int64_t l_sets       = static_cast< int64_t >( l_ecx ) + 1;
+
+      l_sizes[l_level-1] = l_ways * l_partitions * l_line_size * l_sets;
+      l_num_sharing[l_level-1] = ( (l_eax >> 14) & 0xFFF ) + 1;
+    }
+
+    if( l_sizes[0] == 0 && l_sizes[1] == 0 ) {
+      continue;
+    }
+
+    int64_t l_num_threads_core = l_num_sharing[0];
+    int64_t l_num_cores_l2 = std::max< int64_t >( 1, l_num_sharing[1] / l_num_threads_core );
+
+    m_l1_cache_size = l_sizes[0];
+    m_l2_cache_size = l_sizes[1] / l_num_cores_l2;
+    m_l3_cache_size = l_sizes[2];
+    m_num_cpus = std::thread::hardware_concurrency();
+    m_num_cores = std::max< int64_t >( 1, m_num_cpus / l_num_threads_core );
+
+    return true;
+  }
+#endif
+
+  return false;
+}
+
+bool einsum_ir::basic::Topology::probe_sysctl() {
+#if defined(__APPLE__)
+  auto l_get = []( char const * i_name ) -> int64_t {
+    int64_t l_value = 0;
+    size_t l_size = sizeof(l_value);
+    if( sysctlbyname( i_name, &l_value, &l_size, nullptr, 0 ) != 0 ) {
+      return 0;
+    }
+    if( l_size == sizeof(int32_t) ) {
+      int32_t l_value_32 = 0;
+      l_size = sizeof(l_value_32);
+      sysctlbyname( i_name, &l_value_32, &l_size, nullptr, 0 );
+      l_value = l_value_32;
+    }
+    return l_value;
+  };
+
+  // performance cores on Apple Silicon, generic values otherwise
+  int64_t l_l1 = l_get( "hw.perflevel0.l1dcachesize" );
+  int64_t l_l2 = l_get( "hw.perflevel0.l2cachesize" );
+  int64_t l_num_cores_l2 = l_get( "hw.perflevel0.cpusperl2" );
+  int64_t l_num_cores = l_get( "hw.perflevel0.physicalcpu" );
+  if( l_l1 == 0 ) l_l1 = l_get( "hw.l1dcachesize" );
+  if( l_l2 == 0 ) l_l2 = l_get( "hw.l2cachesize" );
+  if( l_num_cores == 0 ) l_num_cores = l_get( "hw.physicalcpu" );
+
+  if( l_l1 == 0 && l_l2 == 0 ) {
+    return false;
+  }
+
+  m_l1_cache_size = l_l1;
+  m_l2_cache_size = l_l2 / std::max< int64_t >( 1, l_num_cores_l2 );
+  m_l3_cache_size = l_get( "hw.l3cachesize" );
+  m_num_cores = l_num_cores;
+  m_num_cpus = l_get( "hw.logicalcpu" );
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+void einsum_ir::basic::Topology::probe_numa() {
+  m_numa_node_ids.clear();
+  m_numa_node_of_cpu.assign( m_num_cpus, 0 );
+  m_cpus_ordered.clear();
+
+  // rank of every cpu among the hardware threads of its core
+  std::vector< int64_t > l_rank_in_core( m_num_cpus, 0 );
+
+#if defined(__linux__)
+  std::string l_path_node = "/sys/devices/system/node/";
+  std::string l_path_cpu = "/sys/devices/system/cpu/";
+
+  std::ifstream l_online( l_path_node + "online" );
+  std::string l_list;
+  if( l_online >> l_list ) {
+    std::vector< int64_t > l_node_ids = parse_cpus( l_list );
+    for( std::size_t l_no = 0; l_no < l_node_ids.size(); l_no++ ) {
+      std::ifstream l_file_cpus( l_path_node + "node" + std::to_string( l_node_ids[l_no] ) + "/cpulist" );
+      std::string l_cpus;
+      l_file_cpus >> l_cpus;
+      std::vector< int64_t > l_cpu_ids = parse_cpus( l_cpus );
+
+      // memory-only nodes are skipped
+      if( l_cpu_ids.size() == 0 ) {
+        continue;
+      }
+      m_numa_node_ids.push_back( l_node_ids[l_no] );
+      for( std::size_t l_cp = 0; l_cp < l_cpu_ids.size(); l_cp++ ) {
+        if( l_cpu_ids[l_cp] < m_num_cpus ) {
+          m_numa_node_of_cpu[ l_cpu_ids[l_cp] ] = l_node_ids[l_no];
+        }
+      }
+    }
+  }
+
+  for( int64_t l_cpu = 0; l_cpu < m_num_cpus; l_cpu++ ) {
+    std::ifstream l_file_siblings( l_path_cpu + "cpu" + std::to_string( l_cpu ) + "/topology/thread_siblings_list" );
+    std::string l_siblings;
+    l_file_siblings >> l_siblings;
+    std::vector< int64_t > l_sibling_ids = parse_cpus( l_siblings );
+
+    std::vector< int64_t >::iterator l_it = std::find( l_sibling_ids.begin(),
+                                                       l_sibling_ids.end(),
+                                                       l_cpu );
+    if( l_it != l_sibling_ids.end() ) {
+      l_rank_in_core[l_cpu] = l_it - l_sibling_ids.begin();
+    }
+  }
+#endif
+
+  if( m_numa_node_ids.size() == 0 ) {
+    m_numa_node_ids.push_back( 0 );
+    m_numa_node_of_cpu.assign( m_num_cpus, 0 );
+  }
+
+  for( int64_t l_cpu = 0; l_cpu < m_num_cpus; l_cpu++ ) {
+    m_cpus_ordered.push_back( l_cpu );
+  }
+  std::stable_sort( m_cpus_ordered.begin(),
+                    m_cpus_ordered.end(),
+                    [&]( int64_t i_cpu_0, int64_t i_cpu_1 ) {
+                      if( l_rank_in_core[i_cpu_0] != l_rank_in_core[i_cpu_1] ) {
+                        return l_rank_in_core[i_cpu_0] < l_rank_in_core[i_cpu_1];
+                      }
+                      return m_numa_node_of_cpu[i_cpu_0] < m_numa_node_of_cpu[i_cpu_1];
+                    } );
+}
+
+void einsum_ir::basic::Topology::probe() {
+  m_l1_cache_size = 0;
+  m_l2_cache_size = 0;
+  m_l3_cache_size = 0;
+  m_num_cores = 0;
+  m_num_cpus = 0;
+
+  bool l_found = probe_sysctl();
+  if( !l_found ) {
+    l_found = probe_sysfs();
+  }
+  if( !l_found ) {
+    probe_cpuid();
+  }
+
+  if( m_l1_cache_size <= 0 ) {
+    m_l1_cache_size = m_l1_cache_size_default;
+  }
+  if( m_l2_cache_size <= 0 ) {
+    m_l2_cache_size = m_l2_cache_size_default;
+  }
+  if( m_num_cpus <= 0 ) {
+    m_num_cpus = std::max< int64_t >( 1, std::thread::hardware_concurrency() );
+  }
+  if( m_num_cores <= 0 ) {
+    m_num_cores = m_num_cpus;
+  }
+
+  probe_numa();
+}
@@ -0,0 +1,122 @@
+#ifndef EINSUM_IR_BASIC_TOPOLOGY
+#define EINSUM_IR_BASIC_TOPOLOGY
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace einsum_ir {
+  namespace basic {
+    class Topology;
+  }
+}
+
+/**
+ * Cache hierarchy, core counts and NUMA nodes of the host.
+ *
+ * The topology is probed through sysfs on Linux, falling back to cpuid on x86,
+ * and through sysctl on macOS.
+ * Cache sizes which are shared by multiple cores are reported per core for the L1 and L2 caches,
+ * and per instance for the L3 cache.
+ * Sizes which could not be probed are set to the defaults, an unknown L3 cache has size zero.
+ * Hosts without NUMA information are treated as a single node.
+ **/
+class einsum_ir::basic::Topology {
+  public:
+    //! default size of the L1 data cache in bytes
+    static constexpr int64_t m_l1_cache_size_default = 32 * 1024;
+
+    //! default size of the L2 cache in bytes
+    static constexpr int64_t m_l2_cache_size_default = 1024 * 1024;
+
+    //! size of the L1 data cache per core in bytes
+    int64_t m_l1_cache_size = 0;
+
+    //! size of the L2 cache per core in bytes
+    int64_t m_l2_cache_size = 0;
+
+    //! size of an L3 cache instance in bytes, zero if unknown
+    int64_t m_l3_cache_size = 0;
+
+    //! number of physical cores
+    int64_t m_num_cores = 0;
+
+    //! number of logical cpus
+    int64_t m_num_cpus = 0;
+
+    //! ids of the NUMA nodes
+    std::vector< int64_t > m_numa_node_ids;
+
+    //! NUMA node of every logical cpu
+    std::vector< int64_t > m_numa_node_of_cpu;
+
+    //! logical cpus in placement order: the first hardware thread of every core node by node, followed by the remaining hardware threads
+    std::vector< int64_t > m_cpus_ordered;
+
+    /**
+     * Gets the process-wide topology.
+     * The environment variables EINSUM_IR_L1_CACHE_BYTES, EINSUM_IR_L2_CACHE_BYTES and EINSUM_IR_L3_CACHE_BYTES
+     * overwrite the probed cache sizes.
+     *
+     * @return topology of the host.
+     **/
+    static Topology const & get_instance();
+
+    /**
+     * Probes the topology of the host.
+     **/
+    void probe();
+
+    /**
+     * Parses a cache size given in sysfs notation, e.g., 48K or 2M.
+     *
+     * @param i_size size string.
+     * @return size in bytes, zero if the string is malformed.
+     **/
+    static int64_t parse_size( std::string const & i_size );
+
+    /**
+     * Counts the cpus in a list given in sysfs notation, e.g., 0-3,8,10-11.
+     *
+     * @param i_list cpu list.
+     * @return number of cpus, zero if the list is malformed.
+     **/
+    static int64_t count_cpus( std::string const & i_list );
+
+    /**
+     * Parses a cpu list given in sysfs notation, e.g., 0-3,8,10-11.
+     *
+     * @param i_list cpu list.
+     * @return ids of the cpus, empty if the list is malformed.
+     **/
+    static std::vector< int64_t > parse_cpus( std::string const & i_list );
+
+  private:
+    /**
+     * Probes the topology through sysfs.
+     *
+     * @return true if the caches were found, false otherwise.
+     **/
+    bool probe_sysfs();
+
+    /**
+     * Probes the topology through cpuid.
+     *
+     * @return true if the caches were found, false otherwise.
+     **/
+    bool probe_cpuid();
+
+    /**
+     * Probes the topology through sysctl.
+     *
+     * @return true if the caches were found, false otherwise.
+     **/
+    bool probe_sysctl();
+
+    /**
+     * Probes the NUMA nodes and derives the placement order of the cpus.
+     **/
+    void probe_numa();
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "catch.hpp"
+#include "Topology.h"
+#include <algorithm>
+
+TEST_CASE( "Parsing of cache sizes in sysfs notation.", "[topology]" ) {
+  using einsum_ir::basic::Topology;
+
+  REQUIRE( Topology::parse_size( "48K" ) == 48 * 1024 );
+  REQUIRE( Topology::parse_size( "2M" ) == 2 * 1024 * 1024 );
+  REQUIRE( Topology::parse_size( "1G" ) == 1024 * 1024 * 1024 );
+  REQUIRE( Topology::parse_size( "4096" ) == 4096 );
+
+  REQUIRE( Topology::parse_size( "" ) == 0 );
+  REQUIRE( Topology::parse_size( "K" ) == 0 );
+  REQUIRE( Topology::parse_size( "32X" ) == 0 );
+  REQUIRE( Topology::parse_size( "-1K" ) == 0 );
+}
+
+TEST_CASE( "Counting of cpus in sysfs notation.", "[topology]" ) {
+  using einsum_ir::basic::Topology;
+
+  REQUIRE( Topology::count_cpus( "0" ) == 1 );
+  REQUIRE( Topology::count_cpus( "0-3" ) == 4 );
+  REQUIRE( Topology::count_cpus( "0-3,8,10-11" ) == 7 );
+  REQUIRE( Topology::count_cpus( "0,64" ) == 2 );
+
+  REQUIRE( Topology::count_cpus( "" ) == 0 );
+  REQUIRE( Topology::count_cpus( "3-1" ) == 0 );
+  REQUIRE( Topology::count_cpus( "a-b" ) == 0 );
+}
+
+TEST_CASE( "Parsing of cpu lists in sysfs notation.", "[topology]" ) {
+  using einsum_ir::basic::Topology;
+
+  REQUIRE( Topology::parse_cpus( "0" ) == std::vector< int64_t >{ 0 } );
+  REQUIRE( Topology::parse_cpus( "0-3,8,10-11" ) == std::vector< int64_t >{ 0, 1, 2, 3, 8, 10, 11 } );
+
+  REQUIRE( Topology::parse_cpus( "" ).empty() );
+  REQUIRE( Topology::parse_cpus( "3-1" ).empty() );
+  REQUIRE( Topology::parse_cpus( "0,a" ).empty() );
+}
+
+TEST_CASE( "Probing of the host's topology.", "[topology]" ) {
+  using einsum_ir::basic::Topology;
+
+  Topology l_topology;
+  l_topology.probe();
+
+  REQUIRE( l_topology.m_l1_cache_size > 0 );
+  REQUIRE( l_topology.m_l2_cache_size > 0 );
+  REQUIRE( l_topology.m_l3_cache_size >= 0 );
+  REQUIRE( l_topology.m_num_cores > 0 );
+  REQUIRE( l_topology.m_num_cpus >= l_topology.m_num_cores );
+
+  REQUIRE( l_topology.m_numa_node_ids.size() >= 1 );
+  REQUIRE( (int64_t) l_topology.m_numa_node_of_cpu.size() == l_topology.m_num_cpus );
+
+  // the placement order is a permutation of the cpus
+  std::vector< int64_t > l_cpus = l_topology.m_cpus_ordered;
+  std::sort( l_cpus.begin(), l_cpus.end() );
+  REQUIRE( (int64_t) l_cpus.size() == l_topology.m_num_cpus );
+  for( int64_t l_cpu = 0; l_cpu < l_topology.m_num_cpus; l_cpu++ ) {
+    REQUIRE( l_cpus[l_cpu] == l_cpu );
+  }
+}
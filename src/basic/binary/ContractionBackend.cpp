@@ -1,7 +1,10 @@
 #include "ContractionBackend.h"
 #include "../unary/UnaryOptimizer.h"
 #include "../threading.h"
+#include "../MappedFile.h"
+#include "../low_precision.h"
 #include <algorithm>
+#include <chrono>
 
 void einsum_ir::basic::ContractionBackend::init( std::vector< dim_t >   const & i_dim_type,
                                                  std::vector< exec_t >  const & i_exec_type,
@@ -54,6 +57,7 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< dim_t >   const &
   m_ktype_first_touch = i_ktype_first_touch;
   m_ktype_main        = i_ktype_main;
   m_ktype_last_touch  = i_ktype_last_touch;
+  m_epilogue.init( {}, 1.0, 1.0 );
 
   m_num_threads_sfc_m  = i_num_threads_sfc_m;
   m_num_threads_sfc_n  = i_num_threads_sfc_n;
@@ -109,6 +113,7 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< iter_property > co
   m_ktype_first_touch = i_ktype_first_touch;
   m_ktype_main        = i_ktype_main;
   m_ktype_last_touch  = i_ktype_last_touch;
+  m_epilogue.init( {}, 1.0, 1.0 );
 
   m_num_threads_sfc_m  = i_num_threads_sfc_m;
   m_num_threads_sfc_n  = i_num_threads_sfc_n;
@@ -119,6 +124,39 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< iter_property > co
   m_is_compiled = false;
 }
 
+void einsum_ir::basic::ContractionBackend::init( ContractionConfig        const & i_config,
+                                                 ContractionMemoryManager       * i_contraction_mem ){
+  init( i_config.m_iterations,
+        i_config.m_dtype_left,
+        i_config.m_dtype_right,
+        i_config.m_dtype_comp,
+        i_config.m_dtype_out,
+        i_config.m_ktype_first_touch,
+        i_config.m_ktype_main,
+        i_config.m_ktype_last_touch,
+        i_config.m_num_threads_shared,
+        i_config.m_num_threads_sfc_m,
+        i_config.m_num_threads_sfc_n,
+        i_contraction_mem );
+}
+
+void einsum_ir::basic::ContractionBackend::set_epilogue( std::vector< kernel_t > const & i_ktypes,
+                                                         double                          i_alpha,
+                                                         double                          i_beta ) {
+  m_epilogue.init( i_ktypes,
+                   i_alpha,
+                   i_beta );
+  m_ktype_last_touch = i_ktypes.empty() ? kernel_t::UNDEFINED_KTYPE : kernel_t::EPILOGUE;
+  m_is_compiled = false;
+}
+
+void einsum_ir::basic::ContractionBackend::set_streamed_inputs( bool i_streamed_left,
+                                                                bool i_streamed_right ) {
+  m_streamed_left  = i_streamed_left;
+  m_streamed_right = i_streamed_right;
+  m_is_compiled = false;
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
   err_t l_err = err_t::UNDEFINED_ERROR;
   if( m_is_compiled ){
@@ -131,12 +169,35 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
     return l_err;
   }
 
+  // element-wise operations without dedicated kernels are executed as epilogue
+  if(    m_ktype_last_touch == kernel_t::GELU
+      || m_ktype_last_touch == kernel_t::SILU
+      || m_ktype_last_touch == kernel_t::SIGMOID
+      || m_ktype_last_touch == kernel_t::TANH
+      || m_ktype_last_touch == kernel_t::SCALE ) {
+    m_epilogue.init( { m_ktype_last_touch },
+                     1.0,
+                     1.0 );
+    m_ktype_last_touch = kernel_t::EPILOGUE;
+  }
+
+  // low-precision outputs are accumulated in FP32 across calls of the main kernel
+  setup_acc();
+
   // compile kernel
   l_err = compile_kernels();
   if( l_err != err_t::SUCCESS ) {
     return l_err;
   }
 
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    l_err = m_epilogue.compile( m_dtype_comp,
+                                m_dtype_out );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
   //update number of threads if loops are to small
   int64_t l_num_iters = m_dim_type.size();
   int64_t l_size_shared = 1;
@@ -213,16 +274,13 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
   m_num_cached_ptrs_left = m_iter.get_caching_size();
   m_num_cached_ptrs_right = m_iter.get_caching_size();
 
-  //reserve memory for packing
-  int64_t l_reserved_size = m_size_packing_left * m_num_cached_ptrs_left + m_size_packing_right * m_num_cached_ptrs_right;
-  if( m_memory == nullptr ){
-    m_memory = &m_personal_memory;
-    m_memory->reserve_thread_memory( l_reserved_size, m_num_threads );
-    m_memory->alloc_all_memory();
-  }
-  else{
-    m_memory->reserve_thread_memory( l_reserved_size, m_num_threads );
-  }
+  //reserve memory for the accumulator and packing
+  m_size_packing_memory = m_size_packing_left * m_num_cached_ptrs_left + m_size_packing_right * m_num_cached_ptrs_right;
+  m_context.init( m_thread_infos,
+                  m_num_cached_ptrs_left,
+                  m_num_cached_ptrs_right,
+                  m_size_acc_memory + m_size_packing_memory,
+                  m_memory );
 
   //setup function pointer vector
   m_loop_functs.resize(l_num_iters);
@@ -244,23 +302,50 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
     }
   }
 
+  //prefetch in the outermost sequential loop which advances a streamed input
+  m_id_prefetch_loop = -1;
+  for( int64_t l_id = 0; l_id < l_num_iters && m_exec_type[l_id] == exec_t::SEQ; l_id++ ){
+    if(    ( m_streamed_left  && m_strides_left[l_id]  != 0 )
+        || ( m_streamed_right && m_strides_right[l_id] != 0 ) ){
+      m_id_prefetch_loop = l_id;
+      break;
+    }
+  }
+
   m_is_compiled = true;
   return err_t::SUCCESS;
 }
 
+void einsum_ir::basic::ContractionBackend::init_context( ContractionContext & o_context ) const {
+  o_context.init( m_thread_infos,
+                  m_num_cached_ptrs_left,
+                  m_num_cached_ptrs_right,
+                  m_size_acc_memory + m_size_packing_memory,
+                  nullptr );
+}
+
 void einsum_ir::basic::ContractionBackend::contract( void const * i_tensor_left,
                                                      void const * i_tensor_right,
                                                      void const * i_tensor_out_aux,
                                                      void       * io_tensor_out ) {
+  contract( i_tensor_left,
+            i_tensor_right,
+            i_tensor_out_aux,
+            io_tensor_out,
+            m_context );
+}
+
+void einsum_ir::basic::ContractionBackend::contract( void const         * i_tensor_left,
+                                                     void const         * i_tensor_right,
+                                                     void const         * i_tensor_out_aux,
+                                                     void               * io_tensor_out,
+                                                     ContractionContext & io_context ) const {
   execute_threaded( m_num_threads, [&](int64_t l_thread_id) {
-    thread_info * l_thread_inf = &m_thread_infos[l_thread_id];
-    //get packing memory
-    if( m_size_packing_left || m_size_packing_right ){
-      l_thread_inf->memory_left  = m_memory->get_thread_memory( l_thread_id );
-      l_thread_inf->memory_right = l_thread_inf->memory_left + m_size_packing_left * m_num_cached_ptrs_left;
-      l_thread_inf->cached_ptrs_left.resize(  m_num_cached_ptrs_left,  nullptr );
-      l_thread_inf->cached_ptrs_right.resize( m_num_cached_ptrs_right, nullptr );
-    }
+    thread_info const * l_thread_inf = &m_thread_infos[l_thread_id];
+    //reset state and get packing memory
+    thread_state * l_thread_state = io_context.prepare_thread( l_thread_id,
+                                                               m_size_acc_memory,
+                                                               m_size_packing_left * m_num_cached_ptrs_left );
 
     //add thread offset
     char * l_tensor_left    = (char *) i_tensor_left    + l_thread_inf->offset_left;
@@ -271,44 +356,63 @@ void einsum_ir::basic::ContractionBackend::contract( void const * i_tensor_left,
 
     //pack left tensor
     if( m_packing_left_id == 0)  {
-      m_unary_left.eval(l_tensor_left, l_thread_inf->memory_left);
-      l_tensor_left = l_thread_inf->memory_left;
+      pack( l_thread_state, m_unary_left, l_tensor_left, l_thread_state->memory_left );
+      l_tensor_left = l_thread_state->memory_left;
     }
 
     //pack right tensor
     if( m_packing_right_id == 0 )  {
-      m_unary_right.eval(l_tensor_right, l_thread_inf->memory_right);
-      l_tensor_right = l_thread_inf->memory_right;
+      pack( l_thread_state, m_unary_right, l_tensor_right, l_thread_state->memory_right );
+      l_tensor_right = l_thread_state->memory_right;
     }
 
     //contract
     (this->*(m_loop_functs[0]))( l_thread_inf,
+                                 l_thread_state,
                                  0,
                                  l_tensor_left,
                                  l_tensor_right,
                                  l_tensor_out_aux,
                                  l_tensor_out,
-                                 m_has_first_touch,
-                                 m_has_last_touch );
+                                 m_has_first_touch || m_id_acc_loop >= 0,
+                                 m_has_last_touch  || m_id_acc_loop >= 0 );
   });
 }
 
-void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thread_info,
-                                                          int64_t         i_id_loop,
-                                                          char    const * i_ptr_left,
-                                                          char    const * i_ptr_right,
-                                                          char    const * i_ptr_out_aux,
-                                                          char          * i_ptr_out,
-                                                          bool            i_first_access,
-                                                          bool            i_last_access ) {
+void einsum_ir::basic::ContractionBackend::contract_iter( thread_info  const * i_thread_info,
+                                                          thread_state       * io_thread_state,
+                                                          int64_t              i_id_loop,
+                                                          char         const * i_ptr_left,
+                                                          char         const * i_ptr_right,
+                                                          char         const * i_ptr_out_aux,
+                                                          char               * i_ptr_out,
+                                                          bool                 i_first_access,
+                                                          bool                 i_last_access ) const {
   bool l_first_access = i_first_access;
   bool l_last_access  = i_last_access;
 
   int64_t l_size = m_dim_sizes[i_id_loop];
   int64_t l_id_next_loop = i_id_loop + 1;
 
+  //the first thread requests the pages of the next iteration's tiles of streamed inputs
+  bool l_prefetch = i_id_loop == m_id_prefetch_loop && i_thread_info == m_thread_infos.data();
+
+  if( i_id_loop == m_id_acc_loop ) {
+    io_thread_state->ptr_out_acc = i_ptr_out;
+  }
+
   // issue loop iterations
   for( int64_t l_it = 0; l_it < l_size; l_it++ ) {
+    if( l_prefetch && l_it + 1 < l_size ) {
+      if( m_streamed_left ) {
+        MappedFile::prefetch( i_ptr_left  + m_strides_left[i_id_loop],
+                              m_strides_left[i_id_loop] );
+      }
+      if( m_streamed_right ) {
+        MappedFile::prefetch( i_ptr_right + m_strides_right[i_id_loop],
+                              m_strides_right[i_id_loop] );
+      }
+    }
 
     //determine if this is the first or last access in the k dimension
     bool l_non_k_loop = m_dim_type[i_id_loop] != dim_t::K;
@@ -318,19 +422,20 @@ void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thre
     //pack left tensor
     const char * l_ptr_left_active = i_ptr_left;
     if( m_packing_left_id == l_id_next_loop )  {
-      l_ptr_left_active = i_thread_info->memory_left;
-      m_unary_left.eval(i_ptr_left, (void *)l_ptr_left_active);
+      l_ptr_left_active = io_thread_state->memory_left;
+      pack( io_thread_state, m_unary_left, i_ptr_left, (void *)l_ptr_left_active );
     }
 
     //pack right tensor
     const char * l_ptr_right_active = i_ptr_right;
     if( m_packing_right_id == l_id_next_loop )  {
-      l_ptr_right_active = i_thread_info->memory_right;
-      m_unary_right.eval(i_ptr_right, (void *)l_ptr_right_active);
+      l_ptr_right_active = io_thread_state->memory_right;
+      pack( io_thread_state, m_unary_right, i_ptr_right, (void *)l_ptr_right_active );
     }
   
     //recursive function call
     (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
+                                              io_thread_state,
                                               l_id_next_loop,
                                               l_ptr_left_active,
                                               l_ptr_right_active,
@@ -347,14 +452,19 @@ void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thre
   }
 }
 
-void einsum_ir::basic::ContractionBackend::contract_iter_shared( thread_info   * i_thread_info,
-                                                                 int64_t         i_id_loop,
-                                                                 char    const * i_ptr_left,
-                                                                 char    const * i_ptr_right,
-                                                                 char    const * i_ptr_out_aux,
-                                                                 char          * i_ptr_out,
-                                                                 bool            i_first_access,
-                                                                 bool            i_last_access ) {
+void einsum_ir::basic::ContractionBackend::contract_iter_shared( thread_info  const * i_thread_info,
+                                                                 thread_state       * io_thread_state,
+                                                                 int64_t              i_id_loop,
+                                                                 char         const * i_ptr_left,
+                                                                 char         const * i_ptr_right,
+                                                                 char         const * i_ptr_out_aux,
+                                                                 char               * i_ptr_out,
+                                                                 bool                 i_first_access,
+                                                                 bool                 i_last_access ) const {
+
+  if( i_id_loop == m_id_acc_loop ) {
+    io_thread_state->ptr_out_acc = i_ptr_out;
+  }
 
   // issue loop iterations
   int64_t l_id_next_loop = i_id_loop + m_num_shared_loops;
@@ -382,25 +492,26 @@ void einsum_ir::basic::ContractionBackend::contract_iter_shared( thread_info   *
 
     //pack left tensor
     if( m_packing_left_id == l_id_next_loop )  {
-      if( l_ptr_left != i_thread_info->cached_ptrs_left[0] ){
-        m_unary_left.eval(l_ptr_left, i_thread_info->memory_left);
-        i_thread_info->cached_ptrs_left[0] = l_ptr_left;
+      if( l_ptr_left != io_thread_state->cached_ptrs_left[0] ){
+        pack( io_thread_state, m_unary_left, l_ptr_left, io_thread_state->memory_left );
+        io_thread_state->cached_ptrs_left[0] = l_ptr_left;
       }
-      l_ptr_left = i_thread_info->memory_left;
+      l_ptr_left = io_thread_state->memory_left;
     }
 
     //pack right tensor
     if( m_packing_right_id == l_id_next_loop )  {
-      if( l_ptr_right != i_thread_info->cached_ptrs_right[0]){
-        m_unary_right.eval(l_ptr_right, i_thread_info->memory_right);
-        i_thread_info->cached_ptrs_right[0] = l_ptr_right;
+      if( l_ptr_right != io_thread_state->cached_ptrs_right[0]){
+        pack( io_thread_state, m_unary_right, l_ptr_right, io_thread_state->memory_right );
+        io_thread_state->cached_ptrs_right[0] = l_ptr_right;
       }
-      l_ptr_right = i_thread_info->memory_right;
+      l_ptr_right = io_thread_state->memory_right;
     }
 
 
     //recursive function call
     (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
+                                              io_thread_state,
                                               l_id_next_loop,
                                               l_ptr_left,
                                               l_ptr_right,
@@ -411,14 +522,15 @@ void einsum_ir::basic::ContractionBackend::contract_iter_shared( thread_info   *
   }
 }
 
-void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_thread_info,
-                                                              int64_t         i_id_loop,
-                                                              char    const * i_ptr_left,
-                                                              char    const * i_ptr_right,
-                                                              char    const * i_ptr_out_aux,
-                                                              char          * i_ptr_out,
-                                                              bool            i_first_access,
-                                                              bool            i_last_access ) {
+void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info  const * i_thread_info,
+                                                              thread_state       * io_thread_state,
+                                                              int64_t              i_id_loop,
+                                                              char         const * i_ptr_left,
+                                                              char         const * i_ptr_right,
+                                                              char         const * i_ptr_out_aux,
+                                                              char               * i_ptr_out,
+                                                              bool                 i_first_access,
+                                                              bool                 i_last_access ) const {
   bool l_first_access = i_first_access;
   bool l_last_access  = i_last_access;
 
@@ -428,6 +540,10 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
   int64_t l_id_next_loop = i_id_loop + m_num_sfc_loops;
   int64_t l_size = i_thread_info->movement_ids.size();
 
+  if( i_id_loop == m_id_acc_loop ) {
+    io_thread_state->ptr_out_acc = i_ptr_out;
+  }
+
   // issue loop iterations
   uint64_t l_id_m = 0;
   uint64_t l_id_n = 0;
@@ -435,10 +551,10 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
 
     //determine if this is the first or last access in the k dimension
     int64_t l_id_k_count = l_id_m + l_id_n * i_thread_info->sfc_size_m;
-    l_first_access = i_first_access && ( i_thread_info->k_count[l_id_k_count] == 0 );
-    i_thread_info->k_count[l_id_k_count]++;
-    i_thread_info->k_count[l_id_k_count] %= i_thread_info->sfc_size_k;
-    l_last_access  = i_last_access  && ( i_thread_info->k_count[l_id_k_count] == 0 );
+    l_first_access = i_first_access && ( io_thread_state->k_count[l_id_k_count] == 0 );
+    io_thread_state->k_count[l_id_k_count]++;
+    io_thread_state->k_count[l_id_k_count] %= i_thread_info->sfc_size_k;
+    l_last_access  = i_last_access  && ( io_thread_state->k_count[l_id_k_count] == 0 );
 
 
     //get dimension and direction from sfc
@@ -451,10 +567,10 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
     const char * l_ptr_left_active = i_ptr_left;
     if( m_packing_left_id == l_id_next_loop )  {
       int64_t l_id = l_id_m % m_num_cached_ptrs_left;
-      l_ptr_left_active = i_thread_info->memory_left + l_id * m_size_packing_left;
-      if( i_ptr_left != i_thread_info->cached_ptrs_left[l_id] ){
-        m_unary_left.eval(i_ptr_left, (void *)l_ptr_left_active);
-        i_thread_info->cached_ptrs_left[l_id] = i_ptr_left;
+      l_ptr_left_active = io_thread_state->memory_left + l_id * m_size_packing_left;
+      if( i_ptr_left != io_thread_state->cached_ptrs_left[l_id] ){
+        pack( io_thread_state, m_unary_left, i_ptr_left, (void *)l_ptr_left_active );
+        io_thread_state->cached_ptrs_left[l_id] = i_ptr_left;
       }
     }
 
@@ -462,15 +578,16 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
     const char * l_ptr_right_active = i_ptr_right;
     if( m_packing_right_id == l_id_next_loop )  {
       int64_t l_id = l_id_n % m_num_cached_ptrs_right;
-      l_ptr_right_active = i_thread_info->memory_right + l_id * m_size_packing_right;
-      if( i_ptr_right != i_thread_info->cached_ptrs_right[l_id]){
-        m_unary_right.eval(i_ptr_right, (void *)l_ptr_right_active);
-        i_thread_info->cached_ptrs_right[l_id] = i_ptr_right;
+      l_ptr_right_active = io_thread_state->memory_right + l_id * m_size_packing_right;
+      if( i_ptr_right != io_thread_state->cached_ptrs_right[l_id]){
+        pack( io_thread_state, m_unary_right, i_ptr_right, (void *)l_ptr_right_active );
+        io_thread_state->cached_ptrs_right[l_id] = i_ptr_right;
       }
     }
     
     //recursive function call
     (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
+                                              io_thread_state,
                                               l_id_next_loop,
                                               l_ptr_left_active,
                                               l_ptr_right_active,
@@ -492,28 +609,119 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
 }
 
 
-void einsum_ir::basic::ContractionBackend::contract_iter_kernel( thread_info   * i_thread_info,
-                                                                 int64_t         i_id_loop,
-                                                                 char    const * i_ptr_left,
-                                                                 char    const * i_ptr_right,
-                                                                 char    const * i_ptr_out_aux,
-                                                                 char          * i_ptr_out,
-                                                                 bool            i_first_access,
-                                                                 bool            i_last_access ) {
+void einsum_ir::basic::ContractionBackend::contract_iter_kernel( thread_info  const * i_thread_info,
+                                                                 thread_state       * io_thread_state,
+                                                                 int64_t              i_id_loop,
+                                                                 char         const * i_ptr_left,
+                                                                 char         const * i_ptr_right,
+                                                                 char         const * i_ptr_out_aux,
+                                                                 char               * i_ptr_out,
+                                                                 bool                 i_first_access,
+                                                                 bool                 i_last_access ) const {
+  // the main kernel works on the accumulator if low-precision outputs are accumulated in FP32
+  char * l_ptr_out_main = i_ptr_out;
+  if( m_id_acc_loop >= 0 ) {
+    l_ptr_out_main = io_thread_state->memory_acc + ( i_ptr_out - io_thread_state->ptr_out_acc ) * m_acc_scale;
+  }
+
   if( i_first_access ) {
-    kernel_first_touch( i_ptr_out_aux,
-                        i_ptr_out );
+    if( m_has_first_touch ) {
+      kernel_first_touch( i_ptr_out_aux,
+                          i_ptr_out );
+    }
+    if( m_id_acc_loop >= 0 ) {
+      acc_load( i_ptr_out,
+                l_ptr_out_main );
+    }
   }
   kernel_main( i_ptr_left,
                i_ptr_right,
-               i_ptr_out );
+               l_ptr_out_main );
   
   if( i_last_access ) {
-    kernel_last_touch( i_ptr_out_aux,
-                       i_ptr_out );
+    if( m_id_acc_loop >= 0 ) {
+      acc_store( l_ptr_out_main,
+                 i_ptr_out );
+    }
+    if( m_has_last_touch ) {
+      kernel_last_touch( i_ptr_out_aux,
+                         i_ptr_out );
+    }
   }                                                             
 }
 
+void einsum_ir::basic::ContractionBackend::setup_acc() {
+  m_dtype_out_main = m_dtype_out;
+  m_id_acc_loop = -1;
+  m_size_acc_memory = 0;
+  m_acc_scale = 1;
+
+  if(    m_dtype_comp != FP32
+      || ( m_dtype_out != BF16 && m_dtype_out != FP16 ) ) {
+    return;
+  }
+
+  // outermost loop over K outside of the kernel, parallel loops are entered at the first loop of their group
+  int64_t l_num_iters = m_dim_type.size();
+  int64_t l_id_group = 0;
+  for( int64_t l_id = 0; l_id < l_num_iters && m_exec_type[l_id] != exec_t::PRIM; l_id++ ) {
+    if(    m_exec_type[l_id] == exec_t::SEQ
+        || m_exec_type[l_id] != m_exec_type[l_id_group] ) {
+      l_id_group = l_id;
+    }
+    if( m_dim_type[l_id] == dim_t::K ) {
+      m_id_acc_loop = l_id_group;
+      break;
+    }
+  }
+  if( m_id_acc_loop < 0 ) {
+    return;
+  }
+
+  // output data touched inside of the loop
+  int64_t l_size_acc = 1;
+  for( int64_t l_id = m_id_acc_loop; l_id < l_num_iters; l_id++ ) {
+    if( m_dim_type[l_id] != dim_t::K ) {
+      l_size_acc += ( m_dim_sizes[l_id] - 1 ) * m_strides_out[l_id];
+    }
+  }
+
+  m_dtype_out_main = m_dtype_comp;
+  m_acc_scale = ce_n_bytes( m_dtype_comp ) / ce_n_bytes( m_dtype_out );
+  m_size_acc_memory  = l_size_acc * ce_n_bytes( m_dtype_comp );
+  m_size_acc_memory += ( 64 - m_size_acc_memory % 64 ) % 64;
+
+  m_acc_m  = m_m * m_r;
+  m_acc_n  = m_n;
+  m_acc_ld = m_ldc;
+}
+
+void einsum_ir::basic::ContractionBackend::acc_load( char const * i_out,
+                                                     char       * o_acc ) const {
+  uint16_t const * l_out = (uint16_t const *) i_out;
+  float          * l_acc = (float          *) o_acc;
+
+  for( int64_t l_n = 0; l_n < m_acc_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < m_acc_m; l_m++ ) {
+      int64_t l_id = l_n * m_acc_ld + l_m;
+      l_acc[l_id] = ( m_dtype_out == BF16 ) ? bf16_to_fp32( l_out[l_id] ) : fp16_to_fp32( l_out[l_id] );
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::acc_store( char const * i_acc,
+                                                      char       * o_out ) const {
+  float const * l_acc = (float const *) i_acc;
+  uint16_t    * l_out = (uint16_t    *) o_out;
+
+  for( int64_t l_n = 0; l_n < m_acc_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < m_acc_m; l_m++ ) {
+      int64_t l_id = l_n * m_acc_ld + l_m;
+      l_out[l_id] = ( m_dtype_out == BF16 ) ? fp32_to_bf16( l_acc[l_id] ) : fp32_to_fp16( l_acc[l_id] );
+    }
+  }
+}
+
 
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::set_kernel_shape( ){
   //check that there are enough primitive dimensions
@@ -677,9 +885,33 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::set_kernel_shape(
   return err_t::SUCCESS;
 }
 
+void einsum_ir::basic::ContractionBackend::set_profiling( bool i_profiling ) {
+  m_profiling = i_profiling;
+}
+
+double einsum_ir::basic::ContractionBackend::time_packing() const {
+  return m_context.time_packing();
+}
+
+void einsum_ir::basic::ContractionBackend::pack( thread_state       * io_thread_state,
+                                                 UnaryBackend const & i_unary,
+                                                 void         const * i_in,
+                                                 void               * o_out ) const {
+  if( !m_profiling ) {
+    i_unary.eval( i_in, o_out );
+    return;
+  }
+
+  std::chrono::steady_clock::time_point l_tp0 = std::chrono::steady_clock::now();
+  i_unary.eval( i_in, o_out );
+  std::chrono::steady_clock::time_point l_tp1 = std::chrono::steady_clock::now();
+
+  io_thread_state->time_packing += std::chrono::duration< double >( l_tp1 - l_tp0 ).count();
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::create_packing( int64_t              & o_packing_id,
                                                                               int64_t              & o_size_packing,
-                                                                              UnaryBackendTpp      & o_unary,
+                                                                              UnaryBackend         & o_unary,
                                                                               std::vector<int64_t> & i_strides,
                                                                               std::vector<int64_t> & i_packing_strides ){
   //determine size of and iteration id of packing
@@ -719,7 +951,11 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::create_packing( in
     }
     //optimize packing iters
     UnaryOptimizer l_unary_opt;
+#ifdef EINSUM_IR_ENABLE_TPP
     l_unary_opt.init( &l_packing_iters, 1 , false);
+#else
+    l_unary_opt.init( &l_packing_iters, 1 , true);
+#endif
     err_t l_err = err_t::UNDEFINED_ERROR;
     l_err = l_unary_opt.optimize();
     if( l_err != err_t::SUCCESS ) {
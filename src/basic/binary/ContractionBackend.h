@@ -6,7 +6,14 @@
 #include "../constants.h"
 #include "IterationSpace.h"
 #include "ContractionMemoryManager.h"
+#include "ContractionContext.h"
+#include "ContractionConfig.h"
+#include "ContractionEpilogue.h"
+#ifdef EINSUM_IR_ENABLE_TPP
 #include "../unary/UnaryBackendTpp.h"
+#else
+#include "../unary/UnaryBackendScalar.h"
+#endif
 
 
 namespace einsum_ir {
@@ -48,17 +55,39 @@ class einsum_ir::basic::ContractionBackend {
     //! indicates existance of last touch kernel
     bool m_has_last_touch = false;
 
-    //! vector with thread personal information
+    //! vector with thread personal information, fixed after the compilation
     std::vector<thread_info> m_thread_infos;
 
+    //! context used by contractions without an explicit context
+    ContractionContext m_context;
+
     //! indicates if the backend is compiled
     bool m_is_compiled = false;
 
-    //! pointer to active memory manager for contraction
+    //! true if the packing time is measured
+    bool m_profiling = false;
+
+    //! pointer to the external memory manager of the default context, nullptr if the context owns its memory
     ContractionMemoryManager * m_memory = nullptr;
 
-    //! personal memory manager for contraction, used if no external memory manager is given
-    ContractionMemoryManager m_personal_memory;
+    //! packing memory required per thread in bytes
+    int64_t m_size_packing_memory = 0;
+
+    //! id of the outermost loop over K whose iterations accumulate in FP32, -1 if the output is accumulated in place
+    int64_t m_id_acc_loop = -1;
+
+    //! accumulator memory required per thread in bytes
+    int64_t m_size_acc_memory = 0;
+
+    //! ratio of the accumulator's and the output's element sizes
+    int64_t m_acc_scale = 1;
+
+    //! number of rows of the output block touched by the main kernel
+    int64_t m_acc_m = 0;
+    //! number of columns of the output block touched by the main kernel
+    int64_t m_acc_n = 0;
+    //! leading dimension of the output block touched by the main kernel
+    int64_t m_acc_ld = 0;
 
     //! size of packed left input tensor
     int64_t m_size_packing_left  = 0;
@@ -66,10 +95,17 @@ class einsum_ir::basic::ContractionBackend {
     //! size of packed right input tensor
     int64_t m_size_packing_right = 0;
 
+#ifdef EINSUM_IR_ENABLE_TPP
     //! unary packing backend for left input tensor
     UnaryBackendTpp m_unary_left;
     //! unary packing backend for right input tensor
     UnaryBackendTpp m_unary_right;
+#else
+    //! unary packing backend for left input tensor, scalar if built without TPPs
+    UnaryBackendScalar m_unary_left;
+    //! unary packing backend for right input tensor, scalar if built without TPPs
+    UnaryBackendScalar m_unary_right;
+#endif
 
     //! id of the left packing loop
     int64_t m_packing_left_id  = -1;
@@ -81,6 +117,39 @@ class einsum_ir::basic::ContractionBackend {
     //! number of cached pointers for right input tensor
     int64_t m_num_cached_ptrs_right = 1;
 
+    //! true if the left input tensor is streamed, e.g., from a memory-mapped file
+    bool m_streamed_left = false;
+    //! true if the right input tensor is streamed, e.g., from a memory-mapped file
+    bool m_streamed_right = false;
+
+    //! id of the sequential loop whose next iteration is prefetched, -1 if none
+    int64_t m_id_prefetch_loop = -1;
+
+    /**
+     * Derives the accumulation of low-precision outputs.
+     * If the main kernel is called repeatedly for the same output block, i.e., loops over K surround the kernel,
+     * the running sums are kept in a per-thread FP32 accumulator which covers the output data touched in the outermost of these loops.
+     **/
+    void setup_acc();
+
+    /**
+     * Loads a block of the output tensor into the accumulator.
+     *
+     * @param i_out pointer to a data section of the output tensor.
+     * @param o_acc pointer to the corresponding data section of the accumulator.
+     **/
+    void acc_load( char const * i_out,
+                   char       * o_acc ) const;
+
+    /**
+     * Stores a block of the accumulator in the output tensor.
+     *
+     * @param i_acc pointer to a data section of the accumulator.
+     * @param o_out pointer to the corresponding data section of the output tensor.
+     **/
+    void acc_store( char const * i_acc,
+                    char       * o_out ) const;
+
   protected:
     //! datatype of the left input
     data_t m_dtype_left = UNDEFINED_DTYPE;
@@ -94,6 +163,9 @@ class einsum_ir::basic::ContractionBackend {
     //! datatype used during the computations
     data_t m_dtype_comp = UNDEFINED_DTYPE;
 
+    //! datatype of the main kernel's output, the computation type if low-precision outputs are accumulated in FP32
+    data_t m_dtype_out_main = UNDEFINED_DTYPE;
+
 
     //! vector with dimension types of all loops
     std::vector< dim_t >   m_dim_type;
@@ -129,6 +201,9 @@ class einsum_ir::basic::ContractionBackend {
     //! type of the last touch kernel
     kernel_t m_ktype_last_touch = UNDEFINED_KTYPE;
 
+    //! element-wise operations of the last touch if its type is EPILOGUE
+    ContractionEpilogue m_epilogue;
+
     //! kernel br size
     uint64_t m_br = 0;
     //! kernel m size
@@ -178,14 +253,15 @@ class einsum_ir::basic::ContractionBackend {
     bool m_trans_b = false;
 
     //! vector of function pointers to the loop implementations, set once during compielation and used in contraction
-    std::vector<void (ContractionBackend::*)( thread_info *,
+    std::vector<void (ContractionBackend::*)( thread_info const *,
+                                              thread_state      *,
                                               int64_t,
                                               char const  *,
                                               char const  *,
                                               char const  *,
                                               char        *,
                                               bool,
-                                              bool) > m_loop_functs;
+                                              bool) const > m_loop_functs;
     
   public:
     /**
@@ -263,6 +339,38 @@ class einsum_ir::basic::ContractionBackend {
                int64_t                              i_num_threads_sfc_n,
                ContractionMemoryManager           * i_contraction_mem );
 
+    /**
+     * Initializes the class with a configuration, e.g., an optimized configuration loaded from a plan file.
+     *
+     * @param i_config configuration of the contraction.
+     * @param i_contraction_mem pointer to the contraction memory manager.
+     **/
+    void init( ContractionConfig        const & i_config,
+               ContractionMemoryManager       * i_contraction_mem );
+
+    /**
+     * Sets a chain of element-wise operations as last touch, e.g., a bias addition followed by an activation function.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_ktypes operations of the chain, see ContractionEpilogue.
+     * @param i_alpha factor of the SCALE operation.
+     * @param i_beta factor of the auxiliary tensor in the ADD operation.
+     **/
+    void set_epilogue( std::vector< kernel_t > const & i_ktypes,
+                       double                          i_alpha,
+                       double                          i_beta );
+
+    /**
+     * Marks input tensors as streamed, e.g., from memory-mapped files.
+     * The outermost sequential loop advancing a streamed input requests the pages of its next iteration ahead of time.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_streamed_left true if the left input tensor is streamed.
+     * @param i_streamed_right true if the right input tensor is streamed.
+     **/
+    void set_streamed_inputs( bool i_streamed_left,
+                              bool i_streamed_right );
+
     /**
      * Compiles the contraction loop interface.
      *
@@ -271,7 +379,16 @@ class einsum_ir::basic::ContractionBackend {
     err_t compile();
 
     /**
-     * Contracts the two tensors.
+     * Initializes a context for contractions of the compiled backend.
+     * The context owns its packing memory.
+     *
+     * @param o_context context which is initialized.
+     **/
+    void init_context( ContractionContext & o_context ) const;
+
+    /**
+     * Contracts the two tensors using the backend's default context.
+     * Not reentrant since the default context is mutated during the contraction.
      *
      * @param i_tensor_left left tensor.
      * @param i_tensor_right right tensor.
@@ -282,12 +399,44 @@ class einsum_ir::basic::ContractionBackend {
                    void const * i_tensor_right,
                    void const * i_tensor_out_aux,
                    void       * io_tensor_out );
+
+    /**
+     * Contracts the two tensors using the given context.
+     * Reentrant: concurrent contractions are allowed if each of them uses a different context.
+     *
+     * @param i_tensor_left left tensor.
+     * @param i_tensor_right right tensor.
+     * @param i_tensor_out_aux auxiliary data w.r.t. output tensor.
+     * @param io_tensor_out output tensor.
+     * @param io_context context initialized through init_context.
+     **/
+    void contract( void const         * i_tensor_left,
+                   void const         * i_tensor_right,
+                   void const         * i_tensor_out_aux,
+                   void               * io_tensor_out,
+                   ContractionContext & io_context ) const;
+
+    /**
+     * Enables or disables the measurement of the packing time.
+     *
+     * @param i_profiling true if the packing time is measured.
+     **/
+    void set_profiling( bool i_profiling );
+
+    /**
+     * Gets the packing time of the last contraction using the default context.
+     * Only available if profiling is enabled.
+     *
+     * @return packing time in seconds, averaged over the threads.
+     **/
+    double time_packing() const;
     
     /**
      * General purpose loop implementation featuring first and last touch operations.
      * No threading is applied.
      *
      * @param i_thread_info information for the executing thread.
+     * @param io_thread_state state of the executing thread.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -296,20 +445,22 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data
      * @param i_last_access true if last time accessing this data
      **/
-    void contract_iter( thread_info   * i_thread_info,
-                        int64_t         i_id_loop,
-                        char    const * i_ptr_left,
-                        char    const * i_ptr_right,
-                        char    const * i_ptr_out_aux,
-                        char          * i_ptr_out,
-                        bool            i_first_access,
-                        bool            i_last_access );
+    void contract_iter( thread_info  const * i_thread_info,
+                        thread_state       * io_thread_state,
+                        int64_t              i_id_loop,
+                        char         const * i_ptr_left,
+                        char         const * i_ptr_right,
+                        char         const * i_ptr_out_aux,
+                        char               * i_ptr_out,
+                        bool                 i_first_access,
+                        bool                 i_last_access ) const;
 
     /**
      * General purpose loop implementation featuring first and last touch operations.
      * Threading is applied.
      *
      * @param i_thread_info information for the executing thread.
+     * @param io_thread_state state of the executing thread.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -318,19 +469,21 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data.
      * @param i_last_access true if last time accessing this data.
      **/
-    void contract_iter_shared( thread_info   * i_thread_info,
-                               int64_t         i_id_loop,
-                               char    const * i_ptr_left,
-                               char    const * i_ptr_right,
-                               char    const * i_ptr_out_aux,
-                               char          * i_ptr_out,
-                               bool            i_first_access,
-                               bool            i_last_access );
+    void contract_iter_shared( thread_info  const * i_thread_info,
+                               thread_state       * io_thread_state,
+                               int64_t              i_id_loop,
+                               char         const * i_ptr_left,
+                               char         const * i_ptr_right,
+                               char         const * i_ptr_out_aux,
+                               char               * i_ptr_out,
+                               bool                 i_first_access,
+                               bool                 i_last_access ) const;
  
     /**
      * SFC based loop implementation featuring first and last touch operations.
      *
      * @param i_thread_info information for the executing thread.
+     * @param io_thread_state state of the executing thread.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -339,19 +492,21 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data
      * @param i_last_access true if last time accessing this data
      **/
-    void contract_iter_sfc( thread_info   * i_thread_info,
-                            int64_t         i_id_loop,
-                            char    const * i_ptr_left,
-                            char    const * i_ptr_right,
-                            char    const * i_ptr_out_aux,
-                            char          * i_ptr_out,
-                            bool            i_first_access,
-                            bool            i_last_access );
+    void contract_iter_sfc( thread_info  const * i_thread_info,
+                            thread_state       * io_thread_state,
+                            int64_t              i_id_loop,
+                            char         const * i_ptr_left,
+                            char         const * i_ptr_right,
+                            char         const * i_ptr_out_aux,
+                            char               * i_ptr_out,
+                            bool                 i_first_access,
+                            bool                 i_last_access ) const;
 
     /**
      * Inner most loop implementation based on kernel call featuring first and last touch operations.
      *
      * @param i_thread_info information for the executing thread.
+     * @param io_thread_state state of the executing thread.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -360,14 +515,15 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data
      * @param i_last_access true if last time accessing this data
      **/
-    void contract_iter_kernel( thread_info   * i_thread_info,
-                               int64_t         i_id_loop,
-                               char    const * i_ptr_left,
-                               char    const * i_ptr_right,
-                               char    const * i_ptr_out_aux,
-                               char          * i_ptr_out,
-                               bool            i_first_access,
-                               bool            i_last_access );
+    void contract_iter_kernel( thread_info  const * i_thread_info,
+                               thread_state       * io_thread_state,
+                               int64_t              i_id_loop,
+                               char         const * i_ptr_left,
+                               char         const * i_ptr_right,
+                               char         const * i_ptr_out_aux,
+                               char               * i_ptr_out,
+                               bool                 i_first_access,
+                               bool                 i_last_access ) const;
 
     /**
      * calculates the shape of the kernel i.e. m, n, k, lda, ldb, ldc, ...
@@ -389,10 +545,24 @@ class einsum_ir::basic::ContractionBackend {
      **/
     err_t create_packing( int64_t              & o_packing_id,
                           int64_t              & o_size_packing,
-                          UnaryBackendTpp      & o_unary,
+                          UnaryBackend         & o_unary,
                           std::vector<int64_t> & i_strides,
                           std::vector<int64_t> & i_packing_strides );
 
+    /**
+     * Packs a block of an input tensor.
+     * The time of the packing is added to the thread's packing time if profiling is enabled.
+     *
+     * @param io_thread_state state of the executing thread.
+     * @param i_unary packing operation.
+     * @param i_in pointer to the data of the input tensor.
+     * @param o_out pointer to the packed data.
+     **/
+    void pack( thread_state       * io_thread_state,
+               UnaryBackend const & i_unary,
+               void         const * i_in,
+               void               * o_out ) const;
+
     /**
      * Kernel applied to the output tensor before the main primitive touches the memory.
      *
@@ -400,7 +570,7 @@ class einsum_ir::basic::ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     virtual void kernel_first_touch( void const * i_out_aux,
-                                     void       * io_out ) = 0;
+                                     void       * io_out ) const = 0;
 
     /**
      * Kernel applied to the output tensor after the main primitve finished using the memory.
@@ -409,7 +579,7 @@ class einsum_ir::basic::ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     virtual void kernel_last_touch( void const * i_out_aux,
-                                    void       * io_out ) = 0;
+                                    void       * io_out ) const = 0;
 
     /**
      * Kernel called in the innermost loop.
@@ -420,7 +590,7 @@ class einsum_ir::basic::ContractionBackend {
      **/
     virtual void kernel_main( void const * i_left,
                               void const * i_right,
-                              void       * io_out ) = 0;
+                              void       * io_out ) const = 0;
 
     /**
      * Compiles all kernels
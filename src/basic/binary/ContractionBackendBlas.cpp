@@ -5,6 +5,25 @@
 #include <cblas.h>
 #endif
 
+#ifdef PP_EINSUM_IR_HAS_BLAS_GEMM_BATCH
+namespace {
+  /**
+   * Derives the integer type of the CBLAS interface from the signature of cblas_sgemm,
+   * e.g., MKL_INT, blasint or nvpl_int_t.
+   **/
+  template< typename T_LAYOUT,
+            typename T_TRANS,
+            typename T_INT >
+  T_INT blas_int( void (*)( T_LAYOUT, T_TRANS, T_TRANS,
+                            T_INT, T_INT, T_INT,
+                            float, float const *, T_INT,
+                            float const *, T_INT,
+                            float, float *, T_INT ) );
+
+  typedef decltype( blas_int( &cblas_sgemm ) ) blas_int_t;
+}
+#endif
+
 void einsum_ir::basic::ContractionBackendBlas::kernel_zero_32( int64_t   i_m,
                                                                int64_t   i_n,
                                                                int64_t   i_ld,
@@ -116,7 +135,7 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_trans_64( int64_t   i_m,
 void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp32( float         i_alpha,
                                                                  void  const * i_a,
                                                                  void  const * i_b,
-                                                                 void        * io_c ) {
+                                                                 void        * io_c ) const {
   cblas_sgemm( CblasColMajor,
                m_trans_a ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
                m_trans_b ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
@@ -136,7 +155,7 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp32( float         i
 void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp64( double         i_alpha,
                                                                  void   const * i_a,
                                                                  void   const * i_b,
-                                                                 void         * io_c ) {
+                                                                 void         * io_c ) const {
   cblas_dgemm( CblasColMajor,
                m_trans_a ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
                m_trans_b ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
@@ -153,7 +172,182 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp64( double
                m_ldc );
 }
 
-void einsum_ir::basic::ContractionBackendBlas::kernel_first_touch_part( void * io_out ) {
+void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_batch_fp32( float          i_alpha,
+                                                                       int64_t        i_size,
+                                                                       void   const ** i_a,
+                                                                       void   const ** i_b,
+                                                                       void         ** io_c ) const {
+#ifdef PP_EINSUM_IR_HAS_BLAS_GEMM_BATCH
+  CBLAS_TRANSPOSE l_trans_a = m_trans_a ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans;
+  CBLAS_TRANSPOSE l_trans_b = m_trans_b ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans;
+  blas_int_t l_m = m_m;
+  blas_int_t l_n = m_n;
+  blas_int_t l_k = m_k;
+  blas_int_t l_lda = m_lda;
+  blas_int_t l_ldb = m_ldb;
+  blas_int_t l_ldc = m_ldc;
+  blas_int_t l_size = i_size;
+  float l_beta = 1.0f;
+
+  // single group: all GEMMs share the same parameters
+  cblas_sgemm_batch( CblasColMajor,
+                     &l_trans_a,
+                     &l_trans_b,
+                     &l_m,
+                     &l_n,
+                     &l_k,
+                     &i_alpha,
+                     (const float **) i_a,
+                     &l_lda,
+                     (const float **) i_b,
+                     &l_ldb,
+                     &l_beta,
+                     (float **) io_c,
+                     &l_ldc,
+                     1,
+                     &l_size );
+#else
+  for( int64_t l_ba = 0; l_ba < i_size; l_ba++ ) {
+    kernel_gemm_fp32( i_alpha,
+                      i_a[l_ba],
+                      i_b[l_ba],
+                      io_c[l_ba] );
+  }
+#endif
+}
+
+void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_batch_fp64( double         i_alpha,
+                                                                       int64_t        i_size,
+                                                                       void   const ** i_a,
+                                                                       void   const ** i_b,
+                                                                       void         ** io_c ) const {
+#ifdef PP_EINSUM_IR_HAS_BLAS_GEMM_BATCH
+  CBLAS_TRANSPOSE l_trans_a = m_trans_a ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans;
+  CBLAS_TRANSPOSE l_trans_b = m_trans_b ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans;
+  blas_int_t l_m = m_m;
+  blas_int_t l_n = m_n;
+  blas_int_t l_k = m_k;
+  blas_int_t l_lda = m_lda;
+  blas_int_t l_ldb = m_ldb;
+  blas_int_t l_ldc = m_ldc;
+  blas_int_t l_size = i_size;
+  double l_beta = 1.0;
+
+  // single group: all GEMMs share the same parameters
+  cblas_dgemm_batch( CblasColMajor,
+                     &l_trans_a,
+                     &l_trans_b,
+                     &l_m,
+                     &l_n,
+                     &l_k,
+                     &i_alpha,
+                     (const double **) i_a,
+                     &l_lda,
+                     (const double **) i_b,
+                     &l_ldb,
+                     &l_beta,
+                     (double **) io_c,
+                     &l_ldc,
+                     1,
+                     &l_size );
+#else
+  for( int64_t l_ba = 0; l_ba < i_size; l_ba++ ) {
+    kernel_gemm_fp64( i_alpha,
+                      i_a[l_ba],
+                      i_b[l_ba],
+                      io_c[l_ba] );
+  }
+#endif
+}
+
+void einsum_ir::basic::ContractionBackendBlas::kernel_main_part( double         i_alpha,
+                                                                 void   const * i_left,
+                                                                 void   const * i_right,
+                                                                 void         * io_out ) const {
+  void const * l_a[m_batch_chunk_size];
+  void const * l_b[m_batch_chunk_size];
+  void       * l_c[m_batch_chunk_size];
+  int64_t l_size = 0;
+
+  for( int64_t l_ba = 0; l_ba < m_batch_size; l_ba++ ) {
+    // packed GEMM primitive: ckm, cnk -> n[...]cm
+    for( uint64_t l_pa = 0; l_pa < m_r; l_pa++ ) {
+      l_a[l_size] = (char const *) i_left  + m_batch_offsets_left[l_ba]  + l_pa * m_packed_stride_a * m_num_bytes_scalar;
+      l_b[l_size] = (char const *) i_right + m_batch_offsets_right[l_ba] + l_pa * m_packed_stride_b * m_num_bytes_scalar;
+      l_c[l_size] = (char       *) io_out  + m_batch_offsets_out[l_ba]   + l_pa * m_m               * m_num_bytes_scalar;
+      l_size++;
+
+      if(    l_size == m_batch_chunk_size
+          || ( l_ba == m_batch_size - 1 && l_pa == m_r - 1 ) ) {
+        if( m_dtype_comp == data_t::FP32 ) {
+          kernel_gemm_batch_fp32( i_alpha,
+                                  l_size,
+                                  l_a,
+                                  l_b,
+                                  l_c );
+        }
+        else {
+          kernel_gemm_batch_fp64( i_alpha,
+                                  l_size,
+                                  l_a,
+                                  l_b,
+                                  l_c );
+        }
+        l_size = 0;
+      }
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackendBlas::init_batch() {
+  m_batch_size = 1;
+  m_batch_offsets_left.assign(  1, 0 );
+  m_batch_offsets_right.assign( 1, 0 );
+  m_batch_offsets_out.assign(   1, 0 );
+  m_batch_offsets_out_aux.assign( 1, 0 );
+
+  // packing is tied to the ids of the loops
+  for( std::size_t l_id = 0; l_id < m_packing_strides_left.size(); l_id++ ) {
+    if( m_packing_strides_left[l_id] != 0 ) return;
+  }
+  for( std::size_t l_id = 0; l_id < m_packing_strides_right.size(); l_id++ ) {
+    if( m_packing_strides_right[l_id] != 0 ) return;
+  }
+
+  // id of the outermost primitive loop
+  int64_t l_id_prim = m_exec_type.size();
+  while( l_id_prim > 0 && m_exec_type[l_id_prim-1] == exec_t::PRIM ) {
+    l_id_prim--;
+  }
+
+  // absorb loops from the inside out, K loops accumulate into the same output
+  int64_t l_id_first = l_id_prim;
+  while(    l_id_first > 0
+         && m_exec_type[l_id_first-1] == exec_t::SEQ
+         && (    m_dim_type[l_id_first-1] == dim_t::M
+              || m_dim_type[l_id_first-1] == dim_t::N
+              || m_dim_type[l_id_first-1] == dim_t::C )
+         && m_batch_size * m_dim_sizes[l_id_first-1] <= m_batch_size_max ) {
+    l_id_first--;
+    m_batch_size *= m_dim_sizes[l_id_first];
+  }
+
+  // derive offsets, the innermost loop is the fastest
+  for( int64_t l_id = l_id_prim - 1; l_id >= l_id_first; l_id-- ) {
+    std::size_t l_num_offsets = m_batch_offsets_out.size();
+    for( int64_t l_it = 1; l_it < m_dim_sizes[l_id]; l_it++ ) {
+      for( std::size_t l_of = 0; l_of < l_num_offsets; l_of++ ) {
+        m_batch_offsets_left.push_back(  m_batch_offsets_left[l_of]  + l_it * m_strides_left[l_id]  * ce_n_bytes( m_dtype_left  ) );
+        m_batch_offsets_right.push_back( m_batch_offsets_right[l_of] + l_it * m_strides_right[l_id] * ce_n_bytes( m_dtype_right ) );
+        m_batch_offsets_out.push_back(   m_batch_offsets_out[l_of]   + l_it * m_strides_out[l_id]   * ce_n_bytes( m_dtype_out   ) );
+        m_batch_offsets_out_aux.push_back( m_batch_offsets_out_aux[l_of] + l_it * m_strides_out_aux[l_id] * ce_n_bytes( m_dtype_out ) );
+      }
+    }
+    m_exec_type[l_id] = exec_t::PRIM;
+  }
+}
+
+void einsum_ir::basic::ContractionBackendBlas::kernel_first_touch_part( void * io_out ) const {
   if(    m_ktype_first_touch == kernel_t::ZERO
       || m_ktype_first_touch == kernel_t::CPX_ZERO ) {
     if( m_dtype_comp == data_t::FP32 ) {
@@ -192,22 +386,51 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_first_touch_part( void * i
   }
 }
 void einsum_ir::basic::ContractionBackendBlas::kernel_first_touch( void const *,
-                                                                   void       * io_out ) {
-  kernel_first_touch_part( io_out );
-  if( m_cpx_outer_c ) {
-    kernel_first_touch_part( (char *) io_out + m_cpx_stride_out_bytes );
+                                                                   void       * io_out ) const {
+  for( int64_t l_ba = 0; l_ba < m_batch_size; l_ba++ ) {
+    char * l_out = (char *) io_out + m_batch_offsets_out[l_ba];
+    kernel_first_touch_part( l_out );
+    if( m_cpx_outer_c ) {
+      kernel_first_touch_part( l_out + m_cpx_stride_out_bytes );
+    }
   }
 }
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendBlas::compile_kernels(){
+  // BLAS operates on FP32 or FP64 data only
+  if(    m_dtype_left  != m_dtype_comp
+      || m_dtype_right != m_dtype_comp
+      || m_dtype_out   != m_dtype_comp
+      || ( m_dtype_comp != FP32 && m_dtype_comp != FP64 ) ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
   m_num_bytes_scalar = ce_n_bytes( m_dtype_comp );
 
   m_cpx_outer_c = m_ktype_main == kernel_t::CPX_MADD || m_ktype_main == kernel_t::CPX_PACKED_MADD;
 
+  // single element-wise last touch operations are executed as epilogue
+  if(    m_ktype_last_touch == kernel_t::RELU
+      || m_ktype_last_touch == kernel_t::ADD ) {
+    m_epilogue.init( { m_ktype_last_touch },
+                     1.0,
+                     1.0 );
+    m_ktype_last_touch = kernel_t::EPILOGUE;
+  }
+  else if(    m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE
+           && m_ktype_last_touch != kernel_t::EPILOGUE ) {
+    return err_t::COMPILATION_FAILED;
+  }
+  if( m_ktype_last_touch == kernel_t::EPILOGUE && m_cpx_outer_c ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
   if( m_ktype_main == kernel_t::PACKED_MADD || m_ktype_main == kernel_t::CPX_PACKED_MADD){
     if(m_ktype_first_touch == kernel_t::UNDEFINED_KTYPE ){
       m_ktype_first_touch = kernel_t::CPX_COPY;
     }
-    m_ktype_last_touch = kernel_t::CPX_COPY;
+    if( m_ktype_last_touch == kernel_t::UNDEFINED_KTYPE ) {
+      m_ktype_last_touch = kernel_t::CPX_COPY;
+    }
   }
 
   // disable threading in OpenBLAS
@@ -215,121 +438,42 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendBlas::compile_kernel
   openblas_set_num_threads( 1 );
 #endif
 
+  // batch the GEMMs of the loops around the kernel
+  init_batch();
+
   return err_t::SUCCESS;
 }
 
 
 void einsum_ir::basic::ContractionBackendBlas::kernel_main( void const * i_left,
                                                             void const * i_right,
-                                                            void       * io_out ) {
-  // GEMM primitive
-  if( m_r == 1 ) {
-    if( m_dtype_comp == data_t::FP32 ) {
-      kernel_gemm_fp32( 1.0f,
-                        i_left,
-                        i_right,
-                        io_out );
-      if( m_cpx_outer_c ) {
-        // imag += real * imag
-        kernel_gemm_fp32( 1.0f,
-                          i_left,
-                          (char *) i_right + m_cpx_stride_in_right_bytes,
-                          (char *) io_out  + m_cpx_stride_out_bytes );
-        // imag += imag * real
-        kernel_gemm_fp32( 1.0f,
-                          (char *) i_left  + m_cpx_stride_in_left_bytes,
-                          i_right,
-                          (char *) io_out  + m_cpx_stride_out_bytes );
-        // real += imag * imag
-        kernel_gemm_fp32( -1.0f,
-                          (char *) i_left  + m_cpx_stride_in_left_bytes,
-                          (char *) i_right + m_cpx_stride_in_right_bytes,
-                          (char *) io_out  );
-      }
-    }
-    else {
-      kernel_gemm_fp64( 1.0,
-                        i_left,
-                        i_right,
-                        io_out );
-      if( m_cpx_outer_c ) {
-        // imag += real * imag
-        kernel_gemm_fp64( 1.0,
-                          i_left,
-                          (char *) i_right + m_cpx_stride_in_right_bytes,
-                          (char *) io_out  + m_cpx_stride_out_bytes );
-        // imag += imag * real
-        kernel_gemm_fp64( 1.0,
-                          (char *) i_left  + m_cpx_stride_in_left_bytes,
-                          i_right,
-                          (char *) io_out  + m_cpx_stride_out_bytes );
-        // real += imag * imag
-        kernel_gemm_fp64( -1.0,
-                          (char *) i_left  + m_cpx_stride_in_left_bytes,
-                          (char *) i_right + m_cpx_stride_in_right_bytes,
-                          (char *) io_out  );
-      }
-    }
-  }
-  // packed GEMM primitive: ckm, cnk -> n[...]cm
-  else {
-    for( uint64_t l_c = 0; l_c < m_r; l_c++ ) {
-      // derive pointers for current GEMM
-      void const * l_left  = (char *) i_left  + l_c * m_packed_stride_a * m_num_bytes_scalar;
-      void const * l_right = (char *) i_right + l_c * m_packed_stride_b * m_num_bytes_scalar;
-      void       * l_out   = (char *) io_out  + l_c * m_m * m_num_bytes_scalar;
-      // execute GEMM
-      if( m_dtype_comp == data_t::FP32 ) {
-        kernel_gemm_fp32( 1.0f,
-                          l_left,
-                          l_right,
-                          l_out );
-        if( m_cpx_outer_c ) {
-          // imag += real * imag
-          kernel_gemm_fp32( 1.0f,
-                            l_left,
-                            (char *) l_right + m_cpx_stride_in_right_bytes,
-                            (char *) l_out   + m_cpx_stride_out_bytes );
-          // imag += imag * real
-          kernel_gemm_fp32( 1.0f,
-                            (char *) l_left  + m_cpx_stride_in_left_bytes,
-                            l_right,
-                            (char *) l_out   + m_cpx_stride_out_bytes );
-          // real += imag * imag
-          kernel_gemm_fp32( -1.0f,
-                            (char *) l_left  + m_cpx_stride_in_left_bytes,
-                            (char *) l_right + m_cpx_stride_in_right_bytes,
-                            (char *) l_out  );
-        }
-      }
-      else if( m_dtype_comp == data_t::FP64  ) {
-        kernel_gemm_fp64( 1.0f,
-                          l_left,
-                          l_right,
-                          l_out );
-        if( m_cpx_outer_c ) {
-          // imag += real * imag
-          kernel_gemm_fp64( 1.0,
-                            l_left,
-                            (char *) l_right + m_cpx_stride_in_right_bytes,
-                            (char *) l_out   + m_cpx_stride_out_bytes );
-          // imag += imag * real
-          kernel_gemm_fp64( 1.0,
-                            (char *) l_left  + m_cpx_stride_in_left_bytes,
-                            l_right,
-                            (char *) l_out   + m_cpx_stride_out_bytes );
-          // real += imag * imag
-          kernel_gemm_fp64( -1.0,
-                            (char *) l_left  + m_cpx_stride_in_left_bytes,
-                            (char *) l_right + m_cpx_stride_in_right_bytes,
-                            (char *) l_out  );
-        }
-      }
-    }
+                                                            void       * io_out ) const {
+  kernel_main_part( 1.0,
+                    i_left,
+                    i_right,
+                    io_out );
+
+  if( m_cpx_outer_c ) {
+    // imag += real * imag
+    kernel_main_part( 1.0,
+                      i_left,
+                      (char *) i_right + m_cpx_stride_in_right_bytes,
+                      (char *) io_out  + m_cpx_stride_out_bytes );
+    // imag += imag * real
+    kernel_main_part( 1.0,
+                      (char *) i_left  + m_cpx_stride_in_left_bytes,
+                      i_right,
+                      (char *) io_out  + m_cpx_stride_out_bytes );
+    // real += imag * imag
+    kernel_main_part( -1.0,
+                      (char *) i_left  + m_cpx_stride_in_left_bytes,
+                      (char *) i_right + m_cpx_stride_in_right_bytes,
+                      (char *) io_out  );
   }
 }
 
-void einsum_ir::basic::ContractionBackendBlas::kernel_last_touch_part( void * io_out ) {
+void einsum_ir::basic::ContractionBackendBlas::kernel_last_touch_part( void const * i_out_aux,
+                                                                        void       * io_out ) const {
 
   if( m_r != 1 ) {
     // transpose part of the packed GEMM primitive: n[...]cm -> n[...]mc
@@ -352,12 +496,28 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_last_touch_part( void * io
       }
     }
   }
+
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    m_epilogue.apply( m_m * m_r,
+                      m_n,
+                      m_ldc,
+                      m_stride_m_out_aux,
+                      m_stride_n_out_aux,
+                      i_out_aux,
+                      io_out );
+  }
 }
 
-void einsum_ir::basic::ContractionBackendBlas::kernel_last_touch( void const *,
-                                                                  void       * io_out ) {
-  kernel_last_touch_part( io_out );
-  if( m_cpx_outer_c ) {
-    kernel_last_touch_part( (char *) io_out + m_cpx_stride_out_bytes );
+void einsum_ir::basic::ContractionBackendBlas::kernel_last_touch( void const * i_out_aux,
+                                                                  void       * io_out ) const {
+  for( int64_t l_ba = 0; l_ba < m_batch_size; l_ba++ ) {
+    char const * l_out_aux = (char const *) i_out_aux + m_batch_offsets_out_aux[l_ba];
+    char       * l_out     = (char       *) io_out    + m_batch_offsets_out[l_ba];
+    kernel_last_touch_part( l_out_aux,
+                            l_out );
+    if( m_cpx_outer_c ) {
+      kernel_last_touch_part( l_out_aux + m_cpx_stride_out_aux_bytes,
+                              l_out     + m_cpx_stride_out_bytes );
+    }
   }
 }
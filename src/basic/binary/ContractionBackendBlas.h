@@ -17,6 +17,27 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
     //! true if the outermost C dimension represents the complex dimension
     bool m_cpx_outer_c = false;
 
+    //! maximum number of GEMMs which are absorbed from the loops around the kernel
+    static constexpr int64_t m_batch_size_max = 256;
+
+    //! number of GEMMs issued in a single call of the BLAS library
+    static constexpr int64_t m_batch_chunk_size = 64;
+
+    //! number of entries in the batch of the main kernel
+    int64_t m_batch_size = 1;
+
+    //! byte offsets of the batch entries in the left tensor
+    std::vector< int64_t > m_batch_offsets_left;
+
+    //! byte offsets of the batch entries in the right tensor
+    std::vector< int64_t > m_batch_offsets_right;
+
+    //! byte offsets of the batch entries in the output tensor
+    std::vector< int64_t > m_batch_offsets_out;
+
+    //! byte offsets of the batch entries in the auxiliary output tensor
+    std::vector< int64_t > m_batch_offsets_out_aux;
+
     /**
      * 32-bit kernel zeroing a column-major matrix.
      *
@@ -85,7 +106,7 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
     void kernel_gemm_fp32( float         i_alpha,
                            void  const * i_a,
                            void  const * i_b,
-                           void        * io_c );
+                           void        * io_c ) const;
 
     /**
      * FP64 GEMM kernel.
@@ -98,21 +119,75 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
     void kernel_gemm_fp64( double         i_alpha,
                            void   const * i_a,
                            void   const * i_b,
-                           void         * io_c );
+                           void         * io_c ) const;
+
+    /**
+     * FP32 batched GEMM kernel.
+     * All GEMMs share the shape and leading dimensions of the kernel.
+     *
+     * @param i_alpha parameter alpha.
+     * @param i_size number of GEMMs.
+     * @param i_a pointers to the A matrices.
+     * @param i_b pointers to the B matrices.
+     * @param io_c pointers to the C matrices.
+     **/
+    void kernel_gemm_batch_fp32( float          i_alpha,
+                                 int64_t        i_size,
+                                 void   const ** i_a,
+                                 void   const ** i_b,
+                                 void         ** io_c ) const;
+
+    /**
+     * FP64 batched GEMM kernel.
+     * All GEMMs share the shape and leading dimensions of the kernel.
+     *
+     * @param i_alpha parameter alpha.
+     * @param i_size number of GEMMs.
+     * @param i_a pointers to the A matrices.
+     * @param i_b pointers to the B matrices.
+     * @param io_c pointers to the C matrices.
+     **/
+    void kernel_gemm_batch_fp64( double         i_alpha,
+                                 int64_t        i_size,
+                                 void   const ** i_a,
+                                 void   const ** i_b,
+                                 void         ** io_c ) const;
+
+    /**
+     * Executes the GEMMs of all batch entries and packed dimensions for a single real or imaginary part.
+     *
+     * @param i_alpha parameter alpha.
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_main_part( double         i_alpha,
+                           void   const * i_left,
+                           void   const * i_right,
+                           void         * io_out ) const;
+
+    /**
+     * Absorbs sequential M, N and C loops which directly surround the kernel into a batch.
+     * The GEMMs of these loops write to disjoint sections of the output tensor.
+     * The absorbed loops are turned into primitive loops.
+     **/
+    void init_batch();
 
     /**
      * Partially executes the first touch kernel on the given real or imaginary data section of the tensor.
      *
      * @param io_out pointer to a data section of the output tensor.
      **/
-    void kernel_first_touch_part( void * io_out );
+    void kernel_first_touch_part( void * io_out ) const;
 
     /**
      * Partially executes the last touch kernel on the given real or imaginary data section of the tensor.
      *
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
      * @param io_out pointer to a data section of the output tensor.
      **/
-    void kernel_last_touch_part( void * io_out );
+    void kernel_last_touch_part( void const * i_out_aux,
+                                 void       * io_out ) const;
 
   public:
     /**
@@ -122,7 +197,7 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     void kernel_first_touch( void const * i_out_aux,
-                             void       * io_out );
+                             void       * io_out ) const;
 
     /**
      * Executes the main kernel on the given data sections of the tensors.
@@ -133,7 +208,7 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
      **/
     void kernel_main( void const * i_left,
                       void const * i_right,
-                      void       * io_out );
+                      void       * io_out ) const;
 
     /**
      * Executes the last touch kernel on the given data section of the tensor.
@@ -142,7 +217,7 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     void kernel_last_touch( void const * i_out_aux,
-                            void       * io_out );
+                            void       * io_out ) const;
 
     /**
      * Compiles all kernels
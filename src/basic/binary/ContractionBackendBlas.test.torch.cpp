@@ -477,4 +477,84 @@ TEST_CASE( "FP32 packed tensor contraction using the BLAS contraction backend im
                           { l_left, l_right } );
 
   REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
-}
\ No newline at end of file
+}
+TEST_CASE( "Batched small FP32 GEMMs using the BLAS contraction backend implementation.", "[contraction_backend_blas]" ) {
+  // test case:
+  //
+  //    ____cxnm____
+  //   /            \
+  // yckm          ycxnk
+  //
+  // char    size   type
+  //    y    2      K (SEQ)
+  //    c    6      C (SEQ, batched)
+  //    x    3      N (SEQ, batched)
+  //    m    4      M (PRIM)
+  //    n    3      N (PRIM)
+  //    k    5      K (PRIM)
+
+  using namespace einsum_ir::basic;
+
+  at::Tensor l_left    = at::randn( { 2, 6, 5, 4 } );
+  at::Tensor l_right   = at::randn( { 2, 6, 3, 3, 5 } );
+  at::Tensor l_out     = at::randn( { 6, 3, 3, 4 } );
+  at::Tensor l_out_ref = l_out.clone();
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::C,
+                                             dim_t::N,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                    y,  c,  x, m, n, k
+  std::vector< int64_t > l_loop_sizes            = {    2,  6,  3, 4, 3, 5 };
+  std::vector< int64_t > l_loop_strides_left     = {  120, 20,  0, 1, 0, 4 };
+  std::vector< int64_t > l_loop_strides_right    = {  270, 45, 15, 0, 5, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {    0,  0,  0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {    0, 36, 12, 1, 4, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+
+  ContractionBackendBlas l_cont_blas;
+
+  l_cont_blas.init( l_loop_dim_type,
+                    l_loop_exec_type,
+                    l_loop_sizes,
+                    l_loop_strides_left,
+                    l_loop_strides_right,
+                    l_loop_strides_out_aux,
+                    l_loop_strides_out,
+                    l_packing_strides_left,
+                    l_packing_strides_right,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    kernel_t::ZERO,
+                    kernel_t::MADD,
+                    kernel_t::UNDEFINED_KTYPE,
+                    1,
+                    1,
+                    1,
+                    nullptr );
+  err_t l_err = l_cont_blas.compile();
+  REQUIRE(l_err == err_t::SUCCESS );
+
+  l_cont_blas.contract( l_left.data_ptr(),
+                        l_right.data_ptr(),
+                        nullptr,
+                        l_out.data_ptr() );
+
+  l_out_ref = at::einsum( "yckm,ycxnk->cxnm",
+                          { l_left, l_right } );
+
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+}
@@ -1,5 +1,6 @@
 
 #include "ContractionBackendScalar.h"
+#include "../low_precision.h"
 
 template < typename T >
 void einsum_ir::basic::ContractionBackendScalar::kernel_zero( void const *,
@@ -26,6 +27,7 @@ void einsum_ir::basic::ContractionBackendScalar::kernel_copy( void const * i_dat
 
 template < typename T_LEFT,
            typename T_RIGHT,
+           typename T_COMP,
            typename T_OUT >
 void einsum_ir::basic::ContractionBackendScalar::kernel_madd( void const * i_left,
                                                               void const * i_right,
@@ -34,7 +36,7 @@ void einsum_ir::basic::ContractionBackendScalar::kernel_madd( void const * i_lef
   T_RIGHT const * l_right = (T_RIGHT const *) i_right;
   T_OUT         * l_out   = (T_OUT         *) io_out;
 
-  *l_out += (*l_left) * (*l_right);
+  *l_out = T_OUT( T_COMP(*l_out) + T_COMP(*l_left) * T_COMP(*l_right) );
 }
 
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kernels() {
@@ -47,9 +49,12 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     return err_t::COMPILATION_FAILED;
   }
 
-  // determine if all dtypes are FP32 or FP64
+  // determine if all dtypes are FP32 or FP64,
+  // or if BF16 / FP16 is used for storage with FP32 computations
   bool l_dtype_all_fp32 = false;
   bool l_dtype_all_fp64 = false;
+  bool l_dtype_bf16 = false;
+  bool l_dtype_fp16 = false;
 
   if(    m_dtype_left  == FP32
       && m_dtype_right == FP32
@@ -63,6 +68,18 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
            && m_dtype_out   == FP64 ) {
     l_dtype_all_fp64 = true;
   }
+  else if(    m_dtype_left  == BF16
+           && m_dtype_right == BF16
+           && m_dtype_comp  == FP32
+           && m_dtype_out   == BF16 ) {
+    l_dtype_bf16 = true;
+  }
+  else if(    m_dtype_left  == FP16
+           && m_dtype_right == FP16
+           && m_dtype_comp  == FP32
+           && m_dtype_out   == FP16 ) {
+    l_dtype_fp16 = true;
+  }
   else {
     return err_t::COMPILATION_FAILED;
   }
@@ -75,6 +92,12 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     else if( l_dtype_all_fp64 ) {
       m_kernel_first_touch = &kernel_zero< double >;
     }
+    else if( l_dtype_bf16 ) {
+      m_kernel_first_touch = &kernel_zero< bf16_t >;
+    }
+    else if( l_dtype_fp16 ) {
+      m_kernel_first_touch = &kernel_zero< fp16_t >;
+    }
   }
   else if( m_ktype_first_touch == kernel_t::COPY ) {
     if( l_dtype_all_fp32 ) {
@@ -83,6 +106,12 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     else if( l_dtype_all_fp64 ) {
       m_kernel_first_touch = &kernel_copy< double >;
     }
+    else if( l_dtype_bf16 ) {
+      m_kernel_first_touch = &kernel_copy< bf16_t >;
+    }
+    else if( l_dtype_fp16 ) {
+      m_kernel_first_touch = &kernel_copy< fp16_t >;
+    }
   }
   else if( m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE ) {
     return err_t::COMPILATION_FAILED;
@@ -91,10 +120,23 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
   // main kernel
   if( m_ktype_main == kernel_t::MADD ) {
     if( l_dtype_all_fp32 ) {
-      m_kernel_main = &kernel_madd< float, float, float >;
+      m_kernel_main = &kernel_madd< float, float, float, float >;
     }
     else if( l_dtype_all_fp64 ) {
-      m_kernel_main = &kernel_madd< double, double, double >;
+      m_kernel_main = &kernel_madd< double, double, double, double >;
+    }
+    // low-precision outputs are accumulated in FP32 if loops over K surround the kernel
+    else if( l_dtype_bf16 && m_dtype_out_main == FP32 ) {
+      m_kernel_main = &kernel_madd< bf16_t, bf16_t, float, float >;
+    }
+    else if( l_dtype_bf16 ) {
+      m_kernel_main = &kernel_madd< bf16_t, bf16_t, float, bf16_t >;
+    }
+    else if( l_dtype_fp16 && m_dtype_out_main == FP32 ) {
+      m_kernel_main = &kernel_madd< fp16_t, fp16_t, float, float >;
+    }
+    else if( l_dtype_fp16 ) {
+      m_kernel_main = &kernel_madd< fp16_t, fp16_t, float, fp16_t >;
     }
   }
   else {
@@ -109,8 +151,15 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     else if( l_dtype_all_fp64 ) {
       m_kernel_last_touch = &kernel_relu< double >;
     }
+    else if( l_dtype_bf16 ) {
+      m_kernel_last_touch = &kernel_relu< bf16_t >;
+    }
+    else if( l_dtype_fp16 ) {
+      m_kernel_last_touch = &kernel_relu< fp16_t >;
+    }
   }
-  else if( m_ktype_last_touch != UNDEFINED_KTYPE ) {
+  else if(    m_ktype_last_touch != UNDEFINED_KTYPE
+           && m_ktype_last_touch != EPILOGUE ) {
     return err_t::COMPILATION_FAILED;
   }
 
@@ -119,7 +168,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
 
 
 void einsum_ir::basic::ContractionBackendScalar::kernel_first_touch( void const * i_out_aux,
-                                                                     void       * io_out ) {
+                                                                     void       * io_out ) const {
   if( m_kernel_first_touch != nullptr ) {
     m_kernel_first_touch( i_out_aux,
                           io_out );
@@ -128,16 +177,25 @@ void einsum_ir::basic::ContractionBackendScalar::kernel_first_touch( void const
 
 void einsum_ir::basic::ContractionBackendScalar::kernel_main( void const * i_left,
                                                               void const * i_right,
-                                                              void       * io_out ) {
+                                                              void       * io_out ) const {
   m_kernel_main( i_left,
                  i_right,
                  io_out );
 }
 
 void einsum_ir::basic::ContractionBackendScalar::kernel_last_touch( void const * i_out_aux,
-                                                                    void       * io_out ) {
+                                                                    void       * io_out ) const {
   if( m_kernel_last_touch != nullptr ) {
     m_kernel_last_touch( i_out_aux,
                          io_out );
   }
+  else if( m_ktype_last_touch == EPILOGUE ) {
+    m_epilogue.apply( 1,
+                      1,
+                      1,
+                      0,
+                      0,
+                      i_out_aux,
+                      io_out );
+  }
 }
\ No newline at end of file
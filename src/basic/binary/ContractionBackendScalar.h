@@ -47,10 +47,12 @@ class einsum_ir::basic::ContractionBackendScalar: public ContractionBackend {
      *
      * @param_t T_LEFT data type of the left input.
      * @param_t T_RIGHT data type of the right input.
+     * @param_t T_COMP data type of the computations.
      * @param_t T_OUT data type of the output.
      **/
     template < typename T_LEFT,
                typename T_RIGHT,
+               typename T_COMP,
                typename T_OUT >
     static void kernel_madd( void const * i_in_left,
                              void const * i_in_right,
@@ -77,7 +79,7 @@ class einsum_ir::basic::ContractionBackendScalar: public ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     void kernel_first_touch( void const * i_out_aux,
-                             void       * io_out );
+                             void       * io_out ) const;
 
     /**
      * Executes the main kernel on the given data sections of the tensors.
@@ -88,7 +90,7 @@ class einsum_ir::basic::ContractionBackendScalar: public ContractionBackend {
      **/
     void kernel_main( void const * i_left,
                       void const * i_right,
-                      void       * io_out );
+                      void       * io_out ) const;
 
     /**
      * Executes the last touch kernel on the given data section of the tensor.
@@ -97,7 +99,7 @@ class einsum_ir::basic::ContractionBackendScalar: public ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     void kernel_last_touch( void const * i_out_aux,
-                            void       * io_out );
+                            void       * io_out ) const;
 
     /**
      * Compiles all kernels
@@ -626,3 +626,86 @@ TEST_CASE( "Binary contraction involving C, M, N and K dimensions using FP64, ze
 
   REQUIRE( at::allclose( l_out, l_out_ref )  );
 }
+
+TEST_CASE( "BF16 and FP16 matmul with a long K dimension using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // Test Case:
+  //
+  //      ____nm____
+  //     /          |
+  //  xkm           nxk
+  //
+  // char   id   size
+  //    x    0     16
+  //    m    1      3
+  //    n    2      2
+  //    k    3    128
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                   x, m,   n,  k,mp,np,kp
+  std::vector< int64_t > l_loop_sizes            = {  16, 3,   2,128, 1, 1, 1 };
+  std::vector< int64_t > l_loop_strides_left     = { 384, 1,   0,  3, 1, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = { 128, 0,2048,  1, 0, 1, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 0,   0,  0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {   0, 1,   3,  0, 1, 1, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // the running sums are kept in FP32 across all 2048 steps, rounding them after every step exceeds the tolerances
+  for( data_t l_dtype : { data_t::BF16, data_t::FP16 } ) {
+    at::ScalarType l_dtype_at = ( l_dtype == data_t::BF16 ) ? at::kBFloat16 : at::kHalf;
+    double l_rtol = ( l_dtype == data_t::BF16 ) ? 1E-2 : 1E-3;
+
+    ContractionBackendScalar l_bin_cont;
+    l_bin_cont.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     l_dtype,
+                     l_dtype,
+                     data_t::FP32,
+                     l_dtype,
+                     kernel_t::ZERO,
+                     kernel_t::MADD,
+                     kernel_t::UNDEFINED_KTYPE,
+                     1,
+                     1,
+                     1,
+                     nullptr );
+    // data
+    at::Tensor l_in_left  = at::rand( {16, 128, 3} ).to( l_dtype_at );
+    at::Tensor l_in_right = at::rand( {2, 16, 128} ).to( l_dtype_at );
+    at::Tensor l_out      = at::zeros( {2, 3} ).to( l_dtype_at );
+
+    // reference
+    at::Tensor l_out_ref = at::einsum( "xkm,nxk->nm",
+                                       {l_in_left.to( at::kFloat ), l_in_right.to( at::kFloat )} );
+
+    REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+    l_bin_cont.contract( l_in_left.data_ptr(),
+                         l_in_right.data_ptr(),
+                         nullptr,
+                         l_out.data_ptr() );
+
+    REQUIRE( at::allclose( l_out.to( at::kFloat ), l_out_ref, l_rtol, 0 ) );
+  }
+}
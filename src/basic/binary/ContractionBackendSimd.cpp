@@ -0,0 +1,822 @@
+#include "ContractionBackendSimd.h"
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+  /**
+   * Appends the microkernels for 1, ..., NR columns to the given vector.
+   *
+   * @param_t T_KERNEL microkernel template.
+   * @param_t T data type.
+   * @param_t NR maximum number of columns.
+   * @param io_kernels vector to which the kernels are appended.
+   **/
+  template< template< typename, int64_t > class T_KERNEL,
+            typename T,
+            int64_t NR >
+  void fill_kernels( std::vector< einsum_ir::basic::ContractionBackendSimd::kernel_gemm_t > & io_kernels ) {
+    if constexpr( NR > 1 ) {
+      fill_kernels< T_KERNEL, T, NR-1 >( io_kernels );
+    }
+    io_kernels.push_back( &T_KERNEL< T, NR >::kernel );
+  }
+
+  /**
+   * Generic microkernel which relies on the compiler's vectorization.
+   **/
+  template< typename T, int64_t NR >
+  struct GemmGeneric {
+    static constexpr int64_t nr = 4;
+
+    static void kernel( int64_t         i_m,
+                        int64_t         i_k,
+                        void    const * i_a,
+                        int64_t         i_lda,
+                        void    const * i_b,
+                        int64_t         i_rs_b,
+                        int64_t         i_cs_b,
+                        void          * io_c,
+                        int64_t         i_ldc ) {
+      T const * l_a = (T const *) i_a;
+      T const * l_b = (T const *) i_b;
+      T       * l_c = (T       *) io_c;
+
+      for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+        for( int64_t l_k = 0; l_k < i_k; l_k++ ) {
+          T l_b_kn = l_b[ l_k * i_rs_b + l_n * i_cs_b ];
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+          for( int64_t l_m = 0; l_m < i_m; l_m++ ) {
+            l_c[ l_n * i_ldc + l_m ] += l_a[ l_k * i_lda + l_m ] * l_b_kn;
+          }
+        }
+      }
+    }
+  };
+
+#if defined(__x86_64__)
+  /*
+   * AVX-512 microkernels.
+   * The kernels block two vectors in the m-dimension and NR columns.
+   * Remaining rows are processed with masked loads and stores.
+   */
+#if defined(__clang__)
+#pragma clang attribute push( __attribute__((target("avx512f"))), apply_to = function )
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+  template< typename T >
+  struct Avx512;
+
+  template<>
+  struct Avx512< float > {
+    typedef __m512    vec_t;
+    typedef __mmask16 mask_t;
+    static constexpr int64_t w = 16;
+
+    static inline mask_t mask( int64_t i_count ) {
+      return (mask_t) ( ( 1u << i_count ) - 1 );
+    }
+    template< bool T_MASKED >
+    static inline vec_t load( float const * i_ptr,
+                              mask_t        i_mask ) {
+      if constexpr( T_MASKED ) return _mm512_maskz_loadu_ps( i_mask, i_ptr );
+      else                     return _mm512_loadu_ps( i_ptr );
+    }
+    template< bool T_MASKED >
+    static inline void store( float  * o_ptr,
+                              vec_t    i_vec,
+                              mask_t   i_mask ) {
+      if constexpr( T_MASKED ) _mm512_mask_storeu_ps( o_ptr, i_mask, i_vec );
+      else                     _mm512_storeu_ps( o_ptr, i_vec );
+    }
+    static inline vec_t bcast( float i_val ) {
+      return _mm512_set1_ps( i_val );
+    }
+    static inline vec_t fmadd( vec_t i_a,
+                               vec_t i_b,
+                               vec_t i_c ) {
+      return _mm512_fmadd_ps( i_a, i_b, i_c );
+    }
+  };
+
+  template<>
+  struct Avx512< double > {
+    typedef __m512d  vec_t;
+    typedef __mmask8 mask_t;
+    static constexpr int64_t w = 8;
+
+    static inline mask_t mask( int64_t i_count ) {
+      return (mask_t) ( ( 1u << i_count ) - 1 );
+    }
+    template< bool T_MASKED >
+    static inline vec_t load( double const * i_ptr,
+                              mask_t         i_mask ) {
+      if constexpr( T_MASKED ) return _mm512_maskz_loadu_pd( i_mask, i_ptr );
+      else                     return _mm512_loadu_pd( i_ptr );
+    }
+    template< bool T_MASKED >
+    static inline void store( double * o_ptr,
+                              vec_t    i_vec,
+                              mask_t   i_mask ) {
+      if constexpr( T_MASKED ) _mm512_mask_storeu_pd( o_ptr, i_mask, i_vec );
+      else                     _mm512_storeu_pd( o_ptr, i_vec );
+    }
+    static inline vec_t bcast( double i_val ) {
+      return _mm512_set1_pd( i_val );
+    }
+    static inline vec_t fmadd( vec_t i_a,
+                               vec_t i_b,
+                               vec_t i_c ) {
+      return _mm512_fmadd_pd( i_a, i_b, i_c );
+    }
+  };
+
+  template< typename T, int64_t NR >
+  struct GemmAvx512 {
+    typedef Avx512< T > V;
+    static constexpr int64_t nr = 12;
+
+    template< bool T_MASKED >
+    static inline void block( int64_t                      i_k,
+                              T                    const * i_a,
+                              int64_t                      i_lda,
+                              T                    const * i_b,
+                              int64_t                      i_rs_b,
+                              int64_t                      i_cs_b,
+                              T                          * io_c,
+                              int64_t                      i_ldc,
+                              typename V::mask_t           i_mask_0,
+                              typename V::mask_t           i_mask_1 ) {
+      typename V::vec_t l_c_0[NR];
+      typename V::vec_t l_c_1[NR];
+
+#pragma GCC unroll 16
+      for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+        l_c_0[l_n] = V::template load< T_MASKED >( io_c + l_n * i_ldc,        i_mask_0 );
+        l_c_1[l_n] = V::template load< T_MASKED >( io_c + l_n * i_ldc + V::w, i_mask_1 );
+      }
+
+      for( int64_t l_k = 0; l_k < i_k; l_k++ ) {
+        typename V::vec_t l_a_0 = V::template load< T_MASKED >( i_a + l_k * i_lda,        i_mask_0 );
+        typename V::vec_t l_a_1 = V::template load< T_MASKED >( i_a + l_k * i_lda + V::w, i_mask_1 );
+#pragma GCC unroll 16
+        for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+          typename V::vec_t l_b = V::bcast( i_b[ l_k * i_rs_b + l_n * i_cs_b ] );
+          l_c_0[l_n] = V::fmadd( l_a_0, l_b, l_c_0[l_n] );
+          l_c_1[l_n] = V::fmadd( l_a_1, l_b, l_c_1[l_n] );
+        }
+      }
+
+#pragma GCC unroll 16
+      for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+        V::template store< T_MASKED >( io_c + l_n * i_ldc,        l_c_0[l_n], i_mask_0 );
+        V::template store< T_MASKED >( io_c + l_n * i_ldc + V::w, l_c_1[l_n], i_mask_1 );
+      }
+    }
+
+    static void kernel( int64_t         i_m,
+                        int64_t         i_k,
+                        void    const * i_a,
+                        int64_t         i_lda,
+                        void    const * i_b,
+                        int64_t         i_rs_b,
+                        int64_t         i_cs_b,
+                        void          * io_c,
+                        int64_t         i_ldc ) {
+      T const * l_a = (T const *) i_a;
+      T const * l_b = (T const *) i_b;
+      T       * l_c = (T       *) io_c;
+
+      int64_t l_m = 0;
+      for( ; l_m + 2*V::w <= i_m; l_m += 2*V::w ) {
+        block< false >( i_k, l_a + l_m, i_lda, l_b, i_rs_b, i_cs_b, l_c + l_m, i_ldc, 0, 0 );
+      }
+      if( l_m < i_m ) {
+        int64_t l_rem = i_m - l_m;
+        block< true >( i_k, l_a + l_m, i_lda, l_b, i_rs_b, i_cs_b, l_c + l_m, i_ldc,
+                       V::mask( std::min( l_rem, V::w ) ),
+                       V::mask( std::max( l_rem - V::w, int64_t(0) ) ) );
+      }
+    }
+  };
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+  /*
+   * AVX2 microkernels.
+   * Same blocking as the AVX-512 kernels with masks stored in vector registers.
+   */
+#if defined(__clang__)
+#pragma clang attribute push( __attribute__((target("avx2,fma"))), apply_to = function )
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+  template< typename T >
+  struct Avx2;
+
+  template<>
+  struct Avx2< float > {
+    typedef __m256  vec_t;
+    typedef __m256i mask_t;
+    static constexpr int64_t w = 8;
+
+    static inline mask_t mask( int64_t i_count ) {
+      return _mm256_cmpgt_epi32( _mm256_set1_epi32( (int) i_count ),
+                                 _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+    }
+    template< bool T_MASKED >
+    static inline vec_t load( float const * i_ptr,
+                              mask_t        i_mask ) {
+      if constexpr( T_MASKED ) return _mm256_maskload_ps( i_ptr, i_mask );
+      else                     return _mm256_loadu_ps( i_ptr );
+    }
+    template< bool T_MASKED >
+    static inline void store( float  * o_ptr,
+                              vec_t    i_vec,
+                              mask_t   i_mask ) {
+      if constexpr( T_MASKED ) _mm256_maskstore_ps( o_ptr, i_mask, i_vec );
+      else                     _mm256_storeu_ps( o_ptr, i_vec );
+    }
+    static inline vec_t bcast( float i_val ) {
+      return _mm256_set1_ps( i_val );
+    }
+    static inline vec_t fmadd( vec_t i_a,
+                               vec_t i_b,
+                               vec_t i_c ) {
+      return _mm256_fmadd_ps( i_a, i_b, i_c );
+    }
+  };
+
+  template<>
+  struct Avx2< double > {
+    typedef __m256d vec_t;
+    typedef __m256i mask_t;
+    static constexpr int64_t w = 4;
+
+    static inline mask_t mask( int64_t i_count ) {
+      return _mm256_cmpgt_epi64( _mm256_set1_epi64x( i_count ),
+                                 _mm256_setr_epi64x( 0, 1, 2, 3 ) );
+    }
+    template< bool T_MASKED >
+    static inline vec_t load( double const * i_ptr,
+                              mask_t         i_mask ) {
+      if constexpr( T_MASKED ) return _mm256_maskload_pd( i_ptr, i_mask );
+      else                     return _mm256_loadu_pd( i_ptr );
+    }
+    template< bool T_MASKED >
+    static inline void store( double * o_ptr,
+                              vec_t    i_vec,
+                              mask_t   i_mask ) {
+      if constexpr( T_MASKED ) _mm256_maskstore_pd( o_ptr, i_mask, i_vec );
+      else                     _mm256_storeu_pd( o_ptr, i_vec );
+    }
+    static inline vec_t bcast( double i_val ) {
+      return _mm256_set1_pd( i_val );
+    }
+    static inline vec_t fmadd( vec_t i_a,
+                               vec_t i_b,
+                               vec_t i_c ) {
+      return _mm256_fmadd_pd( i_a, i_b, i_c );
+    }
+  };
+
+  template< typename T, int64_t NR >
+  struct GemmAvx2 {
+    typedef Avx2< T > V;
+    static constexpr int64_t nr = 6;
+
+    template< bool T_MASKED >
+    static inline void block( int64_t                      i_k,
+                              T                    const * i_a,
+                              int64_t                      i_lda,
+                              T                    const * i_b,
+                              int64_t                      i_rs_b,
+                              int64_t                      i_cs_b,
+                              T                          * io_c,
+                              int64_t                      i_ldc,
+                              typename V::mask_t           i_mask_0,
+                              typename V::mask_t           i_mask_1 ) {
+      typename V::vec_t l_c_0[NR];
+      typename V::vec_t l_c_1[NR];
+
+#pragma GCC unroll 16
+      for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+        l_c_0[l_n] = V::template load< T_MASKED >( io_c + l_n * i_ldc,        i_mask_0 );
+        l_c_1[l_n] = V::template load< T_MASKED >( io_c + l_n * i_ldc + V::w, i_mask_1 );
+      }
+
+      for( int64_t l_k = 0; l_k < i_k; l_k++ ) {
+        typename V::vec_t l_a_0 = V::template load< T_MASKED >( i_a + l_k * i_lda,        i_mask_0 );
+        typename V::vec_t l_a_1 = V::template load< T_MASKED >( i_a + l_k * i_lda + V::w, i_mask_1 );
+#pragma GCC unroll 16
+        for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+          typename V::vec_t l_b = V::bcast( i_b[ l_k * i_rs_b + l_n * i_cs_b ] );
+          l_c_0[l_n] = V::fmadd( l_a_0, l_b, l_c_0[l_n] );
+          l_c_1[l_n] = V::fmadd( l_a_1, l_b, l_c_1[l_n] );
+        }
+      }
+
+#pragma GCC unroll 16
+      for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+        V::template store< T_MASKED >( io_c + l_n * i_ldc,        l_c_0[l_n], i_mask_0 );
+        V::template store< T_MASKED >( io_c + l_n * i_ldc + V::w, l_c_1[l_n], i_mask_1 );
+      }
+    }
+
+    static void kernel( int64_t         i_m,
+                        int64_t         i_k,
+                        void    const * i_a,
+                        int64_t         i_lda,
+                        void    const * i_b,
+                        int64_t         i_rs_b,
+                        int64_t         i_cs_b,
+                        void          * io_c,
+                        int64_t         i_ldc ) {
+      T const * l_a = (T const *) i_a;
+      T const * l_b = (T const *) i_b;
+      T       * l_c = (T       *) io_c;
+
+      typename V::mask_t l_mask_full = V::mask( V::w );
+
+      int64_t l_m = 0;
+      for( ; l_m + 2*V::w <= i_m; l_m += 2*V::w ) {
+        block< false >( i_k, l_a + l_m, i_lda, l_b, i_rs_b, i_cs_b, l_c + l_m, i_ldc, l_mask_full, l_mask_full );
+      }
+      if( l_m < i_m ) {
+        int64_t l_rem = i_m - l_m;
+        block< true >( i_k, l_a + l_m, i_lda, l_b, i_rs_b, i_cs_b, l_c + l_m, i_ldc,
+                       V::mask( std::min( l_rem, V::w ) ),
+                       V::mask( std::max( l_rem - V::w, int64_t(0) ) ) );
+      }
+    }
+  };
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif
+
+#if defined(__aarch64__)
+  /*
+   * NEON microkernels.
+   * Advanced SIMD is part of the baseline of AArch64, no target attributes are required.
+   * Rows which do not fill a vector are processed by a scalar loop.
+   */
+  template< typename T >
+  struct Neon;
+
+  template<>
+  struct Neon< float > {
+    typedef float32x4_t vec_t;
+    static constexpr int64_t w = 4;
+
+    static inline vec_t load( float const * i_ptr ) {
+      return vld1q_f32( i_ptr );
+    }
+    static inline void store( float * o_ptr,
+                              vec_t   i_vec ) {
+      vst1q_f32( o_ptr, i_vec );
+    }
+    static inline vec_t bcast( float i_val ) {
+      return vdupq_n_f32( i_val );
+    }
+    static inline vec_t fmadd( vec_t i_a,
+                               vec_t i_b,
+                               vec_t i_c ) {
+      return vfmaq_f32( i_c, i_a, i_b );
+    }
+  };
+
+  template<>
+  struct Neon< double > {
+    typedef float64x2_t vec_t;
+    static constexpr int64_t w = 2;
+
+    static inline vec_t load( double const * i_ptr ) {
+      return vld1q_f64( i_ptr );
+    }
+    static inline void store( double * o_ptr,
+                              vec_t    i_vec ) {
+      vst1q_f64( o_ptr, i_vec );
+    }
+    static inline vec_t bcast( double i_val ) {
+      return vdupq_n_f64( i_val );
+    }
+    static inline vec_t fmadd( vec_t i_a,
+                               vec_t i_b,
+                               vec_t i_c ) {
+      return vfmaq_f64( i_c, i_a, i_b );
+    }
+  };
+
+  template< typename T, int64_t NR >
+  struct GemmNeon {
+    typedef Neon< T > V;
+    static constexpr int64_t nr = 8;
+
+    template< int64_t T_NUM_VECS >
+    static inline void block( int64_t         i_k,
+                              T       const * i_a,
+                              int64_t         i_lda,
+                              T       const * i_b,
+                              int64_t         i_rs_b,
+                              int64_t         i_cs_b,
+                              T             * io_c,
+                              int64_t         i_ldc ) {
+      typename V::vec_t l_c[NR][T_NUM_VECS];
+
+#pragma GCC unroll 16
+      for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+        for( int64_t l_ve = 0; l_ve < T_NUM_VECS; l_ve++ ) {
+          l_c[l_n][l_ve] = V::load( io_c + l_n * i_ldc + l_ve * V::w );
+        }
+      }
+
+      for( int64_t l_k = 0; l_k < i_k; l_k++ ) {
+        typename V::vec_t l_a[T_NUM_VECS];
+        for( int64_t l_ve = 0; l_ve < T_NUM_VECS; l_ve++ ) {
+          l_a[l_ve] = V::load( i_a + l_k * i_lda + l_ve * V::w );
+        }
+#pragma GCC unroll 16
+        for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+          typename V::vec_t l_b = V::bcast( i_b[ l_k * i_rs_b + l_n * i_cs_b ] );
+          for( int64_t l_ve = 0; l_ve < T_NUM_VECS; l_ve++ ) {
+            l_c[l_n][l_ve] = V::fmadd( l_a[l_ve], l_b, l_c[l_n][l_ve] );
+          }
+        }
+      }
+
+#pragma GCC unroll 16
+      for( int64_t l_n = 0; l_n < NR; l_n++ ) {
+        for( int64_t l_ve = 0; l_ve < T_NUM_VECS; l_ve++ ) {
+          V::store( io_c + l_n * i_ldc + l_ve * V::w, l_c[l_n][l_ve] );
+        }
+      }
+    }
+
+    static void kernel( int64_t         i_m,
+                        int64_t         i_k,
+                        void    const * i_a,
+                        int64_t         i_lda,
+                        void    const * i_b,
+                        int64_t         i_rs_b,
+                        int64_t         i_cs_b,
+                        void          * io_c,
+                        int64_t         i_ldc ) {
+      T const * l_a = (T const *) i_a;
+      T const * l_b = (T const *) i_b;
+      T       * l_c = (T       *) io_c;
+
+      int64_t l_m = 0;
+      for( ; l_m + 2*V::w <= i_m; l_m += 2*V::w ) {
+        block< 2 >( i_k, l_a + l_m, i_lda, l_b, i_rs_b, i_cs_b, l_c + l_m, i_ldc );
+      }
+      if( l_m + V::w <= i_m ) {
+        block< 1 >( i_k, l_a + l_m, i_lda, l_b, i_rs_b, i_cs_b, l_c + l_m, i_ldc );
+        l_m += V::w;
+      }
+      if( l_m < i_m ) {
+        GemmGeneric< T, NR >::kernel( i_m - l_m, i_k, l_a + l_m, i_lda, l_b, i_rs_b, i_cs_b, l_c + l_m, i_ldc );
+      }
+    }
+  };
+#endif
+
+  /**
+   * Fills the microkernels of the given instruction set.
+   *
+   * @param_t T data type.
+   * @param i_simd instruction set.
+   * @param o_kernels will be set to the microkernels.
+   **/
+  template< typename T >
+  void select_kernels( einsum_ir::basic::simd_t                                                 i_simd,
+                       std::vector< einsum_ir::basic::ContractionBackendSimd::kernel_gemm_t > & o_kernels ) {
+    o_kernels.clear();
+
+#if defined(__x86_64__)
+    if( i_simd == einsum_ir::basic::simd_t::AVX512 ) {
+      fill_kernels< GemmAvx512, T, GemmAvx512< T, 1 >::nr >( o_kernels );
+      return;
+    }
+    if( i_simd == einsum_ir::basic::simd_t::AVX2 ) {
+      fill_kernels< GemmAvx2, T, GemmAvx2< T, 1 >::nr >( o_kernels );
+      return;
+    }
+#endif
+#if defined(__aarch64__)
+    if( i_simd == einsum_ir::basic::simd_t::NEON ) {
+      fill_kernels< GemmNeon, T, GemmNeon< T, 1 >::nr >( o_kernels );
+      return;
+    }
+#endif
+    fill_kernels< GemmGeneric, T, GemmGeneric< T, 1 >::nr >( o_kernels );
+  }
+}
+
+einsum_ir::basic::simd_t einsum_ir::basic::ContractionBackendSimd::detect_simd() {
+#if defined(__x86_64__) && ( defined(__GNUC__) || defined(__clang__) )
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "avx512f" ) ) {
+    return simd_t::AVX512;
+  }
+  if(    __builtin_cpu_supports( "avx2" )
+      && __builtin_cpu_supports( "fma" ) ) {
+    return simd_t::AVX2;
+  }
+#elif defined(__aarch64__)
+  return simd_t::NEON;
+#endif
+
+  return simd_t::GENERIC_SIMD;
+}
+
+bool einsum_ir::basic::ContractionBackendSimd::supports( simd_t i_simd ) {
+  simd_t l_simd = detect_simd();
+
+  if( i_simd == simd_t::GENERIC_SIMD ) {
+    return true;
+  }
+  else if( i_simd == simd_t::AVX2 ) {
+    return l_simd == simd_t::AVX2 || l_simd == simd_t::AVX512;
+  }
+  else if( i_simd == simd_t::AVX512 ) {
+    return l_simd == simd_t::AVX512;
+  }
+  else if( i_simd == simd_t::NEON ) {
+    return l_simd == simd_t::NEON;
+  }
+
+  return false;
+}
+
+void einsum_ir::basic::ContractionBackendSimd::set_simd( simd_t i_simd ) {
+  m_simd = i_simd;
+}
+
+einsum_ir::basic::simd_t einsum_ir::basic::ContractionBackendSimd::get_simd() const {
+  return m_simd;
+}
+
+bool einsum_ir::basic::ContractionBackendSimd::supports_touch( kernel_t i_ktype ) {
+  return    i_ktype == kernel_t::UNDEFINED_KTYPE
+         || i_ktype == kernel_t::ZERO
+         || i_ktype == kernel_t::COPY
+         || i_ktype == kernel_t::ADD
+         || i_ktype == kernel_t::RELU;
+}
+
+template< typename T >
+void einsum_ir::basic::ContractionBackendSimd::kernel_gemm_trans_a( void const * i_a,
+                                                                    void const * i_b,
+                                                                    void       * io_c ) const {
+  // packed block of A: 32 KiB, at most 64 rows
+  constexpr int64_t l_size_pack = 32768 / sizeof(T);
+  constexpr int64_t l_mc = 64;
+  constexpr int64_t l_kc = l_size_pack / l_mc;
+  alignas(64) T l_a_packed[ l_size_pack ];
+
+  T const * l_a = (T const *) i_a;
+  T const * l_b = (T const *) i_b;
+  T       * l_c = (T       *) io_c;
+
+  int64_t l_m = m_m;
+  int64_t l_n = m_n;
+  int64_t l_k = m_k;
+  int64_t l_lda = m_lda;
+  int64_t l_ldc = m_ldc;
+  int64_t l_nr = m_kernels_gemm.size();
+
+  for( int64_t l_m0 = 0; l_m0 < l_m; l_m0 += l_mc ) {
+    int64_t l_mb = std::min( l_mc, l_m - l_m0 );
+
+    for( int64_t l_k0 = 0; l_k0 < l_k; l_k0 += l_kc ) {
+      int64_t l_kb = std::min( l_kc, l_k - l_k0 );
+
+      // rows of A^T are contiguous in K, the packed block is column-major with leading dimension l_mb
+      for( int64_t l_im = 0; l_im < l_mb; l_im++ ) {
+        T const * l_a_row = l_a + (l_m0 + l_im) * l_lda + l_k0;
+        for( int64_t l_ik = 0; l_ik < l_kb; l_ik++ ) {
+          l_a_packed[ l_ik * l_mb + l_im ] = l_a_row[l_ik];
+        }
+      }
+
+      for( int64_t l_n0 = 0; l_n0 < l_n; l_n0 += l_nr ) {
+        int64_t l_nb = std::min( l_nr, l_n - l_n0 );
+        m_kernels_gemm[l_nb-1]( l_mb,
+                                l_kb,
+                                l_a_packed,
+                                l_mb,
+                                l_b + l_k0 * m_rs_b + l_n0 * m_cs_b,
+                                m_rs_b,
+                                m_cs_b,
+                                l_c + l_n0 * l_ldc + l_m0,
+                                l_ldc );
+      }
+    }
+  }
+}
+
+template< typename T >
+void einsum_ir::basic::ContractionBackendSimd::kernel_touch( kernel_t         i_ktype,
+                                                             void     const * i_out_aux,
+                                                             void           * io_out ) const {
+  if( i_ktype == kernel_t::UNDEFINED_KTYPE ) {
+    return;
+  }
+
+  T const * l_out_aux = (T const *) i_out_aux;
+  T       * l_out     = (T       *) io_out;
+
+  int64_t l_m = m_m;
+  int64_t l_n = m_n;
+  int64_t l_ldc = m_ldc;
+  int64_t l_rs_aux = m_stride_m_out_aux;
+  int64_t l_cs_aux = m_stride_n_out_aux;
+
+  for( int64_t l_in = 0; l_in < l_n; l_in++ ) {
+    T * l_out_col = l_out + l_in * l_ldc;
+
+    if( i_ktype == kernel_t::ZERO ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for( int64_t l_im = 0; l_im < l_m; l_im++ ) {
+        l_out_col[l_im] = 0;
+      }
+    }
+    else if( i_ktype == kernel_t::RELU ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for( int64_t l_im = 0; l_im < l_m; l_im++ ) {
+        l_out_col[l_im] = std::max( l_out_col[l_im], T(0) );
+      }
+    }
+    else if( i_ktype == kernel_t::COPY ) {
+      T const * l_aux_col = l_out_aux + l_in * l_cs_aux;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for( int64_t l_im = 0; l_im < l_m; l_im++ ) {
+        l_out_col[l_im] = l_aux_col[ l_im * l_rs_aux ];
+      }
+    }
+    else if( i_ktype == kernel_t::ADD ) {
+      T const * l_aux_col = l_out_aux + l_in * l_cs_aux;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for( int64_t l_im = 0; l_im < l_m; l_im++ ) {
+        l_out_col[l_im] += l_aux_col[ l_im * l_rs_aux ];
+      }
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackendSimd::kernel_first_touch( void const * i_out_aux,
+                                                                   void       * io_out ) const {
+  if( m_num_bytes_scalar == 4 ) {
+    kernel_touch< float >( m_ktype_first_touch,
+                           i_out_aux,
+                           io_out );
+  }
+  else {
+    kernel_touch< double >( m_ktype_first_touch,
+                            i_out_aux,
+                            io_out );
+  }
+}
+
+void einsum_ir::basic::ContractionBackendSimd::kernel_main( void const * i_left,
+                                                            void const * i_right,
+                                                            void       * io_out ) const {
+  int64_t l_m = m_m;
+  int64_t l_n = m_n;
+  int64_t l_k = m_k;
+  int64_t l_lda = m_lda;
+  int64_t l_ldc = m_ldc;
+  int64_t l_nr = m_kernels_gemm.size();
+
+  for( uint64_t l_br = 0; l_br < m_br; l_br++ ) {
+    char const * l_a = (char const *) i_left  + l_br * m_br_stride_a * m_num_bytes_scalar;
+    char const * l_b = (char const *) i_right + l_br * m_br_stride_b * m_num_bytes_scalar;
+
+    // transposed left matrix
+    if( m_trans_a ) {
+      if( m_num_bytes_scalar == 4 ) {
+        kernel_gemm_trans_a< float >( l_a, l_b, io_out );
+      }
+      else {
+        kernel_gemm_trans_a< double >( l_a, l_b, io_out );
+      }
+      continue;
+    }
+
+    // blocks of columns, the last block might be smaller
+    for( int64_t l_n0 = 0; l_n0 < l_n; l_n0 += l_nr ) {
+      int64_t l_nb = std::min( l_nr, l_n - l_n0 );
+      m_kernels_gemm[l_nb-1]( l_m,
+                              l_k,
+                              l_a,
+                              l_lda,
+                              l_b + l_n0 * m_cs_b * m_num_bytes_scalar,
+                              m_rs_b,
+                              m_cs_b,
+                              (char *) io_out + l_n0 * l_ldc * m_num_bytes_scalar,
+                              l_ldc );
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackendSimd::kernel_last_touch( void const * i_out_aux,
+                                                                  void       * io_out ) const {
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    m_epilogue.apply( m_m,
+                      m_n,
+                      m_ldc,
+                      m_stride_m_out_aux,
+                      m_stride_n_out_aux,
+                      i_out_aux,
+                      io_out );
+  }
+  else if( m_num_bytes_scalar == 4 ) {
+    kernel_touch< float >( m_ktype_last_touch,
+                           i_out_aux,
+                           io_out );
+  }
+  else {
+    kernel_touch< double >( m_ktype_last_touch,
+                            i_out_aux,
+                            io_out );
+  }
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendSimd::compile_kernels() {
+  // kernels operate on FP32 or FP64 data only
+  if(    m_dtype_left  != m_dtype_comp
+      || m_dtype_right != m_dtype_comp
+      || m_dtype_out   != m_dtype_comp
+      || ( m_dtype_comp != FP32 && m_dtype_comp != FP64 ) ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // real-valued GEMMs and BRGEMMs only
+  if(    ( m_ktype_main != kernel_t::MADD && m_ktype_main != kernel_t::BR_MADD )
+      || m_r != 1 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+  if(    !supports_touch( m_ktype_first_touch )
+      || (    !supports_touch( m_ktype_last_touch )
+           && m_ktype_last_touch != kernel_t::EPILOGUE ) ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // instruction set
+  if( m_simd == simd_t::UNDEFINED_SIMD ) {
+    m_simd = detect_simd();
+  }
+  else if( !supports( m_simd ) ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  m_num_bytes_scalar = ce_n_bytes( m_dtype_comp );
+
+  // strides of the right matrix
+  if( m_trans_b ) {
+    m_rs_b = m_ldb;
+    m_cs_b = 1;
+  }
+  else {
+    m_rs_b = 1;
+    m_cs_b = m_ldb;
+  }
+
+  if( m_dtype_comp == FP32 ) {
+    select_kernels< float >( m_simd,
+                             m_kernels_gemm );
+  }
+  else {
+    select_kernels< double >( m_simd,
+                              m_kernels_gemm );
+  }
+
+  return err_t::SUCCESS;
+}
@@ -0,0 +1,165 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND_SIMD
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND_SIMD
+
+#include "ContractionBackend.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionBackendSimd;
+  }
+}
+
+/**
+ * Contraction backend with hand-written register-blocked GEMM and BRGEMM microkernels.
+ * Kernels for AVX2, AVX-512 and NEON are selected at runtime by CPU feature detection.
+ * Generic kernels are used if no supported instruction set is available.
+ **/
+class einsum_ir::basic::ContractionBackendSimd: public ContractionBackend {
+  public:
+    /**
+     * Microkernel computing C += A * B for a block of columns of C.
+     * The number of columns is a compile-time parameter of the kernel.
+     * A is column-major with unit stride in the m-dimension.
+     * Entry (k,n) of B is located at i_b[ k*i_rs_b + n*i_cs_b ].
+     *
+     * @param i_m number of rows.
+     * @param i_k size of the contracted dimension.
+     * @param i_a pointer to matrix A.
+     * @param i_lda leading dimension of A.
+     * @param i_b pointer to matrix B.
+     * @param i_rs_b row stride of B.
+     * @param i_cs_b column stride of B.
+     * @param io_c pointer to matrix C.
+     * @param i_ldc leading dimension of C.
+     **/
+    typedef void (* kernel_gemm_t)( int64_t         i_m,
+                                    int64_t         i_k,
+                                    void    const * i_a,
+                                    int64_t         i_lda,
+                                    void    const * i_b,
+                                    int64_t         i_rs_b,
+                                    int64_t         i_cs_b,
+                                    void          * io_c,
+                                    int64_t         i_ldc );
+
+  private:
+    //! instruction set of the kernels, UNDEFINED_SIMD selects the best supported one
+    simd_t m_simd = simd_t::UNDEFINED_SIMD;
+
+    //! number of bytes in a scalar
+    int64_t m_num_bytes_scalar = 0;
+
+    //! row stride of the right matrix
+    int64_t m_rs_b = 0;
+
+    //! column stride of the right matrix
+    int64_t m_cs_b = 0;
+
+    //! microkernels, entry i computes i+1 columns
+    std::vector< kernel_gemm_t > m_kernels_gemm;
+
+    /**
+     * GEMM for transposed left matrices.
+     * Blocks of A^T are packed column-major into a buffer on the executing thread's stack,
+     * the packed blocks are multiplied by the register-blocked microkernels.
+     *
+     * @param_t T data type.
+     * @param i_a pointer to the transposed matrix A.
+     * @param i_b pointer to matrix B.
+     * @param io_c pointer to matrix C.
+     **/
+    template< typename T >
+    void kernel_gemm_trans_a( void const * i_a,
+                              void const * i_b,
+                              void       * io_c ) const;
+
+    /**
+     * Applies a first-touch or last-touch operation to the output block of the microkernels.
+     *
+     * @param_t T data type.
+     * @param i_ktype type of the operation: ZERO, COPY, ADD, RELU or UNDEFINED_KTYPE.
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    template< typename T >
+    void kernel_touch( kernel_t         i_ktype,
+                       void     const * i_out_aux,
+                       void           * io_out ) const;
+
+    /**
+     * Checks if the given kernel type is a supported first-touch or last-touch operation.
+     *
+     * @param i_ktype kernel type.
+     * @return true if supported, false otherwise.
+     **/
+    static bool supports_touch( kernel_t i_ktype );
+
+  public:
+    /**
+     * Detects the best instruction set supported by the executing CPU.
+     *
+     * @return detected instruction set.
+     **/
+    static simd_t detect_simd();
+
+    /**
+     * Checks if the executing CPU supports the given instruction set.
+     *
+     * @param i_simd instruction set.
+     * @return true if supported, false otherwise.
+     **/
+    static bool supports( simd_t i_simd );
+
+    /**
+     * Sets the instruction set of the kernels.
+     * Has to be called before the compilation.
+     *
+     * @param i_simd instruction set, UNDEFINED_SIMD selects the best supported one.
+     **/
+    void set_simd( simd_t i_simd );
+
+    /**
+     * Gets the instruction set of the kernels.
+     *
+     * @return instruction set, UNDEFINED_SIMD before the compilation.
+     **/
+    simd_t get_simd() const;
+
+    /**
+     * Executes the first touch kernel on the given data section of the tensor.
+     *
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_first_touch( void const * i_out_aux,
+                             void       * io_out ) const;
+
+    /**
+     * Executes the main kernel on the given data sections of the tensors.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_main( void const * i_left,
+                      void const * i_right,
+                      void       * io_out ) const;
+
+    /**
+     * Executes the last touch kernel on the given data section of the tensor.
+     *
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     **/
+    void kernel_last_touch( void const * i_out_aux,
+                            void       * io_out ) const;
+
+    /**
+     * Compiles all kernels
+     *
+     * @return SUCCESS if the compilation was successful, otherwise an appropiate error code.
+     **/
+    err_t compile_kernels();
+};
+
+#endif
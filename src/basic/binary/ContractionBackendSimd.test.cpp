@@ -0,0 +1,470 @@
+#include "catch.hpp"
+#include "ContractionBackendSimd.h"
+#include <algorithm>
+#include <cmath>
+
+TEST_CASE( "Detection of the instruction set of the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  using namespace einsum_ir::basic;
+
+  simd_t l_simd = ContractionBackendSimd::detect_simd();
+  REQUIRE( l_simd != simd_t::UNDEFINED_SIMD );
+  REQUIRE( ContractionBackendSimd::supports( l_simd ) );
+  REQUIRE( ContractionBackendSimd::supports( simd_t::GENERIC_SIMD ) );
+  REQUIRE( !ContractionBackendSimd::supports( simd_t::UNDEFINED_SIMD ) );
+}
+
+TEST_CASE( "FP32 BRGEMM with zero first touch and ReLU last touch using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //    _____xnm_____
+  //   /
+  // ykm           xynk
+  //
+  // char   id   size   type
+  //    x    0      2   N (SEQ)
+  //    y    1      3   K (BR)
+  //    m    2     37   M (PRIM)
+  //    n    3     15   N (PRIM)
+  //    k    4      5   K (PRIM)
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_dim_types  = { dim_t::N,
+                                         dim_t::K,
+                                         dim_t::M,
+                                         dim_t::N,
+                                         dim_t::K };
+  std::vector< exec_t > l_exec_types = { exec_t::SEQ,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM };
+
+  //                                             x,     y,  m,  n,  k
+  std::vector< int64_t > l_sizes             = { 2,     3, 37, 15,  5 };
+  std::vector< int64_t > l_strides_left      = { 0,   185,  1,  0, 37 };
+  std::vector< int64_t > l_strides_right     = { 225,  75,  0,  5,  1 };
+  std::vector< int64_t > l_strides_out_aux   = { 0,     0,  0,  0,  0 };
+  std::vector< int64_t > l_strides_out       = { 555,   0,  1, 37,  0 };
+  std::vector< int64_t > l_packing_strides   = {};
+
+  std::vector< float > l_left(  3 * 5 * 37 );
+  std::vector< float > l_right( 2 * 3 * 15 * 5 );
+  std::vector< float > l_out_ref( 2 * 15 * 37 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 7) % 13 ) * 0.25f - 1.5f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 5) % 11 ) * 0.5f - 2.0f;
+  }
+
+  // reference
+  for( int64_t l_x = 0; l_x < 2; l_x++ ) {
+    for( int64_t l_n = 0; l_n < 15; l_n++ ) {
+      for( int64_t l_m = 0; l_m < 37; l_m++ ) {
+        float l_sum = 0;
+        for( int64_t l_y = 0; l_y < 3; l_y++ ) {
+          for( int64_t l_k = 0; l_k < 5; l_k++ ) {
+            l_sum +=   l_left[  l_y*185 + l_k*37 + l_m ]
+                     * l_right[ l_x*225 + l_y*75 + l_n*5 + l_k ];
+          }
+        }
+        l_out_ref[ l_x*555 + l_n*37 + l_m ] = std::max( l_sum, 0.0f );
+      }
+    }
+  }
+
+  for( simd_t l_simd : { simd_t::GENERIC_SIMD, simd_t::AVX2, simd_t::AVX512, simd_t::NEON } ) {
+    if( !ContractionBackendSimd::supports( l_simd ) ) {
+      continue;
+    }
+
+    ContractionBackendSimd l_bin_cont;
+    l_bin_cont.init( l_dim_types,
+                     l_exec_types,
+                     l_sizes,
+                     l_strides_left,
+                     l_strides_right,
+                     l_strides_out_aux,
+                     l_strides_out,
+                     l_packing_strides,
+                     l_packing_strides,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::ZERO,
+                     kernel_t::BR_MADD,
+                     kernel_t::RELU,
+                     1,
+                     1,
+                     1,
+                     nullptr );
+    l_bin_cont.set_simd( l_simd );
+    REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+    REQUIRE( l_bin_cont.get_simd() == l_simd );
+
+    std::vector< float > l_out( l_out_ref.size(), 42.0f );
+    l_bin_cont.contract( l_left.data(),
+                         l_right.data(),
+                         nullptr,
+                         l_out.data() );
+
+    for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+      REQUIRE( l_out[l_en] == Approx( l_out_ref[l_en] ) );
+    }
+  }
+}
+
+TEST_CASE( "FP64 GEMMs with transposed inputs and bias using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //    __nm__
+  //   /
+  // km        kn
+  //
+  // char   id   size
+  //    m    0     19
+  //    n    1     13
+  //    k    2      7
+  //
+  // the bias is broadcasted in the n-dimension
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_dim_types  = { dim_t::M,
+                                         dim_t::N,
+                                         dim_t::K };
+  std::vector< exec_t > l_exec_types = { exec_t::PRIM,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM };
+
+  //                                             m,  n,  k
+  std::vector< int64_t > l_sizes             = { 19, 13,  7 };
+  std::vector< int64_t > l_strides_right     = {  0,  1, 13 };
+  std::vector< int64_t > l_strides_out_aux   = {  1,  0,  0 };
+  std::vector< int64_t > l_strides_out       = {  1, 19,  0 };
+  std::vector< int64_t > l_packing_strides   = {};
+
+  std::vector< double > l_left(  7 * 19 );
+  std::vector< double > l_right( 7 * 13 );
+  std::vector< double > l_bias( 19 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 3) % 17 ) * 0.125 - 1.0;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 11) % 7 ) * 0.5 - 1.5;
+  }
+  for( std::size_t l_en = 0; l_en < l_bias.size(); l_en++ ) {
+    l_bias[l_en] = l_en * 0.1;
+  }
+
+  // the left matrix is either stored as km or as mk
+  for( bool l_trans_a : { false, true } ) {
+    std::vector< int64_t > l_strides_left = { 1, 0, 19 };
+    std::vector< double > l_left_stored = l_left;
+    if( l_trans_a ) {
+      l_strides_left = { 7, 0, 1 };
+      for( int64_t l_k = 0; l_k < 7; l_k++ ) {
+        for( int64_t l_m = 0; l_m < 19; l_m++ ) {
+          l_left_stored[ l_m*7 + l_k ] = l_left[ l_k*19 + l_m ];
+        }
+      }
+    }
+
+    for( simd_t l_simd : { simd_t::GENERIC_SIMD, simd_t::AVX2, simd_t::AVX512, simd_t::NEON } ) {
+      if( !ContractionBackendSimd::supports( l_simd ) ) {
+        continue;
+      }
+
+      ContractionBackendSimd l_bin_cont;
+      l_bin_cont.init( l_dim_types,
+                       l_exec_types,
+                       l_sizes,
+                       l_strides_left,
+                       l_strides_right,
+                       l_strides_out_aux,
+                       l_strides_out,
+                       l_packing_strides,
+                       l_packing_strides,
+                       data_t::FP64,
+                       data_t::FP64,
+                       data_t::FP64,
+                       data_t::FP64,
+                       kernel_t::COPY,
+                       kernel_t::MADD,
+                       kernel_t::UNDEFINED_KTYPE,
+                       1,
+                       1,
+                       1,
+                       nullptr );
+      l_bin_cont.set_simd( l_simd );
+      REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+
+      std::vector< double > l_out( 13 * 19, 42.0 );
+      l_bin_cont.contract( l_left_stored.data(),
+                           l_right.data(),
+                           l_bias.data(),
+                           l_out.data() );
+
+      for( int64_t l_n = 0; l_n < 13; l_n++ ) {
+        for( int64_t l_m = 0; l_m < 19; l_m++ ) {
+          double l_ref = l_bias[l_m];
+          for( int64_t l_k = 0; l_k < 7; l_k++ ) {
+            l_ref += l_left[ l_k*19 + l_m ] * l_right[ l_k*13 + l_n ];
+          }
+          REQUIRE( l_out[ l_n*19 + l_m ] == Approx( l_ref ) );
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE( "FP32 GEMM with a transposed left matrix spanning multiple packed blocks using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //    __nm__
+  //   /
+  // mk        kn
+  //
+  // char   id   size
+  //    m    0    150
+  //    n    1      9
+  //    k    2    300
+  //
+  // m and k exceed the blocks in which the left matrix is packed
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_dim_types  = { dim_t::M,
+                                         dim_t::N,
+                                         dim_t::K };
+  std::vector< exec_t > l_exec_types = { exec_t::PRIM,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM };
+
+  //                                             m,   n,   k
+  std::vector< int64_t > l_sizes             = { 150,  9, 300 };
+  std::vector< int64_t > l_strides_left      = { 300,  0,   1 };
+  std::vector< int64_t > l_strides_right     = {   0, 300,  1 };
+  std::vector< int64_t > l_strides_out_aux   = {   0,  0,   0 };
+  std::vector< int64_t > l_strides_out       = {   1, 150,  0 };
+  std::vector< int64_t > l_packing_strides   = {};
+
+  std::vector< float > l_left(  150 * 300 );
+  std::vector< float > l_right( 300 * 9 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 5) % 13 ) * 0.125f - 0.75f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 7) % 11 ) * 0.25f - 1.25f;
+  }
+
+  for( simd_t l_simd : { simd_t::GENERIC_SIMD, simd_t::AVX2, simd_t::AVX512, simd_t::NEON } ) {
+    if( !ContractionBackendSimd::supports( l_simd ) ) {
+      continue;
+    }
+
+    ContractionBackendSimd l_bin_cont;
+    l_bin_cont.init( l_dim_types,
+                     l_exec_types,
+                     l_sizes,
+                     l_strides_left,
+                     l_strides_right,
+                     l_strides_out_aux,
+                     l_strides_out,
+                     l_packing_strides,
+                     l_packing_strides,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::ZERO,
+                     kernel_t::MADD,
+                     kernel_t::UNDEFINED_KTYPE,
+                     1,
+                     1,
+                     1,
+                     nullptr );
+    l_bin_cont.set_simd( l_simd );
+    REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+
+    std::vector< float > l_out( 9 * 150, 42.0f );
+    l_bin_cont.contract( l_left.data(),
+                         l_right.data(),
+                         nullptr,
+                         l_out.data() );
+
+    for( int64_t l_n = 0; l_n < 9; l_n++ ) {
+      for( int64_t l_m = 0; l_m < 150; l_m++ ) {
+        double l_ref = 0;
+        for( int64_t l_k = 0; l_k < 300; l_k++ ) {
+          l_ref += l_left[ l_m*300 + l_k ] * l_right[ l_n*300 + l_k ];
+        }
+        REQUIRE( l_out[ l_n*150 + l_m ] == Approx( l_ref ).margin( 1E-3 ) );
+      }
+    }
+  }
+}
+
+TEST_CASE( "FP32 GEMM with a bias and tanh epilogue using the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  // Test Case:
+  //
+  //    __nm__
+  //   /
+  // km        kn
+  //
+  // char   id   size
+  //    m    0     21
+  //    n    1      9
+  //    k    2      6
+  //
+  // the bias is broadcasted in the n-dimension and scaled by beta
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_dim_types  = { dim_t::M,
+                                         dim_t::N,
+                                         dim_t::K };
+  std::vector< exec_t > l_exec_types = { exec_t::PRIM,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM };
+
+  //                                             m,  n,  k
+  std::vector< int64_t > l_sizes             = { 21,  9,  6 };
+  std::vector< int64_t > l_strides_left      = {  1,  0, 21 };
+  std::vector< int64_t > l_strides_right     = {  0,  1,  9 };
+  std::vector< int64_t > l_strides_out_aux   = {  1,  0,  0 };
+  std::vector< int64_t > l_strides_out       = {  1, 21,  0 };
+  std::vector< int64_t > l_packing_strides   = {};
+
+  std::vector< float > l_left(  6 * 21 );
+  std::vector< float > l_right( 6 * 9 );
+  std::vector< float > l_bias( 21 );
+
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = ( (l_en * 3) % 17 ) * 0.125f - 1.0f;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = ( (l_en * 11) % 7 ) * 0.25f - 0.75f;
+  }
+  for( std::size_t l_en = 0; l_en < l_bias.size(); l_en++ ) {
+    l_bias[l_en] = l_en * 0.05f - 0.5f;
+  }
+
+  for( simd_t l_simd : { simd_t::GENERIC_SIMD, simd_t::AVX2, simd_t::AVX512, simd_t::NEON } ) {
+    if( !ContractionBackendSimd::supports( l_simd ) ) {
+      continue;
+    }
+
+    ContractionBackendSimd l_bin_cont;
+    l_bin_cont.init( l_dim_types,
+                     l_exec_types,
+                     l_sizes,
+                     l_strides_left,
+                     l_strides_right,
+                     l_strides_out_aux,
+                     l_strides_out,
+                     l_packing_strides,
+                     l_packing_strides,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::ZERO,
+                     kernel_t::MADD,
+                     kernel_t::UNDEFINED_KTYPE,
+                     1,
+                     1,
+                     1,
+                     nullptr );
+    l_bin_cont.set_epilogue( { kernel_t::ADD,
+                               kernel_t::TANH },
+                             1.0,
+                             2.0 );
+    l_bin_cont.set_simd( l_simd );
+    REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+
+    std::vector< float > l_out( 9 * 21, 42.0f );
+    l_bin_cont.contract( l_left.data(),
+                         l_right.data(),
+                         l_bias.data(),
+                         l_out.data() );
+
+    for( int64_t l_n = 0; l_n < 9; l_n++ ) {
+      for( int64_t l_m = 0; l_m < 21; l_m++ ) {
+        float l_ref = 2.0f * l_bias[l_m];
+        for( int64_t l_k = 0; l_k < 6; l_k++ ) {
+          l_ref += l_left[ l_k*21 + l_m ] * l_right[ l_k*9 + l_n ];
+        }
+        l_ref = std::tanh( l_ref );
+        REQUIRE( l_out[ l_n*21 + l_m ] == Approx( l_ref ) );
+      }
+    }
+  }
+}
+
+TEST_CASE( "Unsupported configurations of the SIMD contraction backend.", "[contraction_backend_simd]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >   l_dim_types  = { dim_t::M, dim_t::N, dim_t::K };
+  std::vector< exec_t >  l_exec_types = { exec_t::PRIM, exec_t::PRIM, exec_t::PRIM };
+  std::vector< int64_t > l_sizes      = { 4, 4, 4 };
+  std::vector< int64_t > l_strides_left    = { 1, 0, 4 };
+  std::vector< int64_t > l_strides_right   = { 0, 4, 1 };
+  std::vector< int64_t > l_strides_out_aux = { 0, 0, 0 };
+  std::vector< int64_t > l_strides_out     = { 1, 4, 0 };
+  std::vector< int64_t > l_packing_strides = {};
+
+  // mixed precision
+  ContractionBackendSimd l_bin_cont_mixed;
+  l_bin_cont_mixed.init( l_dim_types,
+                         l_exec_types,
+                         l_sizes,
+                         l_strides_left,
+                         l_strides_right,
+                         l_strides_out_aux,
+                         l_strides_out,
+                         l_packing_strides,
+                         l_packing_strides,
+                         data_t::BF16,
+                         data_t::BF16,
+                         data_t::FP32,
+                         data_t::BF16,
+                         kernel_t::ZERO,
+                         kernel_t::MADD,
+                         kernel_t::UNDEFINED_KTYPE,
+                         1,
+                         1,
+                         1,
+                         nullptr );
+  REQUIRE( l_bin_cont_mixed.compile() == err_t::COMPILATION_FAILED );
+
+  // instruction set of another architecture
+  ContractionBackendSimd l_bin_cont_isa;
+  l_bin_cont_isa.init( l_dim_types,
+                       l_exec_types,
+                       l_sizes,
+                       l_strides_left,
+                       l_strides_right,
+                       l_strides_out_aux,
+                       l_strides_out,
+                       l_packing_strides,
+                       l_packing_strides,
+                       data_t::FP32,
+                       data_t::FP32,
+                       data_t::FP32,
+                       data_t::FP32,
+                       kernel_t::ZERO,
+                       kernel_t::MADD,
+                       kernel_t::UNDEFINED_KTYPE,
+                       1,
+                       1,
+                       1,
+                       nullptr );
+#if defined(__aarch64__)
+  l_bin_cont_isa.set_simd( simd_t::AVX2 );
+#else
+  l_bin_cont_isa.set_simd( simd_t::NEON );
+#endif
+  REQUIRE( l_bin_cont_isa.compile() == err_t::COMPILATION_FAILED );
+}
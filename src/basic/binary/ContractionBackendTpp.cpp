@@ -7,13 +7,19 @@ libxsmm_datatype einsum_ir::basic::ContractionBackendTpp::dtype_to_libxsmm( data
   else if( i_dtype == FP64 ) {
     return libxsmm_datatype::LIBXSMM_DATATYPE_F64;
   }
+  else if( i_dtype == BF16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_BF16;
+  }
+  else if( i_dtype == FP16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_F16;
+  }
 
   return libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED;
 }
 
 
 void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch( void const * i_out_aux,
-                                                                  void       * io_out ){
+                                                                  void       * io_out ) const {
 
   if( m_xmm_kernel_first_touch_unary != nullptr ) {
     libxsmm_meltw_unary_param l_param;
@@ -32,7 +38,7 @@ void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch( void const * i
 
 
 void einsum_ir::basic::ContractionBackendTpp::kernel_last_touch( void const * i_out_aux,
-                                                                 void       * io_out ){
+                                                                 void       * io_out ) const {
   if( m_xmm_kernel_last_touch_unary != nullptr ) {
     libxsmm_meltw_unary_param l_param;
     l_param.in.primary = io_out;
@@ -46,17 +52,44 @@ void einsum_ir::basic::ContractionBackendTpp::kernel_last_touch( void const * i_
     l_param.out.primary =          io_out;
     m_xmm_kernel_last_touch_binary( &l_param );
   }
+  else if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    // fallback for chains which are not expressible through TPPs
+    if( m_xmm_kernels_epilogue_unary.empty() ) {
+      m_epilogue.apply( m_m * m_r,
+                        m_n,
+                        m_ldc * m_r,
+                        m_stride_m_out_aux,
+                        m_stride_n_out_aux,
+                        i_out_aux,
+                        io_out );
+    }
+    for( std::size_t l_op = 0; l_op < m_xmm_kernels_epilogue_unary.size(); l_op++ ) {
+      if( m_xmm_kernels_epilogue_unary[l_op] != nullptr ) {
+        libxsmm_meltw_unary_param l_param;
+        l_param.in.primary = io_out;
+        l_param.out.primary = io_out;
+        m_xmm_kernels_epilogue_unary[l_op]( &l_param );
+      }
+      else {
+        libxsmm_meltw_binary_param l_param;
+        l_param.in0.primary = (void *) io_out;
+        l_param.in1.primary = (void *) i_out_aux;
+        l_param.out.primary =          io_out;
+        m_xmm_kernels_epilogue_binary[l_op]( &l_param );
+      }
+    }
+  }
 }
 
 
 void einsum_ir::basic::ContractionBackendTpp::kernel_main( void const * i_left,
                                                            void const * i_right,
-                                                           void       * io_out ){
+                                                           void       * io_out ) const {
   libxsmm_gemm_param l_param;
   l_param.a.primary = (void *) i_left;
   l_param.b.primary = (void *) i_right;
   l_param.c.primary =          io_out;
-  l_param.op.tertiary = &m_br;
+  l_param.op.tertiary = (void *) &m_br;
 
   m_xmm_kernel_main( &l_param );
 }
@@ -69,6 +102,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
   libxsmm_datatype l_xmm_dtype_right = dtype_to_libxsmm( m_dtype_right );
   libxsmm_datatype l_xmm_dtype_out   = dtype_to_libxsmm( m_dtype_out   );
   libxsmm_datatype l_xmm_dtype_comp  = dtype_to_libxsmm( m_dtype_comp );
+  libxsmm_datatype l_xmm_dtype_out_main = dtype_to_libxsmm( m_dtype_out_main );
 
   if(    l_xmm_dtype_left  == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED
       || l_xmm_dtype_right == libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED
@@ -107,7 +141,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                      m_ldc,
                                                                                      l_xmm_dtype_out,
                                                                                      l_xmm_dtype_out,
-                                                                                     l_xmm_dtype_out );
+                                                                                     l_xmm_dtype_comp );
   
   libxsmm_meltw_unary_shape l_shape_single_touch_aux_unary = libxsmm_create_meltw_unary_shape( m_m * m_r,
                                                                                                m_n,
@@ -115,7 +149,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                                m_ldc,
                                                                                                l_xmm_dtype_out,
                                                                                                l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out );
+                                                                                               l_xmm_dtype_comp );
 
   libxsmm_meltw_binary_shape l_shape_single_touch_aux_binary = libxsmm_create_meltw_binary_shape( m_m * m_r,
                                                                                                   m_n,
@@ -125,7 +159,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                                   l_xmm_dtype_out,
                                                                                                   l_xmm_dtype_out,
                                                                                                   l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out );
+                                                                                                  l_xmm_dtype_comp );
 
   //first touch kernel
   if( m_ktype_first_touch == kernel_t::ZERO ) {
@@ -158,6 +192,47 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                     l_shape_single_touch_aux_binary,
                                                                     l_flag_out_aux_binary );
   }
+  else if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    // map the chain to TPPs, SCALE, SILU and scaled additions are not available
+    m_xmm_kernels_epilogue_unary.clear();
+    m_xmm_kernels_epilogue_binary.clear();
+    bool l_tpps = m_epilogue.get_beta() == 1.0;
+
+    for( kernel_t l_ktype : m_epilogue.get_ktypes() ) {
+      libxsmm_meltwfunction_unary  l_unary  = nullptr;
+      libxsmm_meltwfunction_binary l_binary = nullptr;
+
+      if( l_ktype == kernel_t::ADD ) {
+        l_binary = libxsmm_dispatch_meltw_binary( LIBXSMM_MELTW_TYPE_BINARY_ADD,
+                                                  l_shape_single_touch_aux_binary,
+                                                  l_flag_out_aux_binary );
+      }
+      else if(    l_ktype == kernel_t::RELU
+               || l_ktype == kernel_t::GELU
+               || l_ktype == kernel_t::TANH
+               || l_ktype == kernel_t::SIGMOID ) {
+        libxsmm_meltw_unary_type l_type = LIBXSMM_MELTW_TYPE_UNARY_RELU;
+        if(      l_ktype == kernel_t::GELU    ) l_type = LIBXSMM_MELTW_TYPE_UNARY_GELU;
+        else if( l_ktype == kernel_t::TANH    ) l_type = LIBXSMM_MELTW_TYPE_UNARY_TANH;
+        else if( l_ktype == kernel_t::SIGMOID ) l_type = LIBXSMM_MELTW_TYPE_UNARY_SIGMOID;
+
+        l_unary = libxsmm_dispatch_meltw_unary( l_type,
+                                                l_shape_single_touch,
+                                                LIBXSMM_MELTW_FLAG_UNARY_NONE );
+      }
+
+      if( l_unary == nullptr && l_binary == nullptr ) {
+        l_tpps = false;
+      }
+      m_xmm_kernels_epilogue_unary.push_back( l_unary );
+      m_xmm_kernels_epilogue_binary.push_back( l_binary );
+    }
+
+    if( !l_tpps ) {
+      m_xmm_kernels_epilogue_unary.clear();
+      m_xmm_kernels_epilogue_binary.clear();
+    }
+  }
   else if( m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE ) {
     return err_t::COMPILATION_FAILED;
   }
@@ -183,7 +258,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                               m_ldc,
                                               l_xmm_dtype_left,
                                               l_xmm_dtype_right,
-                                              l_xmm_dtype_out,
+                                              l_xmm_dtype_out_main,
                                               l_xmm_dtype_comp );
 
   //set br type and scale br strides
@@ -28,6 +28,12 @@ class einsum_ir::basic::ContractionBackendTpp: public ContractionBackend {
     //! LIBXSMM-based binary last-touch TPP
     libxsmm_meltwfunction_binary m_xmm_kernel_last_touch_binary = nullptr;
 
+    //! LIBXSMM-based unary TPPs of the epilogue, nullptr for binary operations
+    std::vector< libxsmm_meltwfunction_unary > m_xmm_kernels_epilogue_unary;
+
+    //! LIBXSMM-based binary TPPs of the epilogue, nullptr for unary operations
+    std::vector< libxsmm_meltwfunction_binary > m_xmm_kernels_epilogue_binary;
+
     /**
      * converts internal datatypes to libxsmm datatypes
      *
@@ -43,7 +49,7 @@ class einsum_ir::basic::ContractionBackendTpp: public ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     void kernel_first_touch( void const * i_out_aux,
-                             void       * io_out );
+                             void       * io_out ) const;
 
     /**
      * Kernel applied to the output tensor after the main primitve finished using the memory.
@@ -52,7 +58,7 @@ class einsum_ir::basic::ContractionBackendTpp: public ContractionBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     void kernel_last_touch( void const * i_out_aux,
-                            void       * io_out );
+                            void       * io_out ) const;
 
     /**
      * Kernel called in the innermost loop.
@@ -63,7 +69,7 @@ class einsum_ir::basic::ContractionBackendTpp: public ContractionBackend {
      **/
     void kernel_main( void const * i_left,
                       void const * i_right,
-                      void       * io_out );
+                      void       * io_out ) const;
 
     /**
      * Compiles all kernels
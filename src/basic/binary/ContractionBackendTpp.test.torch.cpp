@@ -749,4 +749,146 @@ TEST_CASE( "Tensor contraction with packing of both tensors and SFC parallelisat
                           { l_left, l_right } );
 
   REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
-}
\ No newline at end of file
+}
+TEST_CASE( "Matmul with bias and GELU epilogue.", "[contraction_backend]" ) {
+  //example: [c1,k1,m1],[c1,n1,k1]->[c1,n1,m1] with bias [m1]
+  //sizes:   [5,13,20],[5,47,13]->[5,47,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  c1,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {   5,20,47,13 };
+  std::vector< int64_t > l_loop_strides_left     = { 260, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = { 611, 0,13, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 1, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 940, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left  = at::randn( { 5,13,20 } );
+  at::Tensor l_right = at::randn( { 5,47,13 } );
+  at::Tensor l_bias  = at::randn( { 20 } );
+  at::Tensor l_out   = at::zeros( { 5,47,20 } );
+
+  // beta=1 is expressible in libxsmm TPPs, beta=2 uses the generic epilogue
+  for( double l_beta : { 1.0, 2.0 } ) {
+    ContractionBackendTpp l_cont;
+
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 data_t::FP32,
+                 data_t::FP32,
+                 data_t::FP32,
+                 data_t::FP32,
+                 kernel_t::ZERO,
+                 kernel_t::MADD,
+                 kernel_t::UNDEFINED_KTYPE,
+                 2,
+                 2,
+                 2,
+                 nullptr );
+    l_cont.set_epilogue( { kernel_t::ADD,
+                           kernel_t::GELU },
+                         1.0,
+                         l_beta );
+
+    err_t l_err = l_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    l_cont.contract( l_left.data_ptr(),
+                     l_right.data_ptr(),
+                     l_bias.data_ptr(),
+                     l_out.data_ptr() );
+
+    at::Tensor l_out_ref = at::einsum( "xcb,xac->xab",
+                                       { l_left, l_right } );
+    l_out_ref = at::gelu( l_out_ref + l_beta * l_bias );
+
+    REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+  }
+}
+
+TEST_CASE( "BF16 and FP16 matmul with many blocks in K.", "[contraction_backend]" ) {
+  //example: [k0,k1,m1],[n1,k0,k1]->[n1,m1]
+  //sizes:   [128,16,16],[8,128,16]->[8,16]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  k0,m1,  n1,k1
+  std::vector< int64_t > l_loop_sizes            = { 128,16,   8,16 };
+  std::vector< int64_t > l_loop_strides_left     = { 256, 1,   0,16 };
+  std::vector< int64_t > l_loop_strides_right    = {  16, 0,2048, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 0,   0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {   0, 1,  16, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // the partial sums are kept in FP32 across all blocks, rounding them after every block exceeds the tolerances
+  for( data_t l_dtype : { data_t::BF16, data_t::FP16 } ) {
+    at::ScalarType l_dtype_at = ( l_dtype == data_t::BF16 ) ? at::kBFloat16 : at::kHalf;
+    double l_rtol = ( l_dtype == data_t::BF16 ) ? 1E-2 : 1E-3;
+
+    at::Tensor l_left  = at::rand( { 128,16,16 } ).to( l_dtype_at );
+    at::Tensor l_right = at::rand( { 8,128,16 } ).to( l_dtype_at );
+    at::Tensor l_out   = at::zeros( { 8,16 } ).to( l_dtype_at );
+
+    ContractionBackendTpp l_cont;
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 l_dtype,
+                 l_dtype,
+                 data_t::FP32,
+                 l_dtype,
+                 kernel_t::ZERO,
+                 kernel_t::MADD,
+                 kernel_t::UNDEFINED_KTYPE,
+                 1,
+                 1,
+                 1,
+                 nullptr );
+
+    err_t l_err = l_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    l_cont.contract( l_left.data_ptr(),
+                     l_right.data_ptr(),
+                     nullptr,
+                     l_out.data_ptr() );
+
+    at::Tensor l_out_ref = at::einsum( "xkm,nxk->nm",
+                                       { l_left.to( at::kFloat ),
+                                         l_right.to( at::kFloat ) } );
+
+    REQUIRE( at::allclose( l_out.to( at::kFloat ), l_out_ref, l_rtol, 0 ) );
+  }
+}
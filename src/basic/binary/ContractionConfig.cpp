@@ -0,0 +1,271 @@
+#include "ContractionConfig.h"
+#include <cstring>
+#include <sstream>
+
+void einsum_ir::basic::ContractionConfig::serialize( std::vector< int64_t > & io_values ) const {
+  io_values.push_back( m_dtype_left );
+  io_values.push_back( m_dtype_right );
+  io_values.push_back( m_dtype_comp );
+  io_values.push_back( m_dtype_out );
+  io_values.push_back( m_ktype_first_touch );
+  io_values.push_back( m_ktype_main );
+  io_values.push_back( m_ktype_last_touch );
+  io_values.push_back( m_num_threads_shared );
+  io_values.push_back( m_num_threads_sfc_m );
+  io_values.push_back( m_num_threads_sfc_n );
+  io_values.push_back( m_iterations.size() );
+
+  for( std::size_t l_it = 0; l_it < m_iterations.size(); l_it++ ) {
+    io_values.push_back( m_iterations[l_it].dim_type );
+    io_values.push_back( m_iterations[l_it].exec_type );
+    io_values.push_back( m_iterations[l_it].size );
+    io_values.push_back( m_iterations[l_it].stride_left );
+    io_values.push_back( m_iterations[l_it].stride_right );
+    io_values.push_back( m_iterations[l_it].stride_out_aux );
+    io_values.push_back( m_iterations[l_it].stride_out );
+    io_values.push_back( m_iterations[l_it].packing_stride_left );
+    io_values.push_back( m_iterations[l_it].packing_stride_right );
+  }
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionConfig::deserialize( std::vector< int64_t > const & i_values,
+                                                                          std::size_t                  & io_pos ) {
+  std::size_t l_pos = io_pos;
+  if( l_pos + 11 > i_values.size() ) {
+    return err_t::INVALID_CONFIG;
+  }
+
+  // data types
+  data_t l_dtypes[4] = { UNDEFINED_DTYPE };
+  for( int64_t l_dt = 0; l_dt < 4; l_dt++ ) {
+    int64_t l_value = i_values[l_pos++];
+    if(    l_value != FP32
+        && l_value != FP64
+        && l_value != BF16
+        && l_value != FP16 ) {
+      return err_t::INVALID_CONFIG;
+    }
+    l_dtypes[l_dt] = static_cast< data_t >( l_value );
+  }
+
+  // kernel types
+  kernel_t l_ktypes[3] = { UNDEFINED_KTYPE };
+  for( int64_t l_kt = 0; l_kt < 3; l_kt++ ) {
+    int64_t l_value = i_values[l_pos++];
+    if(    l_value != ZERO
+        && l_value != RELU
+        && l_value != ADD
+        && l_value != COPY
+        && l_value != MADD
+        && l_value != CPX_ZERO
+        && l_value != CPX_ADD
+        && l_value != CPX_MADD
+        && l_value != CPX_COPY
+        && l_value != BR_MADD
+        && l_value != PACKED_MADD
+        && l_value != CPX_PACKED_MADD
+        && l_value != GELU
+        && l_value != SILU
+        && l_value != SIGMOID
+        && l_value != TANH
+        && l_value != SCALE
+        && l_value != EPILOGUE
+        && l_value != UNDEFINED_KTYPE ) {
+      return err_t::INVALID_CONFIG;
+    }
+    l_ktypes[l_kt] = static_cast< kernel_t >( l_value );
+  }
+
+  // thread partition
+  int64_t l_num_threads[3] = { 1, 1, 1 };
+  for( int64_t l_th = 0; l_th < 3; l_th++ ) {
+    l_num_threads[l_th] = i_values[l_pos++];
+    if( l_num_threads[l_th] < 1 ) {
+      return err_t::INVALID_CONFIG;
+    }
+  }
+
+  // iterations
+  int64_t l_num_iters = i_values[l_pos++];
+  if(    l_num_iters < 0
+      || (i_values.size() - l_pos) / 9 < static_cast< std::size_t >( l_num_iters ) ) {
+    return err_t::INVALID_CONFIG;
+  }
+
+  std::vector< iter_property > l_iterations( l_num_iters );
+  for( int64_t l_it = 0; l_it < l_num_iters; l_it++ ) {
+    int64_t l_dim_type  = i_values[l_pos++];
+    int64_t l_exec_type = i_values[l_pos++];
+    if(    l_dim_type < dim_t::C
+        || l_dim_type > dim_t::J ) {
+      return err_t::INVALID_CONFIG;
+    }
+    if(    l_exec_type < exec_t::OMP
+        || l_exec_type > exec_t::PRIM ) {
+      return err_t::INVALID_CONFIG;
+    }
+
+    l_iterations[l_it].dim_type             = static_cast< dim_t >( l_dim_type );
+    l_iterations[l_it].exec_type            = static_cast< exec_t >( l_exec_type );
+    l_iterations[l_it].size                 = i_values[l_pos++];
+    l_iterations[l_it].stride_left          = i_values[l_pos++];
+    l_iterations[l_it].stride_right         = i_values[l_pos++];
+    l_iterations[l_it].stride_out_aux       = i_values[l_pos++];
+    l_iterations[l_it].stride_out           = i_values[l_pos++];
+    l_iterations[l_it].packing_stride_left  = i_values[l_pos++];
+    l_iterations[l_it].packing_stride_right = i_values[l_pos++];
+
+    if( l_iterations[l_it].size < 1 ) {
+      return err_t::INVALID_CONFIG;
+    }
+  }
+
+  // only modify the configuration if all values are valid
+  m_dtype_left  = l_dtypes[0];
+  m_dtype_right = l_dtypes[1];
+  m_dtype_comp  = l_dtypes[2];
+  m_dtype_out   = l_dtypes[3];
+
+  m_ktype_first_touch = l_ktypes[0];
+  m_ktype_main        = l_ktypes[1];
+  m_ktype_last_touch  = l_ktypes[2];
+
+  m_num_threads_shared = l_num_threads[0];
+  m_num_threads_sfc_m  = l_num_threads[1];
+  m_num_threads_sfc_n  = l_num_threads[2];
+
+  m_iterations = l_iterations;
+
+  io_pos = l_pos;
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::basic::ContractionConfig::append_text( std::string & io_text ) const {
+  std::vector< int64_t > l_values;
+  serialize( l_values );
+
+  std::ostringstream l_stream;
+  for( std::size_t l_va = 0; l_va < l_values.size(); l_va++ ) {
+    l_stream << l_values[l_va];
+
+    // first line holds 11 values, every iteration 9 values
+    bool l_end_line = ( l_va + 1 >= 11 ) && ( (l_va + 1 - 11) % 9 == 0 );
+    l_stream << ( l_end_line ? '\n' : ' ' );
+  }
+
+  io_text += l_stream.str();
+}
+
+std::string einsum_ir::basic::ContractionConfig::to_string() const {
+  std::string l_text = std::string( m_header_text ) + " " + std::to_string( m_version ) + "\n";
+  append_text( l_text );
+
+  return l_text;
+}
+
+std::string einsum_ir::basic::ContractionConfig::to_binary() const {
+  std::vector< int64_t > l_values;
+  serialize( l_values );
+
+  return write_values_binary( m_magic_binary,
+                              l_values );
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionConfig::from_string( std::string const & i_data ) {
+  std::vector< int64_t > l_values;
+  err_t l_err = read_values( i_data,
+                             m_header_text,
+                             m_magic_binary,
+                             l_values );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  // only modify the configuration if all values are consumed
+  ContractionConfig l_config;
+  std::size_t l_pos = 0;
+  l_err = l_config.deserialize( l_values,
+                                l_pos );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+  if( l_pos != l_values.size() ) {
+    return err_t::INVALID_CONFIG;
+  }
+  *this = l_config;
+
+  return err_t::SUCCESS;
+}
+
+std::string einsum_ir::basic::ContractionConfig::write_values_binary( int64_t                        i_magic,
+                                                                      std::vector< int64_t > const & i_values ) {
+  std::string l_data( (2 + i_values.size()) * sizeof(int64_t), '\0' );
+
+  int64_t l_header[2] = { i_magic, m_version };
+  std::memcpy( &l_data[0],
+               l_header,
+               2 * sizeof(int64_t) );
+  if( i_values.size() > 0 ) {
+    std::memcpy( &l_data[2 * sizeof(int64_t)],
+                 i_values.data(),
+                 i_values.size() * sizeof(int64_t) );
+  }
+
+  return l_data;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionConfig::read_values( std::string const      & i_data,
+                                                                          char const             * i_header,
+                                                                          int64_t                  i_magic,
+                                                                          std::vector< int64_t > & o_values ) {
+  o_values.clear();
+
+  // binary format
+  int64_t l_magic = 0;
+  if( i_data.size() >= sizeof(int64_t) ) {
+    std::memcpy( &l_magic,
+                 i_data.data(),
+                 sizeof(int64_t) );
+  }
+  if( l_magic == i_magic ) {
+    if(    i_data.size() % sizeof(int64_t) != 0
+        || i_data.size() < 2 * sizeof(int64_t) ) {
+      return err_t::INVALID_CONFIG;
+    }
+
+    std::size_t l_num_values = i_data.size() / sizeof(int64_t);
+    std::vector< int64_t > l_values( l_num_values );
+    std::memcpy( l_values.data(),
+                 i_data.data(),
+                 i_data.size() );
+    if( l_values[1] != m_version ) {
+      return err_t::INVALID_CONFIG;
+    }
+
+    o_values.assign( l_values.begin() + 2,
+                     l_values.end() );
+    return err_t::SUCCESS;
+  }
+
+  // text format
+  std::istringstream l_stream( i_data );
+  std::string l_header;
+  int64_t l_version = 0;
+  if(    !( l_stream >> l_header >> l_version )
+      || l_header != i_header
+      || l_version != m_version ) {
+    return err_t::INVALID_CONFIG;
+  }
+
+  int64_t l_value = 0;
+  while( l_stream >> l_value ) {
+    o_values.push_back( l_value );
+  }
+  if( !l_stream.eof() ) {
+    o_values.clear();
+    return err_t::INVALID_CONFIG;
+  }
+
+  return err_t::SUCCESS;
+}
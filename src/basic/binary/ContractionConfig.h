@@ -0,0 +1,133 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_CONFIG
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_CONFIG
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionConfig;
+  }
+}
+
+/**
+ * Configuration of a contraction backend, i.e., the iteration space, the data types, the kernel types and the thread partition.
+ *
+ * Configurations are serialized to a sequence of integer values.
+ * The text format stores a header line with the format version followed by whitespace-separated values,
+ * the binary format stores a magic number, the format version and the values as raw int64_t.
+ **/
+class einsum_ir::basic::ContractionConfig {
+  public:
+    //! version of the serialization format
+    static constexpr int64_t m_version = 1;
+
+    //! magic number which starts the binary format
+    static constexpr int64_t m_magic_binary = 0x46434e4f43524945;
+
+    //! header of the text format
+    static constexpr char const * m_header_text = "einsum_ir_contraction_config";
+
+    //! iterations of the contraction
+    std::vector< iter_property > m_iterations;
+
+    //! datatype of the left input
+    data_t m_dtype_left = UNDEFINED_DTYPE;
+    //! datatype of the right input
+    data_t m_dtype_right = UNDEFINED_DTYPE;
+    //! datatype used during the computations
+    data_t m_dtype_comp = UNDEFINED_DTYPE;
+    //! datatype of the output
+    data_t m_dtype_out = UNDEFINED_DTYPE;
+
+    //! type of the first touch kernel
+    kernel_t m_ktype_first_touch = UNDEFINED_KTYPE;
+    //! type of the main kernel
+    kernel_t m_ktype_main = UNDEFINED_KTYPE;
+    //! type of the last touch kernel
+    kernel_t m_ktype_last_touch = UNDEFINED_KTYPE;
+
+    //! number of threads used for shared dimension parallelization
+    int64_t m_num_threads_shared = 1;
+    //! number of threads used for sfc m parallelization
+    int64_t m_num_threads_sfc_m = 1;
+    //! number of threads used for sfc n parallelization
+    int64_t m_num_threads_sfc_n = 1;
+
+    /**
+     * Appends the values of the configuration.
+     *
+     * @param io_values vector to which the values are appended.
+     **/
+    void serialize( std::vector< int64_t > & io_values ) const;
+
+    /**
+     * Sets the configuration from serialized values.
+     *
+     * @param i_values serialized values.
+     * @param io_pos position of the first value, will be set to the position after the configuration.
+     * @return SUCCESS if the values describe a valid configuration, INVALID_CONFIG otherwise.
+     **/
+    err_t deserialize( std::vector< int64_t > const & i_values,
+                       std::size_t                  & io_pos );
+
+    /**
+     * Converts the configuration to the text format.
+     *
+     * @return configuration in the text format.
+     **/
+    std::string to_string() const;
+
+    /**
+     * Sets the configuration from the text or binary format.
+     *
+     * @param i_data serialized configuration.
+     * @return SUCCESS if successful, INVALID_CONFIG otherwise.
+     **/
+    err_t from_string( std::string const & i_data );
+
+    /**
+     * Converts the configuration to the binary format.
+     *
+     * @return configuration in the binary format.
+     **/
+    std::string to_binary() const;
+
+    /**
+     * Appends the configuration's values to a text.
+     * The first line holds the data types, kernel types, thread partition and number of iterations,
+     * every following line one iteration.
+     *
+     * @param io_text text to which the values are appended.
+     **/
+    void append_text( std::string & io_text ) const;
+
+    /**
+     * Writes values in the binary format.
+     *
+     * @param i_magic magic number of the binary format.
+     * @param i_values values which are written.
+     * @return values in the binary format.
+     **/
+    static std::string write_values_binary( int64_t                        i_magic,
+                                            std::vector< int64_t > const & i_values );
+
+    /**
+     * Reads values in the text or binary format.
+     * The format is derived from the leading header or magic number.
+     *
+     * @param i_data serialized data.
+     * @param i_header header of the text format.
+     * @param i_magic magic number of the binary format.
+     * @param o_values will be set to the values.
+     * @return SUCCESS if successful, INVALID_CONFIG otherwise.
+     **/
+    static err_t read_values( std::string const      & i_data,
+                              char const             * i_header,
+                              int64_t                  i_magic,
+                              std::vector< int64_t > & o_values );
+};
+
+#endif
@@ -0,0 +1,222 @@
+#include "catch.hpp"
+#include "ContractionConfig.h"
+#include "ContractionConfigStore.h"
+#include "ContractionOptimizer.h"
+#include "ContractionBackendScalar.h"
+#include <cstdio>
+#include <string>
+
+TEST_CASE( "Text and binary serialization of contraction configurations.", "[contraction_config]" ) {
+  using namespace einsum_ir::basic;
+
+  ContractionConfig l_config;
+  l_config.m_iterations = { {dim_t::N, exec_t::OMP,   4,  0, 16, 0, 32,  0, 0},
+                            {dim_t::K, exec_t::SEQ,   2, 32,  1, 0,  0,  0, 8},
+                            {dim_t::M, exec_t::PRIM,  8,  1,  0, 0,  1,  0, 0},
+                            {dim_t::N, exec_t::PRIM,  4,  0, 64, 0,  8,  0, 0},
+                            {dim_t::K, exec_t::PRIM, 16,  8,  2, 0,  0, 16, 0} };
+  l_config.m_dtype_left         = FP32;
+  l_config.m_dtype_right        = BF16;
+  l_config.m_dtype_comp         = FP32;
+  l_config.m_dtype_out          = FP64;
+  l_config.m_ktype_first_touch  = ZERO;
+  l_config.m_ktype_main         = BR_MADD;
+  l_config.m_ktype_last_touch   = UNDEFINED_KTYPE;
+  l_config.m_num_threads_shared = 4;
+  l_config.m_num_threads_sfc_m  = 2;
+  l_config.m_num_threads_sfc_n  = 3;
+
+  std::vector< int64_t > l_values_ref;
+  l_config.serialize( l_values_ref );
+  REQUIRE( l_values_ref.size() == 11 + 5*9 );
+
+  std::string l_formats[2] = { l_config.to_string(),
+                               l_config.to_binary() };
+  for( int64_t l_fo = 0; l_fo < 2; l_fo++ ) {
+    ContractionConfig l_config_read;
+    REQUIRE( l_config_read.from_string( l_formats[l_fo] ) == SUCCESS );
+
+    std::vector< int64_t > l_values;
+    l_config_read.serialize( l_values );
+    REQUIRE( l_values == l_values_ref );
+  }
+
+  // malformed configurations leave the configuration unchanged
+  ContractionConfig l_config_invalid;
+  std::string l_text = l_config.to_string();
+  REQUIRE( l_config_invalid.from_string( "" ) == INVALID_CONFIG );
+  REQUIRE( l_config_invalid.from_string( l_text.substr( 0, l_text.size() - 4 ) ) == INVALID_CONFIG );
+  REQUIRE( l_config_invalid.from_string( l_text + " 1" ) == INVALID_CONFIG );
+  REQUIRE( l_config_invalid.from_string( "einsum_ir_contraction_config 2\n" + l_text.substr( l_text.find( '\n' ) + 1 ) ) == INVALID_CONFIG );
+  REQUIRE( l_config_invalid.from_string( l_config.to_binary().substr( 8 ) ) == INVALID_CONFIG );
+  REQUIRE( l_config_invalid.m_iterations.size() == 0 );
+
+  l_config.m_iterations[1].exec_type = exec_t::UNDEFINED_EXECTYPE;
+  REQUIRE( l_config_invalid.from_string( l_config.to_string() ) == INVALID_CONFIG );
+}
+
+TEST_CASE( "Contraction backend initialized from a stored configuration.", "[contraction_config]" ) {
+  using namespace einsum_ir::basic;
+
+  // C[n][m] = A[k][m] * B[n][k], the targets match the scalar backend's primitives
+  int64_t l_size_m = 24;
+  int64_t l_size_n = 20;
+  int64_t l_size_k = 12;
+
+  ContractionConfig l_config;
+  l_config.m_iterations = { {dim_t::M, exec_t::SEQ, l_size_m,        1,        0, 0,        1},
+                            {dim_t::N, exec_t::SEQ, l_size_n,        0, l_size_k, 0, l_size_m},
+                            {dim_t::K, exec_t::SEQ, l_size_k, l_size_m,        1, 0,        0} };
+  l_config.m_dtype_left         = FP32;
+  l_config.m_dtype_right        = FP32;
+  l_config.m_dtype_comp         = FP32;
+  l_config.m_dtype_out          = FP32;
+  l_config.m_ktype_first_touch  = ZERO;
+  l_config.m_ktype_main         = MADD;
+  l_config.m_ktype_last_touch   = UNDEFINED_KTYPE;
+  l_config.m_num_threads_shared = 2;
+
+  std::vector< int64_t > l_key = ContractionConfigStore::key( l_config,
+                                                              1,
+                                                              1,
+                                                              1,
+                                                              true,
+                                                              false,
+                                                              false,
+                                                              packed_gemm_t::ALL_STRIDE_ONE,
+                                                              0,
+                                                              1024*1024,
+                                                              0 );
+
+  // the streamed inputs are the last entry of every key
+  std::vector< int64_t > l_key_streamed = ContractionConfigStore::key( l_config,
+                                                                       1,
+                                                                       1,
+                                                                       1,
+                                                                       true,
+                                                                       false,
+                                                                       false,
+                                                                       packed_gemm_t::ALL_STRIDE_ONE,
+                                                                       0,
+                                                                       1024*1024,
+                                                                       0,
+                                                                       false,
+                                                                       true );
+  REQUIRE( l_key_streamed.size() == l_key.size() );
+  REQUIRE( l_key.back() == 0 );
+  REQUIRE( l_key_streamed.back() == 2 );
+
+  ContractionOptimizer l_optim;
+  l_optim.init( &l_config.m_iterations,
+                &l_config.m_ktype_main,
+                1,
+                1,
+                1,
+                true,
+                false,
+                false,
+                packed_gemm_t::ALL_STRIDE_ONE,
+                4,
+                1024*1024,
+                &l_config.m_num_threads_shared,
+                &l_config.m_num_threads_sfc_m,
+                &l_config.m_num_threads_sfc_n );
+  REQUIRE( l_optim.optimize() == SUCCESS );
+
+  // round trip through the text and binary formats of the store
+  ContractionConfigStore l_store;
+  l_store.insert( l_key, l_config );
+  REQUIRE( l_store.size() == 0 );
+  l_store.set_recording( true );
+  l_store.insert( l_key, l_config );
+  REQUIRE( l_store.size() == 1 );
+
+  for( int64_t l_fo = 0; l_fo < 2; l_fo++ ) {
+    ContractionConfigStore l_store_read;
+    REQUIRE( l_store_read.from_string( l_store.to_string( l_fo == 1 ) ) == SUCCESS );
+    REQUIRE( l_store_read.size() == 1 );
+
+    ContractionConfig l_config_read;
+    REQUIRE( l_store_read.find( l_key, l_config_read ) );
+    REQUIRE( l_config_read.to_string() == l_config.to_string() );
+
+    std::vector< int64_t > l_key_other = l_key;
+    l_key_other[0]++;
+    REQUIRE( !l_store_read.find( l_key_other, l_config_read ) );
+  }
+  REQUIRE( l_store.from_string( "einsum_ir_contraction_configs 1\n2\n" ) == INVALID_CONFIG );
+  REQUIRE( l_store.size() == 1 );
+
+  // plan files of other key layouts are rejected
+  REQUIRE( l_key[0] == ContractionConfigStore::m_version_key );
+  std::string l_text = l_store.to_string();
+  std::size_t l_pos_version = l_text.find( '\n' ) + 1;
+  std::string l_text_old = l_text;
+  l_text_old.replace( l_pos_version,
+                      std::to_string( ContractionConfigStore::m_version_key ).size(),
+                      std::to_string( ContractionConfigStore::m_version_key - 1 ) );
+  ContractionConfigStore l_store_old;
+  REQUIRE( l_store_old.from_string( l_text_old ) == INVALID_CONFIG );
+  REQUIRE( l_store_old.size() == 0 );
+
+  // forced insertions are written to the tuning database once per flush
+  std::string l_path_db = "einsum_ir_contraction_config.test.db";
+  std::remove( l_path_db.c_str() );
+  {
+    ContractionConfigStore l_store_db;
+    l_store_db.set_path_db( l_path_db );
+    REQUIRE( l_store_db.flush() == SUCCESS );
+    REQUIRE( l_store_db.load( l_path_db ) == UNDEFINED_ERROR );
+
+    l_store_db.insert( l_key, l_config, true );
+    REQUIRE( l_store_db.load( l_path_db ) == UNDEFINED_ERROR );
+    REQUIRE( l_store_db.flush() == SUCCESS );
+
+    ContractionConfigStore l_store_read;
+    REQUIRE( l_store_read.load( l_path_db ) == SUCCESS );
+    REQUIRE( l_store_read.size() == 1 );
+    std::remove( l_path_db.c_str() );
+
+    // pending insertions are written on destruction
+    l_store_db.insert( l_key, l_config, true );
+  }
+  ContractionConfigStore l_store_destructed;
+  REQUIRE( l_store_destructed.load( l_path_db ) == SUCCESS );
+  REQUIRE( l_store_destructed.size() == 1 );
+  std::remove( l_path_db.c_str() );
+
+  // contract with the loaded configuration
+  ContractionConfigStore l_store_loaded;
+  REQUIRE( l_store_loaded.from_string( l_store.to_string() ) == SUCCESS );
+  ContractionConfig l_config_loaded;
+  REQUIRE( l_store_loaded.find( l_key, l_config_loaded ) );
+
+  std::vector< float > l_left( l_size_k * l_size_m );
+  std::vector< float > l_right( l_size_n * l_size_k );
+  std::vector< float > l_out( l_size_n * l_size_m, 1.0f );
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = (float) (l_en % 7) - 3;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = (float) (l_en % 5) * 0.5f;
+  }
+
+  ContractionBackendScalar l_backend;
+  l_backend.init( l_config_loaded,
+                  nullptr );
+  REQUIRE( l_backend.compile() == SUCCESS );
+  l_backend.contract( l_left.data(),
+                      l_right.data(),
+                      nullptr,
+                      l_out.data() );
+
+  for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < l_size_m; l_m++ ) {
+      float l_ref = 0;
+      for( int64_t l_k = 0; l_k < l_size_k; l_k++ ) {
+        l_ref += l_left[l_k*l_size_m + l_m] * l_right[l_n*l_size_k + l_k];
+      }
+      REQUIRE( l_out[l_n*l_size_m + l_m] == Approx( l_ref ) );
+    }
+  }
+}
@@ -0,0 +1,254 @@
+#include "ContractionConfigStore.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+einsum_ir::basic::ContractionConfigStore::~ContractionConfigStore() {
+  flush();
+}
+
+einsum_ir::basic::ContractionConfigStore & einsum_ir::basic::ContractionConfigStore::get_instance() {
+  static ContractionConfigStore s_store;
+  static std::once_flag s_init;
+
+  std::call_once( s_init, [](){
+    char * l_env = std::getenv( "EINSUM_IR_CONTRACTION_CONFIGS" );
+    if( l_env != nullptr ) {
+      // a missing or malformed plan file falls back to the optimizer
+      s_store.load( l_env );
+    }
+
+    // tuned configurations take precedence
+    l_env = std::getenv( "EINSUM_IR_TUNE_DB" );
+    if( l_env != nullptr ) {
+      s_store.load( l_env );
+      s_store.set_path_db( l_env );
+    }
+
+    l_env = std::getenv( "EINSUM_IR_CONTRACTION_CONFIGS_RECORD" );
+    if( l_env != nullptr ) {
+      s_store.set_recording( std::atoi( l_env ) != 0 );
+    }
+  } );
+
+  return s_store;
+}
+
+std::vector< int64_t > einsum_ir::basic::ContractionConfigStore::key( ContractionConfig const & i_config,
+                                                                      int64_t                   i_target_m,
+                                                                      int64_t                   i_target_n,
+                                                                      int64_t                   i_target_k,
+                                                                      bool                      i_generate_sfcs,
+                                                                      bool                      i_br_gemm_support,
+                                                                      bool                      i_packing_support,
+                                                                      packed_gemm_t             i_packed_gemm_support,
+                                                                      int64_t                   i_l1_cache_size,
+                                                                      int64_t                   i_l2_cache_size,
+                                                                      int64_t                   i_l3_cache_size,
+                                                                      bool                      i_streamed_left,
+                                                                      bool                      i_streamed_right ) {
+  std::vector< int64_t > l_key;
+  l_key.push_back( m_version_key );
+  l_key.push_back( i_target_m );
+  l_key.push_back( i_target_n );
+  l_key.push_back( i_target_k );
+  l_key.push_back( i_generate_sfcs );
+  l_key.push_back( i_br_gemm_support );
+  l_key.push_back( i_packing_support );
+  l_key.push_back( i_packed_gemm_support );
+  l_key.push_back( i_l1_cache_size );
+  l_key.push_back( i_l2_cache_size );
+  l_key.push_back( i_l3_cache_size );
+
+  i_config.serialize( l_key );
+
+  l_key.push_back( i_streamed_left + 2 * i_streamed_right );
+
+  return l_key;
+}
+
+bool einsum_ir::basic::ContractionConfigStore::find( std::vector< int64_t > const & i_key,
+                                                     ContractionConfig            & o_config ) const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  auto l_it = m_configs.find( i_key );
+  if( l_it == m_configs.end() ) {
+    return false;
+  }
+  o_config = l_it->second;
+
+  return true;
+}
+
+void einsum_ir::basic::ContractionConfigStore::insert( std::vector< int64_t > const & i_key,
+                                                       ContractionConfig      const & i_config,
+                                                       bool                           i_force ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  if( m_recording || i_force ) {
+    m_configs[i_key] = i_config;
+  }
+  if( i_force ) {
+    m_modified = true;
+  }
+}
+
+void einsum_ir::basic::ContractionConfigStore::set_path_db( std::string const & i_path ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_path_db = i_path;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionConfigStore::flush() {
+  std::string l_path;
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    if( !m_modified || m_path_db.empty() ) {
+      return err_t::SUCCESS;
+    }
+    l_path = m_path_db;
+    m_modified = false;
+  }
+
+  return store( l_path );
+}
+
+void einsum_ir::basic::ContractionConfigStore::set_recording( bool i_recording ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_recording = i_recording;
+}
+
+void einsum_ir::basic::ContractionConfigStore::clear() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_configs.clear();
+}
+
+int64_t einsum_ir::basic::ContractionConfigStore::size() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_configs.size();
+}
+
+std::string einsum_ir::basic::ContractionConfigStore::to_string( bool i_binary ) const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  if( i_binary ) {
+    std::vector< int64_t > l_values;
+    l_values.push_back( m_version_key );
+    l_values.push_back( m_configs.size() );
+    for( auto const & l_entry : m_configs ) {
+      l_values.push_back( l_entry.first.size() );
+      l_values.insert( l_values.end(),
+                       l_entry.first.begin(),
+                       l_entry.first.end() );
+      l_entry.second.serialize( l_values );
+    }
+
+    return ContractionConfig::write_values_binary( m_magic_binary,
+                                                   l_values );
+  }
+
+  std::ostringstream l_stream;
+  l_stream << m_header_text << " " << ContractionConfig::m_version << "\n";
+  l_stream << m_version_key << " " << m_configs.size() << "\n";
+  std::string l_text = l_stream.str();
+
+  // every entry is given by a line with the key's size and values, followed by the configuration
+  for( auto const & l_entry : m_configs ) {
+    l_text += std::to_string( l_entry.first.size() );
+    for( std::size_t l_va = 0; l_va < l_entry.first.size(); l_va++ ) {
+      l_text += " " + std::to_string( l_entry.first[l_va] );
+    }
+    l_text += "\n";
+    l_entry.second.append_text( l_text );
+  }
+
+  return l_text;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionConfigStore::from_string( std::string const & i_data ) {
+  std::vector< int64_t > l_values;
+  err_t l_err = ContractionConfig::read_values( i_data,
+                                                m_header_text,
+                                                m_magic_binary,
+                                                l_values );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+  // keys of other layouts would never be found
+  if(    l_values.size() < 2
+      || l_values[0] != m_version_key
+      || l_values[1] < 0 ) {
+    return err_t::INVALID_CONFIG;
+  }
+
+  // parse all entries before modifying the store
+  std::map< std::vector< int64_t >, ContractionConfig > l_configs;
+  std::size_t l_pos = 2;
+  for( int64_t l_en = 0; l_en < l_values[1]; l_en++ ) {
+    if( l_pos >= l_values.size() ) {
+      return err_t::INVALID_CONFIG;
+    }
+    int64_t l_key_size = l_values[l_pos++];
+    if(    l_key_size < 1
+        || static_cast< std::size_t >( l_key_size ) > l_values.size() - l_pos
+        || l_values[l_pos] != m_version_key ) {
+      return err_t::INVALID_CONFIG;
+    }
+    std::vector< int64_t > l_key( l_values.begin() + l_pos,
+                                  l_values.begin() + l_pos + l_key_size );
+    l_pos += l_key_size;
+
+    ContractionConfig l_config;
+    l_err = l_config.deserialize( l_values,
+                                  l_pos );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+    l_configs[l_key] = l_config;
+  }
+  if( l_pos != l_values.size() ) {
+    return err_t::INVALID_CONFIG;
+  }
+
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  for( auto const & l_entry : l_configs ) {
+    m_configs[l_entry.first] = l_entry.second;
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionConfigStore::store( std::string const & i_path,
+                                                                         bool                i_binary ) const {
+  std::lock_guard< std::mutex > l_lock( m_mutex_file );
+
+  std::ofstream l_file( i_path,
+                        std::ios::binary );
+  if( !l_file ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  std::string l_data = to_string( i_binary );
+  l_file.write( l_data.data(),
+                l_data.size() );
+  if( !l_file ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionConfigStore::load( std::string const & i_path ) {
+  std::ifstream l_file( i_path,
+                        std::ios::binary );
+  if( !l_file ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  std::ostringstream l_data;
+  l_data << l_file.rdbuf();
+  if( !l_file ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  return from_string( l_data.str() );
+}
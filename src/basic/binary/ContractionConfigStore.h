@@ -0,0 +1,200 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_CONFIG_STORE
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_CONFIG_STORE
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../constants.h"
+#include "ContractionConfig.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionConfigStore;
+  }
+}
+
+/**
+ * Store of optimized contraction configurations.
+ *
+ * Configurations are keyed by the unoptimized configuration and the parameters of the contraction optimizer.
+ * A deployment ships a plan file with precomputed configurations which is loaded through the environment variable
+ * EINSUM_IR_CONTRACTION_CONFIGS, in which case the contraction optimization is skipped for all stored contractions.
+ * Plan files are generated by enabling the recording of optimized configurations and storing the configurations afterwards.
+ * Every key and every plan file carries the version of the key layout, plan files of other versions are rejected.
+ **/
+class einsum_ir::basic::ContractionConfigStore {
+  private:
+    //! magic number which starts the binary format
+    static constexpr int64_t m_magic_binary = 0x53434e4f43524945;
+
+    //! header of the text format
+    static constexpr char const * m_header_text = "einsum_ir_contraction_configs";
+
+  public:
+    //! version of the key layout, has to be incremented whenever the parameters of the key change
+    static constexpr int64_t m_version_key = 3;
+
+  private:
+
+    //! stored configurations
+    std::map< std::vector< int64_t >, ContractionConfig > m_configs;
+
+    //! true if inserted configurations are recorded
+    bool m_recording = false;
+
+    //! path of the tuning database, empty if forced insertions are not persisted
+    std::string m_path_db;
+
+    //! true if the store holds forced insertions which are not written to the tuning database
+    bool m_modified = false;
+
+    //! protects the store
+    mutable std::mutex m_mutex;
+
+    //! serializes writes of plan files
+    mutable std::mutex m_mutex_file;
+
+  public:
+    /**
+     * Destructor which writes pending forced insertions to the tuning database.
+     **/
+    ~ContractionConfigStore();
+
+    /**
+     * Gets the process-wide store.
+     * The store is initialized with the plan file given by the environment variable EINSUM_IR_CONTRACTION_CONFIGS
+     * and the tuning database given by EINSUM_IR_TUNE_DB, which is also the store's database path.
+     * Setting EINSUM_IR_CONTRACTION_CONFIGS_RECORD to 1 enables the recording.
+     *
+     * @return process-wide store.
+     **/
+    static ContractionConfigStore & get_instance();
+
+    /**
+     * Derives the key of a contraction.
+     * The key starts with the version of the key layout.
+     *
+     * @param i_config unoptimized configuration of the contraction.
+     * @param i_target_m target m size of the primitive.
+     * @param i_target_n target n size of the primitive.
+     * @param i_target_k target k size of the primitive.
+     * @param i_generate_sfcs true if sfcs may be generated.
+     * @param i_br_gemm_support true if batch-reduce kernels are supported.
+     * @param i_packing_support true if packing is supported.
+     * @param i_packed_gemm_support supported packed kernels.
+     * @param i_l1_cache_size size of the L1 data cache in bytes.
+     * @param i_l2_cache_size size of the L2 cache in bytes.
+     * @param i_l3_cache_size size of the L3 cache in bytes.
+     * @param i_streamed_left true if the left input is streamed.
+     * @param i_streamed_right true if the right input is streamed.
+     * @return key of the contraction.
+     **/
+    static std::vector< int64_t > key( ContractionConfig const & i_config,
+                                       int64_t                   i_target_m,
+                                       int64_t                   i_target_n,
+                                       int64_t                   i_target_k,
+                                       bool                      i_generate_sfcs,
+                                       bool                      i_br_gemm_support,
+                                       bool                      i_packing_support,
+                                       packed_gemm_t             i_packed_gemm_support,
+                                       int64_t                   i_l1_cache_size,
+                                       int64_t                   i_l2_cache_size,
+                                       int64_t                   i_l3_cache_size,
+                                       bool                      i_streamed_left = false,
+                                       bool                      i_streamed_right = false );
+
+    /**
+     * Finds a configuration.
+     *
+     * @param i_key key of the contraction.
+     * @param o_config will be set to the stored configuration if present.
+     * @return true if a configuration is stored for the key, false otherwise.
+     **/
+    bool find( std::vector< int64_t > const & i_key,
+               ContractionConfig            & o_config ) const;
+
+    /**
+     * Inserts a configuration if the recording is enabled.
+     * Existing configurations are replaced.
+     * Forced insertions are written to the tuning database by the next flush.
+     *
+     * @param i_key key of the contraction.
+     * @param i_config optimized configuration.
+     * @param i_force true if the configuration is inserted regardless of the recording, e.g., for tuned configurations.
+     **/
+    void insert( std::vector< int64_t > const & i_key,
+                 ContractionConfig      const & i_config,
+                 bool                           i_force = false );
+
+    /**
+     * Enables or disables the recording of inserted configurations.
+     *
+     * @param i_recording true if configurations are recorded.
+     **/
+    void set_recording( bool i_recording );
+
+    /**
+     * Sets the path of the tuning database.
+     *
+     * @param i_path path of the tuning database, empty if forced insertions are not persisted.
+     **/
+    void set_path_db( std::string const & i_path );
+
+    /**
+     * Writes the store to the tuning database if forced insertions are pending.
+     * Callers flush once after a batch of tuned contractions instead of after every contraction.
+     *
+     * @return SUCCESS if successful or nothing is pending, UNDEFINED_ERROR if the file could not be written.
+     **/
+    err_t flush();
+
+    /**
+     * Removes all configurations.
+     **/
+    void clear();
+
+    /**
+     * Gets the number of stored configurations.
+     *
+     * @return number of configurations.
+     **/
+    int64_t size() const;
+
+    /**
+     * Converts the store to the text or binary format.
+     *
+     * @param i_binary true if the binary format is used.
+     * @return serialized store.
+     **/
+    std::string to_string( bool i_binary = false ) const;
+
+    /**
+     * Adds the configurations of a serialized store in the text or binary format.
+     *
+     * @param i_data serialized store.
+     * @return SUCCESS if successful, INVALID_CONFIG if the data is malformed or uses another version of the key layout.
+     **/
+    err_t from_string( std::string const & i_data );
+
+    /**
+     * Writes the store to a plan file.
+     *
+     * @param i_path path of the plan file.
+     * @param i_binary true if the binary format is used.
+     * @return SUCCESS if successful, UNDEFINED_ERROR if the file could not be written.
+     **/
+    err_t store( std::string const & i_path,
+                 bool                i_binary = false ) const;
+
+    /**
+     * Adds the configurations of a plan file.
+     *
+     * @param i_path path of the plan file.
+     * @return SUCCESS if successful, UNDEFINED_ERROR if the file could not be read, INVALID_CONFIG if the file is malformed or uses another version of the key layout.
+     **/
+    err_t load( std::string const & i_path );
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "ContractionContext.h"
+#include <algorithm>
+
+void einsum_ir::basic::ContractionContext::init( std::vector< thread_info > const & i_thread_infos,
+                                                 int64_t                            i_num_cached_ptrs_left,
+                                                 int64_t                            i_num_cached_ptrs_right,
+                                                 int64_t                            i_size_packing_memory,
+                                                 ContractionMemoryManager         * i_memory ) {
+  int64_t l_num_threads = i_thread_infos.size();
+  m_size_packing_memory = i_size_packing_memory;
+
+  m_thread_states.clear();
+  m_thread_states.resize( l_num_threads );
+  for( int64_t l_th = 0; l_th < l_num_threads; l_th++ ) {
+    m_thread_states[l_th].k_count.resize( i_thread_infos[l_th].sfc_size_m * i_thread_infos[l_th].sfc_size_n, 0 );
+    m_thread_states[l_th].cached_ptrs_left.resize(  i_num_cached_ptrs_left,  nullptr );
+    m_thread_states[l_th].cached_ptrs_right.resize( i_num_cached_ptrs_right, nullptr );
+  }
+
+  if( i_memory == nullptr ) {
+    m_personal_memory.reset( new ContractionMemoryManager() );
+    m_personal_memory->reserve_thread_memory( i_size_packing_memory,
+                                              l_num_threads );
+    m_personal_memory->alloc_all_memory();
+    m_memory = m_personal_memory.get();
+  }
+  else {
+    m_personal_memory.reset();
+    i_memory->reserve_thread_memory( i_size_packing_memory,
+                                     l_num_threads );
+    m_memory = i_memory;
+  }
+}
+
+einsum_ir::basic::thread_state * einsum_ir::basic::ContractionContext::prepare_thread( int64_t i_thread_id,
+                                                                                        int64_t i_size_acc,
+                                                                                        int64_t i_size_packing_left ) {
+  thread_state * l_state = &m_thread_states[i_thread_id];
+  l_state->time_packing = 0;
+
+  // the memory of external managers is allocated after the compilation
+  if( m_size_packing_memory > 0 ) {
+    l_state->memory_acc   = m_memory->get_thread_memory( i_thread_id );
+    l_state->memory_left  = l_state->memory_acc + i_size_acc;
+    l_state->memory_right = l_state->memory_left + i_size_packing_left;
+  }
+
+  // packed blocks of previous contractions are stale since the inputs may have changed
+  std::fill( l_state->cached_ptrs_left.begin(),  l_state->cached_ptrs_left.end(),  nullptr );
+  std::fill( l_state->cached_ptrs_right.begin(), l_state->cached_ptrs_right.end(), nullptr );
+
+  return l_state;
+}
+
+double einsum_ir::basic::ContractionContext::time_packing() const {
+  if( m_thread_states.size() == 0 ) {
+    return 0;
+  }
+
+  double l_time = 0;
+  for( std::size_t l_th = 0; l_th < m_thread_states.size(); l_th++ ) {
+    l_time += m_thread_states[l_th].time_packing;
+  }
+
+  return l_time / m_thread_states.size();
+}
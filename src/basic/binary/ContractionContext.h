@@ -0,0 +1,83 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_CONTEXT
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_CONTEXT
+
+#include <memory>
+#include <vector>
+#include "../constants.h"
+#include "ContractionMemoryManager.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionContext;
+  }
+}
+
+/**
+ * Mutable state of contractions, i.e., the per-thread accumulator and packing memory, cached pointers and k-counters.
+ * A compiled contraction backend is not modified by a contraction with an explicit context.
+ * Thus, one backend can be shared by multiple threads which contract concurrently using their own contexts.
+ **/
+class einsum_ir::basic::ContractionContext {
+  private:
+    //! memory manager owned by the context, used if no external memory manager is given
+    std::unique_ptr< ContractionMemoryManager > m_personal_memory;
+
+    //! memory manager providing the scratch memory of the threads
+    ContractionMemoryManager * m_memory = nullptr;
+
+    //! scratch memory required per thread in bytes, i.e., accumulator and packing memory
+    int64_t m_size_packing_memory = 0;
+
+  public:
+    //! state of the threads
+    std::vector< thread_state > m_thread_states;
+
+    /**
+     * Constructor.
+     **/
+    ContractionContext() = default;
+
+    /**
+     * Contexts own memory and are not copyable.
+     **/
+    ContractionContext( ContractionContext const & ) = delete;
+    ContractionContext & operator=( ContractionContext const & ) = delete;
+
+    /**
+     * Initializes the context for a compiled contraction.
+     *
+     * @param i_thread_infos information of the contraction's threads.
+     * @param i_num_cached_ptrs_left number of cached packed blocks of the left tensor.
+     * @param i_num_cached_ptrs_right number of cached packed blocks of the right tensor.
+     * @param i_size_packing_memory scratch memory required per thread in bytes, i.e., accumulator and packing memory.
+     * @param i_memory external memory manager whose thread memory is reserved; nullptr allocates memory owned by the context.
+     **/
+    void init( std::vector< thread_info > const & i_thread_infos,
+               int64_t                            i_num_cached_ptrs_left,
+               int64_t                            i_num_cached_ptrs_right,
+               int64_t                            i_size_packing_memory,
+               ContractionMemoryManager         * i_memory );
+
+    /**
+     * Resets the per-contraction state of a thread and gets its scratch memory.
+     *
+     * @param i_thread_id id of the thread.
+     * @param i_size_acc size of the accumulator memory in bytes, multiple of the cache line size.
+     *                   The left tensor's packing memory follows the accumulator.
+     * @param i_size_packing_left size of the left tensor's packing memory in bytes, including all cached blocks.
+     *                            The right tensor's packing memory follows the left one.
+     * @return state of the thread.
+     **/
+    thread_state * prepare_thread( int64_t i_thread_id,
+                                   int64_t i_size_acc,
+                                   int64_t i_size_packing_left );
+
+    /**
+     * Gets the packing time of the last contraction.
+     *
+     * @return packing time in seconds, averaged over the threads.
+     **/
+    double time_packing() const;
+};
+
+#endif
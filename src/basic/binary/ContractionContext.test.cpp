@@ -0,0 +1,114 @@
+#include "catch.hpp"
+#include "ContractionBackendSimd.h"
+#include "../threading.h"
+#include <cmath>
+
+TEST_CASE( "Concurrent FP32 contractions sharing a compiled backend through contexts.", "[contraction_context]" ) {
+  // Test Case:
+  //
+  //    _____xnm_____
+  //   /
+  // km             xnk
+  //
+  // char   id   size   type
+  //    x    0      4   N (SFC)
+  //    m    1     21   M (PRIM)
+  //    n    2      6   N (PRIM)
+  //    k    3      9   K (PRIM)
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_dim_types  = { dim_t::N,
+                                         dim_t::M,
+                                         dim_t::N,
+                                         dim_t::K };
+  std::vector< exec_t > l_exec_types = { exec_t::SFC,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM,
+                                         exec_t::PRIM };
+
+  //                                           x,  m,  n,  k
+  std::vector< int64_t > l_sizes           = { 4, 21,  6,  9 };
+  std::vector< int64_t > l_strides_left    = { 0,  1,  0, 21 };
+  std::vector< int64_t > l_strides_right   = { 54, 0,  9,  1 };
+  std::vector< int64_t > l_strides_out_aux = { 0,  0,  0,  0 };
+  std::vector< int64_t > l_strides_out     = { 126, 1, 21, 0 };
+  std::vector< int64_t > l_packing_strides = {};
+
+  int64_t l_num_tasks = 3;
+
+  ContractionBackendSimd l_bin_cont;
+  l_bin_cont.init( l_dim_types,
+                   l_exec_types,
+                   l_sizes,
+                   l_strides_left,
+                   l_strides_right,
+                   l_strides_out_aux,
+                   l_strides_out,
+                   l_packing_strides,
+                   l_packing_strides,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   kernel_t::ZERO,
+                   kernel_t::MADD,
+                   kernel_t::UNDEFINED_KTYPE,
+                   1,
+                   2,
+                   1,
+                   nullptr );
+  REQUIRE( l_bin_cont.compile() == err_t::SUCCESS );
+
+  // every task uses its own inputs, output and context
+  std::vector< std::vector< float > > l_left( l_num_tasks );
+  std::vector< std::vector< float > > l_right( l_num_tasks );
+  std::vector< std::vector< float > > l_out( l_num_tasks );
+  std::vector< std::vector< float > > l_out_ref( l_num_tasks );
+  std::vector< ContractionContext > l_contexts( l_num_tasks );
+
+  for( int64_t l_ta = 0; l_ta < l_num_tasks; l_ta++ ) {
+    l_left[l_ta].resize( 9 * 21 );
+    l_right[l_ta].resize( 4 * 6 * 9 );
+    l_out[l_ta].resize( 4 * 6 * 21, 42.0f );
+    l_out_ref[l_ta].resize( 4 * 6 * 21 );
+
+    for( std::size_t l_en = 0; l_en < l_left[l_ta].size(); l_en++ ) {
+      l_left[l_ta][l_en] = ( (l_en * 7 + l_ta) % 13 ) * 0.25f - 1.5f;
+    }
+    for( std::size_t l_en = 0; l_en < l_right[l_ta].size(); l_en++ ) {
+      l_right[l_ta][l_en] = ( (l_en * 5 + 3 * l_ta) % 11 ) * 0.5f - 2.0f;
+    }
+
+    // reference
+    for( int64_t l_x = 0; l_x < 4; l_x++ ) {
+      for( int64_t l_n = 0; l_n < 6; l_n++ ) {
+        for( int64_t l_m = 0; l_m < 21; l_m++ ) {
+          float l_sum = 0;
+          for( int64_t l_k = 0; l_k < 9; l_k++ ) {
+            l_sum +=   l_left[l_ta][ l_k*21 + l_m ]
+                     * l_right[l_ta][ l_x*54 + l_n*9 + l_k ];
+          }
+          l_out_ref[l_ta][ l_x*126 + l_n*21 + l_m ] = l_sum;
+        }
+      }
+    }
+
+    l_bin_cont.init_context( l_contexts[l_ta] );
+  }
+
+  for( int64_t l_re = 0; l_re < 4; l_re++ ) {
+    execute_nested( l_num_tasks, [&]( int64_t l_ta ) {
+      l_bin_cont.contract( l_left[l_ta].data(),
+                           l_right[l_ta].data(),
+                           nullptr,
+                           l_out[l_ta].data(),
+                           l_contexts[l_ta] );
+    } );
+  }
+
+  for( int64_t l_ta = 0; l_ta < l_num_tasks; l_ta++ ) {
+    for( std::size_t l_en = 0; l_en < l_out[l_ta].size(); l_en++ ) {
+      REQUIRE( l_out[l_ta][l_en] == Approx( l_out_ref[l_ta][l_en] ) );
+    }
+  }
+}
@@ -0,0 +1,167 @@
+#include "ContractionEpilogue.h"
+#include "../low_precision.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+template< typename T_OUT,
+          typename T_COMP >
+void einsum_ir::basic::ContractionEpilogue::kernel( ContractionEpilogue const & i_epilogue,
+                                                    int64_t                     i_m,
+                                                    int64_t                     i_n,
+                                                    int64_t                     i_ld_out,
+                                                    int64_t                     i_stride_m_out_aux,
+                                                    int64_t                     i_stride_n_out_aux,
+                                                    void                const * i_out_aux,
+                                                    void                      * io_out ) {
+  T_OUT const * l_out_aux = (T_OUT const *) i_out_aux;
+  T_OUT       * l_out     = (T_OUT       *) io_out;
+
+  T_COMP const l_alpha = T_COMP( i_epilogue.m_alpha );
+  T_COMP const l_beta  = T_COMP( i_epilogue.m_beta );
+  T_COMP const l_rsqrt2 = T_COMP( 0.70710678118654752440 );
+
+  T_COMP l_buffer[m_size_block];
+
+  for( int64_t l_n = 0; l_n < i_n; l_n++ ) {
+    for( int64_t l_m0 = 0; l_m0 < i_m; l_m0 += m_size_block ) {
+      int64_t l_size = std::min( m_size_block, i_m - l_m0 );
+      T_OUT * l_out_block = l_out + l_n * i_ld_out + l_m0;
+
+      // values of the block in the computation type
+      T_COMP * l_vals = l_buffer;
+      if constexpr( std::is_same< T_OUT, T_COMP >::value ) {
+        l_vals = l_out_block;
+      }
+      else {
+        for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+          l_vals[l_m] = T_COMP( l_out_block[l_m] );
+        }
+      }
+
+      for( kernel_t l_ktype : i_epilogue.m_ktypes ) {
+        if( l_ktype == kernel_t::ADD ) {
+          T_OUT const * l_aux_block = l_out_aux + l_n * i_stride_n_out_aux + l_m0 * i_stride_m_out_aux;
+          for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+            l_vals[l_m] += l_beta * T_COMP( l_aux_block[ l_m * i_stride_m_out_aux ] );
+          }
+        }
+        else if( l_ktype == kernel_t::SCALE ) {
+          for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+            l_vals[l_m] *= l_alpha;
+          }
+        }
+        else if( l_ktype == kernel_t::RELU ) {
+          for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+            l_vals[l_m] = std::max( l_vals[l_m], T_COMP(0) );
+          }
+        }
+        else if( l_ktype == kernel_t::GELU ) {
+          for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+            l_vals[l_m] = T_COMP(0.5) * l_vals[l_m] * ( T_COMP(1) + std::erf( l_vals[l_m] * l_rsqrt2 ) );
+          }
+        }
+        else if( l_ktype == kernel_t::SILU ) {
+          for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+            l_vals[l_m] = l_vals[l_m] / ( T_COMP(1) + std::exp( -l_vals[l_m] ) );
+          }
+        }
+        else if( l_ktype == kernel_t::SIGMOID ) {
+          for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+            l_vals[l_m] = T_COMP(1) / ( T_COMP(1) + std::exp( -l_vals[l_m] ) );
+          }
+        }
+        else if( l_ktype == kernel_t::TANH ) {
+          for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+            l_vals[l_m] = std::tanh( l_vals[l_m] );
+          }
+        }
+      }
+
+      if constexpr( !std::is_same< T_OUT, T_COMP >::value ) {
+        for( int64_t l_m = 0; l_m < l_size; l_m++ ) {
+          l_out_block[l_m] = T_OUT( l_vals[l_m] );
+        }
+      }
+    }
+  }
+}
+
+bool einsum_ir::basic::ContractionEpilogue::supports( kernel_t i_ktype ) {
+  return    i_ktype == kernel_t::ADD
+         || i_ktype == kernel_t::SCALE
+         || i_ktype == kernel_t::RELU
+         || i_ktype == kernel_t::GELU
+         || i_ktype == kernel_t::SILU
+         || i_ktype == kernel_t::SIGMOID
+         || i_ktype == kernel_t::TANH;
+}
+
+void einsum_ir::basic::ContractionEpilogue::init( std::vector< kernel_t > const & i_ktypes,
+                                                  double                          i_alpha,
+                                                  double                          i_beta ) {
+  m_ktypes = i_ktypes;
+  m_alpha = i_alpha;
+  m_beta = i_beta;
+  m_kernel = nullptr;
+}
+
+std::vector< einsum_ir::basic::kernel_t > const & einsum_ir::basic::ContractionEpilogue::get_ktypes() const {
+  return m_ktypes;
+}
+
+double einsum_ir::basic::ContractionEpilogue::get_alpha() const {
+  return m_alpha;
+}
+
+double einsum_ir::basic::ContractionEpilogue::get_beta() const {
+  return m_beta;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionEpilogue::compile( data_t i_dtype_comp,
+                                                                        data_t i_dtype_out ) {
+  for( kernel_t l_ktype : m_ktypes ) {
+    if( !supports( l_ktype ) ) {
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+
+  if( i_dtype_comp == FP32 && i_dtype_out == FP32 ) {
+    m_kernel = &kernel< float, float >;
+  }
+  else if( i_dtype_comp == FP64 && i_dtype_out == FP64 ) {
+    m_kernel = &kernel< double, double >;
+  }
+  else if( i_dtype_comp == FP32 && i_dtype_out == BF16 ) {
+    m_kernel = &kernel< bf16_t, float >;
+  }
+  else if( i_dtype_comp == FP32 && i_dtype_out == FP16 ) {
+    m_kernel = &kernel< fp16_t, float >;
+  }
+  else {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::basic::ContractionEpilogue::apply( int64_t         i_m,
+                                                   int64_t         i_n,
+                                                   int64_t         i_ld_out,
+                                                   int64_t         i_stride_m_out_aux,
+                                                   int64_t         i_stride_n_out_aux,
+                                                   void    const * i_out_aux,
+                                                   void          * io_out ) const {
+  if( m_ktypes.empty() ) {
+    return;
+  }
+
+  m_kernel( *this,
+            i_m,
+            i_n,
+            i_ld_out,
+            i_stride_m_out_aux,
+            i_stride_n_out_aux,
+            i_out_aux,
+            io_out );
+}
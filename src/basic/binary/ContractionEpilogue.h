@@ -0,0 +1,149 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_EPILOGUE
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_EPILOGUE
+
+#include <cstdint>
+#include <vector>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionEpilogue;
+  }
+}
+
+/**
+ * Chain of element-wise operations which is applied to an output block of a contraction in its last touch.
+ * The operations are executed in the given order, e.g., ADD followed by GELU adds a bias and applies the activation function.
+ *
+ * Supported operations:
+ *   ADD:     x = x + beta * aux
+ *   SCALE:   x = alpha * x
+ *   RELU:    x = max( x, 0 )
+ *   GELU:    x = 0.5 * x * ( 1 + erf( x / sqrt(2) ) )
+ *   SILU:    x = x / ( 1 + exp(-x) )
+ *   SIGMOID: x = 1 / ( 1 + exp(-x) )
+ *   TANH:    x = tanh( x )
+ **/
+class einsum_ir::basic::ContractionEpilogue {
+  private:
+    //! number of values of a column which are processed at once
+    static constexpr int64_t m_size_block = 256;
+
+    //! operations of the chain
+    std::vector< kernel_t > m_ktypes;
+
+    //! factor of the SCALE operation
+    double m_alpha = 1.0;
+
+    //! factor of the auxiliary tensor in the ADD operation
+    double m_beta = 1.0;
+
+    //! kernel applying the chain, set during compilation
+    void (* m_kernel)( ContractionEpilogue const & i_epilogue,
+                       int64_t                     i_m,
+                       int64_t                     i_n,
+                       int64_t                     i_ld_out,
+                       int64_t                     i_stride_m_out_aux,
+                       int64_t                     i_stride_n_out_aux,
+                       void                const * i_out_aux,
+                       void                      * io_out ) = nullptr;
+
+    /**
+     * Applies the chain to a column-major block.
+     * Low precision outputs are converted to the computation type once per block.
+     *
+     * @param_t T_OUT datatype of the output.
+     * @param_t T_COMP datatype used during the computations.
+     * @param i_epilogue epilogue whose chain is applied.
+     * @param i_m number of rows.
+     * @param i_n number of columns.
+     * @param i_ld_out leading dimension of the output.
+     * @param i_stride_m_out_aux stride of the auxiliary tensor in the m-dimension.
+     * @param i_stride_n_out_aux stride of the auxiliary tensor in the n-dimension.
+     * @param i_out_aux pointer to the auxiliary tensor's data.
+     * @param io_out pointer to the output tensor's data.
+     **/
+    template< typename T_OUT,
+              typename T_COMP >
+    static void kernel( ContractionEpilogue const & i_epilogue,
+                        int64_t                     i_m,
+                        int64_t                     i_n,
+                        int64_t                     i_ld_out,
+                        int64_t                     i_stride_m_out_aux,
+                        int64_t                     i_stride_n_out_aux,
+                        void                const * i_out_aux,
+                        void                      * io_out );
+
+  public:
+    /**
+     * Checks if the given kernel type is a supported operation of the chain.
+     *
+     * @param i_ktype kernel type.
+     * @return true if supported, false otherwise.
+     **/
+    static bool supports( kernel_t i_ktype );
+
+    /**
+     * Initializes the epilogue.
+     *
+     * @param i_ktypes operations of the chain.
+     * @param i_alpha factor of the SCALE operation.
+     * @param i_beta factor of the auxiliary tensor in the ADD operation.
+     **/
+    void init( std::vector< kernel_t > const & i_ktypes,
+               double                          i_alpha,
+               double                          i_beta );
+
+    /**
+     * Gets the operations of the chain.
+     *
+     * @return operations of the chain.
+     **/
+    std::vector< kernel_t > const & get_ktypes() const;
+
+    /**
+     * Gets the factor of the SCALE operation.
+     *
+     * @return factor of the SCALE operation.
+     **/
+    double get_alpha() const;
+
+    /**
+     * Gets the factor of the auxiliary tensor in the ADD operation.
+     *
+     * @return factor of the auxiliary tensor.
+     **/
+    double get_beta() const;
+
+    /**
+     * Compiles the epilogue.
+     *
+     * @param i_dtype_comp datatype used during the computations.
+     * @param i_dtype_out datatype of the output.
+     * @return SUCCESS if the compilation was successful, COMPILATION_FAILED otherwise.
+     **/
+    err_t compile( data_t i_dtype_comp,
+                   data_t i_dtype_out );
+
+    /**
+     * Applies the chain to a column-major output block.
+     * Entry (m,n) of the auxiliary tensor is located at i_out_aux[ m*i_stride_m_out_aux + n*i_stride_n_out_aux ].
+     *
+     * @param i_m number of rows.
+     * @param i_n number of columns.
+     * @param i_ld_out leading dimension of the output.
+     * @param i_stride_m_out_aux stride of the auxiliary tensor in the m-dimension.
+     * @param i_stride_n_out_aux stride of the auxiliary tensor in the n-dimension.
+     * @param i_out_aux pointer to the auxiliary tensor's data.
+     * @param io_out pointer to the output tensor's data.
+     **/
+    void apply( int64_t         i_m,
+                int64_t         i_n,
+                int64_t         i_ld_out,
+                int64_t         i_stride_m_out_aux,
+                int64_t         i_stride_n_out_aux,
+                void    const * i_out_aux,
+                void          * io_out ) const;
+};
+
+#endif
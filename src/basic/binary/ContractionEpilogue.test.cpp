@@ -0,0 +1,125 @@
+#include "catch.hpp"
+#include "ContractionEpilogue.h"
+#include "../low_precision.h"
+#include <cmath>
+
+TEST_CASE( "FP32 bias addition, scaling and GELU in a contraction epilogue.", "[contraction_epilogue]" ) {
+  using namespace einsum_ir::basic;
+
+  // column-major block with a padded leading dimension, the bias is broadcasted in the n-dimension
+  int64_t l_m = 300;
+  int64_t l_n = 3;
+  int64_t l_ld = 301;
+
+  std::vector< float > l_out( l_ld * l_n );
+  std::vector< float > l_bias( l_m );
+
+  for( std::size_t l_en = 0; l_en < l_out.size(); l_en++ ) {
+    l_out[l_en] = ( (l_en * 7) % 13 ) * 0.25f - 1.5f;
+  }
+  for( std::size_t l_en = 0; l_en < l_bias.size(); l_en++ ) {
+    l_bias[l_en] = ( (l_en * 5) % 11 ) * 0.125f - 0.5f;
+  }
+  std::vector< float > l_out_ref = l_out;
+
+  for( int64_t l_in = 0; l_in < l_n; l_in++ ) {
+    for( int64_t l_im = 0; l_im < l_m; l_im++ ) {
+      float l_val = l_out_ref[ l_in * l_ld + l_im ];
+      l_val = 0.5f * ( l_val + 2.0f * l_bias[l_im] );
+      l_val = 0.5f * l_val * ( 1.0f + std::erf( l_val / std::sqrt( 2.0f ) ) );
+      l_out_ref[ l_in * l_ld + l_im ] = l_val;
+    }
+  }
+
+  ContractionEpilogue l_epilogue;
+  l_epilogue.init( { kernel_t::ADD,
+                     kernel_t::SCALE,
+                     kernel_t::GELU },
+                   0.5,
+                   2.0 );
+  REQUIRE( l_epilogue.compile( data_t::FP32,
+                               data_t::FP32 ) == err_t::SUCCESS );
+
+  l_epilogue.apply( l_m,
+                    l_n,
+                    l_ld,
+                    1,
+                    0,
+                    l_bias.data(),
+                    l_out.data() );
+
+  for( int64_t l_in = 0; l_in < l_n; l_in++ ) {
+    for( int64_t l_im = 0; l_im < l_ld; l_im++ ) {
+      REQUIRE( l_out[ l_in * l_ld + l_im ] == Approx( l_out_ref[ l_in * l_ld + l_im ] ) );
+    }
+  }
+}
+
+TEST_CASE( "Activation functions in a contraction epilogue with BF16 output.", "[contraction_epilogue]" ) {
+  using namespace einsum_ir::basic;
+
+  int64_t l_m = 7;
+  int64_t l_n = 5;
+
+  std::vector< float > l_values( l_m * l_n );
+  for( std::size_t l_en = 0; l_en < l_values.size(); l_en++ ) {
+    l_values[l_en] = ( (l_en * 3) % 17 ) * 0.25f - 2.0f;
+  }
+
+  for( kernel_t l_ktype : { kernel_t::RELU,
+                            kernel_t::SILU,
+                            kernel_t::SIGMOID,
+                            kernel_t::TANH } ) {
+    std::vector< bf16_t > l_out( l_values.begin(), l_values.end() );
+
+    ContractionEpilogue l_epilogue;
+    l_epilogue.init( { l_ktype },
+                     1.0,
+                     1.0 );
+    REQUIRE( l_epilogue.compile( data_t::FP32,
+                                 data_t::BF16 ) == err_t::SUCCESS );
+
+    l_epilogue.apply( l_m,
+                      l_n,
+                      l_m,
+                      0,
+                      0,
+                      nullptr,
+                      l_out.data() );
+
+    for( std::size_t l_en = 0; l_en < l_values.size(); l_en++ ) {
+      float l_in = float( bf16_t( l_values[l_en] ) );
+      float l_ref = 0;
+      if(      l_ktype == kernel_t::RELU    ) l_ref = std::max( l_in, 0.0f );
+      else if( l_ktype == kernel_t::SILU    ) l_ref = l_in / ( 1.0f + std::exp( -l_in ) );
+      else if( l_ktype == kernel_t::SIGMOID ) l_ref = 1.0f / ( 1.0f + std::exp( -l_in ) );
+      else if( l_ktype == kernel_t::TANH    ) l_ref = std::tanh( l_in );
+
+      REQUIRE( float( l_out[l_en] ) == Approx( l_ref ).epsilon( 1E-2 ).margin( 1E-2 ) );
+    }
+  }
+}
+
+TEST_CASE( "Unsupported configurations of a contraction epilogue.", "[contraction_epilogue]" ) {
+  using namespace einsum_ir::basic;
+
+  REQUIRE(  ContractionEpilogue::supports( kernel_t::GELU ) );
+  REQUIRE( !ContractionEpilogue::supports( kernel_t::COPY ) );
+  REQUIRE( !ContractionEpilogue::supports( kernel_t::EPILOGUE ) );
+
+  ContractionEpilogue l_epilogue;
+  l_epilogue.init( { kernel_t::ADD,
+                     kernel_t::COPY },
+                   1.0,
+                   1.0 );
+  REQUIRE( l_epilogue.compile( data_t::FP32,
+                               data_t::FP32 ) == err_t::COMPILATION_FAILED );
+
+  l_epilogue.init( { kernel_t::RELU },
+                   1.0,
+                   1.0 );
+  REQUIRE( l_epilogue.compile( data_t::FP64,
+                               data_t::FP32 ) == err_t::COMPILATION_FAILED );
+  REQUIRE( l_epilogue.compile( data_t::FP64,
+                               data_t::FP64 ) == err_t::SUCCESS );
+}
@@ -1,14 +1,12 @@
 #include "ContractionMemoryManager.h"
-
-#ifdef _OPENMP
-#include <omp.h>
-#endif
+#include "../threading.h"
+#include "../Numa.h"
 
 einsum_ir::basic::ContractionMemoryManager::~ContractionMemoryManager() {
   for( std::size_t l_id = 0; l_id < m_thread_memory.size(); l_id++ ){
-    if( m_thread_memory[l_id] != nullptr ){
-      delete [] (char *) m_thread_memory[l_id];
-    }
+    Numa::free( m_thread_memory[l_id],
+                m_alloc_thread_mem,
+                m_thread_pages[l_id] );
   }
 }
 
@@ -16,13 +14,15 @@ void einsum_ir::basic::ContractionMemoryManager::alloc_all_memory(){
   if( m_req_thread_mem ){
     m_thread_memory.resize( m_num_threads, nullptr );
     m_aligned_thread_memory.resize(m_num_threads, nullptr);
+    m_thread_pages.resize( m_num_threads, m_pages_requested );
+    m_alloc_thread_mem = m_req_thread_mem + m_alignment_line;
 
-#ifdef _OPENMP
-#pragma omp parallel for num_threads(m_num_threads)
-#endif
-    for( int64_t l_thread_id = 0; l_thread_id < m_num_threads; l_thread_id++ ){
-      //allocate memory
-      char * l_ptr = new char[ m_req_thread_mem + m_alignment_line ];
+    // first touch by the threads which later use the memory
+    execute_threaded( m_num_threads, [&](int64_t l_thread_id) {
+      //allocate untouched pages
+      char * l_ptr = Numa::alloc( m_alloc_thread_mem,
+                                  Numa::FIRST_TOUCH,
+                                  m_thread_pages[l_thread_id] );
       m_thread_memory[l_thread_id] = l_ptr;
 
       //allign data in memory
@@ -31,10 +31,9 @@ void einsum_ir::basic::ContractionMemoryManager::alloc_all_memory(){
       m_aligned_thread_memory[l_thread_id] = l_ptr + l_align_offset;
 
       //first touch policy
-      for( int64_t l_mem_id = 0; l_mem_id <= m_req_thread_mem; l_mem_id++ ){
-        m_aligned_thread_memory[l_thread_id][l_mem_id] = 0;
-      }
-    }
+      Numa::touch( m_aligned_thread_memory[l_thread_id],
+                   m_req_thread_mem );
+    } );
   }
 }
 
@@ -48,9 +47,49 @@ void einsum_ir::basic::ContractionMemoryManager::reserve_thread_memory( int64_t
   }
 }
 
+void einsum_ir::basic::ContractionMemoryManager::bind_thread_memory( std::vector< char * > const & i_thread_memory ){
+  m_aligned_thread_memory = i_thread_memory;
+}
+
+int64_t einsum_ir::basic::ContractionMemoryManager::get_num_bytes_thread() const {
+  return m_req_thread_mem;
+}
+
+int64_t einsum_ir::basic::ContractionMemoryManager::get_num_threads() const {
+  return m_num_threads;
+}
+
 char * einsum_ir::basic::ContractionMemoryManager::get_thread_memory( int64_t i_thread_id ){
-  if( i_thread_id < m_num_threads ){
+  if(    i_thread_id < m_num_threads
+      && i_thread_id < (int64_t) m_aligned_thread_memory.size() ){
     return m_aligned_thread_memory[i_thread_id];
   }
   return nullptr;
-}
\ No newline at end of file
+}
+
+void einsum_ir::basic::ContractionMemoryManager::set_pages( Numa::pages_t i_pages ){
+  m_pages_requested = i_pages;
+}
+
+einsum_ir::basic::Numa::pages_t einsum_ir::basic::ContractionMemoryManager::get_pages() const {
+  if( m_thread_pages.size() == 0 ){
+    return Numa::SMALL;
+  }
+
+  Numa::pages_t l_pages = Numa::HUGE_1G;
+  for( std::size_t l_id = 0; l_id < m_thread_pages.size(); l_id++ ){
+    if( m_thread_pages[l_id] < l_pages ){
+      l_pages = m_thread_pages[l_id];
+    }
+  }
+  return l_pages;
+}
+
+int64_t einsum_ir::basic::ContractionMemoryManager::get_num_bytes() const {
+  int64_t l_num_bytes = 0;
+  for( std::size_t l_id = 0; l_id < m_thread_memory.size(); l_id++ ){
+    l_num_bytes += Numa::get_num_bytes_mapped( m_alloc_thread_mem,
+                                               m_thread_pages[l_id] );
+  }
+  return l_num_bytes;
+}
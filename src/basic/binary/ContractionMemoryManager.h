@@ -3,6 +3,7 @@
 
 #include <vector>
 #include "../constants.h"
+#include "../Numa.h"
 
 namespace einsum_ir {
   namespace basic {
@@ -22,6 +23,12 @@ class einsum_ir::basic::ContractionMemoryManager{
 
     //! required memory per thread
     int64_t m_req_thread_mem = 0;
+    //! allocated memory per thread
+    int64_t m_alloc_thread_mem = 0;
+    //! requested page backing
+    Numa::pages_t m_pages_requested = Numa::get_pages();
+    //! obtained page backing of every thread's memory
+    std::vector< Numa::pages_t > m_thread_pages;
     //! number of threads
     int64_t m_num_threads = 1;
     
@@ -33,6 +40,7 @@ class einsum_ir::basic::ContractionMemoryManager{
 
     /**
      * Allocates the required memory.
+     * The memory of every thread is allocated and first touched by the thread which uses it.
      **/
     void alloc_all_memory();
 
@@ -44,12 +52,57 @@ class einsum_ir::basic::ContractionMemoryManager{
     void reserve_thread_memory( int64_t i_size,
                                 int64_t i_num_threads );
 
+    /**
+     * Uses external thread memory instead of the allocated one, e.g., memory of an arena.
+     * The memory of every thread has to hold at least the reserved number of bytes.
+     *
+     * @param i_thread_memory cache line-aligned memory of the threads, empty to release the external memory.
+     **/
+    void bind_thread_memory( std::vector< char * > const & i_thread_memory );
+
+    /**
+     * Gets the reserved memory per thread.
+     *
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes_thread() const;
+
+    /**
+     * Gets the number of threads for which memory is reserved.
+     *
+     * @return number of threads.
+     **/
+    int64_t get_num_threads() const;
+
     /**
      * Returns a pointer to thread specific memory
      *
      * @return pointer to requested memory
      **/
     char * get_thread_memory( int64_t i_thread_id );
+
+    /**
+     * Sets the requested page backing.
+     * Has to be called before the memory is allocated.
+     *
+     * @param i_pages page backing.
+     **/
+    void set_pages( Numa::pages_t i_pages );
+
+    /**
+     * Gets the page backing which was obtained for all threads.
+     *
+     * @return smallest page backing of the threads' memory, SMALL if no memory was allocated.
+     **/
+    Numa::pages_t get_pages() const;
+
+    /**
+     * Gets the number of bytes allocated for all threads.
+     * Every thread's memory is rounded up to the size of its pages.
+     *
+     * @return number of allocated bytes.
+     **/
+    int64_t get_num_bytes() const;
 };
 
 #endif
@@ -44,6 +44,24 @@ void einsum_ir::basic::ContractionOptimizer::init( std::vector< iter_property >
   m_target_extra_packing = 8;
 }
 
+void einsum_ir::basic::ContractionOptimizer::set_cache_sizes( int64_t i_l1_cache_size,
+                                                              int64_t i_l3_cache_size ){
+  m_l1_cache_size = i_l1_cache_size;
+  m_l3_cache_size = i_l3_cache_size;
+}
+
+void einsum_ir::basic::ContractionOptimizer::set_streamed_inputs( bool i_streamed_left,
+                                                                  bool i_streamed_right ){
+  m_streamed_left  = i_streamed_left;
+  m_streamed_right = i_streamed_right;
+}
+
+void einsum_ir::basic::ContractionOptimizer::set_parallel_split( int64_t i_parallel_shift,
+                                                                 int64_t i_num_threads_sfc_m ){
+  m_parallel_shift = i_parallel_shift;
+  m_num_threads_sfc_m_fixed = i_num_threads_sfc_m;
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::optimize(){
   // removes size 1 iters
   remove_empty_iters();
@@ -70,6 +88,13 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::optimize(){
                        m_num_threads_sfc_n
                       );
 
+  // fixed split of the threads among the sfc dimensions
+  if( m_num_threads_sfc_m_fixed > 0 && m_num_threads % m_num_threads_sfc_m_fixed == 0 ){
+    *m_num_threads_sfc_m = std::min( m_num_threads_sfc_m_fixed, m_size_sfc_m );
+    *m_num_threads_sfc_n = std::min( m_num_threads / m_num_threads_sfc_m_fixed, m_size_sfc_n );
+    *m_num_threads_shared = m_num_threads / (*m_num_threads_sfc_m * *m_num_threads_sfc_n);
+  }
+
   return err_t::SUCCESS;
 }
 
@@ -277,11 +302,18 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::set_primitive_it
   std::vector<iter_property>::iterator l_extra_packing_iter_left  = m_iter_space->end();
   std::vector<iter_property>::iterator l_extra_packing_iter_right = m_iter_space->end();
   
+  //keep the kernel's block of the left tensor in about half of the L1 cache
+  int64_t l_target_k = m_target_k;
+  if( m_l1_cache_size > 0 ){
+    int64_t l_target_k_l1 = m_l1_cache_size / 2 / ( m_target_m * m_num_bytes_scalar_out );
+    l_target_k = std::max<int64_t>( 1, std::min( l_target_k, l_target_k_l1 ) );
+  }
+
   //kernel variables
   //enum                                                           {        PRIM_BR = 0,         PRIM_C  = 1,         PRIM_M  = 2,        PRIM_N  = 3,          PRIM_K  = 4};
   dim_t                                           l_iter_dim_t[] = {           dim_t::K,            dim_t::C,            dim_t::M,            dim_t::N,            dim_t::K};
   bool                                         l_iter_required[] = {              false,               false,                true,                true,                true};
-  int64_t                                     l_kernel_targets[] = {                  1,                   1,          m_target_m,          m_target_n,          m_target_k};
+  int64_t                                     l_kernel_targets[] = {                  1,                   1,          m_target_m,          m_target_n,          l_target_k};
   int64_t                              l_potential_kernel_size[] = {                  1,                   1,                   1,                   1,                   1};
   std::vector<iter_property>::iterator l_potential_kernel_iter[] = {m_iter_space->end(), m_iter_space->end(), m_iter_space->end(), m_iter_space->end(), m_iter_space->end()};
 
@@ -625,10 +657,22 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
       l_target_parallel_n /= 2;
     }
   }
+
+  //shift the parallel targets between the m and n dimensions
+  for( int64_t l_sh = 0; l_sh < m_parallel_shift && l_target_parallel_n > 1; l_sh++ ){
+    l_target_parallel_m *= 2;
+    l_target_parallel_n /= 2;
+  }
+  for( int64_t l_sh = 0; l_sh > m_parallel_shift && l_target_parallel_m > 1; l_sh-- ){
+    l_target_parallel_m /= 2;
+    l_target_parallel_n *= 2;
+  }
   l_target_parallel_c = l_target_parallel / (l_target_parallel_m * l_target_parallel_n);
 
   //add parallel dimension
   std::vector<iter_property> l_blocking_iters;
+  int64_t l_size_parallel_m = 1;
+  int64_t l_size_parallel_n = 1;
   if( m_generate_sfcs ) {
     m_size_sfc_n = move_iters_until( &l_blocking_iters, 
                                     l_target_parallel_n,
@@ -638,23 +682,38 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
                                     l_target_parallel_m,
                                     dim_t::M,
                                     exec_t::SFC);
+    l_size_parallel_n = m_size_sfc_n;
+    l_size_parallel_m = m_size_sfc_m;
   }
   else{
-    move_iters_until( &l_blocking_iters, 
-                      l_target_parallel_n,
-                      dim_t::N,
-                      exec_t::OMP);
-    move_iters_until( &l_blocking_iters, 
-                      l_target_parallel_m,
-                      dim_t::M,
-                      exec_t::OMP);
+    l_size_parallel_n = move_iters_until( &l_blocking_iters, 
+                                          l_target_parallel_n,
+                                          dim_t::N,
+                                          exec_t::OMP);
+    l_size_parallel_m = move_iters_until( &l_blocking_iters, 
+                                          l_target_parallel_m,
+                                          dim_t::M,
+                                          exec_t::OMP);
     m_size_sfc_n = 1;
     m_size_sfc_m = 1;
   }
 
-  //add sequential K dimension for L3 blocking
+  //add sequential K dimension for L3 blocking, the blocks of A and B touched by the parallel dimensions use about half of the L3 cache
+  int64_t l_target_blocking_k = 64;
+  if( m_l3_cache_size > 0 ){
+    int64_t l_kernel_size_m = 1;
+    int64_t l_kernel_size_n = 1;
+    int64_t l_kernel_size_k = 1;
+    for( l_it = l_kernel_iters.begin(); l_it < l_kernel_iters.end(); l_it++ ){
+      if(      l_it->dim_type == dim_t::M ) l_kernel_size_m *= l_it->size;
+      else if( l_it->dim_type == dim_t::N ) l_kernel_size_n *= l_it->size;
+      else if( l_it->dim_type == dim_t::K ) l_kernel_size_k *= l_it->size;
+    }
+    int64_t l_size_block_k = l_kernel_size_k * ( l_size_parallel_m * l_kernel_size_m + l_size_parallel_n * l_kernel_size_n ) * m_num_bytes_scalar_out;
+    l_target_blocking_k = std::max<int64_t>( 1, m_l3_cache_size / 2 / l_size_block_k );
+  }
   move_iters_until( &l_blocking_iters, 
-                    64,
+                    l_target_blocking_k,
                     dim_t::K,
                     exec_t::SEQ);
   
@@ -672,6 +731,18 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
                 bool l_smaller_stride = l_stride_a > l_stride_b;
                 return l_smaller_stride;
              });
+
+  //traverse streamed inputs in storage order, loops not touching them stay innermost
+  if( m_streamed_left || m_streamed_right ){
+    std::stable_sort( m_iter_space->begin(), m_iter_space->end(),
+                      [&](iter_property l_a, iter_property l_b) -> bool {
+                        int64_t l_stride_a = m_streamed_left  ? l_a.stride_left  : 0;
+                        int64_t l_stride_b = m_streamed_left  ? l_b.stride_left  : 0;
+                        l_stride_a        += m_streamed_right ? l_a.stride_right : 0;
+                        l_stride_b        += m_streamed_right ? l_b.stride_right : 0;
+                        return l_stride_a > l_stride_b;
+                      });
+  }
   
   //add iterations from local data structures
   m_iter_space->insert(m_iter_space->end(), l_blocking_iters.begin(), l_blocking_iters.end() );
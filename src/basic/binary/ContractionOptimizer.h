@@ -34,9 +34,15 @@ class einsum_ir::basic::ContractionOptimizer {
     //! number of bytes for scalar data types in output tensor
     int64_t m_num_bytes_scalar_out = 0;
 
+    //! size of L1 data cache in bytes, zero if unknown
+    int64_t m_l1_cache_size = 0;
+
     //! size of L2 cache in bytes
     int64_t m_l2_cache_size = 0;
 
+    //! size of L3 cache in bytes, zero if unknown
+    int64_t m_l3_cache_size = 0;
+
     //! target size for extra packing dimensions
     int64_t m_target_extra_packing = 0;
 
@@ -73,6 +79,18 @@ class einsum_ir::basic::ContractionOptimizer {
     //! size of the sfc in n dimension
     int64_t m_size_sfc_n = 1;
 
+    //! true if the left input is streamed, e.g., from a memory-mapped file
+    bool m_streamed_left = false;
+
+    //! true if the right input is streamed, e.g., from a memory-mapped file
+    bool m_streamed_right = false;
+
+    //! shift of the parallel targets from the n dimension to the m dimension as power of two
+    int64_t m_parallel_shift = 0;
+
+    //! fixed number of threads in the sfc m dimension, zero if determined by the heuristic
+    int64_t m_num_threads_sfc_m_fixed = 0;
+
     /**
       * Finds all iters with a specific stride in the iteration space.
       *
@@ -203,6 +221,40 @@ class einsum_ir::basic::ContractionOptimizer {
                int64_t                      * io_num_threads_sfc_m,
                int64_t                      * io_num_threads_sfc_n );    
   
+    /**
+     * Sets the sizes of the L1 and L3 caches.
+     * The L1 cache bounds the k size of the kernel, the L3 cache determines the sequential K blocking.
+     * A size of zero disables the respective heuristic.
+     *
+     * @param i_l1_cache_size size of L1 data cache in bytes.
+     * @param i_l3_cache_size size of L3 cache in bytes.
+     **/
+    void set_cache_sizes( int64_t i_l1_cache_size,
+                          int64_t i_l3_cache_size );
+
+    /**
+     * Marks inputs as streamed, e.g., from memory-mapped files.
+     * The outer sequential loops of streamed inputs are ordered by the inputs' strides,
+     * such that the inputs are traversed in storage order.
+     *
+     * @param i_streamed_left true if the left input is streamed.
+     * @param i_streamed_right true if the right input is streamed.
+     **/
+    void set_streamed_inputs( bool i_streamed_left,
+                              bool i_streamed_right );
+
+    /**
+     * Sets the partitioning of the parallel work, e.g., for the autotuning.
+     * The heuristic's parallel targets are shifted between the m and n dimensions:
+     * a positive shift multiplies the m target by 2^shift and divides the n target by the same factor, a negative shift does the opposite.
+     * The number of sfc m threads overwrites the heuristic's split of the threads among the sfc dimensions.
+     *
+     * @param i_parallel_shift shift of the parallel targets from the n dimension to the m dimension as power of two.
+     * @param i_num_threads_sfc_m number of threads in the sfc m dimension, has to divide the number of threads. zero uses the heuristic.
+     **/
+    void set_parallel_split( int64_t i_parallel_shift,
+                             int64_t i_num_threads_sfc_m );
+
     /**
      * Optimizes the iters.
      *
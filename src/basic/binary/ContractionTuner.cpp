@@ -0,0 +1,267 @@
+#include "ContractionTuner.h"
+#include "ContractionOptimizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+einsum_ir::basic::ContractionTuner::Settings const & einsum_ir::basic::ContractionTuner::get_settings() {
+  static Settings s_settings = [](){
+    Settings l_settings;
+
+    char * l_env = std::getenv( "EINSUM_IR_TUNE" );
+    if( l_env != nullptr ) {
+      l_settings.m_enabled = std::atoi( l_env ) != 0;
+    }
+    l_env = std::getenv( "EINSUM_IR_TUNE_BUDGET_MS" );
+    if( l_env != nullptr ) {
+      l_settings.m_time_budget = std::atof( l_env ) / 1000.0;
+    }
+
+    return l_settings;
+  }();
+
+  return s_settings;
+}
+
+void einsum_ir::basic::ContractionTuner::init( ContractionConfig const & i_config,
+                                               int64_t                   i_target_m,
+                                               int64_t                   i_target_n,
+                                               int64_t                   i_target_k,
+                                               bool                      i_generate_sfcs,
+                                               bool                      i_br_gemm_support,
+                                               bool                      i_packing_support,
+                                               packed_gemm_t             i_packed_gemm_support,
+                                               int64_t                   i_l1_cache_size,
+                                               int64_t                   i_l2_cache_size,
+                                               int64_t                   i_l3_cache_size,
+                                               double                    i_time_budget ) {
+  m_config = i_config;
+
+  m_target_m = i_target_m;
+  m_target_n = i_target_n;
+  m_target_k = i_target_k;
+
+  m_generate_sfcs       = i_generate_sfcs;
+  m_br_gemm_support     = i_br_gemm_support;
+  m_packing_support     = i_packing_support;
+  m_packed_gemm_support = i_packed_gemm_support;
+
+  m_l1_cache_size = i_l1_cache_size;
+  m_l2_cache_size = i_l2_cache_size;
+  m_l3_cache_size = i_l3_cache_size;
+  m_time_budget   = i_time_budget;
+
+  m_num_benchmarks = 0;
+  m_time_best = 0;
+}
+
+void einsum_ir::basic::ContractionTuner::candidates( std::vector< Candidate > & o_candidates ) const {
+  o_candidates.clear();
+
+  // primitive targets are halved and doubled, features are only disabled if supported by the backend
+  std::vector< double > l_factors = { 1.0, 2.0, 0.5 };
+  std::vector< bool > l_sfcs = { m_generate_sfcs };
+  if( m_generate_sfcs ) l_sfcs.push_back( false );
+  std::vector< bool > l_packings = { m_packing_support };
+  if( m_packing_support ) l_packings.push_back( false );
+
+  // parallel m and n targets are shifted by a factor of two in both directions
+  std::vector< int64_t > l_shifts = { 0, 1, -1 };
+
+  // sfc threads are split by the optimizer or along the divisors of the number of threads
+  int64_t l_num_threads =   m_config.m_num_threads_shared
+                          * m_config.m_num_threads_sfc_m
+                          * m_config.m_num_threads_sfc_n;
+  std::vector< int64_t > l_splits_sfc = { 0 };
+  for( int64_t l_di = 1; l_di <= l_num_threads; l_di++ ) {
+    if( l_num_threads % l_di == 0 ) {
+      l_splits_sfc.push_back( l_di );
+    }
+  }
+
+  std::vector< std::pair< int64_t, Candidate > > l_ranked;
+  for( double l_fm : l_factors ) {
+    for( double l_fn : l_factors ) {
+      for( double l_fk : l_factors ) {
+        for( bool l_sfc : l_sfcs ) {
+          for( bool l_packing : l_packings ) {
+            for( int64_t l_shift : l_shifts ) {
+              std::size_t l_num_splits = l_sfc ? l_splits_sfc.size() : 1;
+              for( std::size_t l_sp = 0; l_sp < l_num_splits; l_sp++ ) {
+                Candidate l_cand;
+                l_cand.m_target_m = std::max< int64_t >( 1, m_target_m * l_fm );
+                l_cand.m_target_n = std::max< int64_t >( 1, m_target_n * l_fn );
+                l_cand.m_target_k = std::max< int64_t >( 1, m_target_k * l_fk );
+                l_cand.m_generate_sfcs = l_sfc;
+                l_cand.m_packing_support = l_packing;
+                l_cand.m_parallel_shift = l_shift;
+                l_cand.m_num_threads_sfc_m = l_splits_sfc[l_sp];
+
+                // rank by the number of parameters which differ from the defaults
+                int64_t l_rank =   (l_fm != 1.0)
+                                 + (l_fn != 1.0)
+                                 + (l_fk != 1.0)
+                                 + (l_sfc != m_generate_sfcs)
+                                 + (l_packing != m_packing_support)
+                                 + (l_shift != 0)
+                                 + (l_sp != 0);
+                l_ranked.push_back( { l_rank, l_cand } );
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  std::stable_sort( l_ranked.begin(),
+                    l_ranked.end(),
+                    []( std::pair< int64_t, Candidate > const & i_a,
+                        std::pair< int64_t, Candidate > const & i_b ) {
+                      return i_a.first < i_b.first;
+                    } );
+
+  for( std::size_t l_ca = 0; l_ca < l_ranked.size(); l_ca++ ) {
+    o_candidates.push_back( l_ranked[l_ca].second );
+  }
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionTuner::optimize( Candidate         const & i_candidate,
+                                                                      ContractionConfig       & o_config ) const {
+  o_config = m_config;
+
+  ContractionOptimizer l_optim;
+  l_optim.init( &o_config.m_iterations,
+                &o_config.m_ktype_main,
+                i_candidate.m_target_m,
+                i_candidate.m_target_n,
+                i_candidate.m_target_k,
+                i_candidate.m_generate_sfcs,
+                m_br_gemm_support,
+                i_candidate.m_packing_support,
+                m_packed_gemm_support,
+                ce_n_bytes( o_config.m_dtype_out ),
+                m_l2_cache_size,
+                &o_config.m_num_threads_shared,
+                &o_config.m_num_threads_sfc_m,
+                &o_config.m_num_threads_sfc_n );
+  l_optim.set_cache_sizes( m_l1_cache_size,
+                           m_l3_cache_size );
+  l_optim.set_parallel_split( i_candidate.m_parallel_shift,
+                              i_candidate.m_num_threads_sfc_m );
+
+  return l_optim.optimize();
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionTuner::tune( std::function< err_t( ContractionConfig const &,
+                                                                                        double & ) > const & i_benchmark,
+                                                                  ContractionConfig                        & o_config ) {
+  auto l_start = std::chrono::steady_clock::now();
+
+  std::vector< Candidate > l_candidates;
+  candidates( l_candidates );
+
+  m_num_benchmarks = 0;
+  m_time_best = 0;
+
+  // many candidates lead to the same configuration, which is only benchmarked once
+  std::vector< std::vector< int64_t > > l_benchmarked;
+
+  for( std::size_t l_ca = 0; l_ca < l_candidates.size(); l_ca++ ) {
+    std::chrono::duration< double > l_elapsed = std::chrono::steady_clock::now() - l_start;
+    if( m_num_benchmarks > 0 && l_elapsed.count() > m_time_budget ) {
+      break;
+    }
+
+    ContractionConfig l_config;
+    err_t l_err = optimize( l_candidates[l_ca],
+                            l_config );
+    if( l_err != err_t::SUCCESS ) {
+      continue;
+    }
+
+    std::vector< int64_t > l_values;
+    l_config.serialize( l_values );
+    if( std::find( l_benchmarked.begin(),
+                   l_benchmarked.end(),
+                   l_values ) != l_benchmarked.end() ) {
+      continue;
+    }
+    l_benchmarked.push_back( l_values );
+
+    double l_time = 0;
+    l_err = i_benchmark( l_config,
+                         l_time );
+    if( l_err != err_t::SUCCESS ) {
+      continue;
+    }
+
+    if( m_num_benchmarks == 0 || l_time < m_time_best ) {
+      m_time_best = l_time;
+      o_config = l_config;
+    }
+    m_num_benchmarks++;
+  }
+
+  if( m_num_benchmarks == 0 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionTuner::benchmark( ContractionConfig  const & i_config,
+                                                                       ContractionBackend       & io_backend,
+                                                                       int64_t                    i_num_reps,
+                                                                       double                   & o_time ) {
+  io_backend.init( i_config,
+                   nullptr );
+  err_t l_err = io_backend.compile();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  // number of elements spanned by the strides of the iterations
+  int64_t l_num_elements[4] = { 1, 1, 1, 1 };
+  for( std::size_t l_it = 0; l_it < i_config.m_iterations.size(); l_it++ ) {
+    iter_property const & l_iter = i_config.m_iterations[l_it];
+    l_num_elements[0] += (l_iter.size - 1) * std::abs( l_iter.stride_left );
+    l_num_elements[1] += (l_iter.size - 1) * std::abs( l_iter.stride_right );
+    l_num_elements[2] += (l_iter.size - 1) * std::abs( l_iter.stride_out_aux );
+    l_num_elements[3] += (l_iter.size - 1) * std::abs( l_iter.stride_out );
+  }
+  data_t l_dtypes[4] = { i_config.m_dtype_left,
+                         i_config.m_dtype_right,
+                         i_config.m_dtype_out,
+                         i_config.m_dtype_out };
+
+  // zero-initialized tensors, stored as doubles for alignment
+  std::vector< double > l_tensors[4];
+  for( int64_t l_te = 0; l_te < 4; l_te++ ) {
+    int64_t l_num_bytes = l_num_elements[l_te] * ce_n_bytes( l_dtypes[l_te] );
+    l_tensors[l_te].resize( l_num_bytes / sizeof(double) + 1, 0 );
+  }
+
+  // warmup
+  io_backend.contract( l_tensors[0].data(),
+                       l_tensors[1].data(),
+                       l_tensors[2].data(),
+                       l_tensors[3].data() );
+
+  o_time = 0;
+  for( int64_t l_re = 0; l_re < i_num_reps; l_re++ ) {
+    auto l_tp0 = std::chrono::steady_clock::now();
+    io_backend.contract( l_tensors[0].data(),
+                         l_tensors[1].data(),
+                         l_tensors[2].data(),
+                         l_tensors[3].data() );
+    auto l_tp1 = std::chrono::steady_clock::now();
+
+    double l_time = std::chrono::duration< double >( l_tp1 - l_tp0 ).count();
+    if( l_re == 0 || l_time < o_time ) {
+      o_time = l_time;
+    }
+  }
+
+  return err_t::SUCCESS;
+}
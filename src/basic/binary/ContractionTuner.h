@@ -0,0 +1,174 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_TUNER
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_TUNER
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "../constants.h"
+#include "ContractionConfig.h"
+#include "ContractionBackend.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionTuner;
+  }
+}
+
+/**
+ * Empirical autotuner for contraction configurations.
+ *
+ * The tuner optimizes the unoptimized configuration for a bounded set of candidate optimizer parameters,
+ * i.e., primitive targets, sfc and packing support, and partitions of the parallel work.
+ * The partitions shift the optimizer's parallel m and n targets and split the threads among the sfc dimensions.
+ * Candidates are benchmarked until the time budget is exhausted and the fastest configuration is kept.
+ * The optimizer's configuration for the default parameters is always benchmarked first.
+ **/
+class einsum_ir::basic::ContractionTuner {
+  public:
+    //! tuning settings
+    struct Settings {
+      //! true if contractions are tuned
+      bool m_enabled = false;
+      //! time budget per contraction in seconds
+      double m_time_budget = 1.0;
+    };
+
+    //! candidate parameters of the contraction optimizer
+    struct Candidate {
+      //! target m size of the primitive
+      int64_t m_target_m = 1;
+      //! target n size of the primitive
+      int64_t m_target_n = 1;
+      //! target k size of the primitive
+      int64_t m_target_k = 1;
+      //! true if sfcs may be generated
+      bool m_generate_sfcs = false;
+      //! true if packing is supported
+      bool m_packing_support = false;
+      //! shift of the parallel targets from the n dimension to the m dimension as power of two
+      int64_t m_parallel_shift = 0;
+      //! number of threads in the sfc m dimension, zero if determined by the optimizer
+      int64_t m_num_threads_sfc_m = 0;
+    };
+
+  private:
+    //! unoptimized configuration
+    ContractionConfig m_config;
+
+    //! default target m size of the primitive
+    int64_t m_target_m = 1;
+    //! default target n size of the primitive
+    int64_t m_target_n = 1;
+    //! default target k size of the primitive
+    int64_t m_target_k = 1;
+
+    //! true if sfcs may be generated by the backend
+    bool m_generate_sfcs = false;
+    //! true if the backend supports batch-reduce kernels
+    bool m_br_gemm_support = false;
+    //! true if the backend supports packing
+    bool m_packing_support = false;
+    //! packed kernels supported by the backend
+    packed_gemm_t m_packed_gemm_support = packed_gemm_t::NONE;
+
+    //! size of the L1 data cache in bytes
+    int64_t m_l1_cache_size = 0;
+    //! size of the L2 cache in bytes
+    int64_t m_l2_cache_size = 0;
+    //! size of the L3 cache in bytes
+    int64_t m_l3_cache_size = 0;
+
+    //! time budget in seconds
+    double m_time_budget = 0;
+
+  public:
+    //! number of benchmarked configurations of the last tuning
+    int64_t m_num_benchmarks = 0;
+
+    //! time of the fastest configuration of the last tuning in seconds
+    double m_time_best = 0;
+
+    /**
+     * Gets the process-wide settings.
+     * The environment variable EINSUM_IR_TUNE enables the tuning if set to 1
+     * and EINSUM_IR_TUNE_BUDGET_MS sets the time budget per contraction in milliseconds.
+     * The tuning database EINSUM_IR_TUNE_DB is maintained by the ContractionConfigStore.
+     *
+     * @return settings.
+     **/
+    static Settings const & get_settings();
+
+    /**
+     * Initializes the tuner.
+     *
+     * @param i_config unoptimized configuration.
+     * @param i_target_m default target m size of the primitive.
+     * @param i_target_n default target n size of the primitive.
+     * @param i_target_k default target k size of the primitive.
+     * @param i_generate_sfcs true if sfcs may be generated by the backend.
+     * @param i_br_gemm_support true if the backend supports batch-reduce kernels.
+     * @param i_packing_support true if the backend supports packing.
+     * @param i_packed_gemm_support packed kernels supported by the backend.
+     * @param i_l1_cache_size size of the L1 data cache in bytes.
+     * @param i_l2_cache_size size of the L2 cache in bytes.
+     * @param i_l3_cache_size size of the L3 cache in bytes.
+     * @param i_time_budget time budget in seconds.
+     **/
+    void init( ContractionConfig const & i_config,
+               int64_t                   i_target_m,
+               int64_t                   i_target_n,
+               int64_t                   i_target_k,
+               bool                      i_generate_sfcs,
+               bool                      i_br_gemm_support,
+               bool                      i_packing_support,
+               packed_gemm_t             i_packed_gemm_support,
+               int64_t                   i_l1_cache_size,
+               int64_t                   i_l2_cache_size,
+               int64_t                   i_l3_cache_size,
+               double                    i_time_budget );
+
+    /**
+     * Generates the candidates, the first candidate holds the default parameters.
+     *
+     * @param o_candidates will be set to the candidates.
+     **/
+    void candidates( std::vector< Candidate > & o_candidates ) const;
+
+    /**
+     * Derives the configuration of a candidate by running the contraction optimizer.
+     *
+     * @param i_candidate candidate parameters.
+     * @param o_config will be set to the optimized configuration.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t optimize( Candidate         const & i_candidate,
+                    ContractionConfig       & o_config ) const;
+
+    /**
+     * Tunes the contraction.
+     *
+     * @param i_benchmark benchmark which sets the time of a configuration in seconds.
+     * @param o_config will be set to the fastest configuration.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t tune( std::function< err_t( ContractionConfig const &,
+                                      double & ) > const & i_benchmark,
+                ContractionConfig                        & o_config );
+
+    /**
+     * Benchmarks a configuration on zero-initialized tensors.
+     * The backend is initialized and compiled with the configuration, the minimum time of the repetitions is returned.
+     *
+     * @param i_config configuration.
+     * @param io_backend fresh backend used for the benchmark.
+     * @param i_num_reps number of timed repetitions.
+     * @param o_time will be set to the time of a contraction in seconds.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    static err_t benchmark( ContractionConfig  const & i_config,
+                            ContractionBackend       & io_backend,
+                            int64_t                    i_num_reps,
+                            double                   & o_time );
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "catch.hpp"
+#include "ContractionTuner.h"
+#include "ContractionBackendScalar.h"
+
+TEST_CASE( "Candidates and selection of the contraction tuner.", "[contraction_tuner]" ) {
+  using namespace einsum_ir::basic;
+
+  ContractionConfig l_config;
+  l_config.m_iterations = { {dim_t::M, exec_t::SEQ, 64,  1,  0, 0,  1},
+                            {dim_t::N, exec_t::SEQ, 48,  0, 32, 0, 64},
+                            {dim_t::K, exec_t::SEQ, 32, 64,  1, 0,  0} };
+  l_config.m_dtype_left         = FP32;
+  l_config.m_dtype_right        = FP32;
+  l_config.m_dtype_comp         = FP32;
+  l_config.m_dtype_out          = FP32;
+  l_config.m_ktype_first_touch  = ZERO;
+  l_config.m_ktype_main         = MADD;
+  l_config.m_num_threads_shared = 4;
+
+  ContractionTuner l_tuner;
+  l_tuner.init( l_config,
+                16,
+                8,
+                16,
+                true,
+                false,
+                true,
+                packed_gemm_t::NONE,
+                0,
+                1024*1024,
+                0,
+                3600 );
+
+  // targets, sfcs, packing, parallel shifts and sfc thread splits along the divisors 1, 2 and 4
+  std::vector< ContractionTuner::Candidate > l_candidates;
+  l_tuner.candidates( l_candidates );
+  REQUIRE( l_candidates.size() == 27 * ( 2*3*4 + 2*3 ) );
+  REQUIRE( l_candidates[0].m_target_m == 16 );
+  REQUIRE( l_candidates[0].m_target_n == 8 );
+  REQUIRE( l_candidates[0].m_target_k == 16 );
+  REQUIRE( l_candidates[0].m_generate_sfcs );
+  REQUIRE( l_candidates[0].m_packing_support );
+  REQUIRE( l_candidates[0].m_parallel_shift == 0 );
+  REQUIRE( l_candidates[0].m_num_threads_sfc_m == 0 );
+
+  // partitions change the parallel iterations and the split of the threads
+  ContractionTuner::Candidate l_cand_part = l_candidates[0];
+  ContractionConfig l_config_part[3];
+  REQUIRE( l_tuner.optimize( l_cand_part, l_config_part[0] ) == SUCCESS );
+  l_cand_part.m_parallel_shift = -2;
+  REQUIRE( l_tuner.optimize( l_cand_part, l_config_part[1] ) == SUCCESS );
+  l_cand_part.m_parallel_shift = 0;
+  l_cand_part.m_num_threads_sfc_m = 1;
+  REQUIRE( l_tuner.optimize( l_cand_part, l_config_part[2] ) == SUCCESS );
+
+  int64_t l_size_sfc[2][2] = { {1, 1}, {1, 1} };
+  for( int64_t l_pa = 0; l_pa < 2; l_pa++ ) {
+    for( iter_property const & l_iter : l_config_part[l_pa].m_iterations ) {
+      if( l_iter.exec_type == exec_t::SFC ) {
+        l_size_sfc[l_pa][ l_iter.dim_type == dim_t::M ? 0 : 1 ] *= l_iter.size;
+      }
+    }
+  }
+  REQUIRE( l_size_sfc[1][0] < l_size_sfc[0][0] );
+  REQUIRE( l_size_sfc[1][1] >= l_size_sfc[0][1] );
+
+  REQUIRE( l_config_part[2].m_num_threads_sfc_m == 1 );
+  REQUIRE(   l_config_part[2].m_num_threads_sfc_m
+           * l_config_part[2].m_num_threads_sfc_n
+           * l_config_part[2].m_num_threads_shared == 4 );
+
+  // the fastest configuration is selected, duplicate configurations are benchmarked once
+  std::vector< std::vector< int64_t > > l_benchmarked;
+  ContractionConfig l_config_fastest;
+  double l_time_fastest = 0;
+  ContractionConfig l_config_tuned;
+  REQUIRE( l_tuner.tune( [&]( ContractionConfig const & i_config,
+                              double                  & o_time ) {
+                           std::vector< int64_t > l_values;
+                           i_config.serialize( l_values );
+                           for( std::size_t l_be = 0; l_be < l_benchmarked.size(); l_be++ ) {
+                             REQUIRE( l_benchmarked[l_be] != l_values );
+                           }
+                           l_benchmarked.push_back( l_values );
+
+                           o_time = 1.0 / ( 1 + (l_benchmarked.size() * 7) % 11 );
+                           if( l_benchmarked.size() == 1 || o_time < l_time_fastest ) {
+                             l_time_fastest = o_time;
+                             l_config_fastest = i_config;
+                           }
+                           return SUCCESS;
+                         },
+                         l_config_tuned ) == SUCCESS );
+
+  REQUIRE( l_tuner.m_num_benchmarks == (int64_t) l_benchmarked.size() );
+  REQUIRE( l_tuner.m_num_benchmarks > 1 );
+  REQUIRE( l_tuner.m_time_best == l_time_fastest );
+  REQUIRE( l_config_tuned.to_string() == l_config_fastest.to_string() );
+
+  // the first benchmarked configuration is the optimizer's default
+  ContractionConfig l_config_default;
+  REQUIRE( l_tuner.optimize( l_candidates[0], l_config_default ) == SUCCESS );
+  std::vector< int64_t > l_values_default;
+  l_config_default.serialize( l_values_default );
+  REQUIRE( l_benchmarked[0] == l_values_default );
+}
+
+TEST_CASE( "Time budget of the contraction tuner with the scalar backend.", "[contraction_tuner]" ) {
+  using namespace einsum_ir::basic;
+
+  // C[n][m] = A[k][m] * B[n][k]
+  int64_t l_size_m = 16;
+  int64_t l_size_n = 12;
+  int64_t l_size_k = 8;
+
+  ContractionConfig l_config;
+  l_config.m_iterations = { {dim_t::M, exec_t::SEQ, l_size_m,        1,        0, 0,        1},
+                            {dim_t::N, exec_t::SEQ, l_size_n,        0, l_size_k, 0, l_size_m},
+                            {dim_t::K, exec_t::SEQ, l_size_k, l_size_m,        1, 0,        0} };
+  l_config.m_dtype_left         = FP32;
+  l_config.m_dtype_right        = FP32;
+  l_config.m_dtype_comp         = FP32;
+  l_config.m_dtype_out          = FP32;
+  l_config.m_ktype_first_touch  = ZERO;
+  l_config.m_ktype_main         = MADD;
+  l_config.m_num_threads_shared = 2;
+
+  auto l_benchmark = []( ContractionConfig const & i_config,
+                         double                  & o_time ) {
+    ContractionBackendScalar l_backend;
+    return ContractionTuner::benchmark( i_config,
+                                        l_backend,
+                                        2,
+                                        o_time );
+  };
+
+  // the default configuration is benchmarked even if the budget is exhausted
+  ContractionTuner l_tuner;
+  l_tuner.init( l_config,
+                1,
+                1,
+                1,
+                true,
+                false,
+                false,
+                packed_gemm_t::ALL_STRIDE_ONE,
+                0,
+                1024*1024,
+                0,
+                0 );
+
+  ContractionConfig l_config_tuned;
+  REQUIRE( l_tuner.tune( l_benchmark, l_config_tuned ) == SUCCESS );
+  REQUIRE( l_tuner.m_num_benchmarks == 1 );
+  REQUIRE( l_tuner.m_time_best > 0 );
+
+  // larger primitives are rejected by the scalar backend, the tuned configuration compiles
+  l_tuner.init( l_config,
+                1,
+                1,
+                1,
+                true,
+                false,
+                false,
+                packed_gemm_t::ALL_STRIDE_ONE,
+                0,
+                1024*1024,
+                0,
+                3600 );
+  REQUIRE( l_tuner.tune( l_benchmark, l_config_tuned ) == SUCCESS );
+  REQUIRE( l_tuner.m_num_benchmarks >= 1 );
+
+  ContractionBackendScalar l_backend;
+  l_backend.init( l_config_tuned,
+                  nullptr );
+  REQUIRE( l_backend.compile() == SUCCESS );
+}
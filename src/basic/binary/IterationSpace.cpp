@@ -135,8 +135,6 @@ einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< in
     io_thread_infos[l_thread_id].sfc_size_m = l_end_m - l_begin_m;
     io_thread_infos[l_thread_id].sfc_size_n = l_end_n - l_begin_n;
     io_thread_infos[l_thread_id].sfc_size_k = m_sfc_tasks_k;
-    io_thread_infos[l_thread_id].k_count.resize( (l_end_m - l_begin_m) *
-                                                 (l_end_n - l_begin_n), 0 );
 
     //calculate initial thread offsets
     int64_t l_offset;
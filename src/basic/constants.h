@@ -19,6 +19,12 @@ namespace einsum_ir {
       BR_MADD         = 12,
       PACKED_MADD     = 13,
       CPX_PACKED_MADD = 14,
+      GELU            = 15,
+      SILU            = 16,
+      SIGMOID         = 17,
+      TANH            = 18,
+      SCALE           = 19,
+      EPILOGUE        = 20, // chain of element-wise operations, see ContractionEpilogue
       UNDEFINED_KTYPE = 99
     } kernel_t;
 
@@ -37,12 +43,15 @@ namespace einsum_ir {
       SUCCESS                   =  0,
       COMPILATION_FAILED        =  1,
       INVALID_CPX_DIM           =  2,
+      INVALID_CONFIG            =  3,
       UNDEFINED_ERROR           = 99
     } err_t;
 
     typedef enum {
       FP32            = 0,
       FP64            = 1,
+      BF16            = 2,
+      FP16            = 3,
       UNDEFINED_DTYPE = 99
     } data_t;
 
@@ -60,15 +69,22 @@ namespace einsum_ir {
       OUT_STRIDE_ONE = 2  // output dimension has stride one
     } packed_gemm_t;
 
+    typedef enum {
+      GENERIC_SIMD   =  0, // compiler-generated code
+      AVX2           =  1, // x86 AVX2 and FMA3
+      AVX512         =  2, // x86 AVX-512F
+      NEON           =  3, // Arm Advanced SIMD
+      UNDEFINED_SIMD = 99
+    } simd_t;
+
     typedef uint8_t sfc_t;
 
+    // per-thread information which is fixed after the compilation
     struct thread_info {
       int64_t   offset_left    = 0;
       int64_t   offset_right   = 0;
       int64_t   offset_out_aux = 0;
       int64_t   offset_out     = 0;
-      char    * memory_left    = nullptr;
-      char    * memory_right   = nullptr;
 
       int64_t id_shared_loop_start = 0;
       int64_t id_shared_loop_end   = 0;
@@ -76,10 +92,22 @@ namespace einsum_ir {
       int64_t sfc_size_m = 0;
       int64_t sfc_size_n = 0;
       int64_t sfc_size_k = 0;
-      std::vector<int32_t> k_count;
       std::vector<sfc_t>   movement_ids;
+    };
+
+    // per-thread state which is mutated during a contraction
+    struct thread_state {
+      char    * memory_left    = nullptr;
+      char    * memory_right   = nullptr;
+      char    * memory_acc     = nullptr;
+
+      //! output data which corresponds to the first element of the accumulator
+      char const * ptr_out_acc = nullptr;
+
+      std::vector<int32_t> k_count;
       std::vector<const char *> cached_ptrs_left;
       std::vector<const char *> cached_ptrs_right;
+      double time_packing = 0;
     };
 
     struct iter_property {
@@ -97,6 +125,8 @@ namespace einsum_ir {
     constexpr int64_t ce_n_bytes( data_t i_dtype ) {
       if(      i_dtype == FP32 )  return 4;
       else if( i_dtype == FP64 )  return 8;
+      else if( i_dtype == BF16 )  return 2;
+      else if( i_dtype == FP16 )  return 2;
       else                        return -1;
     }
   }
@@ -0,0 +1,161 @@
+#ifndef EINSUM_IR_BASIC_LOW_PRECISION
+#define EINSUM_IR_BASIC_LOW_PRECISION
+
+#include <cstdint>
+#include <cstring>
+
+namespace einsum_ir {
+  namespace basic {
+
+    /**
+     * @brief Converts an FP32 value to BF16 using round-to-nearest-even
+     *
+     * @param i_value FP32 value.
+     * @return bits of the BF16 value.
+     **/
+    inline uint16_t fp32_to_bf16( float i_value ) {
+      uint32_t l_bits = 0;
+      std::memcpy( &l_bits, &i_value, sizeof(float) );
+
+      // keep NaNs quiet
+      if( (l_bits & 0x7FFFFFFF) > 0x7F800000 ) {
+        return static_cast<uint16_t>( (l_bits >> 16) | 0x0040 );
+      }
+
+      l_bits += 0x7FFF + ( (l_bits >> 16) & 1 );
+      return static_cast<uint16_t>( l_bits >> 16 );
+    }
+
+    /**
+     * @brief Converts a BF16 value to FP32
+     *
+     * @param i_bits bits of the BF16 value.
+     * @return FP32 value.
+     **/
+    inline float bf16_to_fp32( uint16_t i_bits ) {
+      uint32_t l_bits = static_cast<uint32_t>( i_bits ) << 16;
+      float l_value = 0;
+      std::memcpy( &l_value, &l_bits, sizeof(float) );
+      return l_value;
+    }
+
+    /**
+     * @brief Converts an FP32 value to FP16 using round-to-nearest-even
+     *
+     * @param i_value FP32 value.
+     * @return bits of the FP16 value.
+     **/
+    inline uint16_t fp32_to_fp16( float i_value ) {
+      uint32_t l_bits = 0;
+      std::memcpy( &l_bits, &i_value, sizeof(float) );
+
+      uint32_t l_sign = (l_bits >> 16) & 0x8000;
+      uint32_t l_mant = l_bits & 0x007FFFFF;
+      int32_t  l_exp  = static_cast<int32_t>( (l_bits >> 23) & 0xFF ) - 127 + 15;
+
+      // infinity and NaN
+      if( ( (l_bits >> 23) & 0xFF ) == 0xFF ) {
+        return static_cast<uint16_t>( l_sign | 0x7C00 | (l_mant ? 0x0200 : 0) );
+      }
+      // overflow
+      if( l_exp >= 0x1F ) {
+        return static_cast<uint16_t>( l_sign | 0x7C00 );
+      }
+      // subnormal or zero
+      if( l_exp <= 0 ) {
+        if( l_exp < -10 ) {
+          return static_cast<uint16_t>( l_sign );
+        }
+        l_mant |= 0x00800000;
+        uint32_t l_shift = 14 - l_exp;
+        uint32_t l_half = l_mant >> l_shift;
+        uint32_t l_rem = l_mant & ( (1u << l_shift) - 1 );
+        uint32_t l_halfway = 1u << (l_shift - 1);
+        if( l_rem > l_halfway || ( l_rem == l_halfway && (l_half & 1) ) ) {
+          l_half++;
+        }
+        return static_cast<uint16_t>( l_sign | l_half );
+      }
+
+      // normal, a carry of the rounding propagates into the exponent
+      uint32_t l_half = ( static_cast<uint32_t>( l_exp ) << 10 ) | (l_mant >> 13);
+      uint32_t l_rem = l_mant & 0x1FFF;
+      if( l_rem > 0x1000 || ( l_rem == 0x1000 && (l_half & 1) ) ) {
+        l_half++;
+      }
+      return static_cast<uint16_t>( l_sign | l_half );
+    }
+
+    /**
+     * @brief Converts an FP16 value to FP32
+     *
+     * @param i_bits bits of the FP16 value.
+     * @return FP32 value.
+     **/
+    inline float fp16_to_fp32( uint16_t i_bits ) {
+      uint32_t l_sign = static_cast<uint32_t>( i_bits & 0x8000 ) << 16;
+      uint32_t l_exp  = (i_bits >> 10) & 0x1F;
+      uint32_t l_mant = i_bits & 0x03FF;
+      uint32_t l_bits = 0;
+
+      if( l_exp == 0 ) {
+        if( l_mant == 0 ) {
+          l_bits = l_sign;
+        }
+        else {
+          // normalize subnormal
+          int32_t l_shift = -1;
+          do {
+            l_shift++;
+            l_mant <<= 1;
+          } while( (l_mant & 0x0400) == 0 );
+          l_mant &= 0x03FF;
+          l_bits = l_sign | ( static_cast<uint32_t>( 127 - 15 - l_shift ) << 23 ) | (l_mant << 13);
+        }
+      }
+      else if( l_exp == 0x1F ) {
+        l_bits = l_sign | 0x7F800000 | (l_mant << 13);
+      }
+      else {
+        l_bits = l_sign | ( (l_exp - 15 + 127) << 23 ) | (l_mant << 13);
+      }
+
+      float l_value = 0;
+      std::memcpy( &l_value, &l_bits, sizeof(float) );
+      return l_value;
+    }
+
+    /**
+     * @brief BF16 storage type, arithmetic is performed in FP32
+     **/
+    struct bf16_t {
+      uint16_t m_bits = 0;
+
+      bf16_t() = default;
+
+      bf16_t( float i_value ) : m_bits( fp32_to_bf16( i_value ) ) {}
+
+      operator float() const {
+        return bf16_to_fp32( m_bits );
+      }
+    };
+
+    /**
+     * @brief FP16 storage type, arithmetic is performed in FP32
+     **/
+    struct fp16_t {
+      uint16_t m_bits = 0;
+
+      fp16_t() = default;
+
+      fp16_t( float i_value ) : m_bits( fp32_to_fp16( i_value ) ) {}
+
+      operator float() const {
+        return fp16_to_fp32( m_bits );
+      }
+    };
+
+  }
+}
+
+#endif
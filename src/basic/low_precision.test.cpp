@@ -0,0 +1,41 @@
+#include "catch.hpp"
+#include "low_precision.h"
+#include <cmath>
+#include <limits>
+
+TEST_CASE( "Conversions between FP32 and BF16.", "[low_precision]" ) {
+  // exactly representable values
+  for( float l_value : { 0.0f, -0.0f, 1.0f, -2.5f, 0.15625f, 65536.0f } ) {
+    REQUIRE( float( einsum_ir::basic::bf16_t( l_value ) ) == l_value );
+  }
+
+  // round-to-nearest-even of the dropped mantissa bits
+  REQUIRE( einsum_ir::basic::fp32_to_bf16( 1.0f + 1.0f / 256.0f ) == 0x3F80 );
+  REQUIRE( einsum_ir::basic::fp32_to_bf16( 1.0f + 3.0f / 256.0f ) == 0x3F82 );
+  REQUIRE( einsum_ir::basic::fp32_to_bf16( 1.0f + 1.5f / 256.0f ) == 0x3F81 );
+
+  REQUIRE( std::isinf( float( einsum_ir::basic::bf16_t( std::numeric_limits< float >::infinity() ) ) ) );
+  REQUIRE( std::isnan( float( einsum_ir::basic::bf16_t( std::numeric_limits< float >::quiet_NaN() ) ) ) );
+}
+
+TEST_CASE( "Conversions between FP32 and FP16.", "[low_precision]" ) {
+  // exactly representable values
+  for( float l_value : { 0.0f, -0.0f, 1.0f, -2.5f, 0.15625f, 65504.0f } ) {
+    REQUIRE( float( einsum_ir::basic::fp16_t( l_value ) ) == l_value );
+  }
+
+  // round-to-nearest-even of the dropped mantissa bits
+  REQUIRE( einsum_ir::basic::fp32_to_fp16( 1.0f + 1.0f / 2048.0f ) == 0x3C00 );
+  REQUIRE( einsum_ir::basic::fp32_to_fp16( 1.0f + 3.0f / 2048.0f ) == 0x3C02 );
+
+  // subnormals
+  float l_min_subnormal = std::ldexp( 1.0f, -24 );
+  REQUIRE( einsum_ir::basic::fp32_to_fp16( l_min_subnormal ) == 0x0001 );
+  REQUIRE( float( einsum_ir::basic::fp16_t( 3 * l_min_subnormal ) ) == 3 * l_min_subnormal );
+  REQUIRE( einsum_ir::basic::fp32_to_fp16( l_min_subnormal / 4 ) == 0x0000 );
+
+  // overflow, infinity and NaN
+  REQUIRE( einsum_ir::basic::fp32_to_fp16( 65520.0f ) == 0x7C00 );
+  REQUIRE( std::isinf( float( einsum_ir::basic::fp16_t( std::numeric_limits< float >::infinity() ) ) ) );
+  REQUIRE( std::isnan( float( einsum_ir::basic::fp16_t( std::numeric_limits< float >::quiet_NaN() ) ) ) );
+}
@@ -8,6 +8,8 @@
   #include <sys/sysctl.h>
 #elif defined(EINSUM_IR_USE_OPENMP)
   #include <omp.h>
+#elif defined(EINSUM_IR_USE_POOL)
+  #include "ThreadPool.h"
 #endif
 
 namespace einsum_ir {
@@ -43,6 +45,10 @@ namespace einsum_ir {
       // OpenMP: Use standard API (respects OMP_NUM_THREADS)
       return static_cast<int64_t>(omp_get_max_threads());
 
+#elif defined(EINSUM_IR_USE_POOL)
+      // Persistent pool: respects EINSUM_IR_NUM_THREADS
+      return ThreadPool::get_instance().get_num_threads();
+
 #else
       // Sequential: Single thread
       return 1;
@@ -93,6 +99,14 @@ namespace einsum_ir {
         i_work( l_thread_id );
       }
       
+#elif defined(EINSUM_IR_USE_POOL)
+      // Persistent pool implementation, the captureless lambda decays to the pool's work type
+      ThreadPool::get_instance().execute( i_num_threads,
+                                          []( void * i_context, int64_t i_thread_id ) {
+                                            (*static_cast< WorkFunc * >( i_context ))( i_thread_id );
+                                          },
+                                          &i_work );
+
 #else
       // Sequential fallback
       for( int64_t l_thread_id = 0; l_thread_id < i_num_threads; l_thread_id++ ) {
@@ -100,6 +114,36 @@ namespace einsum_ir {
       }
 #endif
     }
+
+    /**
+     * @brief Execute work function in a region which may itself call execute_threaded
+     *
+     * OpenMP requires nested parallelism to be enabled explicitly, the other backends nest natively.
+     * The maximum number of active OpenMP levels is raised for the region and restored afterwards.
+     *
+     * @tparam WorkFunc Callable with signature void(int64_t task_id)
+     * @param i_num_tasks Number of concurrent tasks
+     * @param i_work Work function, called once per task with task ID in [0, i_num_tasks)
+     **/
+    template<typename WorkFunc>
+    inline void execute_nested( int64_t   i_num_tasks,
+                                WorkFunc  i_work ) {
+#if defined(EINSUM_IR_USE_OPENMP)
+      int l_levels = omp_get_max_active_levels();
+      int l_levels_required = omp_get_active_level() + 2;
+      if( l_levels < l_levels_required ) {
+        omp_set_max_active_levels( l_levels_required );
+      }
+#endif
+      execute_threaded( i_num_tasks,
+                        i_work );
+#if defined(EINSUM_IR_USE_OPENMP)
+      // the setting is process-wide, keep the one of the host application
+      if( l_levels < l_levels_required ) {
+        omp_set_max_active_levels( l_levels );
+      }
+#endif
+    }
     
   }
 }
@@ -104,7 +104,7 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackend::compile(){
 }
 
 void einsum_ir::basic::UnaryBackend::eval( void const * i_tensor_in,
-                                           void       * io_tensor_out ) {
+                                           void       * io_tensor_out ) const {
   if(m_id_first_primitive_dim == 0){
     kernel_main( (char *) i_tensor_in,
                  (char *) io_tensor_out );
@@ -124,7 +124,7 @@ void einsum_ir::basic::UnaryBackend::eval( void const * i_tensor_in,
 
 void einsum_ir::basic::UnaryBackend::eval_iter( int64_t         i_id_loop,
                                                 char    const * i_ptr_in,
-                                                char          * i_ptr_out ) {
+                                                char          * i_ptr_out ) const {
 
   int64_t l_size = m_dim_sizes[i_id_loop];
 
@@ -147,7 +147,7 @@ void einsum_ir::basic::UnaryBackend::eval_iter( int64_t         i_id_loop,
 
 void einsum_ir::basic::UnaryBackend::eval_iter_parallel( int64_t         i_id_loop,
                                                          char    const * i_ptr_in,
-                                                         char          * i_ptr_out ) {
+                                                         char          * i_ptr_out ) const {
 
   int64_t l_all_size = 1;
   for( int64_t l_loop = 0; l_loop < m_num_parallel_loops; l_loop++ ) {
@@ -123,7 +123,7 @@ class einsum_ir::basic::UnaryBackend {
      * @param io_tensor_out output tensor.
      **/
     void eval( void const * i_tensor_in,
-               void       * io_tensor_out );
+               void       * io_tensor_out ) const;
     
     /**
      * General purpose loop implementation featuring first and last touch operations.
@@ -135,7 +135,7 @@ class einsum_ir::basic::UnaryBackend {
      **/
     void eval_iter( int64_t         i_id_loop,
                     char    const * i_ptr_in,
-                    char          * i_ptr_out );
+                    char          * i_ptr_out ) const;
 
     /**
      * General purpose loop implementation featuring first and last touch operations.
@@ -147,7 +147,7 @@ class einsum_ir::basic::UnaryBackend {
      **/
     void eval_iter_parallel( int64_t         i_id_loop,
                              char    const * i_ptr_in,
-                             char          * i_ptr_out );
+                             char          * i_ptr_out ) const;
 
     /**
      * calculates the properies of the kernel i.e. m, n, lda, ldb ...
@@ -163,7 +163,7 @@ class einsum_ir::basic::UnaryBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     virtual void kernel_main( void const * i_in,
-                              void       * io_out ) = 0;
+                              void       * io_out ) const = 0;
 
     /**
      * Compiles all kernels
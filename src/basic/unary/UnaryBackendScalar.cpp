@@ -1,5 +1,6 @@
 
 #include "UnaryBackendScalar.h"
+#include "../low_precision.h"
 
 template < typename T >
 void einsum_ir::basic::UnaryBackendScalar::kernel_zero( void const *,
@@ -32,9 +33,12 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendScalar::compile_kernels()
     return err_t::COMPILATION_FAILED;
   }
 
-  // determine if all dtypes are FP32 or FP64
+  // determine if all dtypes are FP32 or FP64,
+  // or if BF16 / FP16 is used for storage with FP32 computations
   bool l_dtype_all_fp32 = false;
   bool l_dtype_all_fp64 = false;
+  bool l_dtype_bf16 = false;
+  bool l_dtype_fp16 = false;
 
   if(    m_dtype_in   == FP32
       && m_dtype_comp == FP32
@@ -46,6 +50,16 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendScalar::compile_kernels()
            && m_dtype_out  == FP64 ) {
     l_dtype_all_fp64 = true;
   }
+  else if(    m_dtype_in   == BF16
+           && m_dtype_comp == FP32
+           && m_dtype_out  == BF16 ) {
+    l_dtype_bf16 = true;
+  }
+  else if(    m_dtype_in   == FP16
+           && m_dtype_comp == FP32
+           && m_dtype_out  == FP16 ) {
+    l_dtype_fp16 = true;
+  }
   else {
     return err_t::COMPILATION_FAILED;
   }
@@ -58,6 +72,12 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendScalar::compile_kernels()
     else if( l_dtype_all_fp64 ) {
       m_kernel = &kernel_zero< double >;
     }
+    else if( l_dtype_bf16 ) {
+      m_kernel = &kernel_zero< bf16_t >;
+    }
+    else if( l_dtype_fp16 ) {
+      m_kernel = &kernel_zero< fp16_t >;
+    }
   }
   else if( m_ktype == kernel_t::COPY ) {
     if( l_dtype_all_fp32 ) {
@@ -66,6 +86,12 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendScalar::compile_kernels()
     else if( l_dtype_all_fp64 ) {
       m_kernel = &kernel_copy< double >;
     }
+    else if( l_dtype_bf16 ) {
+      m_kernel = &kernel_copy< bf16_t >;
+    }
+    else if( l_dtype_fp16 ) {
+      m_kernel = &kernel_copy< fp16_t >;
+    }
   }
   else if( m_ktype == kernel_t::RELU ) {
     if( l_dtype_all_fp32 ) {
@@ -74,6 +100,12 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendScalar::compile_kernels()
     else if( l_dtype_all_fp64 ) {
       m_kernel = &kernel_relu< double >;
     }
+    else if( l_dtype_bf16 ) {
+      m_kernel = &kernel_relu< bf16_t >;
+    }
+    else if( l_dtype_fp16 ) {
+      m_kernel = &kernel_relu< fp16_t >;
+    }
   }
   else {
     return err_t::COMPILATION_FAILED;
@@ -83,7 +115,7 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendScalar::compile_kernels()
 }
 
 void einsum_ir::basic::UnaryBackendScalar::kernel_main( void const * i_in,
-                                                        void       * io_out ) {
+                                                        void       * io_out ) const {
 
   m_kernel( i_in,
             io_out );
@@ -55,7 +55,7 @@ class einsum_ir::basic::UnaryBackendScalar: public UnaryBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     void kernel_main( void const * i_in,
-                      void       * io_out );
+                      void       * io_out ) const;
 
     /**
      * Compiles all kernels
@@ -7,12 +7,18 @@ libxsmm_datatype einsum_ir::basic::UnaryBackendTpp::dtype_to_libxsmm( data_t i_d
   else if( i_dtype == FP64 ) {
     return libxsmm_datatype::LIBXSMM_DATATYPE_F64;
   }
+  else if( i_dtype == BF16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_BF16;
+  }
+  else if( i_dtype == FP16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_F16;
+  }
 
   return libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED;
 }
 
 void einsum_ir::basic::UnaryBackendTpp::kernel_main( void const * i_out_aux,
-                                                     void       * io_out ){
+                                                     void       * io_out ) const {
   if( m_xmm_kernel_unary != nullptr ) {
     libxsmm_meltw_unary_param l_param;
     l_param.in.primary  = (void *) i_out_aux;
@@ -48,15 +54,15 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendTpp::compile_kernels(){
                                                                                      m_ldb,
                                                                                      l_xmm_dtype_out,
                                                                                      l_xmm_dtype_out,
-                                                                                     l_xmm_dtype_out );
+                                                                                     l_xmm_dtype_comp );
   
   libxsmm_meltw_unary_shape l_shape_single_touch_aux_unary = libxsmm_create_meltw_unary_shape( m_m,
                                                                                                m_n,
                                                                                                m_lda,
                                                                                                m_ldb,
+                                                                                               l_xmm_dtype_in,
                                                                                                l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out );
+                                                                                               l_xmm_dtype_comp );
 
   libxsmm_meltw_binary_shape l_shape_single_touch_aux_binary = libxsmm_create_meltw_binary_shape( m_m,
                                                                                                   m_n,
@@ -64,9 +70,9 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendTpp::compile_kernels(){
                                                                                                   m_lda,
                                                                                                   m_ldb,
                                                                                                   l_xmm_dtype_out,
+                                                                                                  l_xmm_dtype_in,
                                                                                                   l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out );
+                                                                                                  l_xmm_dtype_comp );
 
   //first touch kernel
   if( m_ktype == kernel_t::ZERO ) {
@@ -32,7 +32,7 @@ class einsum_ir::basic::UnaryBackendTpp: public UnaryBackend {
      * @param io_out pointer to a data section of the output tensor.
      **/
     virtual void kernel_main( void const * i_in,
-                              void       * io_out );
+                              void       * io_out ) const;
 
     /**
      * Compiles all kernels
@@ -1,3 +1,4 @@
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -9,16 +10,18 @@ int main( int     i_argc,
           char  * i_argv[] ) {
   if( i_argc < 4 ) {
     std::cerr << "Usage:" << std::endl;
-    std::cerr << "  ./bench_expression einsum_string dimension_sizes contraction_path dtype store_lock print_tree" << std::endl;
+    std::cerr << "  ./bench_expression einsum_string dimension_sizes contraction_path dtype store_lock print_tree profile memory_budget" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Arguments:" << std::endl;
     std::cerr << "  * einsum_string:    Einsum expression string. Either in single-character or standard format." << std::endl;
     std::cerr << "  * dimension_sizes:  Dimension sizes have to be in ascending order of the dimension names." << std::endl;
     std::cerr << "                      ASCII numbers (see Example #3) are sorted by their numeric value." << std::endl;
-    std::cerr << "  * contraction_path: Contraction path." << std::endl;
-    std::cerr << "  * dtype:            FP32, FP64, CPX_FP32 or CPX_FP64, default: FP32." << std::endl;
+    std::cerr << "  * contraction_path: Contraction path. If \"auto\" the path is derived by einsum_ir." << std::endl;
+    std::cerr << "  * dtype:            FP32, FP64, BF16, FP16, CPX_FP32 or CPX_FP64, default: FP32." << std::endl;
     std::cerr << "  * store_lock:       If 1 all einsum_ir input tensors are stored and locked before evaluation, default: 0." << std::endl;
     std::cerr << "  * print_tree:       If not 0 the einsum tree is printed (1: dimension ids, 2: characters), default: 0." << std::endl;
+    std::cerr << "  * profile:          If given, a profiled evaluation is written to this file in the Chrome trace format, default: none." << std::endl;
+    std::cerr << "  * memory_budget:    Budget of the intermediate tensors and scratch memory in bytes. If exceeded, the expression is sliced, the compilation fails if the budget cannot be met, default: 0 (none)." << std::endl;
     std::cerr << std::endl;
     std::cerr << "Example #1 (single character format):" << std::endl;
     std::cerr << "  ./bench_expression \"iae,bf,dcba,cg,dh->hgfei\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
@@ -26,6 +29,8 @@ int main( int     i_argc,
     std::cerr << "  ./bench_expression \"[i,a,e],[b,f],[d,c,b,a],[c,g],[d,h]->[h,g,f,e,i]\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
     std::cerr << "Example #3 (standard format using integers):" << std::endl;
     std::cerr << "  ./bench_expression \"[8,0,4],[1,5],[3,2,1,0],[2,6],[3,7]->[7,6,5,4,8]\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
+    std::cerr << "Example #4 (derived contraction path):" << std::endl;
+    std::cerr << "  ./bench_expression \"iae,bf,dcba,cg,dh->hgfei\" \"32,8,4,2,16,64,8,8,8\" \"auto\"" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -73,14 +78,20 @@ int main( int     i_argc,
    */
   std::string l_path_string( i_argv[3] );
   std::vector< int64_t > l_path;
-  einsum_ir::frontend::EinsumExpressionAscii::parse_path( l_path_string,
-                                                          l_path );
+  bool l_path_auto = l_path_string == "auto";
+  if( l_path_auto ) {
+    std::cout << "contraction path: auto" << std::endl;
+  }
+  else {
+    einsum_ir::frontend::EinsumExpressionAscii::parse_path( l_path_string,
+                                                            l_path );
 
-  std::cout << "parsed contraction path: ";
-  for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
-    std::cout << l_path[l_co] << " ";
+    std::cout << "parsed contraction path: ";
+    for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
+      std::cout << l_path[l_co] << " ";
+    }
+    std::cout << std::endl;
   }
-  std::cout << std::endl;
 
   /*
    * create mapping from dimension name to id
@@ -129,6 +140,12 @@ int main( int     i_argc,
     else if( l_arg_dtype == "FP64" ) {
       l_dtype_at = at::ScalarType::Double;
     }
+    else if( l_arg_dtype == "BF16" ) {
+      l_dtype_at = at::ScalarType::BFloat16;
+    }
+    else if( l_arg_dtype == "FP16" ) {
+      l_dtype_at = at::ScalarType::Half;
+    }
     else if( l_arg_dtype == "CPX_FP32" ) {
       l_dtype_at = at::ScalarType::ComplexFloat;
     }
@@ -154,6 +171,12 @@ int main( int     i_argc,
   else if( l_dtype_einsum_ir == einsum_ir::FP64 ) {
     std::cout << "dtype: FP64" << std::endl;
   }
+  else if( l_dtype_einsum_ir == einsum_ir::BF16 ) {
+    std::cout << "dtype: BF16" << std::endl;
+  }
+  else if( l_dtype_einsum_ir == einsum_ir::FP16 ) {
+    std::cout << "dtype: FP16" << std::endl;
+  }
   else {
     std::cerr << "failed to determine dtype" << std::endl;
     return EXIT_FAILURE;
@@ -188,6 +211,27 @@ int main( int     i_argc,
   }
   std::cout << "print_tree: " << l_print_tree << std::endl;
 
+  /*
+   * parse profile
+   */
+  std::string l_path_profile;
+  if( i_argc > 7 ) {
+    l_path_profile = std::string( i_argv[7] );
+  }
+
+  /*
+   * parse memory budget
+   */
+  int64_t l_memory_budget = 0;
+  if( i_argc > 8 ) {
+    l_memory_budget = std::stoll( i_argv[8] );
+  }
+  if( l_memory_budget < 0 ) {
+    std::cerr << "error: invalid memory_budget argument" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "memory_budget: " << l_memory_budget << std::endl;
+
   /*
    * assemble einsum_ir data structures
    */
@@ -282,13 +326,14 @@ int main( int     i_argc,
   einsum_ir::frontend::EinsumExpression l_einsum_exp;
   l_einsum_exp.init( l_dim_sizes.size(),
                      l_dim_sizes.data(),
-                     l_path.size()/2,
+                     l_num_tensors-2,
                      l_string_num_dims.data(),
                      l_string_dim_ids.data(),
-                     l_path.data(),
+                     l_path_auto ? nullptr : l_path.data(),
                      l_ctype_einsum_ir,
                      l_dtype_einsum_ir,
                      l_data_ptrs.data() );
+  l_einsum_exp.set_memory_budget( l_memory_budget );
 
   l_tp0 = std::chrono::steady_clock::now();
   einsum_ir::err_t l_err = l_einsum_exp.compile();
@@ -301,6 +346,17 @@ int main( int     i_argc,
     return EXIT_FAILURE;
   }
 
+  // use the derived contraction path in all following runs
+  if( l_path_auto ) {
+    l_path = l_einsum_exp.m_path_opt;
+
+    std::cout << "derived contraction path: ";
+    for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
+      std::cout << l_path[l_co] << " ";
+    }
+    std::cout << std::endl;
+  }
+
   // print einsum tree
   std::string l_tree = "";
   if(    l_print_tree == 1
@@ -363,6 +419,13 @@ int main( int     i_argc,
   std::cout << "  time (eval):    " << l_time_eval << std::endl;
   std::cout << "  gflops (eval):  " << l_gflops_eval << std::endl;
   std::cout << "  gflops (total): " << l_gflops_total << std::endl;
+  std::cout << "  memory (stack, intervals, lower bound): "
+            << l_einsum_exp.m_memory.get_num_bytes_stack() << " "
+            << l_einsum_exp.m_memory.get_num_bytes_intervals() << " "
+            << l_einsum_exp.m_memory.get_num_bytes_lower_bound() << std::endl;
+  std::cout << "  slicing (slices, flop overhead): "
+            << l_einsum_exp.num_slices() << " "
+            << l_einsum_exp.num_ops_slicing() << std::endl;
   std::cout << "CSV_DATA: "
             << "einsum_ir,"
             << "\"" << l_expression_string_arg << "\","
@@ -375,6 +438,33 @@ int main( int     i_argc,
             << l_gflops_total
             << std::endl;
 
+  // profiled run
+  if( !l_path_profile.empty() ) {
+    l_einsum_exp.set_profiling( true );
+    l_einsum_exp.eval();
+    l_einsum_exp.set_profiling( false );
+
+    std::vector< einsum_ir::backend::NodeProfile > l_profiles;
+    l_einsum_exp.profile( l_profiles );
+
+    std::cout << "  profile (node, parent, permute, packing, contraction, gflops):" << std::endl;
+    for( std::size_t l_pr = 0; l_pr < l_profiles.size(); l_pr++ ) {
+      std::cout << "    #" << l_profiles[l_pr].m_id << ": "
+                << l_profiles[l_pr].m_id_parent << " "
+                << l_profiles[l_pr].m_time_permute << " "
+                << l_profiles[l_pr].m_time_packing << " "
+                << l_profiles[l_pr].m_time_contraction << " "
+                << l_profiles[l_pr].gflops() << std::endl;
+    }
+
+    std::ofstream l_file( l_path_profile );
+    l_file << einsum_ir::backend::NodeProfile::to_chrome_trace( l_profiles );
+    if( !l_file ) {
+      std::cerr << "error: failed to write profile: " << l_path_profile << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   /*
    * run at::einsum
    */
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "frontend/EinsumExpression.h"
+#include "basic/Numa.h"
+#include "basic/Topology.h"
+#include "basic/threading.h"
+
+/*
+ * Measures the scaling of a bandwidth-heavy einsum expression over the threads of one and multiple NUMA nodes.
+ *
+ * The expression abc,cd,de->abe has a large intermediate tensor abd.
+ * Three placements of the memory are compared:
+ *   local:       leaf tensors are written by the calling thread, i.e., all leaf pages are on a single node,
+ *   first_touch: leaf tensors are written by all threads in contiguous chunks,
+ *   interleave:  leaf tensors and the intermediate tensor are interleaved over all nodes.
+ * The intermediate tensor is placed by the first touch of the contraction in the local and first_touch placements.
+ */
+
+/**
+ * Sets the number of threads of the threading backend.
+ *
+ * @param i_num_threads number of threads.
+ * @return true if the number of threads was set, false otherwise.
+ **/
+bool set_num_threads( int64_t i_num_threads ) {
+#if defined(EINSUM_IR_USE_OPENMP)
+  omp_set_num_threads( i_num_threads );
+  return true;
+#elif defined(EINSUM_IR_USE_POOL)
+  einsum_ir::basic::ThreadPool::get_instance().init( i_num_threads,
+                                                     1 << 14 );
+  return true;
+#else
+  return i_num_threads == einsum_ir::basic::get_num_threads_available();
+#endif
+}
+
+/**
+ * Allocates a FP32 tensor and initializes it.
+ *
+ * @param i_num_elements number of elements.
+ * @param i_placement placement of the tensor: local, first_touch or interleave.
+ * @param i_num_threads number of threads writing the tensor in the first_touch placement.
+ * @return tensor.
+ **/
+float * create_tensor( int64_t             i_num_elements,
+                       std::string const & i_placement,
+                       int64_t             i_num_threads ) {
+  einsum_ir::basic::Numa::placement_t l_placement = ( i_placement == "interleave" ) ? einsum_ir::basic::Numa::INTERLEAVE
+                                                                                     : einsum_ir::basic::Numa::FIRST_TOUCH;
+  float * l_data = (float *) einsum_ir::basic::Numa::alloc( i_num_elements * sizeof(float),
+                                                            l_placement );
+
+  int64_t l_num_chunks = ( i_placement == "first_touch" ) ? i_num_threads : 1;
+  einsum_ir::basic::execute_threaded( l_num_chunks, [&]( int64_t l_ch ) {
+    int64_t l_first = i_num_elements * l_ch / l_num_chunks;
+    int64_t l_last  = i_num_elements * (l_ch + 1) / l_num_chunks;
+    for( int64_t l_en = l_first; l_en < l_last; l_en++ ) {
+      l_data[l_en] = ( (l_en * 7) % 13 ) * 0.125f - 0.75f;
+    }
+  } );
+
+  return l_data;
+}
+
+/**
+ * Benchmarks the expression for one number of threads and placement.
+ *
+ * @param i_dim_sizes sizes of the dimensions a, b, c, d and e.
+ * @param i_num_threads number of threads.
+ * @param i_placement placement of the tensors.
+ * @param i_num_reps number of timed evaluations.
+ * @param o_num_ops number of operations of an evaluation.
+ * @return median time of an evaluation in seconds, negative on failure.
+ **/
+double bench_expression( std::vector< int64_t > const & i_dim_sizes,
+                         int64_t                        i_num_threads,
+                         std::string            const & i_placement,
+                         int64_t                        i_num_reps,
+                         int64_t                      & o_num_ops ) {
+  // the memory manager of the expression reads the placement of the intermediate tensor
+  setenv( "EINSUM_IR_NUMA_PLACEMENT",
+          i_placement == "interleave" ? "INTERLEAVE" : "FIRST_TOUCH",
+          1 );
+
+  int64_t l_a = i_dim_sizes[0];
+  int64_t l_b = i_dim_sizes[1];
+  int64_t l_c = i_dim_sizes[2];
+  int64_t l_d = i_dim_sizes[3];
+  int64_t l_e = i_dim_sizes[4];
+
+  std::vector< int64_t > l_num_elements = { l_a * l_b * l_c,
+                                            l_c * l_d,
+                                            l_d * l_e,
+                                            l_a * l_b * l_e };
+  std::vector< float * > l_tensors;
+  for( std::size_t l_te = 0; l_te < l_num_elements.size(); l_te++ ) {
+    l_tensors.push_back( create_tensor( l_num_elements[l_te],
+                                        i_placement,
+                                        i_num_threads ) );
+  }
+
+  // abc, cd, de and abe
+  std::vector< int64_t > l_string_num_dims = { 3, 2, 2, 3 };
+  std::vector< int64_t > l_string_dim_ids  = { 0, 1, 2, 2, 3, 3, 4, 0, 1, 4 };
+  std::vector< int64_t > l_path            = { 0, 1, 0, 1 };
+  std::vector< void * > l_data_ptrs( l_tensors.begin(), l_tensors.end() );
+
+  double l_time = -1;
+  {
+    einsum_ir::frontend::EinsumExpression l_expression;
+    l_expression.init( i_dim_sizes.size(),
+                       i_dim_sizes.data(),
+                       2,
+                       l_string_num_dims.data(),
+                       l_string_dim_ids.data(),
+                       l_path.data(),
+                       einsum_ir::FP32,
+                       l_data_ptrs.data() );
+
+    if( l_expression.compile() == einsum_ir::err_t::SUCCESS ) {
+      o_num_ops = l_expression.num_ops();
+      l_expression.eval();
+
+      std::vector< double > l_times;
+      for( int64_t l_re = 0; l_re < i_num_reps; l_re++ ) {
+        std::chrono::steady_clock::time_point l_tp0 = std::chrono::steady_clock::now();
+        l_expression.eval();
+        std::chrono::steady_clock::time_point l_tp1 = std::chrono::steady_clock::now();
+        l_times.push_back( std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 ).count() );
+      }
+      std::sort( l_times.begin(), l_times.end() );
+      l_time = l_times[ l_times.size() / 2 ];
+    }
+  }
+
+  for( std::size_t l_te = 0; l_te < l_tensors.size(); l_te++ ) {
+    einsum_ir::basic::Numa::free( (char *) l_tensors[l_te],
+                                  l_num_elements[l_te] * sizeof(float) );
+  }
+
+  return l_time;
+}
+
+int main( int     i_argc,
+          char  * i_argv[] ) {
+  einsum_ir::basic::Topology const & l_topology = einsum_ir::basic::Topology::get_instance();
+  int64_t l_num_nodes = einsum_ir::basic::Numa::get_num_nodes();
+
+  int64_t l_num_threads_max = einsum_ir::basic::get_num_threads_available();
+  int64_t l_num_reps = 10;
+  // sizes of a, b, c, d and e
+  std::vector< int64_t > l_dim_sizes = { 128, 1024, 64, 64, 64 };
+
+  if( i_argc > 1 ) {
+    l_num_threads_max = std::atoll( i_argv[1] );
+  }
+  if( i_argc > 2 ) {
+    l_num_reps = std::atoll( i_argv[2] );
+  }
+  if( i_argc > 3 ) {
+    l_dim_sizes[1] = std::atoll( i_argv[3] );
+  }
+  if( l_num_threads_max < 1 || l_num_reps < 1 || l_dim_sizes[1] < 1 ) {
+    std::cerr << "Usage: ./bench_numa [max_threads] [num_reps] [size_b]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the calling thread executes thread id 0
+  bool l_pinning = einsum_ir::basic::Numa::get_pinning();
+  if( l_pinning ) {
+    einsum_ir::basic::Numa::pin_thread( einsum_ir::basic::Numa::get_cpus()[0] );
+  }
+
+  std::cout << "numa nodes:       " << l_num_nodes << std::endl;
+  std::cout << "cores:            " << l_topology.m_num_cores << std::endl;
+  std::cout << "cpus:             " << l_topology.m_num_cpus << std::endl;
+  std::cout << "pinning:          " << ( l_pinning ? "on" : "off (set EINSUM_IR_PIN_THREADS=1)" ) << std::endl;
+  std::cout << "expression:       abc,cd,de->abe" << std::endl;
+  std::cout << "sizes (a-e):      " << l_dim_sizes[0] << "," << l_dim_sizes[1] << "," << l_dim_sizes[2] << "," << l_dim_sizes[3] << "," << l_dim_sizes[4] << std::endl;
+
+  // powers of two, the cores of a single node and all threads
+  std::vector< int64_t > l_num_threads;
+  for( int64_t l_th = 1; l_th < l_num_threads_max; l_th *= 2 ) {
+    l_num_threads.push_back( l_th );
+  }
+  int64_t l_num_cores_node = std::max< int64_t >( 1, l_topology.m_num_cores / l_num_nodes );
+  if( l_num_cores_node < l_num_threads_max ) {
+    l_num_threads.push_back( l_num_cores_node );
+  }
+  l_num_threads.push_back( l_num_threads_max );
+  std::sort( l_num_threads.begin(), l_num_threads.end() );
+  l_num_threads.erase( std::unique( l_num_threads.begin(), l_num_threads.end() ),
+                       l_num_threads.end() );
+
+  std::vector< std::string > l_placements = { "local", "first_touch", "interleave" };
+  std::vector< double > l_time_single( l_placements.size(), 0 );
+
+  std::cout << std::endl;
+  std::cout << std::setw( 8 ) << "threads"
+            << std::setw( 14 ) << "placement"
+            << std::setw( 14 ) << "time"
+            << std::setw( 12 ) << "gflops"
+            << std::setw( 10 ) << "speedup" << std::endl;
+
+  for( std::size_t l_th = 0; l_th < l_num_threads.size(); l_th++ ) {
+    if( !set_num_threads( l_num_threads[l_th] ) ) {
+      continue;
+    }
+
+    for( std::size_t l_pl = 0; l_pl < l_placements.size(); l_pl++ ) {
+      int64_t l_num_ops = 0;
+      double l_time = bench_expression( l_dim_sizes,
+                                        l_num_threads[l_th],
+                                        l_placements[l_pl],
+                                        l_num_reps,
+                                        l_num_ops );
+      if( l_time < 0 ) {
+        std::cerr << "error: failed to compile the expression" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if( l_time_single[l_pl] == 0 ) {
+        l_time_single[l_pl] = l_time;
+      }
+
+      std::cout << std::setw( 8 ) << l_num_threads[l_th]
+                << std::setw( 14 ) << l_placements[l_pl]
+                << std::setw( 14 ) << l_time
+                << std::setw( 12 ) << 1.0E-9 * l_num_ops / l_time
+                << std::setw( 10 ) << l_time_single[l_pl] / l_time << std::endl;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,744 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "frontend/EinsumExpression.h"
+#include "frontend/EinsumExpressionAscii.h"
+#include "frontend/EinsumTree.h"
+#include "frontend/EinsumTreeAscii.h"
+#include "basic/low_precision.h"
+#include "basic/Numa.h"
+#include "basic/threading.h"
+
+/*
+ * Replays the workloads of the config files in samples/.
+ * Every line of a config file holds the quoted arguments of bench_expression or bench_tree:
+ *   expression:  "einsum_string" "dimension_sizes" "contraction_path"
+ *   einsum tree: "einsum_tree" "dimension_sizes"
+ * Each entry is compiled once and evaluated repeatedly, all entries are written to a single report.
+ * Optionally, the tensors of expressions are backed by memory-mapped files to replay out-of-core workloads.
+ */
+
+/**
+ * Settings of the replay.
+ **/
+struct Settings {
+  //! number of timed evaluations per entry
+  int64_t num_reps = 5;
+  //! number of untimed evaluations per entry
+  int64_t num_warmup = 1;
+  //! number of threads, 0 keeps the default of the threading backend
+  int64_t num_threads = 0;
+  //! datatype of the tensors
+  std::string dtype = "FP32";
+  //! backend of the binary contractions, empty keeps the default
+  std::string backend = "";
+  //! reordering of the dimensions, empty keeps the default
+  std::string reorder_dims = "";
+  //! page backing of the intermediate tensors, empty keeps the default
+  std::string huge_pages = "";
+  //! directory of the memory-mapped tensors of expressions, tensors are held in memory if empty
+  std::string mmap_dir = "";
+  //! path of the CSV report, no report if empty
+  std::string path_csv = "";
+  //! path of the JSON report, no report if empty
+  std::string path_json = "";
+  //! config files
+  std::vector< std::string > paths_config;
+};
+
+/**
+ * Entry of a config file.
+ **/
+struct Entry {
+  std::string path_config;
+  int64_t id_line = 0;
+  std::vector< std::string > args;
+};
+
+/**
+ * Result of an entry.
+ **/
+struct Result {
+  Entry entry;
+  std::string type = "";
+  std::string status = "ok";
+  int64_t num_ops = 0;
+  std::string pages = "";
+  double time_compile = 0;
+  double time_eval_min = 0;
+  double time_eval_median = 0;
+};
+
+/**
+ * Compiled workload of an entry.
+ **/
+class Workload {
+  public:
+    virtual ~Workload() = default;
+
+    //! evaluates the workload once
+    virtual void eval() = 0;
+
+    //! number of scalar operations of an evaluation
+    virtual int64_t num_ops() = 0;
+
+    //! obtained page backing of the intermediate tensors
+    virtual einsum_ir::basic::Numa::pages_t pages() = 0;
+};
+
+/**
+ * Allocates a tensor and initializes it with deterministic values in [-1, 1).
+ *
+ * @param i_dtype datatype of the tensor.
+ * @param i_num_elements number of elements.
+ * @param i_seed seed of the values.
+ * @return tensor.
+ **/
+std::vector< char > create_tensor( einsum_ir::data_t i_dtype,
+                                   int64_t           i_num_elements,
+                                   uint64_t          i_seed ) {
+  std::vector< char > l_data( i_num_elements * einsum_ir::ce_n_bytes( i_dtype ) );
+
+  uint64_t l_state = i_seed * 6364136223846793005ull + 1442695040888963407ull;
+  for( int64_t l_en = 0; l_en < i_num_elements; l_en++ ) {
+    l_state = l_state * 6364136223846793005ull + 1442695040888963407ull;
+    double l_val = ( l_state >> 11 ) * ( 2.0 / 9007199254740992.0 ) - 1.0;
+
+    if(      i_dtype == einsum_ir::FP64 ) ( (double                      *) l_data.data() )[l_en] = l_val;
+    else if( i_dtype == einsum_ir::FP32 ) ( (float                       *) l_data.data() )[l_en] = (float) l_val;
+    else if( i_dtype == einsum_ir::BF16 ) ( (einsum_ir::basic::bf16_t    *) l_data.data() )[l_en] = (float) l_val;
+    else if( i_dtype == einsum_ir::FP16 ) ( (einsum_ir::basic::fp16_t    *) l_data.data() )[l_en] = (float) l_val;
+  }
+
+  return l_data;
+}
+
+/**
+ * Einsum expression given by an einsum string, dimension sizes and a contraction path.
+ **/
+class WorkloadExpression: public Workload {
+  private:
+    std::vector< int64_t > m_dim_sizes;
+    std::vector< int64_t > m_string_num_dims;
+    std::vector< int64_t > m_string_dim_ids;
+    std::vector< int64_t > m_path;
+    std::vector< std::vector< char > > m_data;
+    std::vector< void * > m_data_ptrs;
+    std::vector< std::string > m_paths_mapped;
+    einsum_ir::frontend::EinsumExpression m_expression;
+
+  public:
+    ~WorkloadExpression() {
+      // the mappings hold their own references of the files
+      for( std::size_t l_pa = 0; l_pa < m_paths_mapped.size(); l_pa++ ) {
+        std::remove( m_paths_mapped[l_pa].c_str() );
+      }
+    }
+
+    /**
+     * Sets up and compiles the expression.
+     *
+     * @param i_expression einsum string in single-character or standard format.
+     * @param i_dim_sizes dimension sizes in ascending order of the dimension names.
+     * @param i_path contraction path or "auto".
+     * @param i_dtype datatype of the tensors.
+     * @param i_mmap_dir directory of the memory-mapped tensors, empty to hold the tensors in memory.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    einsum_ir::err_t compile( std::string const & i_expression,
+                              std::string const & i_dim_sizes,
+                              std::string const & i_path,
+                              einsum_ir::data_t   i_dtype,
+                              std::string const & i_mmap_dir ) {
+      std::string l_expression_std = i_expression;
+      if( i_expression.size() > 0 && i_expression[0] != '[' ) {
+        einsum_ir::frontend::EinsumExpressionAscii::schar_to_standard( i_expression,
+                                                                       l_expression_std );
+      }
+
+      std::vector< std::string > l_tensors;
+      einsum_ir::frontend::EinsumExpressionAscii::parse_tensors( l_expression_std,
+                                                                 l_tensors );
+      einsum_ir::frontend::EinsumExpressionAscii::parse_dim_sizes( i_dim_sizes,
+                                                                   m_dim_sizes );
+      std::map< std::string, int64_t > l_map_dim_name_to_id;
+      einsum_ir::frontend::EinsumExpressionAscii::parse_dim_ids( l_expression_std,
+                                                                 l_map_dim_name_to_id );
+      if(    l_tensors.size() < 2
+          || l_map_dim_name_to_id.size() != m_dim_sizes.size() ) {
+        return einsum_ir::err_t::INVALID_ID;
+      }
+
+      bool l_path_auto = i_path == "auto" || i_path == "";
+      if( !l_path_auto ) {
+        einsum_ir::frontend::EinsumExpressionAscii::parse_path( i_path,
+                                                                m_path );
+      }
+
+      for( std::size_t l_te = 0; l_te < l_tensors.size(); l_te++ ) {
+        std::vector< std::string > l_dim_names;
+        einsum_ir::frontend::EinsumExpressionAscii::split_string( l_tensors[l_te],
+                                                                  std::string(","),
+                                                                  l_dim_names );
+        int64_t l_num_elements = 1;
+        for( std::size_t l_na = 0; l_na < l_dim_names.size(); l_na++ ) {
+          int64_t l_dim_id = l_map_dim_name_to_id[ l_dim_names[l_na] ];
+          m_string_dim_ids.push_back( l_dim_id );
+          l_num_elements *= m_dim_sizes[l_dim_id];
+        }
+        m_string_num_dims.push_back( l_dim_names.size() );
+
+        m_data.push_back( create_tensor( i_dtype,
+                                         l_num_elements,
+                                         l_te ) );
+        m_data_ptrs.push_back( m_data.back().data() );
+      }
+
+      m_expression.init( m_dim_sizes.size(),
+                         m_dim_sizes.data(),
+                         l_tensors.size() - 2,
+                         m_string_num_dims.data(),
+                         m_string_dim_ids.data(),
+                         l_path_auto ? nullptr : m_path.data(),
+                         i_dtype,
+                         m_data_ptrs.data() );
+
+      // inputs are written to their files once, the output is written by the evaluations
+      if( i_mmap_dir != "" ) {
+        for( std::size_t l_te = 0; l_te < l_tensors.size(); l_te++ ) {
+          m_paths_mapped.push_back( i_mmap_dir + "/einsum_ir_tensor_" + std::to_string( l_te ) + ".bin" );
+
+          if( l_te + 1 < l_tensors.size() ) {
+            std::ofstream l_file( m_paths_mapped.back(),
+                                  std::ios::binary );
+            l_file.write( m_data[l_te].data(),
+                          m_data[l_te].size() );
+            if( !l_file ) {
+              return einsum_ir::err_t::UNDEFINED_ERROR;
+            }
+          }
+          std::vector< char >().swap( m_data[l_te] );
+
+          einsum_ir::err_t l_err = m_expression.map_tensor( l_te,
+                                                            m_paths_mapped.back() );
+          if( l_err != einsum_ir::err_t::SUCCESS ) {
+            return l_err;
+          }
+        }
+      }
+
+      return m_expression.compile();
+    }
+
+    void eval() {
+      m_expression.eval();
+    }
+
+    int64_t num_ops() {
+      return m_expression.num_ops();
+    }
+
+    einsum_ir::basic::Numa::pages_t pages() {
+      return m_expression.m_memory.get_pages();
+    }
+};
+
+/**
+ * Einsum tree with a fixed contraction order.
+ **/
+class WorkloadTree: public Workload {
+  private:
+    std::vector< std::vector< int64_t > > m_dim_ids;
+    std::vector< std::vector< int64_t > > m_children;
+    std::map< int64_t, int64_t > m_dim_sizes;
+    std::vector< std::vector< char > > m_data;
+    std::vector< void * > m_data_ptrs;
+    einsum_ir::frontend::EinsumTree m_tree;
+
+  public:
+    /**
+     * Sets up and compiles the einsum tree.
+     *
+     * @param i_tree einsum tree.
+     * @param i_dim_sizes dimension sizes in ascending order of the dimension ids.
+     * @param i_dtype datatype of the tensors.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    einsum_ir::err_t compile( std::string const & i_tree,
+                              std::string const & i_dim_sizes,
+                              einsum_ir::data_t   i_dtype ) {
+      int64_t l_num_nodes = einsum_ir::frontend::EinsumTreeAscii::count_nodes( i_tree );
+      m_dim_ids.resize( l_num_nodes );
+      m_children.resize( l_num_nodes );
+
+      int64_t l_analyzed_nodes = 0;
+      einsum_ir::err_t l_err = einsum_ir::frontend::EinsumTreeAscii::parse_tree( i_tree,
+                                                                                m_dim_ids,
+                                                                                m_children,
+                                                                                l_analyzed_nodes );
+      if( l_err != einsum_ir::err_t::SUCCESS || l_analyzed_nodes != l_num_nodes ) {
+        return einsum_ir::err_t::INVALID_ID;
+      }
+      einsum_ir::frontend::EinsumTreeAscii::parse_dim_size( i_dim_sizes,
+                                                            m_dim_ids,
+                                                            m_dim_sizes );
+
+      // leaves and the root are external tensors
+      m_data.resize( l_num_nodes );
+      for( int64_t l_no = 0; l_no < l_num_nodes; l_no++ ) {
+        if( m_children[l_no].size() == 0 || l_no == l_num_nodes - 1 ) {
+          int64_t l_num_elements = 1;
+          for( std::size_t l_di = 0; l_di < m_dim_ids[l_no].size(); l_di++ ) {
+            l_num_elements *= m_dim_sizes[ m_dim_ids[l_no][l_di] ];
+          }
+          m_data[l_no] = create_tensor( i_dtype,
+                                        l_num_elements,
+                                        l_no );
+          m_data_ptrs.push_back( m_data[l_no].data() );
+        }
+        else {
+          m_data_ptrs.push_back( nullptr );
+        }
+      }
+
+      m_tree.init( &m_dim_ids,
+                   &m_children,
+                   &m_dim_sizes,
+                   i_dtype,
+                   m_data_ptrs.data() );
+
+      return m_tree.compile();
+    }
+
+    void eval() {
+      m_tree.eval();
+    }
+
+    int64_t num_ops() {
+      return m_tree.num_ops();
+    }
+
+    einsum_ir::basic::Numa::pages_t pages() {
+      return m_tree.m_memory.get_pages();
+    }
+};
+
+/**
+ * Parses the entries of a config file.
+ * Empty lines and lines starting with # are skipped.
+ *
+ * @param i_path path of the config file.
+ * @param o_entries entries are appended.
+ * @return true if the file was read, false otherwise.
+ **/
+bool parse_config( std::string          const & i_path,
+                   std::vector< Entry >       & o_entries ) {
+  std::ifstream l_file( i_path );
+  if( !l_file ) {
+    return false;
+  }
+
+  std::string l_line;
+  int64_t l_id_line = 0;
+  while( std::getline( l_file, l_line ) ) {
+    l_id_line++;
+
+    Entry l_entry;
+    l_entry.path_config = i_path;
+    l_entry.id_line = l_id_line;
+
+    std::size_t l_pos = l_line.find_first_not_of( " \t\r" );
+    if( l_pos == std::string::npos || l_line[l_pos] == '#' ) {
+      continue;
+    }
+
+    // arguments are enclosed in double quotes
+    while( true ) {
+      std::size_t l_begin = l_line.find( '"', l_pos );
+      if( l_begin == std::string::npos ) break;
+      std::size_t l_end = l_line.find( '"', l_begin + 1 );
+      if( l_end == std::string::npos ) break;
+
+      l_entry.args.push_back( l_line.substr( l_begin + 1, l_end - l_begin - 1 ) );
+      l_pos = l_end + 1;
+    }
+
+    o_entries.push_back( l_entry );
+  }
+
+  return true;
+}
+
+/**
+ * Compiles and benchmarks an entry.
+ *
+ * @param i_entry entry.
+ * @param i_settings settings of the replay.
+ * @return result.
+ **/
+Result run_entry( Entry    const & i_entry,
+                  Settings const & i_settings ) {
+  std::chrono::steady_clock::time_point l_tp0, l_tp1;
+  std::chrono::duration< double > l_dur;
+
+  Result l_res;
+  l_res.entry = i_entry;
+
+  einsum_ir::data_t l_dtype = einsum_ir::UNDEFINED_DTYPE;
+  einsum_ir::frontend::EinsumExpressionAscii::parse_dtype( i_settings.dtype,
+                                                           l_dtype );
+
+  if( i_entry.args.size() < 2 || i_entry.args.size() > 3 ) {
+    l_res.status = "invalid entry";
+    return l_res;
+  }
+
+  // einsum trees start with a nested tensor
+  bool l_is_tree = i_entry.args[0].compare( 0, 2, "[[" ) == 0;
+  l_res.type = l_is_tree ? "tree" : "expression";
+
+  std::unique_ptr< Workload > l_workload;
+  einsum_ir::err_t l_err = einsum_ir::err_t::UNDEFINED_ERROR;
+  try {
+    l_tp0 = std::chrono::steady_clock::now();
+    if( l_is_tree ) {
+      WorkloadTree * l_tree = new WorkloadTree();
+      l_workload.reset( l_tree );
+      l_err = l_tree->compile( i_entry.args[0],
+                               i_entry.args[1],
+                               l_dtype );
+    }
+    else {
+      WorkloadExpression * l_expression = new WorkloadExpression();
+      l_workload.reset( l_expression );
+      l_err = l_expression->compile( i_entry.args[0],
+                                     i_entry.args[1],
+                                     i_entry.args.size() > 2 ? i_entry.args[2] : "auto",
+                                     l_dtype,
+                                     i_settings.mmap_dir );
+    }
+    l_tp1 = std::chrono::steady_clock::now();
+  }
+  catch( std::bad_alloc const & ) {
+    l_res.status = "out of memory";
+    return l_res;
+  }
+
+  if( l_err != einsum_ir::err_t::SUCCESS ) {
+    l_res.status = "compilation failed";
+    return l_res;
+  }
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 );
+  l_res.time_compile = l_dur.count();
+  l_res.num_ops = l_workload->num_ops();
+  l_res.pages = einsum_ir::basic::Numa::to_string( l_workload->pages() );
+
+  for( int64_t l_wa = 0; l_wa < i_settings.num_warmup; l_wa++ ) {
+    l_workload->eval();
+  }
+
+  std::vector< double > l_times;
+  for( int64_t l_re = 0; l_re < i_settings.num_reps; l_re++ ) {
+    l_tp0 = std::chrono::steady_clock::now();
+    l_workload->eval();
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 );
+    l_times.push_back( l_dur.count() );
+  }
+
+  std::sort( l_times.begin(), l_times.end() );
+  std::size_t l_num = l_times.size();
+  l_res.time_eval_min = l_times[0];
+  l_res.time_eval_median = ( l_num % 2 == 1 ) ? l_times[l_num / 2]
+                                              : 0.5 * ( l_times[l_num / 2 - 1] + l_times[l_num / 2] );
+
+  return l_res;
+}
+
+/**
+ * Escapes a string for the use in CSV or JSON.
+ *
+ * @param i_string string.
+ * @param i_escape character used to escape double quotes.
+ * @return escaped string including the quotes.
+ **/
+std::string quote( std::string const & i_string,
+                   char                i_escape ) {
+  std::string l_quoted = "\"";
+  for( std::size_t l_ch = 0; l_ch < i_string.size(); l_ch++ ) {
+    if( i_string[l_ch] == '"' || ( i_escape == '\\' && i_string[l_ch] == '\\' ) ) {
+      l_quoted += i_escape;
+    }
+    l_quoted += i_string[l_ch];
+  }
+  return l_quoted + "\"";
+}
+
+/**
+ * Gets the GFLOPS of a result.
+ *
+ * @param i_result result.
+ * @param i_total if true, the compile time is included.
+ * @return GFLOPS.
+ **/
+double gflops( Result const & i_result,
+               bool           i_total ) {
+  double l_time = i_result.time_eval_median;
+  if( i_total ) {
+    l_time += i_result.time_compile;
+  }
+  return l_time > 0 ? 1.0E-9 * i_result.num_ops / l_time : 0;
+}
+
+/**
+ * Writes the results in CSV format.
+ *
+ * @param i_results results of the entries.
+ * @param io_stream output stream.
+ **/
+void write_csv( std::vector< Result > const & i_results,
+                std::ostream                & io_stream ) {
+  io_stream << "config,line,type,expression,dim_sizes,path,status,num_ops,pages,time_compile,time_eval_min,time_eval_median,gflops_eval,gflops_total\n";
+  io_stream << std::setprecision( 9 );
+  for( std::size_t l_re = 0; l_re < i_results.size(); l_re++ ) {
+    Result const & l_res = i_results[l_re];
+    std::vector< std::string > const & l_args = l_res.entry.args;
+
+    io_stream << quote( l_res.entry.path_config, '"' ) << ","
+              << l_res.entry.id_line << ","
+              << l_res.type << ","
+              << quote( l_args.size() > 0 ? l_args[0] : "", '"' ) << ","
+              << quote( l_args.size() > 1 ? l_args[1] : "", '"' ) << ","
+              << quote( l_args.size() > 2 ? l_args[2] : "", '"' ) << ","
+              << quote( l_res.status, '"' ) << ","
+              << l_res.num_ops << ","
+              << l_res.pages << ","
+              << l_res.time_compile << ","
+              << l_res.time_eval_min << ","
+              << l_res.time_eval_median << ","
+              << gflops( l_res, false ) << ","
+              << gflops( l_res, true ) << "\n";
+  }
+}
+
+/**
+ * Writes the results in JSON format.
+ *
+ * @param i_settings settings of the replay.
+ * @param i_results results of the entries.
+ * @param io_stream output stream.
+ **/
+void write_json( Settings              const & i_settings,
+                 std::vector< Result > const & i_results,
+                 std::ostream                & io_stream ) {
+  io_stream << std::setprecision( 9 );
+  io_stream << "{\n";
+  io_stream << "  \"context\": {\n";
+  io_stream << "    \"num_threads\": "  << einsum_ir::basic::get_num_threads_available() << ",\n";
+  io_stream << "    \"dtype\": "        << quote( i_settings.dtype, '\\' )        << ",\n";
+  io_stream << "    \"backend\": "      << quote( i_settings.backend, '\\' )      << ",\n";
+  io_stream << "    \"reorder_dims\": " << quote( i_settings.reorder_dims, '\\' ) << ",\n";
+  io_stream << "    \"huge_pages\": "   << quote( i_settings.huge_pages, '\\' )   << ",\n";
+  io_stream << "    \"mmap_dir\": "     << quote( i_settings.mmap_dir, '\\' )     << ",\n";
+  io_stream << "    \"num_reps\": "     << i_settings.num_reps                    << ",\n";
+  io_stream << "    \"num_warmup\": "   << i_settings.num_warmup                  << "\n";
+  io_stream << "  },\n";
+  io_stream << "  \"entries\": [";
+  for( std::size_t l_re = 0; l_re < i_results.size(); l_re++ ) {
+    Result const & l_res = i_results[l_re];
+    std::vector< std::string > const & l_args = l_res.entry.args;
+
+    io_stream << ( l_re == 0 ? "\n" : ",\n" );
+    io_stream << "    {\n";
+    io_stream << "      \"config\": "           << quote( l_res.entry.path_config, '\\' )             << ",\n";
+    io_stream << "      \"line\": "             << l_res.entry.id_line                                << ",\n";
+    io_stream << "      \"type\": "             << quote( l_res.type, '\\' )                          << ",\n";
+    io_stream << "      \"expression\": "       << quote( l_args.size() > 0 ? l_args[0] : "", '\\' ) << ",\n";
+    io_stream << "      \"dim_sizes\": "        << quote( l_args.size() > 1 ? l_args[1] : "", '\\' ) << ",\n";
+    io_stream << "      \"path\": "             << quote( l_args.size() > 2 ? l_args[2] : "", '\\' ) << ",\n";
+    io_stream << "      \"status\": "           << quote( l_res.status, '\\' )                        << ",\n";
+    io_stream << "      \"num_ops\": "          << l_res.num_ops                                      << ",\n";
+    io_stream << "      \"pages\": "            << quote( l_res.pages, '\\' )                         << ",\n";
+    io_stream << "      \"time_compile\": "     << l_res.time_compile                                 << ",\n";
+    io_stream << "      \"time_eval_min\": "    << l_res.time_eval_min                                << ",\n";
+    io_stream << "      \"time_eval_median\": " << l_res.time_eval_median                             << ",\n";
+    io_stream << "      \"gflops_eval\": "      << gflops( l_res, false )                             << ",\n";
+    io_stream << "      \"gflops_total\": "     << gflops( l_res, true )                              << "\n";
+    io_stream << "    }";
+  }
+  io_stream << "\n  ]\n";
+  io_stream << "}\n";
+}
+
+/**
+ * Prints the usage of the replay.
+ **/
+void print_usage() {
+  std::cerr << "Usage:" << std::endl;
+  std::cerr << "  ./bench_samples [options] config_file [config_file ...]" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Options:" << std::endl;
+  std::cerr << "  --reps N              number of timed evaluations per entry, default: 5." << std::endl;
+  std::cerr << "  --warmup N            number of warmup evaluations per entry, default: 1." << std::endl;
+  std::cerr << "  --threads N           number of threads, default: threading backend's default." << std::endl;
+  std::cerr << "  --dtype DTYPE         FP32, FP64, BF16 or FP16, default: FP32." << std::endl;
+  std::cerr << "  --backend BACKEND     AUTO, TPP, BLAS, TBLIS, SIMD or SCALAR, sets EINSUM_IR_BACKEND." << std::endl;
+  std::cerr << "  --reorder_dims 0|1    sets EINSUM_IR_REORDER_DIMS." << std::endl;
+  std::cerr << "  --huge_pages PAGES    NONE, THP, 2M or 1G, sets EINSUM_IR_HUGE_PAGES." << std::endl;
+  std::cerr << "  --mmap DIR            backs the tensors of expressions by memory-mapped files in DIR." << std::endl;
+  std::cerr << "  --csv PATH            writes the report in CSV format to PATH." << std::endl;
+  std::cerr << "  --json PATH           writes the report in JSON format to PATH." << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Example:" << std::endl;
+  std::cerr << "  ./bench_samples --backend BLAS --csv tccg.csv samples/tccg/settings_default.cfg" << std::endl;
+}
+
+int main( int     i_argc,
+          char  * i_argv[] ) {
+  Settings l_settings;
+
+  /*
+   * parse arguments
+   */
+  for( int l_ar = 1; l_ar < i_argc; l_ar++ ) {
+    std::string l_arg( i_argv[l_ar] );
+    bool l_has_value = l_ar + 1 < i_argc;
+
+    if(      l_arg == "--reps"         && l_has_value ) l_settings.num_reps     = std::atoll( i_argv[++l_ar] );
+    else if( l_arg == "--warmup"       && l_has_value ) l_settings.num_warmup   = std::atoll( i_argv[++l_ar] );
+    else if( l_arg == "--threads"      && l_has_value ) l_settings.num_threads  = std::atoll( i_argv[++l_ar] );
+    else if( l_arg == "--dtype"        && l_has_value ) l_settings.dtype        = i_argv[++l_ar];
+    else if( l_arg == "--backend"      && l_has_value ) l_settings.backend      = i_argv[++l_ar];
+    else if( l_arg == "--reorder_dims" && l_has_value ) l_settings.reorder_dims = i_argv[++l_ar];
+    else if( l_arg == "--huge_pages"   && l_has_value ) l_settings.huge_pages   = i_argv[++l_ar];
+    else if( l_arg == "--mmap"         && l_has_value ) l_settings.mmap_dir     = i_argv[++l_ar];
+    else if( l_arg == "--csv"          && l_has_value ) l_settings.path_csv     = i_argv[++l_ar];
+    else if( l_arg == "--json"         && l_has_value ) l_settings.path_json    = i_argv[++l_ar];
+    else if( l_arg.compare( 0, 2, "--" ) != 0 ) {
+      l_settings.paths_config.push_back( l_arg );
+    }
+    else {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  einsum_ir::data_t l_dtype = einsum_ir::UNDEFINED_DTYPE;
+  einsum_ir::frontend::EinsumExpressionAscii::parse_dtype( l_settings.dtype,
+                                                           l_dtype );
+  if(    l_settings.paths_config.size() == 0
+      || l_settings.num_reps < 1
+      || l_settings.num_warmup < 0
+      || l_settings.num_threads < 0
+      || (    l_dtype != einsum_ir::FP32
+           && l_dtype != einsum_ir::FP64
+           && l_dtype != einsum_ir::BF16
+           && l_dtype != einsum_ir::FP16 ) ) {
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  /*
+   * configure the library through its environment variables, before the first contraction is set up
+   */
+  if( l_settings.backend != "" ) {
+    setenv( "EINSUM_IR_BACKEND", l_settings.backend.c_str(), 1 );
+  }
+  if( l_settings.reorder_dims != "" ) {
+    setenv( "EINSUM_IR_REORDER_DIMS", l_settings.reorder_dims.c_str(), 1 );
+  }
+  if( l_settings.huge_pages != "" ) {
+    setenv( "EINSUM_IR_HUGE_PAGES", l_settings.huge_pages.c_str(), 1 );
+  }
+  if( l_settings.num_threads > 0 ) {
+#if defined(EINSUM_IR_USE_OPENMP)
+    omp_set_num_threads( l_settings.num_threads );
+#else
+    setenv( "EINSUM_IR_NUM_THREADS", std::to_string( l_settings.num_threads ).c_str(), 1 );
+#endif
+  }
+
+  /*
+   * parse config files
+   */
+  std::vector< Entry > l_entries;
+  for( std::size_t l_co = 0; l_co < l_settings.paths_config.size(); l_co++ ) {
+    if( !parse_config( l_settings.paths_config[l_co],
+                       l_entries ) ) {
+      std::cerr << "error: failed to read config file " << l_settings.paths_config[l_co] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "threads: " << einsum_ir::basic::get_num_threads_available() << std::endl;
+  std::cout << "dtype:   " << l_settings.dtype << std::endl;
+  std::cout << "backend: " << ( l_settings.backend != "" ? l_settings.backend : "default" ) << std::endl;
+  std::cout << "entries: " << l_entries.size() << std::endl;
+  std::cout << std::endl;
+
+  /*
+   * run entries
+   */
+  std::vector< Result > l_results;
+  int64_t l_num_failed = 0;
+  for( std::size_t l_en = 0; l_en < l_entries.size(); l_en++ ) {
+    Result l_res = run_entry( l_entries[l_en],
+                              l_settings );
+    l_results.push_back( l_res );
+
+    std::string l_expression = l_entries[l_en].args.size() > 0 ? l_entries[l_en].args[0] : "";
+    if( l_expression.size() > 40 ) {
+      l_expression = l_expression.substr( 0, 37 ) + "...";
+    }
+
+    std::cout << l_entries[l_en].path_config << ":" << l_entries[l_en].id_line << " " << l_expression << std::endl;
+    if( l_res.status != "ok" ) {
+      std::cout << "  error: " << l_res.status << std::endl;
+      l_num_failed++;
+      continue;
+    }
+    std::cout << "  pages:          " << l_res.pages << std::endl;
+    std::cout << "  time (compile): " << l_res.time_compile << std::endl;
+    std::cout << "  time (eval):    " << l_res.time_eval_median << std::endl;
+    std::cout << "  gflops (eval):  " << gflops( l_res, false ) << std::endl;
+    std::cout << "  gflops (total): " << gflops( l_res, true ) << std::endl;
+  }
+
+  /*
+   * write reports
+   */
+  if( l_settings.path_csv != "" ) {
+    std::ofstream l_file( l_settings.path_csv );
+    write_csv( l_results,
+               l_file );
+    if( !l_file ) {
+      std::cerr << "error: failed to write " << l_settings.path_csv << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if( l_settings.path_json != "" ) {
+    std::ofstream l_file( l_settings.path_json );
+    write_json( l_settings,
+                l_results,
+                l_file );
+    if( !l_file ) {
+      std::cerr << "error: failed to write " << l_settings.path_json << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << std::endl;
+  std::cout << "entries failed: " << l_num_failed << "/" << l_entries.size() << std::endl;
+
+  return l_num_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
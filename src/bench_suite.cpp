@@ -0,0 +1,903 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "backend/BinaryContractionFactory.h"
+#include "backend/UnaryScalar.h"
+#ifdef PP_EINSUM_IR_HAS_LIBXSMM
+#include "backend/UnaryTpp.h"
+#endif
+#include "frontend/EinsumExpression.h"
+#include "frontend/EinsumTree.h"
+#include "frontend/EinsumTreeAscii.h"
+#include "basic/threading.h"
+
+/*
+ * Self-contained benchmark suite which does not depend on libtorch.
+ * All tensors are plain buffers with synthetic data, every benchmark reports statistics of repeated timings.
+ */
+
+/**
+ * Settings of the suite.
+ **/
+struct Settings {
+  //! number of timed samples per benchmark
+  int64_t num_reps = 20;
+  //! number of untimed warmup calls per benchmark
+  int64_t num_warmup = 3;
+  //! minimum duration of a sample in seconds, short operations are called multiple times per sample
+  double min_time_sample = 1.0E-3;
+  //! only benchmarks whose names contain the filter are executed
+  std::string filter = "";
+  //! path of the JSON output, no output if empty
+  std::string path_json = "";
+  //! datatype of the tensors
+  einsum_ir::data_t dtype = einsum_ir::FP32;
+  //! number of threads
+  int64_t num_threads = 1;
+  //! lists the benchmarks without executing them
+  bool list = false;
+};
+
+/**
+ * Statistics of the per-call times of a benchmark in seconds.
+ **/
+struct Statistics {
+  double min = 0;
+  double median = 0;
+  double p95 = 0;
+  double mean = 0;
+  double stddev = 0;
+};
+
+/**
+ * Result of a benchmark.
+ **/
+struct Result {
+  std::string name;
+  int64_t num_ops = 0;
+  int64_t num_bytes = 0;
+  int64_t num_iters = 0;
+  int64_t num_reps = 0;
+  double time_compile = 0;
+  Statistics stats;
+};
+
+/**
+ * Compiled operation of a benchmark.
+ **/
+struct Operation {
+  //! executes the operation once
+  std::function< void() > run;
+  //! number of scalar operations of a call
+  int64_t num_ops = 0;
+  //! number of bytes of the tensors accessed by a call, used if an operation does not perform arithmetic
+  int64_t num_bytes = 0;
+};
+
+/**
+ * Benchmark of the suite.
+ * The setup compiles the benchmarked operation, owns the tensors and returns the operation.
+ **/
+struct Benchmark {
+  std::string name;
+  std::function< einsum_ir::err_t( Settings const &,
+                                   Operation & ) > setup;
+};
+
+/**
+ * Parses an einsum string with single-character dimension names, e.g., "km,nk->nm".
+ * Dimension ids are assigned in the order of the first occurrence.
+ *
+ * @param i_einsum einsum string.
+ * @param i_sizes sizes of the dimensions.
+ * @param o_dim_ids will be set to the dimension ids of the tensors, the last tensor is the output.
+ * @param o_dim_sizes will be set to the sizes of the dimensions.
+ **/
+void parse_einsum( std::string                 const & i_einsum,
+                   std::map< char, int64_t >   const & i_sizes,
+                   std::vector< std::vector< int64_t > > & o_dim_ids,
+                   std::map< int64_t, int64_t >          & o_dim_sizes ) {
+  std::map< char, int64_t > l_ids;
+  o_dim_ids.clear();
+  o_dim_ids.resize( 1 );
+  o_dim_sizes.clear();
+
+  for( std::size_t l_ch = 0; l_ch < i_einsum.size(); l_ch++ ) {
+    char l_char = i_einsum[l_ch];
+    if( l_char == ',' ) {
+      o_dim_ids.resize( o_dim_ids.size() + 1 );
+    }
+    else if( l_char == '-' ) {
+      o_dim_ids.resize( o_dim_ids.size() + 1 );
+      l_ch++;
+    }
+    else {
+      if( l_ids.count( l_char ) == 0 ) {
+        int64_t l_id = l_ids.size();
+        l_ids[l_char] = l_id;
+        o_dim_sizes[l_id] = i_sizes.at( l_char );
+      }
+      o_dim_ids.back().push_back( l_ids[l_char] );
+    }
+  }
+}
+
+/**
+ * Gets the number of elements of a tensor.
+ *
+ * @param i_dim_ids dimension ids of the tensor.
+ * @param i_dim_sizes sizes of the dimensions.
+ * @return number of elements.
+ **/
+int64_t num_elements( std::vector< int64_t >       const & i_dim_ids,
+                      std::map< int64_t, int64_t > const & i_dim_sizes ) {
+  int64_t l_num = 1;
+  for( std::size_t l_di = 0; l_di < i_dim_ids.size(); l_di++ ) {
+    l_num *= i_dim_sizes.at( i_dim_ids[l_di] );
+  }
+  return l_num;
+}
+
+/**
+ * Allocates a tensor and initializes it with deterministic values in [-1, 1).
+ *
+ * @param i_dtype datatype of the tensor.
+ * @param i_num_elements number of elements.
+ * @param i_seed seed of the values.
+ * @return tensor.
+ **/
+std::vector< char > create_tensor( einsum_ir::data_t i_dtype,
+                                   int64_t           i_num_elements,
+                                   uint64_t          i_seed ) {
+  std::vector< char > l_data( i_num_elements * einsum_ir::ce_n_bytes( i_dtype ) );
+
+  uint64_t l_state = i_seed * 6364136223846793005ull + 1442695040888963407ull;
+  for( int64_t l_en = 0; l_en < i_num_elements; l_en++ ) {
+    l_state = l_state * 6364136223846793005ull + 1442695040888963407ull;
+    double l_val = ( l_state >> 11 ) * ( 2.0 / 9007199254740992.0 ) - 1.0;
+
+    if( i_dtype == einsum_ir::FP64 ) {
+      ( (double *) l_data.data() )[l_en] = l_val;
+    }
+    else {
+      ( (float *) l_data.data() )[l_en] = (float) l_val;
+    }
+  }
+
+  return l_data;
+}
+
+/**
+ * Creates a benchmark of a binary contraction.
+ *
+ * @param i_name name of the benchmark.
+ * @param i_einsum einsum string of the contraction.
+ * @param i_sizes sizes of the dimensions.
+ * @param i_backend backend of the contraction.
+ * @return benchmark.
+ **/
+Benchmark binary( std::string               const & i_name,
+                  std::string               const & i_einsum,
+                  std::map< char, int64_t > const & i_sizes,
+                  einsum_ir::backend_t              i_backend ) {
+  Benchmark l_bench;
+  l_bench.name = i_name;
+  l_bench.setup = [i_einsum, i_sizes, i_backend]( Settings  const & i_settings,
+                                                  Operation       & o_op ) {
+    struct State {
+      std::vector< std::vector< int64_t > > dim_ids;
+      std::map< int64_t, int64_t > dim_sizes;
+      std::vector< char > left;
+      std::vector< char > right;
+      std::vector< char > out;
+      std::unique_ptr< einsum_ir::backend::BinaryContraction > bin_cont;
+    };
+    std::shared_ptr< State > l_state = std::make_shared< State >();
+
+    parse_einsum( i_einsum,
+                  i_sizes,
+                  l_state->dim_ids,
+                  l_state->dim_sizes );
+    if( l_state->dim_ids.size() != 3 ) {
+      return einsum_ir::err_t::INVALID_ID;
+    }
+
+    l_state->left  = create_tensor( i_settings.dtype, num_elements( l_state->dim_ids[0], l_state->dim_sizes ), 1 );
+    l_state->right = create_tensor( i_settings.dtype, num_elements( l_state->dim_ids[1], l_state->dim_sizes ), 2 );
+    l_state->out   = create_tensor( i_settings.dtype, num_elements( l_state->dim_ids[2], l_state->dim_sizes ), 3 );
+
+    l_state->bin_cont.reset( einsum_ir::backend::BinaryContractionFactory::create( i_backend ) );
+    if( l_state->bin_cont == nullptr ) {
+      return einsum_ir::err_t::COMPILATION_FAILED;
+    }
+    l_state->bin_cont->init( l_state->dim_ids[0].size(),
+                             l_state->dim_ids[1].size(),
+                             l_state->dim_ids[2].size(),
+                             &l_state->dim_sizes,
+                             &l_state->dim_sizes,
+                             &l_state->dim_sizes,
+                             nullptr,
+                             &l_state->dim_sizes,
+                             l_state->dim_ids[0].data(),
+                             l_state->dim_ids[1].data(),
+                             l_state->dim_ids[2].data(),
+                             i_settings.dtype,
+                             i_settings.dtype,
+                             i_settings.dtype,
+                             i_settings.dtype,
+                             einsum_ir::kernel_t::ZERO,
+                             einsum_ir::kernel_t::MADD,
+                             einsum_ir::kernel_t::UNDEFINED_KTYPE,
+                             i_settings.num_threads );
+    einsum_ir::err_t l_err = l_state->bin_cont->compile();
+    if( l_err != einsum_ir::err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    o_op.num_ops = 2;
+    for( std::map< int64_t, int64_t >::iterator l_di = l_state->dim_sizes.begin(); l_di != l_state->dim_sizes.end(); l_di++ ) {
+      o_op.num_ops *= l_di->second;
+    }
+    o_op.num_bytes = l_state->left.size() + l_state->right.size() + l_state->out.size();
+    o_op.run = [l_state]() {
+      l_state->bin_cont->contract( l_state->left.data(),
+                                   l_state->right.data(),
+                                   l_state->out.data() );
+    };
+
+    return einsum_ir::err_t::SUCCESS;
+  };
+
+  return l_bench;
+}
+
+/**
+ * Creates a benchmark of a unary operation, i.e., a permutation of a tensor.
+ *
+ * @param i_name name of the benchmark.
+ * @param i_einsum einsum string of the permutation.
+ * @param i_sizes sizes of the dimensions.
+ * @return benchmark.
+ **/
+Benchmark unary( std::string               const & i_name,
+                 std::string               const & i_einsum,
+                 std::map< char, int64_t > const & i_sizes ) {
+  Benchmark l_bench;
+  l_bench.name = i_name;
+  l_bench.setup = [i_einsum, i_sizes]( Settings  const & i_settings,
+                                       Operation       & o_op ) {
+    struct State {
+      std::vector< std::vector< int64_t > > dim_ids;
+      std::map< int64_t, int64_t > dim_sizes;
+      std::vector< char > in;
+      std::vector< char > out;
+      std::unique_ptr< einsum_ir::backend::Unary > unary;
+    };
+    std::shared_ptr< State > l_state = std::make_shared< State >();
+
+    parse_einsum( i_einsum,
+                  i_sizes,
+                  l_state->dim_ids,
+                  l_state->dim_sizes );
+    if( l_state->dim_ids.size() != 2 ) {
+      return einsum_ir::err_t::INVALID_ID;
+    }
+
+    l_state->in  = create_tensor( i_settings.dtype, num_elements( l_state->dim_ids[0], l_state->dim_sizes ), 1 );
+    l_state->out = create_tensor( i_settings.dtype, num_elements( l_state->dim_ids[1], l_state->dim_sizes ), 2 );
+
+#ifdef PP_EINSUM_IR_HAS_LIBXSMM
+    l_state->unary.reset( new einsum_ir::backend::UnaryTpp() );
+#else
+    l_state->unary.reset( new einsum_ir::backend::UnaryScalar() );
+#endif
+    l_state->unary->init( l_state->dim_ids[0].size(),
+                          &l_state->dim_sizes,
+                          l_state->dim_ids[0].data(),
+                          l_state->dim_ids[1].data(),
+                          i_settings.dtype,
+                          i_settings.dtype,
+                          i_settings.dtype,
+                          einsum_ir::kernel_t::COPY,
+                          i_settings.num_threads );
+    einsum_ir::err_t l_err = l_state->unary->compile();
+    if( l_err != einsum_ir::err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    o_op.num_ops = 0;
+    o_op.num_bytes = l_state->in.size() + l_state->out.size();
+    o_op.run = [l_state]() {
+      l_state->unary->eval( l_state->in.data(),
+                            l_state->out.data() );
+    };
+
+    return einsum_ir::err_t::SUCCESS;
+  };
+
+  return l_bench;
+}
+
+/**
+ * Creates a benchmark of an einsum tree.
+ *
+ * @param i_name name of the benchmark.
+ * @param i_tree einsum tree, e.g., "[[3,0]->[0,3]],[[3,2,4],[1,4,2]->[1,2,3]]->[0,1,2]".
+ * @param i_sizes sizes of the dimensions in ascending order of the dimension ids.
+ * @return benchmark.
+ **/
+Benchmark tree( std::string const & i_name,
+                std::string const & i_tree,
+                std::string const & i_sizes ) {
+  Benchmark l_bench;
+  l_bench.name = i_name;
+  l_bench.setup = [i_tree, i_sizes]( Settings  const & i_settings,
+                                     Operation       & o_op ) {
+    struct State {
+      std::vector< std::vector< int64_t > > dim_ids;
+      std::vector< std::vector< int64_t > > children;
+      std::map< int64_t, int64_t > dim_sizes;
+      std::vector< std::vector< char > > data;
+      std::vector< void * > data_ptrs;
+      einsum_ir::frontend::EinsumTree tree;
+    };
+    std::shared_ptr< State > l_state = std::make_shared< State >();
+
+    int64_t l_num_nodes = einsum_ir::frontend::EinsumTreeAscii::count_nodes( i_tree );
+    l_state->dim_ids.resize( l_num_nodes );
+    l_state->children.resize( l_num_nodes );
+
+    int64_t l_analyzed_nodes = 0;
+    einsum_ir::err_t l_err = einsum_ir::frontend::EinsumTreeAscii::parse_tree( i_tree,
+                                                                              l_state->dim_ids,
+                                                                              l_state->children,
+                                                                              l_analyzed_nodes );
+    if( l_err != einsum_ir::err_t::SUCCESS || l_analyzed_nodes != l_num_nodes ) {
+      return einsum_ir::err_t::INVALID_ID;
+    }
+    einsum_ir::frontend::EinsumTreeAscii::parse_dim_size( i_sizes,
+                                                          l_state->dim_ids,
+                                                          l_state->dim_sizes );
+
+    // leaves and the root are external tensors
+    l_state->data.resize( l_num_nodes );
+    for( int64_t l_no = 0; l_no < l_num_nodes; l_no++ ) {
+      if( l_state->children[l_no].size() == 0 || l_no == l_num_nodes - 1 ) {
+        l_state->data[l_no] = create_tensor( i_settings.dtype,
+                                             num_elements( l_state->dim_ids[l_no], l_state->dim_sizes ),
+                                             l_no );
+        l_state->data_ptrs.push_back( l_state->data[l_no].data() );
+      }
+      else {
+        l_state->data_ptrs.push_back( nullptr );
+      }
+    }
+
+    l_state->tree.init( &l_state->dim_ids,
+                        &l_state->children,
+                        &l_state->dim_sizes,
+                        i_settings.dtype,
+                        l_state->data_ptrs.data() );
+    l_err = l_state->tree.compile();
+    if( l_err != einsum_ir::err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    o_op.num_ops = l_state->tree.num_ops();
+    o_op.run = [l_state]() {
+      l_state->tree.eval();
+    };
+
+    return einsum_ir::err_t::SUCCESS;
+  };
+
+  return l_bench;
+}
+
+/**
+ * Creates a benchmark of an einsum expression whose contraction path is derived by einsum_ir.
+ *
+ * @param i_name name of the benchmark.
+ * @param i_einsum einsum string of the expression.
+ * @param i_sizes sizes of the dimensions.
+ * @return benchmark.
+ **/
+Benchmark expression( std::string               const & i_name,
+                      std::string               const & i_einsum,
+                      std::map< char, int64_t > const & i_sizes ) {
+  Benchmark l_bench;
+  l_bench.name = i_name;
+  l_bench.setup = [i_einsum, i_sizes]( Settings  const & i_settings,
+                                       Operation       & o_op ) {
+    struct State {
+      std::vector< int64_t > dim_sizes;
+      std::vector< int64_t > string_num_dims;
+      std::vector< int64_t > string_dim_ids;
+      std::vector< std::vector< char > > data;
+      std::vector< void * > data_ptrs;
+      einsum_ir::frontend::EinsumExpression expression;
+    };
+    std::shared_ptr< State > l_state = std::make_shared< State >();
+
+    std::vector< std::vector< int64_t > > l_dim_ids;
+    std::map< int64_t, int64_t > l_dim_sizes;
+    parse_einsum( i_einsum,
+                  i_sizes,
+                  l_dim_ids,
+                  l_dim_sizes );
+
+    for( std::map< int64_t, int64_t >::iterator l_di = l_dim_sizes.begin(); l_di != l_dim_sizes.end(); l_di++ ) {
+      l_state->dim_sizes.push_back( l_di->second );
+    }
+    for( std::size_t l_te = 0; l_te < l_dim_ids.size(); l_te++ ) {
+      l_state->string_num_dims.push_back( l_dim_ids[l_te].size() );
+      l_state->string_dim_ids.insert( l_state->string_dim_ids.end(),
+                                      l_dim_ids[l_te].begin(),
+                                      l_dim_ids[l_te].end() );
+      l_state->data.push_back( create_tensor( i_settings.dtype,
+                                              num_elements( l_dim_ids[l_te], l_dim_sizes ),
+                                              l_te ) );
+      l_state->data_ptrs.push_back( l_state->data.back().data() );
+    }
+
+    l_state->expression.init( l_state->dim_sizes.size(),
+                              l_state->dim_sizes.data(),
+                              l_dim_ids.size() - 2,
+                              l_state->string_num_dims.data(),
+                              l_state->string_dim_ids.data(),
+                              nullptr,
+                              i_settings.dtype,
+                              l_state->data_ptrs.data() );
+    einsum_ir::err_t l_err = l_state->expression.compile();
+    if( l_err != einsum_ir::err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    o_op.num_ops = l_state->expression.num_ops();
+    o_op.run = [l_state]() {
+      l_state->expression.eval();
+    };
+
+    return einsum_ir::err_t::SUCCESS;
+  };
+
+  return l_bench;
+}
+
+/**
+ * Gets the name of a backend.
+ *
+ * @param i_backend backend.
+ * @return name of the backend.
+ **/
+std::string backend_name( einsum_ir::backend_t i_backend ) {
+  if(      i_backend == einsum_ir::backend_t::SCALAR ) return "scalar";
+  else if( i_backend == einsum_ir::backend_t::TPP    ) return "tpp";
+  else if( i_backend == einsum_ir::backend_t::BLAS   ) return "blas";
+  else if( i_backend == einsum_ir::backend_t::TBLIS  ) return "tblis";
+  else if( i_backend == einsum_ir::backend_t::SIMD   ) return "simd";
+  return "undefined";
+}
+
+/**
+ * Creates the benchmarks of the suite.
+ *
+ * @return benchmarks.
+ **/
+std::vector< Benchmark > create_benchmarks() {
+  std::vector< Benchmark > l_benchs;
+
+  /*
+   * binary contractions: GEMMs, batched GEMMs and TCCG-like contractions with permuted dimensions
+   */
+  struct BinaryCase {
+    std::string name;
+    std::string einsum;
+    std::map< char, int64_t > sizes;
+  };
+  std::vector< BinaryCase > l_binary_cases = {
+    { "gemm_64",         "km,nk->nm",         { {'m',   64}, {'n',   64}, {'k',   64} } },
+    { "gemm_512",        "km,nk->nm",         { {'m',  512}, {'n',  512}, {'k',  512} } },
+    { "gemm_tall_skinny","km,nk->nm",         { {'m', 8192}, {'n',   16}, {'k',  128} } },
+    { "gemm_trans_a",    "mk,nk->nm",         { {'m',  256}, {'n',  256}, {'k',  256} } },
+    { "batched_gemm",    "ckm,cnk->cnm",      { {'c',  256}, {'m',   32}, {'n',   32}, {'k',   32} } },
+    { "tccg_abcd",       "dbea,ec->abcd",     { {'a',   48}, {'b',   32}, {'c',   48}, {'d',   32}, {'e',   48} } },
+    { "tccg_abcde",      "efbad,cf->abcde",   { {'a',   24}, {'b',   16}, {'c',   32}, {'d',   16}, {'e',   24}, {'f',   32} } },
+    { "tccg_abcdef",     "dfgb,geac->abcdef", { {'a',   16}, {'b',   12}, {'c',   16}, {'d',   12}, {'e',   16}, {'f',   12}, {'g',   24} } }
+  };
+
+  std::vector< einsum_ir::backend_t > l_backends = { einsum_ir::backend_t::TPP,
+                                                     einsum_ir::backend_t::BLAS,
+                                                     einsum_ir::backend_t::SIMD };
+  for( std::size_t l_ca = 0; l_ca < l_binary_cases.size(); l_ca++ ) {
+    for( std::size_t l_ba = 0; l_ba < l_backends.size(); l_ba++ ) {
+      if( !einsum_ir::backend::BinaryContractionFactory::supports( l_backends[l_ba] ) ) {
+        continue;
+      }
+      l_benchs.push_back( binary( "binary/" + l_binary_cases[l_ca].name + "/" + backend_name( l_backends[l_ba] ),
+                                  l_binary_cases[l_ca].einsum,
+                                  l_binary_cases[l_ca].sizes,
+                                  l_backends[l_ba] ) );
+    }
+  }
+
+  /*
+   * unary operations: copies and permutations
+   */
+  l_benchs.push_back( unary( "unary/copy_2d",      "ab->ab",     { {'a', 2048}, {'b', 2048} } ) );
+  l_benchs.push_back( unary( "unary/transpose_2d", "ab->ba",     { {'a', 2048}, {'b', 2048} } ) );
+  l_benchs.push_back( unary( "unary/permute_4d",   "abcd->dbca", { {'a',   48}, {'b',   32}, {'c',   48}, {'d',   32} } ) );
+  l_benchs.push_back( unary( "unary/permute_6d",   "abcdef->fedcba", { {'a', 12}, {'b', 8}, {'c', 12}, {'d', 8}, {'e', 12}, {'f', 8} } ) );
+
+  /*
+   * einsum trees: tensor networks with fixed contraction orders
+   */
+  l_benchs.push_back( tree( "tree/permute_contract",
+                            "[[3,0]->[0,3]],[[3,2,4],[1,4,2]->[1,2,3]]->[0,1,2]",
+                            "64,64,32,64,32" ) );
+  l_benchs.push_back( tree( "tree/chain_3",
+                            "[[0,1],[1,2]->[0,2]],[2,3]->[0,3]",
+                            "256,256,256,256" ) );
+  l_benchs.push_back( tree( "tree/mps_contraction",
+                            "[[[0,1,2],[2,3,4]->[0,1,3,4]],[4,5,6]->[0,1,3,5,6]],[6,7,0]->[1,3,5,7]",
+                            "16,4,32,4,32,4,16,4" ) );
+
+  /*
+   * einsum expressions: contraction paths derived by einsum_ir
+   */
+  l_benchs.push_back( expression( "expression/tucker",
+                                  "iae,bf,dcba,cg,dh->hgfei",
+                                  { {'a', 32}, {'b', 8}, {'c', 4}, {'d', 2}, {'e', 16}, {'f', 64}, {'g', 8}, {'h', 8}, {'i', 8} } ) );
+  l_benchs.push_back( expression( "expression/chain_4",
+                                  "ab,bc,cd,de->ae",
+                                  { {'a', 256}, {'b', 64}, {'c', 256}, {'d', 64}, {'e', 256} } ) );
+  l_benchs.push_back( expression( "expression/tensor_ring",
+                                  "iaj,jbk,kcl,ldi->abcd",
+                                  { {'a', 16}, {'b', 16}, {'c', 16}, {'d', 16}, {'i', 12}, {'j', 12}, {'k', 12}, {'l', 12} } ) );
+
+  return l_benchs;
+}
+
+/**
+ * Derives the statistics of timed samples.
+ *
+ * @param i_samples per-call times of the samples in seconds.
+ * @return statistics.
+ **/
+Statistics statistics( std::vector< double > i_samples ) {
+  Statistics l_stats;
+  if( i_samples.size() == 0 ) {
+    return l_stats;
+  }
+
+  std::sort( i_samples.begin(), i_samples.end() );
+  std::size_t l_num = i_samples.size();
+
+  l_stats.min = i_samples[0];
+  l_stats.median = ( l_num % 2 == 1 ) ? i_samples[l_num / 2]
+                                      : 0.5 * ( i_samples[l_num / 2 - 1] + i_samples[l_num / 2] );
+  // nearest-rank percentile
+  std::size_t l_id_p95 = (std::size_t) std::ceil( 0.95 * l_num ) - 1;
+  l_stats.p95 = i_samples[l_id_p95];
+
+  for( std::size_t l_sa = 0; l_sa < l_num; l_sa++ ) {
+    l_stats.mean += i_samples[l_sa];
+  }
+  l_stats.mean /= l_num;
+
+  for( std::size_t l_sa = 0; l_sa < l_num; l_sa++ ) {
+    l_stats.stddev += ( i_samples[l_sa] - l_stats.mean ) * ( i_samples[l_sa] - l_stats.mean );
+  }
+  l_stats.stddev = l_num > 1 ? std::sqrt( l_stats.stddev / ( l_num - 1 ) ) : 0;
+
+  return l_stats;
+}
+
+/**
+ * Runs a benchmark.
+ * The warmup calls calibrate the number of calls per sample such that a sample takes at least the minimum sample time.
+ *
+ * @param i_bench benchmark.
+ * @param i_settings settings of the suite.
+ * @param o_result will be set to the result.
+ * @return SUCCESS if successful, error code of the setup otherwise.
+ **/
+einsum_ir::err_t run_benchmark( Benchmark const & i_bench,
+                                Settings  const & i_settings,
+                                Result          & o_result ) {
+  std::chrono::steady_clock::time_point l_tp0, l_tp1;
+  std::chrono::duration< double > l_dur;
+
+  o_result = Result();
+  o_result.name = i_bench.name;
+
+  Operation l_op;
+  l_tp0 = std::chrono::steady_clock::now();
+  einsum_ir::err_t l_err = i_bench.setup( i_settings,
+                                          l_op );
+  l_tp1 = std::chrono::steady_clock::now();
+  if( l_err != einsum_ir::err_t::SUCCESS ) {
+    return l_err;
+  }
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 );
+  o_result.time_compile = l_dur.count();
+  o_result.num_ops = l_op.num_ops;
+  o_result.num_bytes = l_op.num_bytes;
+
+  // warmup, the fastest call calibrates the number of calls per sample
+  double l_time_call = 0;
+  for( int64_t l_wa = 0; l_wa < std::max( i_settings.num_warmup, (int64_t) 1 ); l_wa++ ) {
+    l_tp0 = std::chrono::steady_clock::now();
+    l_op.run();
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 );
+    l_time_call = ( l_wa == 0 ) ? l_dur.count() : std::min( l_time_call, l_dur.count() );
+  }
+  o_result.num_iters = std::max( (int64_t) 1,
+                                 (int64_t) std::ceil( i_settings.min_time_sample / std::max( l_time_call, 1.0E-9 ) ) );
+  o_result.num_reps = i_settings.num_reps;
+
+  std::vector< double > l_samples;
+  for( int64_t l_re = 0; l_re < i_settings.num_reps; l_re++ ) {
+    l_tp0 = std::chrono::steady_clock::now();
+    for( int64_t l_it = 0; l_it < o_result.num_iters; l_it++ ) {
+      l_op.run();
+    }
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 );
+    l_samples.push_back( l_dur.count() / o_result.num_iters );
+  }
+  o_result.stats = statistics( l_samples );
+
+  return einsum_ir::err_t::SUCCESS;
+}
+
+/**
+ * Gets the name of the threading backend.
+ *
+ * @return name of the threading backend.
+ **/
+std::string threading_name() {
+#if defined(EINSUM_IR_USE_DISPATCH)
+  return "dispatch";
+#elif defined(EINSUM_IR_USE_OPENMP)
+  return "omp";
+#elif defined(EINSUM_IR_USE_POOL)
+  return "pool";
+#else
+  return "none";
+#endif
+}
+
+/**
+ * Escapes a string for the use in JSON.
+ *
+ * @param i_string string.
+ * @return escaped string including the quotes.
+ **/
+std::string json_string( std::string const & i_string ) {
+  std::string l_escaped = "\"";
+  for( std::size_t l_ch = 0; l_ch < i_string.size(); l_ch++ ) {
+    if( i_string[l_ch] == '"' || i_string[l_ch] == '\\' ) {
+      l_escaped += '\\';
+    }
+    l_escaped += i_string[l_ch];
+  }
+  return l_escaped + "\"";
+}
+
+/**
+ * Writes the results in JSON format.
+ * Times are given in seconds, the layout follows the "context" and "benchmarks" sections of Google Benchmark.
+ *
+ * @param i_settings settings of the suite.
+ * @param i_results results of the benchmarks.
+ * @param io_stream output stream.
+ **/
+void write_json( Settings              const & i_settings,
+                 std::vector< Result > const & i_results,
+                 std::ostream                & io_stream ) {
+  char l_date[64] = "";
+  std::time_t l_time = std::time( nullptr );
+  std::strftime( l_date, sizeof( l_date ), "%Y-%m-%dT%H:%M:%S", std::localtime( &l_time ) );
+
+  io_stream << std::setprecision( 9 );
+  io_stream << "{\n";
+  io_stream << "  \"context\": {\n";
+  io_stream << "    \"date\": "            << json_string( l_date )                                      << ",\n";
+  io_stream << "    \"threading\": "       << json_string( threading_name() )                            << ",\n";
+  io_stream << "    \"num_threads\": "     << i_settings.num_threads                                     << ",\n";
+  io_stream << "    \"dtype\": "           << json_string( i_settings.dtype == einsum_ir::FP64 ? "FP64" : "FP32" ) << ",\n";
+  io_stream << "    \"num_reps\": "        << i_settings.num_reps                                        << ",\n";
+  io_stream << "    \"num_warmup\": "      << i_settings.num_warmup                                      << ",\n";
+  io_stream << "    \"min_time_sample\": " << i_settings.min_time_sample                                 << "\n";
+  io_stream << "  },\n";
+  io_stream << "  \"benchmarks\": [";
+  for( std::size_t l_re = 0; l_re < i_results.size(); l_re++ ) {
+    Result const & l_res = i_results[l_re];
+    io_stream << ( l_re == 0 ? "\n" : ",\n" );
+    io_stream << "    {\n";
+    io_stream << "      \"name\": "         << json_string( l_res.name ) << ",\n";
+    io_stream << "      \"num_ops\": "      << l_res.num_ops             << ",\n";
+    io_stream << "      \"num_bytes\": "    << l_res.num_bytes           << ",\n";
+    io_stream << "      \"iterations\": "   << l_res.num_iters           << ",\n";
+    io_stream << "      \"repetitions\": "  << l_res.num_reps            << ",\n";
+    io_stream << "      \"time_compile\": " << l_res.time_compile        << ",\n";
+    io_stream << "      \"time_min\": "     << l_res.stats.min           << ",\n";
+    io_stream << "      \"time_median\": "  << l_res.stats.median        << ",\n";
+    io_stream << "      \"time_p95\": "     << l_res.stats.p95           << ",\n";
+    io_stream << "      \"time_mean\": "    << l_res.stats.mean          << ",\n";
+    io_stream << "      \"time_stddev\": "  << l_res.stats.stddev        << ",\n";
+    io_stream << "      \"gflops\": "       << 1.0E-9 * l_res.num_ops   / l_res.stats.median << ",\n";
+    io_stream << "      \"gibps\": "        << l_res.num_bytes / ( 1024.0 * 1024.0 * 1024.0 ) / l_res.stats.median << "\n";
+    io_stream << "    }";
+  }
+  io_stream << "\n  ]\n";
+  io_stream << "}\n";
+}
+
+/**
+ * Prints the usage of the suite.
+ **/
+void print_usage() {
+  std::cerr << "Usage:" << std::endl;
+  std::cerr << "  ./bench_suite [options]" << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Options:" << std::endl;
+  std::cerr << "  --filter STRING     only runs benchmarks whose names contain STRING." << std::endl;
+  std::cerr << "  --reps N            number of timed samples per benchmark, default: 20." << std::endl;
+  std::cerr << "  --warmup N          number of warmup calls per benchmark, default: 3." << std::endl;
+  std::cerr << "  --min_time SECONDS  minimum duration of a sample, default: 0.001." << std::endl;
+  std::cerr << "  --threads N         number of threads, default: number of available threads." << std::endl;
+  std::cerr << "  --dtype DTYPE       FP32 or FP64, default: FP32." << std::endl;
+  std::cerr << "  --json PATH         writes the results in JSON format to PATH." << std::endl;
+  std::cerr << "  --list              lists the benchmarks." << std::endl;
+  std::cerr << std::endl;
+  std::cerr << "Example:" << std::endl;
+  std::cerr << "  ./bench_suite --filter binary/gemm --reps 50 --json results.json" << std::endl;
+}
+
+int main( int     i_argc,
+          char  * i_argv[] ) {
+  Settings l_settings;
+  l_settings.num_threads = einsum_ir::basic::get_num_threads_available();
+
+  /*
+   * parse arguments
+   */
+  for( int l_ar = 1; l_ar < i_argc; l_ar++ ) {
+    std::string l_arg( i_argv[l_ar] );
+    bool l_has_value = l_ar + 1 < i_argc;
+
+    if( l_arg == "--list" ) {
+      l_settings.list = true;
+    }
+    else if( l_arg == "--filter" && l_has_value ) {
+      l_settings.filter = i_argv[++l_ar];
+    }
+    else if( l_arg == "--reps" && l_has_value ) {
+      l_settings.num_reps = std::atoll( i_argv[++l_ar] );
+    }
+    else if( l_arg == "--warmup" && l_has_value ) {
+      l_settings.num_warmup = std::atoll( i_argv[++l_ar] );
+    }
+    else if( l_arg == "--min_time" && l_has_value ) {
+      l_settings.min_time_sample = std::atof( i_argv[++l_ar] );
+    }
+    else if( l_arg == "--threads" && l_has_value ) {
+      l_settings.num_threads = std::atoll( i_argv[++l_ar] );
+    }
+    else if( l_arg == "--dtype" && l_has_value ) {
+      std::string l_dtype( i_argv[++l_ar] );
+      if(      l_dtype == "FP32" ) l_settings.dtype = einsum_ir::FP32;
+      else if( l_dtype == "FP64" ) l_settings.dtype = einsum_ir::FP64;
+      else {
+        print_usage();
+        return EXIT_FAILURE;
+      }
+    }
+    else if( l_arg == "--json" && l_has_value ) {
+      l_settings.path_json = i_argv[++l_ar];
+    }
+    else {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  if( l_settings.num_reps < 1 || l_settings.num_warmup < 0 || l_settings.num_threads < 1 ) {
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  /*
+   * select benchmarks
+   */
+  std::vector< Benchmark > l_benchs_all = create_benchmarks();
+  std::vector< Benchmark > l_benchs;
+  for( std::size_t l_be = 0; l_be < l_benchs_all.size(); l_be++ ) {
+    if( l_benchs_all[l_be].name.find( l_settings.filter ) != std::string::npos ) {
+      l_benchs.push_back( l_benchs_all[l_be] );
+    }
+  }
+
+  if( l_settings.list ) {
+    for( std::size_t l_be = 0; l_be < l_benchs.size(); l_be++ ) {
+      std::cout << l_benchs[l_be].name << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  std::cout << "threading backend: " << threading_name() << std::endl;
+  std::cout << "  threads:         " << l_settings.num_threads << std::endl;
+  std::cout << "  dtype:           " << ( l_settings.dtype == einsum_ir::FP64 ? "FP64" : "FP32" ) << std::endl;
+  std::cout << "  reps:            " << l_settings.num_reps << std::endl;
+  std::cout << "  warmup:          " << l_settings.num_warmup << std::endl;
+  std::cout << std::endl;
+
+  /*
+   * run benchmarks
+   */
+  std::cout << std::left  << std::setw( 36 ) << "name"
+            << std::right << std::setw( 10 ) << "iters"
+            << std::setw( 14 ) << "median (us)"
+            << std::setw( 14 ) << "p95 (us)"
+            << std::setw( 14 ) << "stddev (us)"
+            << std::setw( 12 ) << "gflops"
+            << std::setw( 12 ) << "gib/s"
+            << std::endl;
+
+  std::vector< Result > l_results;
+  int64_t l_num_failed = 0;
+  for( std::size_t l_be = 0; l_be < l_benchs.size(); l_be++ ) {
+    Result l_res;
+    einsum_ir::err_t l_err = run_benchmark( l_benchs[l_be],
+                                            l_settings,
+                                            l_res );
+    if( l_err != einsum_ir::err_t::SUCCESS ) {
+      std::cerr << "error: failed to set up " << l_benchs[l_be].name << " (error " << l_err << ")" << std::endl;
+      l_num_failed++;
+      continue;
+    }
+    l_results.push_back( l_res );
+
+    std::cout << std::left  << std::setw( 36 ) << l_res.name
+              << std::right << std::setw( 10 ) << l_res.num_iters
+              << std::fixed << std::setprecision( 2 )
+              << std::setw( 14 ) << l_res.stats.median * 1.0E6
+              << std::setw( 14 ) << l_res.stats.p95    * 1.0E6
+              << std::setw( 14 ) << l_res.stats.stddev * 1.0E6
+              << std::setw( 12 ) << 1.0E-9 * l_res.num_ops / l_res.stats.median
+              << std::setw( 12 ) << l_res.num_bytes / ( 1024.0 * 1024.0 * 1024.0 ) / l_res.stats.median
+              << std::defaultfloat
+              << std::endl;
+  }
+
+  /*
+   * write JSON output
+   */
+  if( l_settings.path_json != "" ) {
+    std::ofstream l_file( l_settings.path_json );
+    if( !l_file ) {
+      std::cerr << "error: failed to open " << l_settings.path_json << std::endl;
+      return EXIT_FAILURE;
+    }
+    write_json( l_settings,
+                l_results,
+                l_file );
+  }
+
+  return l_num_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
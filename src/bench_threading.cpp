@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "basic/threading.h"
+
+/**
+ * Measures the latency of execute_threaded calls with empty work.
+ *
+ * For every call, the time between the submission and the start of each thread id is recorded.
+ * The maximum over all thread ids is the wakeup latency of the call.
+ *
+ * @param i_num_threads number of threads used in the calls.
+ * @param i_num_reps number of measured calls.
+ * @param i_pause_us pause between consecutive calls in microseconds, allows idle workers to park.
+ * @param o_time_call average duration of a call in seconds.
+ * @param o_time_wakeup_avg average wakeup latency in seconds.
+ * @param o_time_wakeup_max maximum wakeup latency in seconds.
+ **/
+void bench_latency( int64_t   i_num_threads,
+                    int64_t   i_num_reps,
+                    int64_t   i_pause_us,
+                    double  & o_time_call,
+                    double  & o_time_wakeup_avg,
+                    double  & o_time_wakeup_max ) {
+  std::vector< std::chrono::steady_clock::time_point > l_tps_start( i_num_threads );
+  std::chrono::steady_clock::time_point l_tp0;
+  std::chrono::steady_clock::time_point l_tp1;
+  std::chrono::duration< double > l_dur;
+
+  o_time_call = 0;
+  o_time_wakeup_avg = 0;
+  o_time_wakeup_max = 0;
+
+  // warm up: creates the workers of persistent backends
+  for( int64_t l_re = 0; l_re < 10; l_re++ ) {
+    einsum_ir::basic::execute_threaded( i_num_threads, [&](int64_t l_thread_id) {
+      l_tps_start[l_thread_id] = std::chrono::steady_clock::now();
+    });
+  }
+
+  for( int64_t l_re = 0; l_re < i_num_reps; l_re++ ) {
+    if( i_pause_us > 0 ) {
+      std::this_thread::sleep_for( std::chrono::microseconds( i_pause_us ) );
+    }
+
+    l_tp0 = std::chrono::steady_clock::now();
+    einsum_ir::basic::execute_threaded( i_num_threads, [&](int64_t l_thread_id) {
+      l_tps_start[l_thread_id] = std::chrono::steady_clock::now();
+    });
+    l_tp1 = std::chrono::steady_clock::now();
+
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 );
+    o_time_call += l_dur.count();
+
+    std::chrono::steady_clock::time_point l_tp_last = *std::max_element( l_tps_start.begin(),
+                                                                         l_tps_start.end() );
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp_last - l_tp0 );
+    o_time_wakeup_avg += l_dur.count();
+    o_time_wakeup_max = std::max( o_time_wakeup_max, l_dur.count() );
+  }
+
+  o_time_call /= i_num_reps;
+  o_time_wakeup_avg /= i_num_reps;
+}
+
+int main( int     i_argc,
+          char  * i_argv[] ) {
+  int64_t l_num_threads = einsum_ir::basic::get_num_threads_available();
+  int64_t l_num_reps = 10000;
+
+  if( i_argc > 1 ) {
+    l_num_threads = std::atoll( i_argv[1] );
+  }
+  if( i_argc > 2 ) {
+    l_num_reps = std::atoll( i_argv[2] );
+  }
+  if( l_num_threads < 1 || l_num_reps < 1 ) {
+    std::cerr << "usage: bench_threading num_threads num_reps"              << std::endl;
+    std::cerr << "  num_threads defaults to the number of available threads" << std::endl;
+    std::cerr << "  num_reps defaults to 10000"                              << std::endl;
+    std::cerr << "example: ./bench_threading 8 10000"                        << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#if defined(EINSUM_IR_USE_DISPATCH)
+  std::cout << "threading backend: dispatch" << std::endl;
+#elif defined(EINSUM_IR_USE_OPENMP)
+  std::cout << "threading backend: omp" << std::endl;
+#elif defined(EINSUM_IR_USE_POOL)
+  std::cout << "threading backend: pool" << std::endl;
+#else
+  std::cout << "threading backend: none" << std::endl;
+#endif
+  std::cout << "  threads: " << l_num_threads << std::endl;
+  std::cout << "  reps:    " << l_num_reps    << std::endl;
+
+  // back-to-back calls: idle workers are expected to spin
+  // paused calls: idle workers are expected to park
+  int64_t l_pauses_us[2] = { 0, 1000 };
+  std::string l_names[2] = { "back-to-back", "paused (1ms)" };
+
+  for( int64_t l_pa = 0; l_pa < 2; l_pa++ ) {
+    int64_t l_num_reps_pa = l_pauses_us[l_pa] > 0 ? std::max( l_num_reps / 100, (int64_t) 1 ) : l_num_reps;
+
+    double l_time_call = 0;
+    double l_time_wakeup_avg = 0;
+    double l_time_wakeup_max = 0;
+
+    bench_latency( l_num_threads,
+                   l_num_reps_pa,
+                   l_pauses_us[l_pa],
+                   l_time_call,
+                   l_time_wakeup_avg,
+                   l_time_wakeup_max );
+
+    std::cout << l_names[l_pa] << ":" << std::endl;
+    std::cout << "  time per call (us):        " << l_time_call       * 1.0E6 << std::endl;
+    std::cout << "  wakeup latency avg (us):   " << l_time_wakeup_avg * 1.0E6 << std::endl;
+    std::cout << "  wakeup latency max (us):   " << l_time_wakeup_max * 1.0E6 << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -48,6 +48,8 @@ namespace einsum_ir {
   typedef enum {
     FP32            = 0,
     FP64            = 1,
+    BF16            = 2,
+    FP16            = 3,
     UNDEFINED_DTYPE = 99
   } data_t;
 
@@ -74,6 +76,12 @@ namespace einsum_ir {
     BR_MADD         = 12,
     PACKED_MADD     = 13,
     CPX_PACKED_MADD = 14,
+    GELU            = 15,
+    SILU            = 16,
+    SIGMOID         = 17,
+    TANH            = 18,
+    SCALE           = 19,
+    EPILOGUE        = 20, // chain of element-wise operations
     UNDEFINED_KTYPE = 99
   } kernel_t;
 
@@ -83,6 +91,7 @@ namespace einsum_ir {
     TPP    = 2,
     BLAS   = 3,
     TBLIS  = 4,
+    SIMD   = 5,
     UNDEFINED_BACKEND = 99
   } backend_t;
 
@@ -100,6 +109,8 @@ namespace einsum_ir {
   constexpr basic::data_t ce_dtype_to_basic( data_t i_dtype ) {
     if(      i_dtype == FP32 ) return basic::data_t::FP32;
     else if( i_dtype == FP64 ) return basic::data_t::FP64;
+    else if( i_dtype == BF16 ) return basic::data_t::BF16;
+    else if( i_dtype == FP16 ) return basic::data_t::FP16;
     else                       return basic::data_t::UNDEFINED_DTYPE;
   }
 
@@ -116,6 +127,12 @@ namespace einsum_ir {
     else if( i_ktype == BR_MADD         ) return basic::kernel_t::BR_MADD;
     else if( i_ktype == PACKED_MADD     ) return basic::kernel_t::PACKED_MADD;
     else if( i_ktype == CPX_PACKED_MADD ) return basic::kernel_t::CPX_PACKED_MADD;
+    else if( i_ktype == GELU            ) return basic::kernel_t::GELU;
+    else if( i_ktype == SILU            ) return basic::kernel_t::SILU;
+    else if( i_ktype == SIGMOID         ) return basic::kernel_t::SIGMOID;
+    else if( i_ktype == TANH            ) return basic::kernel_t::TANH;
+    else if( i_ktype == SCALE           ) return basic::kernel_t::SCALE;
+    else if( i_ktype == EPILOGUE        ) return basic::kernel_t::EPILOGUE;
     else                                  return basic::kernel_t::UNDEFINED_KTYPE;
   }
 
@@ -129,9 +146,17 @@ namespace einsum_ir {
   constexpr int64_t ce_n_bytes( data_t i_dtype ) {
     if(      i_dtype == FP32 )  return 4;
     else if( i_dtype == FP64 )  return 8;
+    else if( i_dtype == BF16 )  return 2;
+    else if( i_dtype == FP16 )  return 2;
     else                        return -1;
   }
 
+  constexpr data_t ce_dtype_comp( data_t i_dtype ) {
+    if(    i_dtype == BF16
+        || i_dtype == FP16 ) return FP32;
+    else                     return i_dtype;
+  }
+
   constexpr bool ce_cpx_op( kernel_t i_ktype ) {
     if(    i_ktype > kernel_t::CPX_INT_LOW
         && i_ktype < kernel_t::CPX_INT_HIGH ) {
@@ -1,5 +1,10 @@
 #include "EinsumExpression.h"
+#include "PathOptimizer.h"
 #include "../basic/threading.h"
+#include "../basic/Topology.h"
+#include "../basic/binary/ContractionConfigStore.h"
+#include <algorithm>
+#include <cstring>
 #include <deque>
 #include <set>
 #include <cmath>
@@ -116,6 +121,8 @@ void einsum_ir::frontend::EinsumExpression::init( int64_t                 i_num_
   m_ctype_ext = i_ctype_ext;
   m_dtype = i_dtype;
   m_data_ptrs = i_data_ptrs;
+  m_mapped_files.clear();
+  m_data_ptrs_mapped.clear();
   m_compiled = false;
 }
 
@@ -139,6 +146,28 @@ void einsum_ir::frontend::EinsumExpression::init( int64_t                 i_num_
 }
 
 einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
+  // derive kernel types
+  kernel_t l_ktype_first_touch = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::ZERO : einsum_ir::CPX_ZERO;
+  kernel_t l_ktype_main        = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::MADD : einsum_ir::CPX_MADD;
+
+  // derive contraction path if none was given
+  if( m_path_ext == nullptr ) {
+    PathOptimizer l_path_opt;
+    l_path_opt.init( m_num_dims,
+                     m_dim_sizes,
+                     m_num_conts + 1,
+                     m_string_num_dims_ext,
+                     m_string_dim_ids_ext,
+                     l_ktype_first_touch,
+                     l_ktype_main );
+
+    err_t l_err = l_path_opt.optimize( m_path_opt );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+    m_path_ext = m_path_opt.data();
+  }
+
   // derive contraction path using unqiue tensor ids
   m_path_int.resize( m_num_conts*2 );
   unique_tensor_ids( m_num_conts,
@@ -147,8 +176,9 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
 
   // assemble dim id to sizes map
   for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
-    m_map_dim_sizes.insert( {l_di, m_dim_sizes[l_di]} );
+    m_map_dim_sizes[l_di] = m_dim_sizes[l_di];
   }
+  m_map_dim_sizes_outer = m_map_dim_sizes;
 
   // number of input tensors
   int64_t l_num_tensors_in = m_num_conts + 1;
@@ -230,6 +260,40 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
                                l_dim_ids_ext_root + m_string_num_dims_int.back() );
   l_string_offsets.push_back( m_string_dim_ids_int.size() );
 
+  // slice the expression if a batch dimension is streamed or the intermediate tensors exceed the memory budget
+  m_slice_dim_ids.clear();
+  m_slice_counts.clear();
+  m_num_slices = 1;
+  m_num_ops_slicing = 0;
+  m_slice_accumulate = false;
+  if( m_stream_dim_id >= 0 ) {
+    if(    m_stream_dim_id >= m_num_dims
+        || m_stream_chunk_size < 1
+        || m_dim_sizes[m_stream_dim_id] % m_stream_chunk_size != 0 ) {
+      return err_t::INVALID_ID;
+    }
+    if( m_ctype_ext != complex_t::REAL_ONLY ) {
+      return err_t::COMPILATION_FAILED;
+    }
+    m_map_dim_sizes[m_stream_dim_id] = m_stream_chunk_size;
+  }
+  if(    m_memory_budget > 0
+      && m_ctype_ext != complex_t::REAL_ONLY ) {
+    return err_t::COMPILATION_FAILED;
+  }
+  if( m_memory_budget > 0 || m_stream_dim_id >= 0 ) {
+    slice();
+  }
+
+  // slices of contracted dimensions are accumulated in the output tensor
+  for( std::size_t l_sd = 0; l_sd < m_slice_dim_ids.size(); l_sd++ ) {
+    if( std::find( l_dim_ids_ext_root,
+                   l_dim_ids_ext_root + m_string_num_dims_ext[l_num_tensors-1],
+                   m_slice_dim_ids[l_sd] ) == l_dim_ids_ext_root + m_string_num_dims_ext[l_num_tensors-1] ) {
+      m_slice_accumulate = true;
+    }
+  }
+
   /*
    * add nodes
    */
@@ -251,12 +315,10 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
                         m_dtype,
                         m_data_ptrs[l_te],
                         &m_memory );
+    m_nodes[l_te].m_streamed =    !m_mapped_files.empty()
+                               && m_mapped_files[l_te] != nullptr;
   }
 
-  // derive kernel types
-  kernel_t l_ktype_first_touch = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::ZERO : einsum_ir::CPX_ZERO;
-  kernel_t l_ktype_main        = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::MADD : einsum_ir::CPX_MADD;
-
   int64_t l_num_threads = einsum_ir::basic::get_num_threads_available();
 
   // add internal nodes
@@ -294,17 +356,18 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
   int64_t   l_root_num_dims = m_string_num_dims_int[l_num_tensors_in + m_num_conts - 1];
   int64_t * l_root_dim_ids_out = m_string_dim_ids_int.data() + l_string_offsets[l_num_tensors_in + m_num_conts - 1];
 
+  // a sliced root writes to a view of the output tensor
   m_nodes[l_num_tensors_in + m_num_conts - 1].init( l_root_num_dims,
                                                     l_root_dim_ids_out,
                                                     &m_map_dim_sizes,
                                                     nullptr,
-                                                    nullptr,
+                                                    (m_num_slices > 1) ? &m_map_dim_sizes_outer : nullptr,
                                                     nullptr,
                                                     nullptr,
                                                     m_dtype,
                                                     nullptr,
                                                     (m_ctype_ext != complex_t::BATCH_INNER) ? m_data_ptrs[l_num_tensors-1] : nullptr,
-                                                    l_ktype_first_touch,
+                                                    m_slice_accumulate ? kernel_t::UNDEFINED_KTYPE : l_ktype_first_touch,
                                                     l_ktype_main,
                                                     kernel_t::UNDEFINED_KTYPE,
                                                     &m_nodes[l_root_id_left],
@@ -330,12 +393,385 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
   }
 
   err_t l_err = m_nodes.back().compile();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  // persist the configurations tuned for the expression at once
+  basic::ContractionConfigStore::get_instance().flush();
+
+  // derive the slices' offsets and gather the slices which are not contiguous
+  m_num_bytes = m_memory.get_num_bytes_required();
+  int64_t l_num_slice_dims = m_slice_dim_ids.size();
+  m_slice_offsets.assign( l_num_tensors * l_num_slice_dims, 0 );
+  m_slice_gathers.clear();
+  m_slice_gathers.resize( l_num_tensors_in );
+  m_slice_buffers.clear();
+  m_slice_buffers.resize( l_num_tensors_in );
+  m_slice_buffers_next.clear();
+  m_slice_buffers_next.resize( l_num_tensors_in );
+
+  int64_t l_offset_ext = 0;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    int64_t l_num_dims = m_string_num_dims_ext[l_te];
+    int64_t const * l_dim_ids = m_string_dim_ids_ext + l_offset_ext;
+    l_offset_ext += l_num_dims;
+
+    // strides of the unsliced tensor
+    std::vector< int64_t > l_strides( l_num_dims );
+    int64_t l_stride = 1;
+    for( int64_t l_di = l_num_dims-1; l_di >= 0; l_di-- ) {
+      l_strides[l_di] = l_stride;
+      l_stride *= m_map_dim_sizes_outer.at( l_dim_ids[l_di] );
+    }
+
+    for( int64_t l_di = 0; l_di < l_num_dims; l_di++ ) {
+      for( int64_t l_sd = 0; l_sd < l_num_slice_dims; l_sd++ ) {
+        if( m_slice_dim_ids[l_sd] == l_dim_ids[l_di] ) {
+          m_slice_offsets[l_te*l_num_slice_dims + l_sd] = m_map_dim_sizes.at( l_dim_ids[l_di] ) * l_strides[l_di] * ce_n_bytes( m_dtype );
+        }
+      }
+    }
+
+    int64_t l_num_bytes_slice = 0;
+    if( l_te < l_num_tensors_in ) {
+      l_num_bytes_slice = num_bytes_slice_buffer( l_te,
+                                                  m_map_dim_sizes );
+    }
+    if( l_num_bytes_slice > 0 ) {
+      m_slice_gathers[l_te].init( l_num_dims,
+                                  &m_map_dim_sizes,
+                                  l_dim_ids,
+                                  l_dim_ids,
+                                  l_strides.data(),
+                                  nullptr,
+                                  m_dtype,
+                                  ce_dtype_comp( m_dtype ),
+                                  m_dtype,
+                                  kernel_t::COPY,
+                                  l_num_threads );
+      l_err = m_slice_gathers[l_te].compile();
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+      m_slice_buffers[l_te].resize( l_num_bytes_slice );
+      if( m_stream_dim_id >= 0 ) {
+        m_slice_buffers_next[l_te].resize( l_num_bytes_slice );
+      }
+    }
+    if( l_te < l_num_tensors_in ) {
+      m_num_bytes += m_slice_buffers[l_te].size() + m_slice_buffers_next[l_te].size();
+    }
+  }
+
+  // the estimate steers the slicing, the compiled footprint has to meet the budget
+  if(    m_memory_budget > 0
+      && m_num_bytes > m_memory_budget ) {
+    return err_t::COMPILATION_FAILED;
+  }
 
   m_compiled = true;
 
   return l_err;
 }
 
+void einsum_ir::frontend::EinsumExpression::set_memory_budget( int64_t i_num_bytes ) {
+  m_memory_budget = i_num_bytes;
+}
+
+void einsum_ir::frontend::EinsumExpression::set_stream_dim( int64_t i_dim_id,
+                                                            int64_t i_chunk_size ) {
+  m_stream_dim_id = i_dim_id;
+  m_stream_chunk_size = i_chunk_size;
+}
+
+void einsum_ir::frontend::EinsumExpression::set_memory_arena( backend::MemoryArena * i_arena ) {
+  m_memory.set_arena( i_arena );
+}
+
+void einsum_ir::frontend::EinsumExpression::bind_data_ptrs( void * const * i_data_ptrs ) {
+  int64_t l_num_tensors = m_num_conts + 2;
+
+  // the given pointers may alias the current mapped ones
+  std::vector< void * > l_data_ptrs( l_num_tensors, nullptr );
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    if( m_mapped_files[l_te] != nullptr ) {
+      l_data_ptrs[l_te] = m_mapped_files[l_te]->get_data();
+    }
+    else if( i_data_ptrs != nullptr ) {
+      l_data_ptrs[l_te] = i_data_ptrs[l_te];
+    }
+  }
+  m_data_ptrs_mapped = l_data_ptrs;
+  m_data_ptrs = m_data_ptrs_mapped.data();
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::map_tensor( int64_t             i_tensor_id,
+                                                                    std::string const & i_path ) {
+  int64_t l_num_tensors = m_num_conts + 2;
+  if( i_tensor_id < 0 || i_tensor_id >= l_num_tensors ) {
+    return err_t::INVALID_ID;
+  }
+
+  // size of the tensor
+  int64_t l_offset = 0;
+  for( int64_t l_te = 0; l_te < i_tensor_id; l_te++ ) {
+    l_offset += m_string_num_dims_ext[l_te];
+  }
+  int64_t l_num_bytes = ce_n_bytes( m_dtype );
+  for( int64_t l_di = 0; l_di < m_string_num_dims_ext[i_tensor_id]; l_di++ ) {
+    l_num_bytes *= m_dim_sizes[ m_string_dim_ids_ext[l_offset + l_di] ];
+  }
+  if( m_ctype_ext != complex_t::REAL_ONLY ) {
+    l_num_bytes *= 2;
+  }
+
+  // the output tensor is the only one which is written
+  std::unique_ptr< basic::MappedFile > l_file( new basic::MappedFile() );
+  basic::err_t l_err = l_file->map( i_path,
+                                    l_num_bytes,
+                                    i_tensor_id == l_num_tensors - 1 );
+  if( l_err != basic::err_t::SUCCESS ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  m_mapped_files.resize( l_num_tensors );
+  m_mapped_files[i_tensor_id] = std::move( l_file );
+  bind_data_ptrs( m_data_ptrs );
+  m_compiled = false;
+
+  return err_t::SUCCESS;
+}
+
+int64_t einsum_ir::frontend::EinsumExpression::derive_num_ops( std::map< int64_t, int64_t > const & i_dim_sizes,
+                                                                bool                                 i_accumulate ) const {
+  int64_t l_num_tensors_in = m_num_conts + 1;
+
+  std::vector< int64_t > l_string_offsets( m_string_num_dims_int.size() + 1, 0 );
+  for( std::size_t l_te = 0; l_te < m_string_num_dims_int.size(); l_te++ ) {
+    l_string_offsets[l_te+1] = l_string_offsets[l_te] + m_string_num_dims_int[l_te];
+  }
+
+  int64_t l_num_ops = 0;
+  for( int64_t l_co = 0; l_co < m_num_conts; l_co++ ) {
+    int64_t l_id_left  = m_path_int[l_co*2 + 0];
+    int64_t l_id_right = m_path_int[l_co*2 + 1];
+    int64_t l_id_out   = l_num_tensors_in + l_co;
+
+    l_num_ops += backend::BinaryContraction::num_ops( m_string_num_dims_int[l_id_left],
+                                                      m_string_num_dims_int[l_id_right],
+                                                      m_string_num_dims_int[l_id_out],
+                                                      m_string_dim_ids_int.data() + l_string_offsets[l_id_left],
+                                                      m_string_dim_ids_int.data() + l_string_offsets[l_id_right],
+                                                      m_string_dim_ids_int.data() + l_string_offsets[l_id_out],
+                                                      &i_dim_sizes,
+                                                      ( i_accumulate && l_co == m_num_conts-1 ) ? kernel_t::UNDEFINED_KTYPE : kernel_t::ZERO,
+                                                      kernel_t::MADD );
+  }
+
+  return l_num_ops;
+}
+
+int64_t einsum_ir::frontend::EinsumExpression::estimate_num_bytes( std::map< int64_t, int64_t > const & i_dim_sizes ) const {
+  int64_t l_num_tensors_in = m_num_conts + 1;
+  int64_t l_id_root = l_num_tensors_in + m_num_conts - 1;
+
+  // required memory of the tensors, the output tensor is written directly
+  std::vector< int64_t > l_req_mem( l_id_root + 1, 0 );
+  // unaligned sizes of the contractions' outputs
+  std::vector< int64_t > l_num_bytes_out( m_num_conts, 0 );
+  int64_t l_offset = 0;
+  for( int64_t l_te = 0; l_te <= l_id_root; l_te++ ) {
+    int64_t l_size = ce_n_bytes( m_dtype );
+    for( int64_t l_di = 0; l_di < m_string_num_dims_int[l_te]; l_di++ ) {
+      l_size *= i_dim_sizes.at( m_string_dim_ids_int[l_offset + l_di] );
+    }
+    l_offset += m_string_num_dims_int[l_te];
+
+    if( l_te >= l_num_tensors_in ) {
+      l_num_bytes_out[l_te - l_num_tensors_in] = l_size;
+    }
+
+    // magic number: cache line alignment of the memory manager
+    if( l_size % 128 != 0 ) {
+      l_size += 128 - ( l_size % 128 );
+    }
+    l_req_mem[l_te] = l_size;
+  }
+  l_req_mem[l_id_root] = 0;
+
+  // peak memory of the subtrees, follows the execution order of the einsum nodes
+  std::vector< int64_t > l_mem_subtree( l_req_mem );
+  for( int64_t l_co = 0; l_co < m_num_conts; l_co++ ) {
+    int64_t l_id_left  = m_path_int[l_co*2 + 0];
+    int64_t l_id_right = m_path_int[l_co*2 + 1];
+    int64_t l_id_out   = l_num_tensors_in + l_co;
+
+    int64_t l_max_left  = std::max( l_mem_subtree[l_id_left],  l_mem_subtree[l_id_right] + l_req_mem[l_id_left] );
+    int64_t l_max_right = std::max( l_mem_subtree[l_id_right], l_mem_subtree[l_id_left]  + l_req_mem[l_id_right] );
+
+    l_mem_subtree[l_id_out] = std::max( std::min( l_max_left, l_max_right ),
+                                        l_req_mem[l_id_out] + l_req_mem[l_id_left] + l_req_mem[l_id_right] );
+  }
+
+  // scratch of the contractions, sequentially evaluated contractions share the scratch of a thread
+  int64_t l_num_bytes_l2 = basic::Topology::get_instance().m_l2_cache_size;
+  int64_t l_num_bytes_scratch = 0;
+  for( int64_t l_co = 0; l_co < m_num_conts; l_co++ ) {
+    int64_t l_id_left  = m_path_int[l_co*2 + 0];
+    int64_t l_id_right = m_path_int[l_co*2 + 1];
+
+    int64_t l_num_bytes_thread = std::min( l_req_mem[l_id_left] + l_req_mem[l_id_right],
+                                           l_num_bytes_l2 );
+    if( m_dtype == data_t::BF16 || m_dtype == data_t::FP16 ) {
+      l_num_bytes_thread += l_num_bytes_out[l_co] / ce_n_bytes( m_dtype ) * ce_n_bytes( data_t::FP32 );
+    }
+    l_num_bytes_scratch = std::max( l_num_bytes_scratch,
+                                    l_num_bytes_thread );
+  }
+  l_num_bytes_scratch *= basic::get_num_threads_available();
+
+  // gathered slices are held during the entire evaluation
+  int64_t l_num_bytes_buffers = 0;
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    l_num_bytes_buffers += num_bytes_slice_buffer( l_te,
+                                                   i_dim_sizes );
+  }
+  if( m_stream_dim_id >= 0 ) {
+    l_num_bytes_buffers *= 2;
+  }
+
+  return l_mem_subtree[l_id_root] + l_num_bytes_scratch + l_num_bytes_buffers;
+}
+
+int64_t einsum_ir::frontend::EinsumExpression::num_bytes_slice_buffer( int64_t                              i_tensor_id,
+                                                                       std::map< int64_t, int64_t > const & i_dim_sizes ) const {
+  int64_t l_offset = 0;
+  for( int64_t l_te = 0; l_te < i_tensor_id; l_te++ ) {
+    l_offset += m_string_num_dims_ext[l_te];
+  }
+  int64_t const * l_dim_ids = m_string_dim_ids_ext + l_offset;
+
+  int64_t l_num_sliced = 0;
+  bool l_sliced_outermost = false;
+  int64_t l_num_bytes = ce_n_bytes( m_dtype );
+  for( int64_t l_di = 0; l_di < m_string_num_dims_ext[i_tensor_id]; l_di++ ) {
+    int64_t l_size = i_dim_sizes.at( l_dim_ids[l_di] );
+    l_num_bytes *= l_size;
+
+    if( l_size != m_map_dim_sizes_outer.at( l_dim_ids[l_di] ) ) {
+      l_num_sliced++;
+      l_sliced_outermost = l_sliced_outermost || (l_di == 0);
+    }
+  }
+
+  if(    l_num_sliced == 0
+      || ( l_num_sliced == 1 && l_sliced_outermost ) ) {
+    return 0;
+  }
+
+  return l_num_bytes;
+}
+
+void einsum_ir::frontend::EinsumExpression::slice() {
+  int64_t l_num_bytes = estimate_num_bytes( m_map_dim_sizes );
+  int64_t l_num_ops_unsliced = derive_num_ops( m_map_dim_sizes_outer,
+                                               false );
+  // a streamed batch dimension is sliced into its chunks upfront
+  std::vector< int64_t > l_counts( m_num_dims, 1 );
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    l_counts[l_di] = m_dim_sizes[l_di] / m_map_dim_sizes.at( l_di );
+    m_num_slices *= l_counts[l_di];
+  }
+
+  // dimensions of the output tensor
+  int64_t l_num_dims_out = m_string_num_dims_int[ 2*m_num_conts ];
+  int64_t const * l_dim_ids_out = m_string_dim_ids_int.data() + m_string_dim_ids_int.size() - l_num_dims_out;
+  std::vector< bool > l_dim_out( m_num_dims, false );
+  for( int64_t l_di = 0; l_di < l_num_dims_out; l_di++ ) {
+    l_dim_out[ l_dim_ids_out[l_di] ] = true;
+  }
+  // slices of contracted dimensions are accumulated
+  bool l_accumulate = false;
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    l_accumulate = l_accumulate || ( l_counts[l_di] > 1 && !l_dim_out[l_di] );
+  }
+
+  while(    m_memory_budget > 0
+         && l_num_bytes > m_memory_budget ) {
+    int64_t l_best_dim = -1;
+    int64_t l_best_count = 0;
+    int64_t l_best_num_ops = 0;
+    int64_t l_best_num_bytes = 0;
+
+    for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+      // the chunks of a streamed dimension keep their size
+      if( l_di == m_stream_dim_id ) {
+        continue;
+      }
+
+      // next number of slices which divides the dimension
+      int64_t l_count = l_counts[l_di] + 1;
+      while(    l_count <= m_dim_sizes[l_di]
+             && m_dim_sizes[l_di] % l_count != 0 ) {
+        l_count++;
+      }
+      if( l_count > m_dim_sizes[l_di] ) {
+        continue;
+      }
+
+      std::map< int64_t, int64_t > l_dim_sizes = m_map_dim_sizes;
+      l_dim_sizes[l_di] = m_dim_sizes[l_di] / l_count;
+
+      int64_t l_num_bytes_sliced = estimate_num_bytes( l_dim_sizes );
+      if( l_num_bytes_sliced >= l_num_bytes ) {
+        continue;
+      }
+
+      // total number of operations of all slices
+      int64_t l_num_ops = ( m_num_slices / l_counts[l_di] ) * l_count * derive_num_ops( l_dim_sizes,
+                                                                                       l_accumulate || !l_dim_out[l_di] );
+
+      if(    l_best_dim < 0
+          || l_num_ops < l_best_num_ops
+          || ( l_num_ops == l_best_num_ops && l_num_bytes_sliced < l_best_num_bytes ) ) {
+        l_best_dim = l_di;
+        l_best_count = l_count;
+        l_best_num_ops = l_num_ops;
+        l_best_num_bytes = l_num_bytes_sliced;
+      }
+    }
+
+    // no further reduction possible
+    if( l_best_dim < 0 ) {
+      break;
+    }
+
+    m_num_slices = ( m_num_slices / l_counts[l_best_dim] ) * l_best_count;
+    l_counts[l_best_dim] = l_best_count;
+    l_accumulate = l_accumulate || !l_dim_out[l_best_dim];
+    m_map_dim_sizes[l_best_dim] = m_dim_sizes[l_best_dim] / l_best_count;
+    l_num_bytes = l_best_num_bytes;
+  }
+
+  // the streamed dimension is the slowest, i.e., its chunks are evaluated one after another
+  if(    m_stream_dim_id >= 0
+      && l_counts[m_stream_dim_id] > 1 ) {
+    m_slice_dim_ids.push_back( m_stream_dim_id );
+    m_slice_counts.push_back( l_counts[m_stream_dim_id] );
+  }
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    if(    l_counts[l_di] > 1
+        && l_di != m_stream_dim_id ) {
+      m_slice_dim_ids.push_back( l_di );
+      m_slice_counts.push_back( l_counts[l_di] );
+    }
+  }
+
+  m_num_ops_slicing = m_num_slices * derive_num_ops( m_map_dim_sizes,
+                                                     l_accumulate ) - l_num_ops_unsliced;
+}
+
 einsum_ir::err_t einsum_ir::frontend::EinsumExpression::store_and_lock_data( int64_t i_tensor_id ) {
   if( m_compiled == false ) {
     return err_t::CALLED_BEFORE_COMPILATION;
@@ -344,6 +780,14 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::store_and_lock_data( int
     return err_t::INVALID_ID;
   }
 
+  // the locked data would be used for all slices
+  int64_t l_num_slice_dims = m_slice_dim_ids.size();
+  for( int64_t l_sd = 0; l_sd < l_num_slice_dims; l_sd++ ) {
+    if( m_slice_offsets[i_tensor_id*l_num_slice_dims + l_sd] != 0 ) {
+      return err_t::INVALID_ID;
+    }
+  }
+
   err_t l_err = m_nodes[i_tensor_id].store_and_lock_data();
 
   return l_err;
@@ -362,19 +806,164 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::unlock_data( int64_t i_t
   return l_err;
 }
 
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::set_data_ptrs( void * const * i_data_ptrs ) {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  // the compiled tree relies on the presence of the external data
+  int64_t l_num_tensors_in = m_num_conts + 1;
+  for( int64_t l_te = 0; l_te < l_num_tensors_in + 1; l_te++ ) {
+    bool l_mapped =    !m_mapped_files.empty()
+                    && m_mapped_files[l_te] != nullptr;
+    if( i_data_ptrs[l_te] == nullptr && !l_mapped ) {
+      return err_t::NO_DATA_PTR_PROVIDED;
+    }
+  }
+
+  m_data_ptrs = i_data_ptrs;
+  if( !m_mapped_files.empty() ) {
+    bind_data_ptrs( i_data_ptrs );
+  }
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    m_nodes[l_te].m_data_ptr_ext = m_data_ptrs[l_te];
+  }
+  m_nodes.back().m_data_ptr_ext = m_data_ptrs[l_num_tensors_in];
+
+  return err_t::SUCCESS;
+}
+
 void einsum_ir::frontend::EinsumExpression::eval() {
-  m_nodes.back().eval();
+  m_memory.checkout();
+
+  if( m_num_slices == 1 ) {
+    m_nodes.back().eval();
+    m_memory.checkin();
+    return;
+  }
+
+  int64_t l_num_tensors_in = m_num_conts + 1;
+
+  if( m_slice_accumulate ) {
+    int64_t l_num_bytes_out = m_nodes.back().m_size;
+    std::memset( m_data_ptrs[l_num_tensors_in],
+                 0,
+                 l_num_bytes_out );
+  }
+
+  // the first chunk of a stream is gathered upfront, all others overlap the contraction of their predecessor
+  bool l_stream = m_stream_dim_id >= 0;
+  if( l_stream ) {
+    gather_slice( 0,
+                  m_slice_buffers );
+  }
+
+  for( int64_t l_sl = 0; l_sl < m_num_slices; l_sl++ ) {
+    if( !l_stream ) {
+      gather_slice( l_sl,
+                    m_slice_buffers );
+    }
+
+    // point the leaves and the root to the slice
+    for( int64_t l_te = 0; l_te < l_num_tensors_in + 1; l_te++ ) {
+      char * l_data = (char *) m_data_ptrs[l_te] + slice_offset( l_te,
+                                                                 l_sl );
+
+      if( l_te == l_num_tensors_in ) {
+        m_nodes.back().m_data_ptr_ext = l_data;
+      }
+      else if( m_slice_buffers[l_te].size() > 0 ) {
+        m_nodes[l_te].m_data_ptr_ext = m_slice_buffers[l_te].data();
+      }
+      else {
+        m_nodes[l_te].m_data_ptr_ext = l_data;
+      }
+    }
+
+    if( l_stream && l_sl+1 < m_num_slices ) {
+      basic::execute_nested( 2, [&]( int64_t i_task_id ) {
+        if( i_task_id == 0 ) {
+          m_nodes.back().eval();
+        }
+        else {
+          gather_slice( l_sl+1,
+                        m_slice_buffers_next );
+        }
+      } );
+      std::swap( m_slice_buffers,
+                 m_slice_buffers_next );
+    }
+    else {
+      m_nodes.back().eval();
+    }
+  }
+
+  m_memory.checkin();
+}
+
+void einsum_ir::frontend::EinsumExpression::gather_slice( int64_t                              i_slice_id,
+                                                          std::vector< std::vector< char > > & o_buffers ) {
+  int64_t l_num_tensors_in = m_num_conts + 1;
+
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    if( o_buffers[l_te].size() > 0 ) {
+      char const * l_data = (char const *) m_data_ptrs[l_te] + slice_offset( l_te,
+                                                                             i_slice_id );
+      m_slice_gathers[l_te].eval( l_data,
+                                  o_buffers[l_te].data() );
+    }
+  }
+}
+
+int64_t einsum_ir::frontend::EinsumExpression::slice_offset( int64_t i_tensor_id,
+                                                             int64_t i_slice_id ) const {
+  int64_t l_num_slice_dims = m_slice_dim_ids.size();
+
+  // the last sliced dimension is the fastest
+  int64_t l_offset = 0;
+  int64_t l_remainder = i_slice_id;
+  for( int64_t l_sd = l_num_slice_dims-1; l_sd >= 0; l_sd-- ) {
+    l_offset += ( l_remainder % m_slice_counts[l_sd] ) * m_slice_offsets[i_tensor_id*l_num_slice_dims + l_sd];
+    l_remainder /= m_slice_counts[l_sd];
+  }
+
+  return l_offset;
 }
 
 int64_t einsum_ir::frontend::EinsumExpression::num_ops() {
   if( m_nodes.size() > 0 ) {
-    return m_nodes.back().num_ops( true );
+    return m_num_slices * m_nodes.back().num_ops( true ) - m_num_ops_slicing;
   }
   else {
     return 0;
   }
 }
 
+int64_t einsum_ir::frontend::EinsumExpression::num_slices() const {
+  return m_num_slices;
+}
+
+int64_t einsum_ir::frontend::EinsumExpression::num_ops_slicing() const {
+  return m_num_ops_slicing;
+}
+
+int64_t einsum_ir::frontend::EinsumExpression::num_bytes() const {
+  return m_num_bytes;
+}
+
+void einsum_ir::frontend::EinsumExpression::set_profiling( bool i_profiling ) {
+  if( m_nodes.size() > 0 ) {
+    m_nodes.back().set_profiling( i_profiling );
+  }
+}
+
+void einsum_ir::frontend::EinsumExpression::profile( std::vector< backend::NodeProfile > & o_profiles ) const {
+  o_profiles.clear();
+  if( m_nodes.size() > 0 ) {
+    m_nodes.back().profile( o_profiles );
+  }
+}
+
 std::string einsum_ir::frontend::EinsumExpression::to_string_render() const {
   if( m_compiled == false ) {
     return "Error: Expression not compiled.";
@@ -2,8 +2,11 @@
 #define EINSUM_IR_FRONTEND_EINSUM_EXPRESSION
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include "../backend/EinsumNode.h"
+#include "../backend/UnaryTpp.h"
+#include "../basic/MappedFile.h"
 
 namespace einsum_ir {
   namespace frontend {
@@ -52,6 +55,9 @@ class einsum_ir::frontend::EinsumExpression {
     //! tensors are assumed to be removed after every contraction
     int64_t const * m_path_ext = nullptr;
 
+    //! contraction path derived by the path optimizer if no external path was given
+    std::vector< int64_t > m_path_opt;
+
     //! internal contraction path
     //! tensors are not removed after the contraction, i.e., they have unique ids
     std::vector< int64_t > m_path_int;
@@ -76,6 +82,123 @@ class einsum_ir::frontend::EinsumExpression {
     //! true if the expression was compiled
     bool m_compiled = false;
 
+    //! budget of the memory manager in bytes, 0 if unlimited
+    int64_t m_memory_budget = 0;
+
+    //! mapping from dim ids to the unsliced sizes
+    std::map< int64_t, int64_t > m_map_dim_sizes_outer;
+
+    //! ids of the sliced dimensions
+    std::vector< int64_t > m_slice_dim_ids;
+
+    //! number of slices of the sliced dimensions
+    std::vector< int64_t > m_slice_counts;
+
+    //! total number of slices
+    int64_t m_num_slices = 1;
+
+    //! byte offsets between consecutive slices, one row per tensor and one column per sliced dimension
+    std::vector< int64_t > m_slice_offsets;
+
+    //! copy operations which gather the slices of non-contiguous input tensors
+    std::vector< backend::UnaryTpp > m_slice_gathers;
+
+    //! buffers holding the gathered slices of the input tensors, empty if not required
+    std::vector< std::vector< char > > m_slice_buffers;
+
+    //! second set of buffers into which the next chunk is gathered in streaming mode
+    std::vector< std::vector< char > > m_slice_buffers_next;
+
+    //! id of the streamed batch dimension, -1 if not streamed
+    int64_t m_stream_dim_id = -1;
+
+    //! size of the chunks of the streamed batch dimension
+    int64_t m_stream_chunk_size = 0;
+
+    //! true if the output tensor is accumulated over the slices
+    bool m_slice_accumulate = false;
+
+    //! number of additional scalar operations caused by the slicing
+    int64_t m_num_ops_slicing = 0;
+
+    //! memory footprint of the compiled expression in bytes
+    int64_t m_num_bytes = 0;
+
+    //! memory-mapped files backing the tensors, nullptr for tensors which are not mapped
+    std::vector< std::unique_ptr< basic::MappedFile > > m_mapped_files;
+
+    //! data pointers of the tensors in which mapped tensors point to their files
+    std::vector< void * > m_data_ptrs_mapped;
+
+    /**
+     * Sets the data pointers of the tensors, the pointers of mapped tensors are replaced by the mapped data.
+     *
+     * @param i_data_ptrs pointers to the tensors' data, may be nullptr if all tensors are mapped.
+     **/
+    void bind_data_ptrs( void * const * i_data_ptrs );
+
+    /**
+     * Derives the number of scalar operations of the contractions for the given dimension sizes.
+     *
+     * @param i_dim_sizes mapping from dim ids to sizes.
+     * @param i_accumulate true if the root contraction accumulates into the output tensor.
+     * @return number of scalar operations.
+     **/
+    int64_t derive_num_ops( std::map< int64_t, int64_t > const & i_dim_sizes,
+                            bool                                 i_accumulate ) const;
+
+    /**
+     * Derives the size of the buffer into which the slices of an input tensor are gathered.
+     * Slices of the outermost dimension are contiguous and used in place.
+     *
+     * @param i_tensor_id id of the input tensor.
+     * @param i_dim_sizes mapping from dim ids to the sliced sizes.
+     * @return number of bytes of the buffer, 0 if the slices are used in place.
+     **/
+    int64_t num_bytes_slice_buffer( int64_t                              i_tensor_id,
+                                    std::map< int64_t, int64_t > const & i_dim_sizes ) const;
+
+    /**
+     * Estimates the peak number of bytes of the memory manager for the given dimension sizes.
+     * The estimate follows the stack-based planning of the einsum nodes
+     * and assumes that all input tensors are permuted.
+     * The per-thread scratch of the contractions is included:
+     * packed blocks are bounded by the inputs of a contraction and the L2 cache,
+     * low-precision outputs are bounded by an FP32 copy of the contraction's output.
+     * The buffers of gathered slices are included, twice in streaming mode.
+     *
+     * @param i_dim_sizes mapping from dim ids to sizes.
+     * @return estimated number of bytes.
+     **/
+    int64_t estimate_num_bytes( std::map< int64_t, int64_t > const & i_dim_sizes ) const;
+
+    /**
+     * Chooses the sliced dimensions and their number of slices.
+     * Greedily slices the dimension with the lowest number of total operations
+     * until the estimated memory fits the budget or no slicing reduces the memory further.
+     * Starts from the chunks of a streamed batch dimension which are not sliced further.
+     **/
+    void slice();
+
+    /**
+     * Gathers the non-contiguous input tensors of a slice.
+     *
+     * @param i_slice_id id of the slice.
+     * @param o_buffers buffers into which the slice is gathered, one per input tensor.
+     **/
+    void gather_slice( int64_t                              i_slice_id,
+                       std::vector< std::vector< char > > & o_buffers );
+
+    /**
+     * Derives the byte offset of a slice in a tensor.
+     *
+     * @param i_tensor_id id of the tensor.
+     * @param i_slice_id id of the slice.
+     * @return offset in bytes.
+     **/
+    int64_t slice_offset( int64_t i_tensor_id,
+                          int64_t i_slice_id ) const;
+
     /**
      * Derives a histogram showing how often the dimensions appear in the einsum string.
      *
@@ -140,7 +263,7 @@ class einsum_ir::frontend::EinsumExpression {
      * @param i_num_conts number of binary contractions.
      * @param i_string_num_ids sizes of the substrings describing the input tensors and output tensor.
      * @param i_string_dim_ids einsum string containing the dimension ids.
-     * @param i_path contraction path.
+     * @param i_path contraction path. optional: use nullptr to derive the path in the compilation.
      * @param i_ctype complex type of all tensors.
      * @param i_dtype datatype of all tensors.
      * @param i_data_ptr pointers to the tensor's data.
@@ -163,7 +286,7 @@ class einsum_ir::frontend::EinsumExpression {
      * @param i_num_conts number of binary contractions.
      * @param i_string_num_ids sizes of the substrings describing the input tensors and output tensor.
      * @param i_string_dim_ids einsum string containing the dimension ids.
-     * @param i_path contraction path.
+     * @param i_path contraction path. optional: use nullptr to derive the path in the compilation.
      * @param i_dtype datatype of all tensors.
      * @param i_data_ptr pointers to the tensor's data.
      **/
@@ -176,6 +299,60 @@ class einsum_ir::frontend::EinsumExpression {
                data_t                  i_dtype,
                void          * const * i_data_ptrs );
 
+    /**
+     * Sets the budget of the memory manager.
+     * If the intermediate tensors exceed the budget, the expression is sliced:
+     * The compiled tree operates on slices of the sliced dimensions and is evaluated once per slice.
+     * Slices of contracted dimensions are accumulated into the output tensor.
+     * The budget covers the intermediate tensors, the scratch memory of the contractions and the buffers of gathered slices.
+     * If the compiled expression exceeds the budget, the compilation fails.
+     * Slicing is only supported for real-valued expressions, the compilation of complex expressions with a budget fails.
+     * Has to be called before compilation.
+     *
+     * @param i_num_bytes budget in bytes, 0 disables the slicing.
+     **/
+    void set_memory_budget( int64_t i_num_bytes );
+
+    /**
+     * Streams the expression over a batch dimension.
+     * The expression is compiled once for a chunk of the dimension and evaluated chunk by chunk,
+     * i.e., the intermediate tensors and a shared arena are sized for a single chunk.
+     * Chunks of input tensors which have to be gathered are double-buffered:
+     * The gather of chunk i+1 overlaps the contraction of chunk i.
+     * Streaming is combined with a memory budget by slicing the remaining dimensions.
+     * Streaming is only supported for real-valued expressions.
+     * Has to be called before compilation.
+     *
+     * @param i_dim_id id of the batch dimension, -1 disables the streaming.
+     * @param i_chunk_size size of a chunk, has to divide the size of the dimension.
+     **/
+    void set_stream_dim( int64_t i_dim_id,
+                         int64_t i_chunk_size );
+
+    /**
+     * Attaches a memory arena which is shared with other compiled einsum trees or expressions.
+     * The intermediate data is borrowed from the arena during every evaluation instead of being owned.
+     * Has to be called before compilation, the arena has to outlive the expression.
+     *
+     * @param i_arena memory arena, nullptr to own the intermediate data.
+     **/
+    void set_memory_arena( backend::MemoryArena * i_arena );
+
+    /**
+     * Backs a tensor by a memory-mapped file.
+     * Input tensors are mapped read-only, the file has to hold the tensor's data.
+     * Contractions reading a mapped input in place traverse it in storage order and prefetch its next tiles.
+     * The output tensor is written to the file directly, the file is created or resized if required.
+     * The provided data pointer of a mapped tensor is ignored.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_tensor_id id of the tensor in the einsum string.
+     * @param i_path path of the file.
+     * @return SUCCESS if the file was mapped, error code otherwise.
+     **/
+    err_t map_tensor( int64_t             i_tensor_id,
+                      std::string const & i_path );
+
     /**
      * Compiles the einsum expression. 
      **/
@@ -184,6 +361,7 @@ class einsum_ir::frontend::EinsumExpression {
     /**
      * Stores the data of the given tensor internally and locks it.
      * In following execution the stored data is used.
+     * Sliced tensors cannot be locked.
      *
      * @param i_tensor_id id of the the tensor in the einsum string.
      **/
@@ -195,18 +373,68 @@ class einsum_ir::frontend::EinsumExpression {
      **/
     err_t unlock_data( int64_t i_tensor_id );
 
+    /**
+     * Sets the data pointers of the tensors.
+     * This allows the evaluation of a compiled expression on new data without recompilation.
+     *
+     * @param i_data_ptrs pointers to the tensors' data.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t set_data_ptrs( void * const * i_data_ptrs );
+
     /**
      * Evaluates the einsum expression.
+     * Concurrent evaluations of different expressions sharing a memory arena are supported.
      */
     void eval();
 
     /**
      * Gets the number of scalar operations required to evaluate the expression.
+     * The additional operations of a sliced evaluation are not included.
      *
      * @return number of scalar operations.
      **/
     int64_t num_ops();
 
+    /**
+     * Gets the number of slices in which the expression is evaluated.
+     *
+     * @return number of slices, 1 if the expression is not sliced.
+     **/
+    int64_t num_slices() const;
+
+    /**
+     * Gets the number of additional scalar operations caused by the slicing.
+     * These stem from subtrees which are recomputed for every slice.
+     *
+     * @return number of additional scalar operations.
+     **/
+    int64_t num_ops_slicing() const;
+
+    /**
+     * Gets the memory footprint of the compiled expression.
+     * The footprint consists of the intermediate tensors, the scratch memory of the contractions and the buffers of gathered slices.
+     *
+     * @return number of bytes.
+     **/
+    int64_t num_bytes() const;
+
+    /**
+     * Enables or disables the profiling of the evaluation.
+     * Has to be called after compilation.
+     *
+     * @param i_profiling true if the evaluation is profiled.
+     **/
+    void set_profiling( bool i_profiling );
+
+    /**
+     * Gets the per-node profiles of the last evaluation.
+     * The nodes are numbered in depth-first order, starting at the root.
+     *
+     * @param o_profiles will be set to the profiles.
+     **/
+    void profile( std::vector< backend::NodeProfile > & o_profiles ) const;
+
     /**
      * Generates a string representation of the compiled einsum tree.
      * The string is rendered in a human readable form.
@@ -1,5 +1,9 @@
 #include "catch.hpp"
 #include "EinsumExpression.h"
+#include "../backend/MemoryArena.h"
+#include "../basic/threading.h"
+#include <cstdio>
+#include <fstream>
 
 TEST_CASE( "Derivation of dimension histogram.", "[einsum_exp]" ) {
   int64_t l_string_dim_ids[8] = { 0, 2, 3, 1, 0, 4, 0, 2 };
@@ -59,4 +63,410 @@ TEST_CASE( "Unique contraction path generation.", "[einsum_exp]" ) {
 
   REQUIRE( l_path_unique[4] == 3 );
   REQUIRE( l_path_unique[5] == 5 );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Per-node profiling of an einsum expression.", "[einsum_exp]" ) {
+  // ab,bc,cd->da
+  int64_t l_dim_sizes[4] = { 8, 16, 12, 4 };
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  3, 0 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  std::vector< float > l_a( 8*16, 1.0f );
+  std::vector< float > l_b( 16*12, 0.5f );
+  std::vector< float > l_c( 12*4, 2.0f );
+  std::vector< float > l_d( 4*8, 0.0f );
+  void * l_data_ptrs[4] = { l_a.data(), l_b.data(), l_c.data(), l_d.data() };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+  l_einsum_exp.init( 4,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP32,
+                     l_data_ptrs );
+  REQUIRE( l_einsum_exp.compile() == einsum_ir::SUCCESS );
+
+  l_einsum_exp.set_profiling( true );
+  l_einsum_exp.eval();
+  REQUIRE( l_d[0] == Approx( 16 * 12 ) );
+
+  std::vector< einsum_ir::backend::NodeProfile > l_profiles;
+  l_einsum_exp.profile( l_profiles );
+  REQUIRE( l_profiles.size() == 5 );
+  REQUIRE( l_profiles[0].m_id_parent == -1 );
+
+  int64_t l_num_ops = 0;
+  int64_t l_num_conts = 0;
+  for( std::size_t l_pr = 0; l_pr < l_profiles.size(); l_pr++ ) {
+    REQUIRE( l_profiles[l_pr].m_id == (int64_t) l_pr );
+    REQUIRE( l_profiles[l_pr].m_id_parent < (int64_t) l_pr );
+    REQUIRE( l_profiles[l_pr].m_time_start > 0 );
+
+    l_num_ops += l_profiles[l_pr].m_num_ops;
+    if( l_profiles[l_pr].m_num_ops > 0 ) {
+      l_num_conts++;
+      REQUIRE( l_profiles[l_pr].m_time_contraction > 0 );
+      REQUIRE( l_profiles[l_pr].m_time_packing <= l_profiles[l_pr].m_time_contraction );
+      REQUIRE( l_profiles[l_pr].m_num_bytes_contraction > 0 );
+    }
+  }
+  REQUIRE( l_num_conts == 2 );
+  REQUIRE( l_num_ops == l_einsum_exp.num_ops() );
+
+  // evaluations without profiling leave the profiles unchanged
+  l_einsum_exp.set_profiling( false );
+  l_einsum_exp.eval();
+
+  std::vector< einsum_ir::backend::NodeProfile > l_profiles_disabled;
+  l_einsum_exp.profile( l_profiles_disabled );
+  for( std::size_t l_pr = 0; l_pr < l_profiles.size(); l_pr++ ) {
+    REQUIRE( l_profiles_disabled[l_pr].m_time_start == l_profiles[l_pr].m_time_start );
+  }
+}
+
+TEST_CASE( "Memory-budgeted evaluation of a sliced einsum expression.", "[einsum_exp]" ) {
+  // ab,bc,cd->ad
+  int64_t l_dim_sizes[4] = { 32, 8, 64, 8 };
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  0, 3 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  std::vector< float > l_a( 32*8 );
+  std::vector< float > l_b( 8*64 );
+  std::vector< float > l_c( 64*8 );
+  for( std::size_t l_en = 0; l_en < l_a.size(); l_en++ ) l_a[l_en] = (float) ( l_en % 7 ) - 3.0f;
+  for( std::size_t l_en = 0; l_en < l_b.size(); l_en++ ) l_b[l_en] = (float) ( l_en % 5 ) * 0.5f;
+  for( std::size_t l_en = 0; l_en < l_c.size(); l_en++ ) l_c[l_en] = (float) ( l_en % 3 ) - 1.0f;
+
+  // reference
+  std::vector< float > l_ref( 32*8, 0.0f );
+  for( int64_t l_ia = 0; l_ia < 32; l_ia++ ) {
+    for( int64_t l_ib = 0; l_ib < 8; l_ib++ ) {
+      for( int64_t l_ic = 0; l_ic < 64; l_ic++ ) {
+        for( int64_t l_id = 0; l_id < 8; l_id++ ) {
+          l_ref[l_ia*8 + l_id] += l_a[l_ia*8 + l_ib] * l_b[l_ib*64 + l_ic] * l_c[l_ic*8 + l_id];
+        }
+      }
+    }
+  }
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_full;
+  std::vector< float > l_d_full( 32*8, 0.0f );
+  void * l_data_ptrs_full[4] = { l_a.data(), l_b.data(), l_c.data(), l_d_full.data() };
+  l_einsum_exp_full.init( 4,
+                          l_dim_sizes,
+                          2,
+                          l_string_num_dims,
+                          l_string_dim_ids,
+                          l_path,
+                          einsum_ir::FP32,
+                          l_data_ptrs_full );
+  REQUIRE( l_einsum_exp_full.compile() == einsum_ir::SUCCESS );
+  REQUIRE( l_einsum_exp_full.num_slices() == 1 );
+  REQUIRE( l_einsum_exp_full.num_ops_slicing() == 0 );
+
+  int64_t l_budgets[3] = { 8192, 4096, 1024 };
+  for( int64_t l_bu = 0; l_bu < 3; l_bu++ ) {
+    std::vector< float > l_d( 32*8, 1.0f );
+    void * l_data_ptrs[4] = { l_a.data(), l_b.data(), l_c.data(), l_d.data() };
+
+    einsum_ir::frontend::EinsumExpression l_einsum_exp;
+    l_einsum_exp.init( 4,
+                       l_dim_sizes,
+                       2,
+                       l_string_num_dims,
+                       l_string_dim_ids,
+                       l_path,
+                       einsum_ir::FP32,
+                       l_data_ptrs );
+    l_einsum_exp.set_memory_budget( l_budgets[l_bu] );
+    REQUIRE( l_einsum_exp.compile() == einsum_ir::SUCCESS );
+
+    REQUIRE( l_einsum_exp.num_slices() > 1 );
+    REQUIRE( l_einsum_exp.num_ops_slicing() >= 0 );
+    REQUIRE( l_einsum_exp.num_ops() == l_einsum_exp_full.num_ops() );
+    int64_t l_num_bytes_buffers = 0;
+    for( std::size_t l_te = 0; l_te < l_einsum_exp.m_slice_buffers.size(); l_te++ ) {
+      l_num_bytes_buffers += l_einsum_exp.m_slice_buffers[l_te].size();
+    }
+    REQUIRE( l_einsum_exp.m_memory.get_num_bytes_stack() + l_num_bytes_buffers <= l_einsum_exp.num_bytes() );
+    REQUIRE( l_einsum_exp.num_bytes() <= l_budgets[l_bu] );
+
+    // repeated evaluations overwrite the output
+    l_einsum_exp.eval();
+    l_einsum_exp.eval();
+    for( int64_t l_en = 0; l_en < 32*8; l_en++ ) {
+      REQUIRE( l_d[l_en] == Approx( l_ref[l_en] ) );
+    }
+  }
+
+  // budgets which cannot be met fail the compilation
+  std::vector< float > l_d_unmet( 32*8, 0.0f );
+  void * l_data_ptrs_unmet[4] = { l_a.data(), l_b.data(), l_c.data(), l_d_unmet.data() };
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_unmet;
+  l_einsum_exp_unmet.init( 4,
+                           l_dim_sizes,
+                           2,
+                           l_string_num_dims,
+                           l_string_dim_ids,
+                           l_path,
+                           einsum_ir::FP32,
+                           l_data_ptrs_unmet );
+  l_einsum_exp_unmet.set_memory_budget( 16 );
+  REQUIRE( l_einsum_exp_unmet.compile() == einsum_ir::COMPILATION_FAILED );
+
+  // complex expressions are not sliced
+  std::vector< float > l_d_cpx( 2*32*8, 0.0f );
+  void * l_data_ptrs_cpx[4] = { l_a.data(), l_b.data(), l_c.data(), l_d_cpx.data() };
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_cpx;
+  l_einsum_exp_cpx.init( 4,
+                         l_dim_sizes,
+                         2,
+                         l_string_num_dims,
+                         l_string_dim_ids,
+                         l_path,
+                         einsum_ir::BATCH_OUTER,
+                         einsum_ir::FP32,
+                         l_data_ptrs_cpx );
+  l_einsum_exp_cpx.set_memory_budget( 1024 );
+  REQUIRE( l_einsum_exp_cpx.compile() == einsum_ir::COMPILATION_FAILED );
+}
+
+TEST_CASE( "Streaming evaluation of an einsum expression over a batch dimension.", "[einsum_exp]" ) {
+  // acb,bd,de->cae, the batch dimension c is not outermost in the first input
+  int64_t l_dim_sizes[5] = { 8, 16, 12, 8, 8 };
+  int64_t l_string_num_dims[4] = { 3, 2, 2, 3 };
+  int64_t l_string_dim_ids[10] = { 0, 2, 1,  1, 3,  3, 4,  2, 0, 4 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  std::vector< float > l_x( 8*12*16 );
+  std::vector< float > l_w0( 16*8 );
+  std::vector< float > l_w1( 8*8 );
+  for( std::size_t l_en = 0; l_en < l_x.size(); l_en++ ) l_x[l_en] = (float) ( l_en % 7 ) - 3.0f;
+  for( std::size_t l_en = 0; l_en < l_w0.size(); l_en++ ) l_w0[l_en] = (float) ( l_en % 5 ) * 0.5f;
+  for( std::size_t l_en = 0; l_en < l_w1.size(); l_en++ ) l_w1[l_en] = (float) ( l_en % 3 ) - 1.0f;
+
+  // reference
+  std::vector< float > l_ref( 12*8*8, 0.0f );
+  for( int64_t l_ia = 0; l_ia < 8; l_ia++ ) {
+    for( int64_t l_ib = 0; l_ib < 16; l_ib++ ) {
+      for( int64_t l_ic = 0; l_ic < 12; l_ic++ ) {
+        for( int64_t l_id = 0; l_id < 8; l_id++ ) {
+          for( int64_t l_ie = 0; l_ie < 8; l_ie++ ) {
+            l_ref[(l_ic*8 + l_ia)*8 + l_ie] += l_x[(l_ia*12 + l_ic)*16 + l_ib] * l_w0[l_ib*8 + l_id] * l_w1[l_id*8 + l_ie];
+          }
+        }
+      }
+    }
+  }
+
+  // chunk sizes which do not divide the batch dimension are rejected
+  std::vector< float > l_y_invalid( 12*8*8 );
+  void * l_data_ptrs_invalid[4] = { l_x.data(), l_w0.data(), l_w1.data(), l_y_invalid.data() };
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_invalid;
+  l_einsum_exp_invalid.init( 5,
+                             l_dim_sizes,
+                             2,
+                             l_string_num_dims,
+                             l_string_dim_ids,
+                             l_path,
+                             einsum_ir::FP32,
+                             l_data_ptrs_invalid );
+  l_einsum_exp_invalid.set_stream_dim( 2, 5 );
+  REQUIRE( l_einsum_exp_invalid.compile() == einsum_ir::INVALID_ID );
+
+  int64_t l_chunk_sizes[3] = { 1, 4, 12 };
+  for( int64_t l_ch = 0; l_ch < 3; l_ch++ ) {
+    std::vector< float > l_y( 12*8*8, 1.0f );
+    void * l_data_ptrs[4] = { l_x.data(), l_w0.data(), l_w1.data(), l_y.data() };
+
+    einsum_ir::frontend::EinsumExpression l_einsum_exp;
+    l_einsum_exp.init( 5,
+                       l_dim_sizes,
+                       2,
+                       l_string_num_dims,
+                       l_string_dim_ids,
+                       l_path,
+                       einsum_ir::FP32,
+                       l_data_ptrs );
+    l_einsum_exp.set_stream_dim( 2, l_chunk_sizes[l_ch] );
+    REQUIRE( l_einsum_exp.compile() == einsum_ir::SUCCESS );
+    REQUIRE( l_einsum_exp.num_slices() == 12 / l_chunk_sizes[l_ch] );
+    REQUIRE( l_einsum_exp.num_ops_slicing() == 0 );
+
+    // repeated evaluations overwrite the output
+    l_einsum_exp.eval();
+    l_einsum_exp.eval();
+    for( int64_t l_en = 0; l_en < 12*8*8; l_en++ ) {
+      REQUIRE( l_y[l_en] == Approx( l_ref[l_en] ) );
+    }
+  }
+}
+
+TEST_CASE( "Concurrent evaluation of einsum expressions sharing a memory arena.", "[einsum_exp]" ) {
+  // ab,bc,cd->ad with different sizes of b
+  int64_t l_num_exps = 3;
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  0, 3 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  einsum_ir::backend::MemoryArena l_arena;
+  std::vector< std::vector< int64_t > > l_dim_sizes( l_num_exps );
+  std::vector< std::vector< float > > l_a( l_num_exps ), l_b( l_num_exps ), l_c( l_num_exps ), l_d( l_num_exps ), l_ref( l_num_exps );
+  std::vector< einsum_ir::frontend::EinsumExpression > l_exps( l_num_exps );
+
+  for( int64_t l_ex = 0; l_ex < l_num_exps; l_ex++ ) {
+    int64_t l_sa = 16;
+    int64_t l_sb = 8 * (l_ex + 1);
+    int64_t l_sc = 32;
+    int64_t l_sd = 8;
+    l_dim_sizes[l_ex] = { l_sa, l_sb, l_sc, l_sd };
+
+    l_a[l_ex].resize( l_sa*l_sb );
+    l_b[l_ex].resize( l_sb*l_sc );
+    l_c[l_ex].resize( l_sc*l_sd );
+    l_d[l_ex].resize( l_sa*l_sd, 0.0f );
+    l_ref[l_ex].resize( l_sa*l_sd, 0.0f );
+    for( std::size_t l_en = 0; l_en < l_a[l_ex].size(); l_en++ ) l_a[l_ex][l_en] = (float) ( (l_en + l_ex) % 7 ) - 3.0f;
+    for( std::size_t l_en = 0; l_en < l_b[l_ex].size(); l_en++ ) l_b[l_ex][l_en] = (float) ( l_en % 5 ) * 0.5f;
+    for( std::size_t l_en = 0; l_en < l_c[l_ex].size(); l_en++ ) l_c[l_ex][l_en] = (float) ( l_en % 3 ) - 1.0f;
+
+    for( int64_t l_ia = 0; l_ia < l_sa; l_ia++ ) {
+      for( int64_t l_ib = 0; l_ib < l_sb; l_ib++ ) {
+        for( int64_t l_ic = 0; l_ic < l_sc; l_ic++ ) {
+          for( int64_t l_id = 0; l_id < l_sd; l_id++ ) {
+            l_ref[l_ex][l_ia*l_sd + l_id] +=   l_a[l_ex][l_ia*l_sb + l_ib]
+                                             * l_b[l_ex][l_ib*l_sc + l_ic]
+                                             * l_c[l_ex][l_ic*l_sd + l_id];
+          }
+        }
+      }
+    }
+
+    void * l_data_ptrs[4] = { l_a[l_ex].data(), l_b[l_ex].data(), l_c[l_ex].data(), l_d[l_ex].data() };
+    l_exps[l_ex].init( 4,
+                       l_dim_sizes[l_ex].data(),
+                       2,
+                       l_string_num_dims,
+                       l_string_dim_ids,
+                       l_path,
+                       einsum_ir::FP32,
+                       l_data_ptrs );
+    l_exps[l_ex].set_memory_arena( &l_arena );
+    REQUIRE( l_exps[l_ex].compile() == einsum_ir::SUCCESS );
+  }
+
+  // sequential evaluations share a single slot
+  for( int64_t l_ex = 0; l_ex < l_num_exps; l_ex++ ) {
+    l_exps[l_ex].eval();
+  }
+  REQUIRE( l_arena.get_num_slots() == 1 );
+
+#if defined(EINSUM_IR_USE_OPENMP)
+  int l_levels = omp_get_max_active_levels();
+#endif
+  for( int64_t l_re = 0; l_re < 3; l_re++ ) {
+    einsum_ir::basic::execute_nested( l_num_exps, [&]( int64_t l_ex ) {
+      l_exps[l_ex].eval();
+    } );
+  }
+  REQUIRE( l_arena.get_num_slots() <= l_num_exps );
+#if defined(EINSUM_IR_USE_OPENMP)
+  // nested regions leave the setting of the application untouched
+  REQUIRE( omp_get_max_active_levels() == l_levels );
+#endif
+
+  for( int64_t l_ex = 0; l_ex < l_num_exps; l_ex++ ) {
+    for( std::size_t l_en = 0; l_en < l_ref[l_ex].size(); l_en++ ) {
+      REQUIRE( l_d[l_ex][l_en] == Approx( l_ref[l_ex][l_en] ) );
+    }
+  }
+}
+
+TEST_CASE( "Evaluation of an einsum expression on memory-mapped tensors.", "[einsum_exp]" ) {
+  // ab,bc,cd->ad
+  int64_t l_sizes[4] = { 32, 64, 48, 40 };
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  0, 3 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  std::vector< std::vector< float > > l_inputs( 3 );
+  std::vector< std::string > l_paths;
+  for( int64_t l_te = 0; l_te < 4; l_te++ ) {
+    l_paths.push_back( "einsum_ir_mapped_tensor_" + std::to_string( l_te ) + ".test.bin" );
+  }
+
+  // inputs are written to files, the output file is created by the expression
+  for( int64_t l_te = 0; l_te < 3; l_te++ ) {
+    l_inputs[l_te].resize( l_sizes[ l_string_dim_ids[2*l_te] ] * l_sizes[ l_string_dim_ids[2*l_te+1] ] );
+    for( std::size_t l_en = 0; l_en < l_inputs[l_te].size(); l_en++ ) {
+      l_inputs[l_te][l_en] = (float) ( (l_en * (l_te + 3)) % 11 ) * 0.25f - 1.0f;
+    }
+    std::ofstream l_file( l_paths[l_te],
+                          std::ios::binary );
+    l_file.write( (char const *) l_inputs[l_te].data(),
+                  l_inputs[l_te].size() * sizeof(float) );
+  }
+  std::remove( l_paths[3].c_str() );
+
+  std::vector< float > l_ref( l_sizes[0] * l_sizes[3], 0.0f );
+  for( int64_t l_ia = 0; l_ia < l_sizes[0]; l_ia++ ) {
+    for( int64_t l_ib = 0; l_ib < l_sizes[1]; l_ib++ ) {
+      for( int64_t l_ic = 0; l_ic < l_sizes[2]; l_ic++ ) {
+        for( int64_t l_id = 0; l_id < l_sizes[3]; l_id++ ) {
+          l_ref[l_ia*l_sizes[3] + l_id] +=   l_inputs[0][l_ia*l_sizes[1] + l_ib]
+                                           * l_inputs[1][l_ib*l_sizes[2] + l_ic]
+                                           * l_inputs[2][l_ic*l_sizes[3] + l_id];
+        }
+      }
+    }
+  }
+
+  {
+    // the data pointers of mapped tensors are ignored
+    void * l_data_ptrs[4] = { nullptr, nullptr, nullptr, nullptr };
+
+    einsum_ir::frontend::EinsumExpression l_expression;
+    l_expression.init( 4,
+                       l_sizes,
+                       2,
+                       l_string_num_dims,
+                       l_string_dim_ids,
+                       l_path,
+                       einsum_ir::FP32,
+                       l_data_ptrs );
+    REQUIRE( l_expression.map_tensor( 4, l_paths[3] ) == einsum_ir::INVALID_ID );
+    REQUIRE( l_expression.map_tensor( 0, l_paths[3] + ".missing" ) == einsum_ir::UNDEFINED_ERROR );
+    for( int64_t l_te = 0; l_te < 4; l_te++ ) {
+      REQUIRE( l_expression.map_tensor( l_te, l_paths[l_te] ) == einsum_ir::SUCCESS );
+    }
+    REQUIRE( l_expression.compile() == einsum_ir::SUCCESS );
+    REQUIRE( l_expression.m_nodes[0].m_streamed );
+    REQUIRE( !l_expression.m_nodes.back().m_streamed );
+
+    l_expression.eval();
+
+    float const * l_out = (float const *) l_expression.m_data_ptrs[3];
+    for( std::size_t l_en = 0; l_en < l_ref.size(); l_en++ ) {
+      REQUIRE( l_out[l_en] == Approx( l_ref[l_en] ) );
+    }
+  }
+
+  // the output was written to its file
+  std::vector< float > l_out( l_ref.size() );
+  std::ifstream l_file( l_paths[3],
+                        std::ios::binary );
+  l_file.read( (char *) l_out.data(),
+               l_out.size() * sizeof(float) );
+  REQUIRE( l_file );
+  for( std::size_t l_en = 0; l_en < l_ref.size(); l_en++ ) {
+    REQUIRE( l_out[l_en] == Approx( l_ref[l_en] ) );
+  }
+
+  for( std::size_t l_te = 0; l_te < l_paths.size(); l_te++ ) {
+    std::remove( l_paths[l_te].c_str() );
+  }
+}
@@ -310,6 +310,12 @@ void einsum_ir::frontend::EinsumExpressionAscii::parse_dtype( std::string const
     else if( i_dtype_string == "FP64" ) {
       o_dtype = einsum_ir::FP64;
     }
+    else if( i_dtype_string == "BF16" ) {
+      o_dtype = einsum_ir::BF16;
+    }
+    else if( i_dtype_string == "FP16" ) {
+      o_dtype = einsum_ir::FP16;
+    }
     else if( i_dtype_string == "CPX_FP32" ) {
       o_dtype = einsum_ir::FP32;
     }
@@ -329,6 +335,12 @@ void einsum_ir::frontend::EinsumExpressionAscii::parse_ctype( std::string const
     else if( i_ctype_string == "FP64" ) {
       o_ctype = einsum_ir::REAL_ONLY;
     }
+    else if( i_ctype_string == "BF16" ) {
+      o_ctype = einsum_ir::REAL_ONLY;
+    }
+    else if( i_ctype_string == "FP16" ) {
+      o_ctype = einsum_ir::REAL_ONLY;
+    }
     else if( i_ctype_string == "CPX_FP32" ) {
       o_ctype = einsum_ir::BATCH_INNER;
     }
@@ -89,8 +89,14 @@ einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile() {
   return einsum_ir::SUCCESS;
 }
 
+void einsum_ir::frontend::EinsumTree::set_memory_arena( backend::MemoryArena * i_arena ) {
+  m_memory.set_arena( i_arena );
+}
+
 void einsum_ir::frontend::EinsumTree::eval() {
+  m_memory.checkout();
   m_nodes.back().eval();
+  m_memory.checkin();
 }
 
 int64_t einsum_ir::frontend::EinsumTree::num_ops() {
@@ -100,4 +106,17 @@ int64_t einsum_ir::frontend::EinsumTree::num_ops() {
   else {
     return 0;
   }
-}
\ No newline at end of file
+}
+
+void einsum_ir::frontend::EinsumTree::set_profiling( bool i_profiling ) {
+  if( m_nodes.size() > 0 ) {
+    m_nodes.back().set_profiling( i_profiling );
+  }
+}
+
+void einsum_ir::frontend::EinsumTree::profile( std::vector< backend::NodeProfile > & o_profiles ) const {
+  o_profiles.clear();
+  if( m_nodes.size() > 0 ) {
+    m_nodes.back().profile( o_profiles );
+  }
+}
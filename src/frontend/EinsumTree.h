@@ -49,6 +49,15 @@ class einsum_ir::frontend::EinsumTree {
                data_t                                          i_dtype,
                void                                  * const * i_data_ptrs );
 
+    /**
+     * Attaches a memory arena which is shared with other compiled einsum trees or expressions.
+     * The intermediate data is borrowed from the arena during every evaluation instead of being owned.
+     * Has to be called before compilation, the arena has to outlive the einsum tree.
+     *
+     * @param i_arena memory arena, nullptr to own the intermediate data.
+     **/
+    void set_memory_arena( backend::MemoryArena * i_arena );
+
     /**
      * Compiles the einsum tree. 
      **/
@@ -56,6 +65,7 @@ class einsum_ir::frontend::EinsumTree {
 
     /**
      * Evaluates the einsum tree.
+     * Concurrent evaluations of different trees sharing a memory arena are supported.
      */
     void eval();
 
@@ -66,6 +76,21 @@ class einsum_ir::frontend::EinsumTree {
      **/
     int64_t num_ops();
 
+    /**
+     * Enables or disables the profiling of the evaluation.
+     * Has to be called after compilation.
+     *
+     * @param i_profiling true if the evaluation is profiled.
+     **/
+    void set_profiling( bool i_profiling );
+
+    /**
+     * Gets the per-node profiles of the last evaluation.
+     * The nodes are numbered in depth-first order, starting at the root.
+     *
+     * @param o_profiles will be set to the profiles.
+     **/
+    void profile( std::vector< backend::NodeProfile > & o_profiles ) const;
 
 };
 
@@ -0,0 +1,440 @@
+#include "PathOptimizer.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <tuple>
+
+double einsum_ir::frontend::PathOptimizer::num_ops( std::vector< int64_t > const & i_dim_ids_left,
+                                                    std::vector< int64_t > const & i_dim_ids_right,
+                                                    std::vector< int64_t > const & i_dim_ids_out,
+                                                    int64_t                const * i_dim_sizes,
+                                                    kernel_t                       i_ktype_first_touch,
+                                                    kernel_t                       i_ktype_main ) {
+  double l_size_c = 1;
+  double l_size_m = 1;
+  double l_size_n = 1;
+  double l_size_k = 1;
+
+  // union of the left and right dimensions
+  std::vector< int64_t > l_dim_ids;
+  std::set_union( i_dim_ids_left.begin(),
+                  i_dim_ids_left.end(),
+                  i_dim_ids_right.begin(),
+                  i_dim_ids_right.end(),
+                  std::back_inserter( l_dim_ids ) );
+
+  for( std::size_t l_di = 0; l_di < l_dim_ids.size(); l_di++ ) {
+    int64_t l_id = l_dim_ids[l_di];
+    bool l_left  = std::binary_search( i_dim_ids_left.begin(),  i_dim_ids_left.end(),  l_id );
+    bool l_right = std::binary_search( i_dim_ids_right.begin(), i_dim_ids_right.end(), l_id );
+    bool l_out   = std::binary_search( i_dim_ids_out.begin(),   i_dim_ids_out.end(),   l_id );
+
+    // I and J dimensions are not counted
+    if( l_left && l_right && l_out ) {
+      l_size_c *= i_dim_sizes[l_id];
+    }
+    else if( l_left && l_out ) {
+      l_size_m *= i_dim_sizes[l_id];
+    }
+    else if( l_right && l_out ) {
+      l_size_n *= i_dim_sizes[l_id];
+    }
+    else if( l_left && l_right ) {
+      l_size_k *= i_dim_sizes[l_id];
+    }
+  }
+
+  double l_num_ops = l_size_c * l_size_m * l_size_n * l_size_k * 2;
+
+  if( i_ktype_main == kernel_t::CPX_MADD ) {
+    l_num_ops *= 2;
+  }
+
+  if(    i_ktype_first_touch == ZERO
+      || i_ktype_first_touch == CPX_ZERO ) {
+    l_num_ops -= l_size_c * l_size_m * l_size_n;
+  }
+
+  return l_num_ops;
+}
+
+void einsum_ir::frontend::PathOptimizer::standard_tensor_ids( int64_t         i_num_conts,
+                                                              int64_t const * i_path,
+                                                              int64_t       * o_path ) {
+  int64_t l_num_tensors = i_num_conts + 1;
+
+  std::vector< int64_t > l_tensor_ids;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_tensor_ids.push_back( l_te );
+  }
+
+  for( int64_t l_co = 0; l_co < i_num_conts; l_co++ ) {
+    // get tensors' positions
+    int64_t l_pos_0 = std::find( l_tensor_ids.begin(),
+                                 l_tensor_ids.end(),
+                                 i_path[l_co*2 + 0] ) - l_tensor_ids.begin();
+    int64_t l_pos_1 = std::find( l_tensor_ids.begin(),
+                                 l_tensor_ids.end(),
+                                 i_path[l_co*2 + 1] ) - l_tensor_ids.begin();
+
+    // add contraction to standard path
+    o_path[l_co*2 + 0] = l_pos_0;
+    o_path[l_co*2 + 1] = l_pos_1;
+
+    // remove tensors' ids
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::max( l_pos_0, l_pos_1 ) );
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::min( l_pos_0, l_pos_1 ) );
+
+    // add id of contraction output
+    l_tensor_ids.push_back( l_num_tensors );
+    l_num_tensors++;
+  }
+}
+
+void einsum_ir::frontend::PathOptimizer::init( int64_t         i_num_dims,
+                                               int64_t const * i_dim_sizes,
+                                               int64_t         i_num_tensors_in,
+                                               int64_t const * i_string_num_dims,
+                                               int64_t const * i_string_dim_ids,
+                                               kernel_t        i_ktype_first_touch,
+                                               kernel_t        i_ktype_main ) {
+  m_num_dims = i_num_dims;
+  m_dim_sizes = i_dim_sizes;
+  m_num_tensors_in = i_num_tensors_in;
+  m_ktype_first_touch = i_ktype_first_touch;
+  m_ktype_main = i_ktype_main;
+
+  // sorted dimension ids of the inputs
+  m_dim_ids_in.resize( m_num_tensors_in );
+  int64_t l_offset = 0;
+  for( int64_t l_te = 0; l_te < m_num_tensors_in; l_te++ ) {
+    m_dim_ids_in[l_te] = std::vector< int64_t >( i_string_dim_ids + l_offset,
+                                                 i_string_dim_ids + l_offset + i_string_num_dims[l_te] );
+    std::sort( m_dim_ids_in[l_te].begin(),
+               m_dim_ids_in[l_te].end() );
+    l_offset += i_string_num_dims[l_te];
+  }
+
+  // dimensions of the output
+  m_dim_out = std::vector< bool >( m_num_dims, false );
+  for( int64_t l_di = 0; l_di < i_string_num_dims[m_num_tensors_in]; l_di++ ) {
+    m_dim_out[ i_string_dim_ids[l_offset + l_di] ] = true;
+  }
+
+  m_num_ops = 0;
+  m_size_peak = 0;
+}
+
+double einsum_ir::frontend::PathOptimizer::size( std::vector< int64_t > const & i_dim_ids ) const {
+  double l_size = 1;
+  for( std::size_t l_di = 0; l_di < i_dim_ids.size(); l_di++ ) {
+    l_size *= m_dim_sizes[ i_dim_ids[l_di] ];
+  }
+  return l_size;
+}
+
+void einsum_ir::frontend::PathOptimizer::optimize_optimal( std::vector< int64_t > & o_path ) {
+  uint64_t l_num_subsets = uint64_t(1) << m_num_tensors_in;
+  uint64_t l_all = l_num_subsets - 1;
+
+  // tensors in which the dimensions appear
+  std::vector< uint64_t > l_dim_masks( m_num_dims, 0 );
+  for( int64_t l_te = 0; l_te < m_num_tensors_in; l_te++ ) {
+    for( std::size_t l_di = 0; l_di < m_dim_ids_in[l_te].size(); l_di++ ) {
+      l_dim_masks[ m_dim_ids_in[l_te][l_di] ] |= uint64_t(1) << l_te;
+    }
+  }
+
+  // derive the dimensions of every intermediate tensor:
+  // a dimension is kept if it is part of the output or of a tensor outside of the subset
+  std::vector< std::vector< int64_t > > l_dim_ids( l_num_subsets );
+  std::vector< double > l_sizes( l_num_subsets, 0 );
+  for( uint64_t l_su = 1; l_su < l_num_subsets; l_su++ ) {
+    if( (l_su & (l_su - 1)) == 0 ) {
+      int64_t l_te = __builtin_ctzll( l_su );
+      l_dim_ids[l_su] = m_dim_ids_in[l_te];
+    }
+    else {
+      for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+        if(    (l_dim_masks[l_di] & l_su) != 0
+            && ( m_dim_out[l_di] || (l_dim_masks[l_di] & ~l_su & l_all) != 0 ) ) {
+          l_dim_ids[l_su].push_back( l_di );
+        }
+      }
+    }
+    l_sizes[l_su] = size( l_dim_ids[l_su] );
+  }
+
+  // dynamic programming over the subsets, sub-subsets are always smaller
+  std::vector< SubsetCost > l_costs( l_num_subsets );
+  for( uint64_t l_su = 1; l_su < l_num_subsets; l_su++ ) {
+    if( (l_su & (l_su - 1)) == 0 ) {
+      continue;
+    }
+
+    bool l_first = true;
+    uint64_t l_lowest = l_su & (~l_su + 1);
+    for( uint64_t l_left = (l_su - 1) & l_su; l_left > 0; l_left = (l_left - 1) & l_su ) {
+      // consider every split only once
+      if( (l_left & l_lowest) == 0 ) {
+        continue;
+      }
+      uint64_t l_right = l_su ^ l_left;
+
+      double l_num_ops = l_costs[l_left].m_num_ops + l_costs[l_right].m_num_ops;
+      l_num_ops += num_ops( l_dim_ids[l_left],
+                            l_dim_ids[l_right],
+                            l_dim_ids[l_su],
+                            m_dim_sizes,
+                            m_ktype_first_touch,
+                            m_ktype_main );
+
+      // intermediate tensors which are live during the contraction, inputs and output are external
+      double l_size = 0;
+      if( (l_left & (l_left - 1)) != 0 ) {
+        l_size += l_sizes[l_left];
+      }
+      if( (l_right & (l_right - 1)) != 0 ) {
+        l_size += l_sizes[l_right];
+      }
+      if( l_su != l_all ) {
+        l_size += l_sizes[l_su];
+      }
+      double l_size_peak = std::max( l_size,
+                                     std::max( l_costs[l_left].m_size_peak,
+                                               l_costs[l_right].m_size_peak ) );
+
+      if(    l_first
+          || l_num_ops < l_costs[l_su].m_num_ops
+          || ( l_num_ops == l_costs[l_su].m_num_ops && l_size_peak < l_costs[l_su].m_size_peak ) ) {
+        l_costs[l_su].m_num_ops = l_num_ops;
+        l_costs[l_su].m_size_peak = l_size_peak;
+        l_costs[l_su].m_left = l_left;
+        l_first = false;
+      }
+    }
+  }
+
+  // assemble path by visiting the subsets in post order
+  o_path.clear();
+  int64_t l_id_next = m_num_tensors_in;
+  std::function< int64_t( uint64_t ) > l_assemble = [&]( uint64_t i_subset ) -> int64_t {
+    if( (i_subset & (i_subset - 1)) == 0 ) {
+      return __builtin_ctzll( i_subset );
+    }
+    int64_t l_id_left  = l_assemble( l_costs[i_subset].m_left );
+    int64_t l_id_right = l_assemble( i_subset ^ l_costs[i_subset].m_left );
+    o_path.push_back( l_id_left );
+    o_path.push_back( l_id_right );
+    return l_id_next++;
+  };
+  l_assemble( l_all );
+
+  m_num_ops = l_costs[l_all].m_num_ops;
+  m_size_peak = l_costs[l_all].m_size_peak;
+}
+
+void einsum_ir::frontend::PathOptimizer::optimize_greedy( std::vector< int64_t > & o_path ) {
+  // candidate: memory change, number of operations, left tensor, right tensor
+  typedef std::tuple< double, double, int64_t, int64_t > candidate_t;
+
+  std::vector< std::vector< int64_t > > l_tensors = m_dim_ids_in;
+  std::vector< bool > l_alive( m_num_tensors_in, true );
+  std::vector< bool > l_intermediate( m_num_tensors_in, false );
+  int64_t l_num_alive = m_num_tensors_in;
+
+  // number of live tensors (and the output) in which the dimensions appear
+  std::vector< int64_t > l_hist( m_num_dims, 0 );
+  // tensors in which the dimensions appear
+  std::vector< std::vector< int64_t > > l_dim_tensors( m_num_dims );
+  for( int64_t l_te = 0; l_te < m_num_tensors_in; l_te++ ) {
+    for( std::size_t l_di = 0; l_di < l_tensors[l_te].size(); l_di++ ) {
+      l_hist[ l_tensors[l_te][l_di] ]++;
+      l_dim_tensors[ l_tensors[l_te][l_di] ].push_back( l_te );
+    }
+  }
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    if( m_dim_out[l_di] ) {
+      l_hist[l_di]++;
+    }
+  }
+
+  // derives the output and the costs of contracting two tensors
+  auto l_evaluate = [&]( int64_t                  i_left,
+                         int64_t                  i_right,
+                         std::vector< int64_t > & o_dim_ids_out ) -> candidate_t {
+    std::vector< int64_t > const & l_left  = l_tensors[i_left];
+    std::vector< int64_t > const & l_right = l_tensors[i_right];
+
+    std::vector< int64_t > l_union;
+    std::set_union( l_left.begin(),
+                    l_left.end(),
+                    l_right.begin(),
+                    l_right.end(),
+                    std::back_inserter( l_union ) );
+
+    o_dim_ids_out.clear();
+    for( std::size_t l_di = 0; l_di < l_union.size(); l_di++ ) {
+      int64_t l_id = l_union[l_di];
+      int64_t l_count = l_hist[l_id];
+      l_count -= std::binary_search( l_left.begin(),  l_left.end(),  l_id ) ? 1 : 0;
+      l_count -= std::binary_search( l_right.begin(), l_right.end(), l_id ) ? 1 : 0;
+      if( l_count > 0 ) {
+        o_dim_ids_out.push_back( l_id );
+      }
+    }
+
+    double l_size_change = size( o_dim_ids_out ) - size( l_left ) - size( l_right );
+    double l_num_ops = num_ops( l_left,
+                                l_right,
+                                o_dim_ids_out,
+                                m_dim_sizes,
+                                m_ktype_first_touch,
+                                m_ktype_main );
+
+    return candidate_t( l_size_change, l_num_ops, i_left, i_right );
+  };
+
+  std::priority_queue< candidate_t,
+                       std::vector< candidate_t >,
+                       std::greater< candidate_t > > l_queue;
+  std::vector< int64_t > l_dim_ids_out;
+
+  // adds candidates for all live tensors sharing a dimension with the given one
+  auto l_add_candidates = [&]( int64_t i_tensor ) {
+    std::vector< int64_t > l_neighbors;
+    for( std::size_t l_di = 0; l_di < l_tensors[i_tensor].size(); l_di++ ) {
+      std::vector< int64_t > const & l_dim_tensors_di = l_dim_tensors[ l_tensors[i_tensor][l_di] ];
+      for( std::size_t l_te = 0; l_te < l_dim_tensors_di.size(); l_te++ ) {
+        int64_t l_id = l_dim_tensors_di[l_te];
+        if( l_id != i_tensor && l_alive[l_id] ) {
+          l_neighbors.push_back( l_id );
+        }
+      }
+    }
+    std::sort( l_neighbors.begin(),
+               l_neighbors.end() );
+    l_neighbors.erase( std::unique( l_neighbors.begin(),
+                                    l_neighbors.end() ),
+                       l_neighbors.end() );
+
+    for( std::size_t l_ne = 0; l_ne < l_neighbors.size(); l_ne++ ) {
+      l_queue.push( l_evaluate( std::min( i_tensor, l_neighbors[l_ne] ),
+                                std::max( i_tensor, l_neighbors[l_ne] ),
+                                l_dim_ids_out ) );
+    }
+  };
+
+  for( int64_t l_te = 0; l_te < m_num_tensors_in; l_te++ ) {
+    l_add_candidates( l_te );
+  }
+
+  o_path.clear();
+  m_num_ops = 0;
+  m_size_peak = 0;
+
+  while( l_num_alive > 1 ) {
+    int64_t l_left = -1;
+    int64_t l_right = -1;
+    candidate_t l_cand;
+
+    if( l_queue.empty() ) {
+      // no shared dimensions left: outer product of the two smallest tensors
+      for( std::size_t l_te = 0; l_te < l_tensors.size(); l_te++ ) {
+        if( l_alive[l_te] == false ) {
+          continue;
+        }
+        if( l_left == -1 || size( l_tensors[l_te] ) < size( l_tensors[l_left] ) ) {
+          l_right = l_left;
+          l_left = l_te;
+        }
+        else if( l_right == -1 || size( l_tensors[l_te] ) < size( l_tensors[l_right] ) ) {
+          l_right = l_te;
+        }
+      }
+      l_cand = l_evaluate( std::min( l_left, l_right ),
+                           std::max( l_left, l_right ),
+                           l_dim_ids_out );
+    }
+    else {
+      candidate_t l_top = l_queue.top();
+      l_queue.pop();
+      l_left  = std::get<2>( l_top );
+      l_right = std::get<3>( l_top );
+      if( l_alive[l_left] == false || l_alive[l_right] == false ) {
+        continue;
+      }
+
+      // costs are outdated if other contractions removed shared dimensions
+      l_cand = l_evaluate( l_left,
+                           l_right,
+                           l_dim_ids_out );
+      if( l_cand != l_top ) {
+        l_queue.push( l_cand );
+        continue;
+      }
+    }
+    l_left  = std::get<2>( l_cand );
+    l_right = std::get<3>( l_cand );
+
+    // contract the pair
+    int64_t l_id_out = l_tensors.size();
+    o_path.push_back( l_left );
+    o_path.push_back( l_right );
+    m_num_ops += std::get<1>( l_cand );
+
+    double l_size = 0;
+    if( l_intermediate[l_left] ) {
+      l_size += size( l_tensors[l_left] );
+    }
+    if( l_intermediate[l_right] ) {
+      l_size += size( l_tensors[l_right] );
+    }
+    if( l_num_alive > 2 ) {
+      l_size += size( l_dim_ids_out );
+    }
+    m_size_peak = std::max( m_size_peak, l_size );
+
+    for( std::size_t l_di = 0; l_di < l_tensors[l_left].size(); l_di++ ) {
+      l_hist[ l_tensors[l_left][l_di] ]--;
+    }
+    for( std::size_t l_di = 0; l_di < l_tensors[l_right].size(); l_di++ ) {
+      l_hist[ l_tensors[l_right][l_di] ]--;
+    }
+    for( std::size_t l_di = 0; l_di < l_dim_ids_out.size(); l_di++ ) {
+      l_hist[ l_dim_ids_out[l_di] ]++;
+      l_dim_tensors[ l_dim_ids_out[l_di] ].push_back( l_id_out );
+    }
+
+    l_alive[l_left] = false;
+    l_alive[l_right] = false;
+    l_tensors.push_back( l_dim_ids_out );
+    l_alive.push_back( true );
+    l_intermediate.push_back( true );
+    l_num_alive--;
+
+    l_add_candidates( l_id_out );
+  }
+}
+
+einsum_ir::err_t einsum_ir::frontend::PathOptimizer::optimize( std::vector< int64_t > & o_path ) {
+  if( m_num_tensors_in < 1 ) {
+    return err_t::INVALID_ID;
+  }
+
+  std::vector< int64_t > l_path_unique;
+  if( m_num_tensors_in <= m_num_tensors_optimal_max && m_num_tensors_in < 64 ) {
+    optimize_optimal( l_path_unique );
+  }
+  else {
+    optimize_greedy( l_path_unique );
+  }
+
+  int64_t l_num_conts = m_num_tensors_in - 1;
+  o_path.resize( l_num_conts*2 );
+  standard_tensor_ids( l_num_conts,
+                       l_path_unique.data(),
+                       o_path.data() );
+
+  return err_t::SUCCESS;
+}
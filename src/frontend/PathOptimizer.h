@@ -0,0 +1,144 @@
+#ifndef EINSUM_IR_FRONTEND_PATH_OPTIMIZER
+#define EINSUM_IR_FRONTEND_PATH_OPTIMIZER
+
+#include <cstdint>
+#include <vector>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace frontend {
+    class PathOptimizer;
+  }
+}
+
+/**
+ * Derives contraction paths for einsum expressions.
+ *
+ * Expressions with few input tensors are optimized through dynamic programming over all subsets of the inputs.
+ * The search minimizes the number of operations and uses the peak memory of the intermediate tensors as tie breaker.
+ * Larger expressions are optimized greedily by repeatedly contracting the pair of tensors which reduces the memory most.
+ **/
+class einsum_ir::frontend::PathOptimizer {
+  private:
+    //! result of the dynamic programming for a subset of the input tensors
+    struct SubsetCost {
+      //! number of operations required to contract the subset
+      double m_num_ops = 0;
+      //! peak memory of the intermediate tensors in number of elements
+      double m_size_peak = 0;
+      //! left subset of the last contraction
+      uint64_t m_left = 0;
+    };
+
+    //! number of dimensions
+    int64_t m_num_dims = 0;
+    //! sizes of the dimensions
+    int64_t const * m_dim_sizes = nullptr;
+
+    //! number of input tensors
+    int64_t m_num_tensors_in = 0;
+
+    //! sorted dimension ids of the input tensors
+    std::vector< std::vector< int64_t > > m_dim_ids_in;
+
+    //! true if a dimension is part of the output tensor
+    std::vector< bool > m_dim_out;
+
+    //! type of the first-touch kernel
+    kernel_t m_ktype_first_touch = kernel_t::ZERO;
+    //! type of the main kernel
+    kernel_t m_ktype_main = kernel_t::MADD;
+
+    /**
+     * Derives the size of a tensor in number of elements.
+     *
+     * @param i_dim_ids dimension ids of the tensor.
+     * @return size of the tensor.
+     **/
+    double size( std::vector< int64_t > const & i_dim_ids ) const;
+
+    /**
+     * Optimizes the path through dynamic programming over all subsets of the input tensors.
+     *
+     * @param o_path will be set to the contraction path using unique tensor ids.
+     **/
+    void optimize_optimal( std::vector< int64_t > & o_path );
+
+    /**
+     * Optimizes the path greedily.
+     *
+     * @param o_path will be set to the contraction path using unique tensor ids.
+     **/
+    void optimize_greedy( std::vector< int64_t > & o_path );
+
+  public:
+    //! maximum number of input tensors for which the optimal path is searched
+    int64_t m_num_tensors_optimal_max = 10;
+
+    //! number of operations of the derived path
+    double m_num_ops = 0;
+
+    //! peak memory of the derived path's intermediate tensors in number of elements
+    double m_size_peak = 0;
+
+    /**
+     * Derives the number of operations of a binary contraction.
+     * The accounting follows BinaryContraction::num_ops but uses double precision,
+     * since large tensor networks exceed the range of 64-bit integers.
+     *
+     * @param i_dim_ids_left sorted dimension ids of the left tensor.
+     * @param i_dim_ids_right sorted dimension ids of the right tensor.
+     * @param i_dim_ids_out sorted dimension ids of the output tensor.
+     * @param i_dim_sizes sizes of the dimensions.
+     * @param i_ktype_first_touch type of the first-touch kernel.
+     * @param i_ktype_main type of the main kernel.
+     * @return number of operations.
+     **/
+    static double num_ops( std::vector< int64_t > const & i_dim_ids_left,
+                           std::vector< int64_t > const & i_dim_ids_right,
+                           std::vector< int64_t > const & i_dim_ids_out,
+                           int64_t                const * i_dim_sizes,
+                           kernel_t                       i_ktype_first_touch,
+                           kernel_t                       i_ktype_main );
+
+    /**
+     * Translates a contraction path with unique tensor ids to the standard formulation.
+     * This is the inverse of EinsumExpression::unique_tensor_ids.
+     *
+     * @param i_num_conts number of binary contractions.
+     * @param i_path contraction path which assumes ghost entries where each tensor id is unique.
+     * @param o_path contraction path in the standard formulation.
+     **/
+    static void standard_tensor_ids( int64_t         i_num_conts,
+                                     int64_t const * i_path,
+                                     int64_t       * o_path );
+
+    /**
+     * Initializes the path optimizer.
+     *
+     * @param i_num_dims number of dimensions.
+     * @param i_dim_sizes sizes of the dimensions.
+     * @param i_num_tensors_in number of input tensors.
+     * @param i_string_num_dims sizes of the substrings describing the input tensors and output tensor.
+     * @param i_string_dim_ids einsum string containing the dimension ids.
+     * @param i_ktype_first_touch type of the first-touch kernel.
+     * @param i_ktype_main type of the main kernel.
+     **/
+    void init( int64_t         i_num_dims,
+               int64_t const * i_dim_sizes,
+               int64_t         i_num_tensors_in,
+               int64_t const * i_string_num_dims,
+               int64_t const * i_string_dim_ids,
+               kernel_t        i_ktype_first_touch,
+               kernel_t        i_ktype_main );
+
+    /**
+     * Derives a contraction path.
+     *
+     * @param o_path will be set to the contraction path in the standard formulation.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t optimize( std::vector< int64_t > & o_path );
+};
+
+#endif
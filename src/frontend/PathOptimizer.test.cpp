@@ -0,0 +1,91 @@
+#include "catch.hpp"
+#include "PathOptimizer.h"
+#include "EinsumExpression.h"
+#include "../backend/BinaryContraction.h"
+
+TEST_CASE( "Number of operations of the path optimizer matches the binary contractions.", "[path_optimizer]" ) {
+  // cbkm,cbnk->cbnm with an additional I dimension (e) in the left tensor
+  int64_t l_dim_sizes[6] = { 3, 4, 5, 6, 7, 8 };
+  std::vector< int64_t > l_dim_ids_left  = { 0, 1, 2, 4, 5 };
+  std::vector< int64_t > l_dim_ids_right = { 0, 1, 2, 3 };
+  std::vector< int64_t > l_dim_ids_out   = { 0, 1, 3, 4 };
+
+  std::map< int64_t, int64_t > l_map_dim_sizes;
+  for( int64_t l_di = 0; l_di < 6; l_di++ ) {
+    l_map_dim_sizes.insert( { l_di, l_dim_sizes[l_di] } );
+  }
+
+  int64_t l_num_ops_ref = einsum_ir::backend::BinaryContraction::num_ops( l_dim_ids_left.size(),
+                                                                          l_dim_ids_right.size(),
+                                                                          l_dim_ids_out.size(),
+                                                                          l_dim_ids_left.data(),
+                                                                          l_dim_ids_right.data(),
+                                                                          l_dim_ids_out.data(),
+                                                                          &l_map_dim_sizes,
+                                                                          einsum_ir::ZERO,
+                                                                          einsum_ir::MADD );
+
+  double l_num_ops = einsum_ir::frontend::PathOptimizer::num_ops( l_dim_ids_left,
+                                                                  l_dim_ids_right,
+                                                                  l_dim_ids_out,
+                                                                  l_dim_sizes,
+                                                                  einsum_ir::ZERO,
+                                                                  einsum_ir::MADD );
+
+  REQUIRE( l_num_ops == l_num_ops_ref );
+}
+
+TEST_CASE( "Standard contraction path generation.", "[path_optimizer]" ) {
+  int64_t l_path[6] = { 1, 2,  2, 0,  0, 1 };
+  int64_t l_path_unique[6] = { 0 };
+  int64_t l_path_standard[6] = { 0 };
+
+  einsum_ir::frontend::EinsumExpression::unique_tensor_ids( 3,
+                                                            l_path,
+                                                            l_path_unique );
+
+  einsum_ir::frontend::PathOptimizer::standard_tensor_ids( 3,
+                                                           l_path_unique,
+                                                           l_path_standard );
+
+  for( int64_t l_en = 0; l_en < 6; l_en++ ) {
+    REQUIRE( l_path_standard[l_en] == l_path[l_en] );
+  }
+}
+
+TEST_CASE( "Optimal and greedy contraction paths of a matrix chain.", "[path_optimizer]" ) {
+  // ab,bc,cd,de->ae with a small inner dimension c
+  int64_t l_dim_sizes[5] = { 64, 64, 2, 64, 64 };
+  int64_t l_string_num_dims[5] = { 2, 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[10] = { 0, 1,  1, 2,  2, 3,  3, 4,  0, 4 };
+
+  einsum_ir::frontend::PathOptimizer l_path_opt;
+  l_path_opt.init( 5,
+                   l_dim_sizes,
+                   4,
+                   l_string_num_dims,
+                   l_string_dim_ids,
+                   einsum_ir::ZERO,
+                   einsum_ir::MADD );
+
+  std::vector< int64_t > l_path;
+  REQUIRE( l_path_opt.optimize( l_path ) == einsum_ir::SUCCESS );
+  REQUIRE( l_path.size() == 6 );
+
+  // ab,bc->ac and cd,de->ce are contracted first
+  double l_num_ops_opt = 2 * ( 2.0*64*64*2 - 64*2 ) + ( 2.0*64*2*64 - 64*64 );
+  REQUIRE( l_path_opt.m_num_ops == l_num_ops_opt );
+  REQUIRE( l_path_opt.m_size_peak == 64*2 + 2*64 );
+
+  // greedy path has to be valid and can not beat the optimal one
+  l_path_opt.m_num_tensors_optimal_max = 0;
+  std::vector< int64_t > l_path_greedy;
+  REQUIRE( l_path_opt.optimize( l_path_greedy ) == einsum_ir::SUCCESS );
+  REQUIRE( l_path_greedy.size() == 6 );
+  for( std::size_t l_co = 0; l_co < 3; l_co++ ) {
+    REQUIRE( l_path_greedy[l_co*2 + 0] < 4 - (int64_t) l_co );
+    REQUIRE( l_path_greedy[l_co*2 + 1] < 4 - (int64_t) l_co );
+    REQUIRE( l_path_greedy[l_co*2 + 0] != l_path_greedy[l_co*2 + 1] );
+  }
+  REQUIRE( l_path_opt.m_num_ops >= l_num_ops_opt );
+}
@@ -0,0 +1,253 @@
+#include "PlanCache.h"
+#include "../basic/threading.h"
+#include "../basic/Numa.h"
+#include <cstdlib>
+
+einsum_ir::err_t einsum_ir::frontend::ExpressionPlan::eval( void * const * i_data_ptrs ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  err_t l_err = m_expr.set_data_ptrs( i_data_ptrs );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+  m_expr.eval();
+
+  return err_t::SUCCESS;
+}
+
+std::size_t einsum_ir::frontend::PlanCache::KeyHash::operator()( std::vector< int64_t > const & i_key ) const {
+  // FNV-1a over the key's entries
+  uint64_t l_hash = 14695981039346656037ull;
+  for( std::size_t l_en = 0; l_en < i_key.size(); l_en++ ) {
+    l_hash ^= static_cast< uint64_t >( i_key[l_en] );
+    l_hash *= 1099511628211ull;
+  }
+
+  return static_cast< std::size_t >( l_hash );
+}
+
+einsum_ir::frontend::PlanCache::PlanCache( int64_t i_num_bytes_max ) {
+  m_num_bytes_max = i_num_bytes_max;
+}
+
+einsum_ir::frontend::PlanCache & einsum_ir::frontend::PlanCache::get_instance() {
+  static PlanCache s_cache( [](){
+    int64_t l_num_bytes_max = 1073741824;
+    char * l_env = std::getenv( "EINSUM_IR_PLAN_CACHE_BYTES" );
+    if( l_env != nullptr ) {
+      l_num_bytes_max = std::atoll( l_env );
+    }
+    return l_num_bytes_max;
+  }() );
+
+  return s_cache;
+}
+
+std::vector< int64_t > einsum_ir::frontend::PlanCache::key( int64_t         i_num_dims,
+                                                            int64_t const * i_dim_sizes,
+                                                            int64_t         i_num_conts,
+                                                            int64_t const * i_string_num_dims,
+                                                            int64_t const * i_string_dim_ids,
+                                                            int64_t const * i_path,
+                                                            complex_t       i_ctype,
+                                                            data_t          i_dtype,
+                                                            int64_t         i_num_threads ) {
+  int64_t l_num_tensors = i_num_conts + 2;
+  int64_t l_string_size = 0;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_string_size += i_string_num_dims[l_te];
+  }
+
+  std::vector< int64_t > l_key;
+  l_key.reserve( 12 + i_num_dims + l_num_tensors + l_string_size + 2*i_num_conts );
+
+  l_key.push_back( i_num_dims );
+  l_key.push_back( i_num_conts );
+  l_key.push_back( i_ctype );
+  l_key.push_back( i_dtype );
+  l_key.push_back( i_num_threads );
+  l_key.push_back( i_path != nullptr );
+
+  // compile modes set through the environment, read again for every lookup
+  l_key.push_back( static_cast< int64_t >( backend::EinsumNode::get_env_backend() ) );
+  l_key.push_back( backend::EinsumNode::get_env_flag( "EINSUM_IR_REORDER_DIMS", true ) );
+  l_key.push_back( backend::EinsumNode::get_env_flag( "EINSUM_IR_PACK_INPUTS",  false ) );
+  l_key.push_back( backend::EinsumNode::get_env_flag( "EINSUM_IR_INTER_OP",     false ) );
+  l_key.push_back( static_cast< int64_t >( basic::Numa::get_pages() ) );
+  l_key.push_back( static_cast< int64_t >( basic::Numa::get_placement() ) );
+
+  l_key.insert( l_key.end(), i_dim_sizes,       i_dim_sizes       + i_num_dims    );
+  l_key.insert( l_key.end(), i_string_num_dims, i_string_num_dims + l_num_tensors );
+  l_key.insert( l_key.end(), i_string_dim_ids,  i_string_dim_ids  + l_string_size );
+  if( i_path != nullptr ) {
+    l_key.insert( l_key.end(), i_path, i_path + 2*i_num_conts );
+  }
+
+  return l_key;
+}
+
+void einsum_ir::frontend::PlanCache::evict() {
+  int64_t l_num_bytes_arena = m_arena != nullptr ? m_arena->get_num_bytes() : 0;
+
+  while(    m_num_bytes + l_num_bytes_arena > m_num_bytes_max
+         && m_lru.size() > 1 ) {
+    Entry & l_entry = m_lru.back();
+    m_num_bytes -= l_entry.m_plan->m_num_bytes;
+    m_entries.erase( l_entry.m_key );
+    m_lru.pop_back();
+    m_num_evictions++;
+  }
+}
+
+einsum_ir::err_t einsum_ir::frontend::PlanCache::get( int64_t                             i_num_dims,
+                                                      int64_t                     const * i_dim_sizes,
+                                                      int64_t                             i_num_conts,
+                                                      int64_t                     const * i_string_num_dims,
+                                                      int64_t                     const * i_string_dim_ids,
+                                                      int64_t                     const * i_path,
+                                                      complex_t                           i_ctype,
+                                                      data_t                              i_dtype,
+                                                      std::shared_ptr< ExpressionPlan > & o_plan ) {
+  std::vector< int64_t > l_key = key( i_num_dims,
+                                      i_dim_sizes,
+                                      i_num_conts,
+                                      i_string_num_dims,
+                                      i_string_dim_ids,
+                                      i_path,
+                                      i_ctype,
+                                      i_dtype,
+                                      basic::get_num_threads_available() );
+
+  // lookup
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+
+    auto l_it = m_entries.find( l_key );
+    if( l_it != m_entries.end() ) {
+      m_lru.splice( m_lru.begin(), m_lru, l_it->second );
+      o_plan = l_it->second->m_plan;
+      m_num_hits++;
+      return err_t::SUCCESS;
+    }
+    m_num_misses++;
+  }
+
+  // compile the plan without holding the lock
+  std::shared_ptr< ExpressionPlan > l_plan = std::make_shared< ExpressionPlan >();
+
+  int64_t l_num_tensors = i_num_conts + 2;
+  l_plan->m_dim_sizes = std::vector< int64_t >( i_dim_sizes,
+                                                i_dim_sizes + i_num_dims );
+  l_plan->m_string_num_dims = std::vector< int64_t >( i_string_num_dims,
+                                                      i_string_num_dims + l_num_tensors );
+  int64_t l_string_size = 0;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_string_size += i_string_num_dims[l_te];
+  }
+  l_plan->m_string_dim_ids = std::vector< int64_t >( i_string_dim_ids,
+                                                     i_string_dim_ids + l_string_size );
+  if( i_path != nullptr ) {
+    l_plan->m_path = std::vector< int64_t >( i_path,
+                                             i_path + 2*i_num_conts );
+  }
+
+  // the compilation only requires the presence of external data, the data is bound at evaluation time
+  l_plan->m_data_ptrs = std::vector< void * >( l_num_tensors,
+                                               l_plan.get() );
+
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    l_plan->m_arena = m_arena;
+  }
+
+  l_plan->m_expr.init( i_num_dims,
+                       l_plan->m_dim_sizes.data(),
+                       i_num_conts,
+                       l_plan->m_string_num_dims.data(),
+                       l_plan->m_string_dim_ids.data(),
+                       i_path != nullptr ? l_plan->m_path.data() : nullptr,
+                       i_ctype,
+                       i_dtype,
+                       l_plan->m_data_ptrs.data() );
+
+  l_plan->m_expr.set_memory_arena( l_plan->m_arena.get() );
+
+  err_t l_err = l_plan->m_expr.compile();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+  l_plan->m_num_bytes = l_plan->m_expr.m_memory.get_num_bytes();
+
+  // insert, a concurrent lookup might have inserted the plan in the meantime
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  auto l_it = m_entries.find( l_key );
+  if( l_it != m_entries.end() ) {
+    m_lru.splice( m_lru.begin(), m_lru, l_it->second );
+    o_plan = l_it->second->m_plan;
+    return err_t::SUCCESS;
+  }
+
+  m_lru.push_front( Entry{ l_key, l_plan } );
+  m_entries.insert( { l_key, m_lru.begin() } );
+  m_num_bytes += l_plan->m_num_bytes;
+  evict();
+
+  o_plan = l_plan;
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::frontend::PlanCache::set_num_bytes_max( int64_t i_num_bytes_max ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  m_num_bytes_max = i_num_bytes_max;
+  evict();
+}
+
+void einsum_ir::frontend::PlanCache::set_memory_arena( std::shared_ptr< backend::MemoryArena > i_arena ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  m_arena = i_arena;
+}
+
+void einsum_ir::frontend::PlanCache::clear() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  m_entries.clear();
+  m_lru.clear();
+  m_num_bytes = 0;
+  m_num_hits = 0;
+  m_num_misses = 0;
+  m_num_evictions = 0;
+}
+
+int64_t einsum_ir::frontend::PlanCache::get_num_plans() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_lru.size();
+}
+
+int64_t einsum_ir::frontend::PlanCache::get_num_bytes() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  int64_t l_num_bytes = m_num_bytes;
+  if( m_arena != nullptr ) {
+    l_num_bytes += m_arena->get_num_bytes();
+  }
+  return l_num_bytes;
+}
+
+int64_t einsum_ir::frontend::PlanCache::get_num_hits() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_num_hits;
+}
+
+int64_t einsum_ir::frontend::PlanCache::get_num_misses() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_num_misses;
+}
+
+int64_t einsum_ir::frontend::PlanCache::get_num_evictions() const {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_num_evictions;
+}
@@ -0,0 +1,249 @@
+#ifndef EINSUM_IR_FRONTEND_PLAN_CACHE
+#define EINSUM_IR_FRONTEND_PLAN_CACHE
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "EinsumExpression.h"
+
+namespace einsum_ir {
+  namespace frontend {
+    class ExpressionPlan;
+    class PlanCache;
+  }
+}
+
+/**
+ * Compiled einsum expression which owns its description.
+ * The plan is bound to the tensors' data at evaluation time and may be reused for arbitrary data.
+ **/
+class einsum_ir::frontend::ExpressionPlan {
+  private:
+    //! serializes evaluations, since all evaluations share the intermediate data
+    std::mutex m_mutex;
+
+  public:
+    //! sizes of the dimensions
+    std::vector< int64_t > m_dim_sizes;
+
+    //! sizes of the substrings describing the input tensors and output tensor
+    std::vector< int64_t > m_string_num_dims;
+
+    //! einsum string containing the dimension ids
+    std::vector< int64_t > m_string_dim_ids;
+
+    //! contraction path, empty if derived by the path optimizer
+    std::vector< int64_t > m_path;
+
+    //! placeholder data pointers used in the compilation
+    std::vector< void * > m_data_ptrs;
+
+    //! memory arena shared with other plans, kept alive until the expression is destroyed
+    std::shared_ptr< backend::MemoryArena > m_arena;
+
+    //! compiled expression
+    EinsumExpression m_expr;
+
+    //! number of bytes held by the plan
+    int64_t m_num_bytes = 0;
+
+    /**
+     * Evaluates the plan.
+     * Concurrent evaluations of the same plan are serialized.
+     *
+     * @param i_data_ptrs pointers to the data of the input tensors and output tensor.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t eval( void * const * i_data_ptrs );
+};
+
+/**
+ * Process-wide cache of compiled einsum expressions.
+ *
+ * Plans are keyed by the einsum string, the dimension sizes, the contraction path, the data type,
+ * the complex type, the number of threads and the compile modes set through the environment
+ * (EINSUM_IR_BACKEND, EINSUM_IR_REORDER_DIMS, EINSUM_IR_PACK_INPUTS, EINSUM_IR_INTER_OP,
+ * EINSUM_IR_HUGE_PAGES and EINSUM_IR_NUMA_PLACEMENT).
+ * The cache holds at most m_num_bytes_max bytes of plan memory, including the memory of the attached arena,
+ * and evicts the least recently used plans.
+ * Evicted plans remain valid for users which still hold them.
+ **/
+class einsum_ir::frontend::PlanCache {
+  private:
+    //! hash of a key
+    struct KeyHash {
+      std::size_t operator()( std::vector< int64_t > const & i_key ) const;
+    };
+
+    //! entry of the cache
+    struct Entry {
+      //! key of the entry
+      std::vector< int64_t > m_key;
+      //! cached plan
+      std::shared_ptr< ExpressionPlan > m_plan;
+    };
+
+    //! entries ordered from most to least recently used
+    std::list< Entry > m_lru;
+
+    //! map from keys to the entries
+    std::unordered_map< std::vector< int64_t >,
+                        std::list< Entry >::iterator,
+                        KeyHash > m_entries;
+
+    //! maximum number of bytes held by the cached plans
+    int64_t m_num_bytes_max = 0;
+
+    //! number of bytes held by the cached plans, excluding the attached arena
+    int64_t m_num_bytes = 0;
+
+    //! number of lookups which returned a cached plan
+    int64_t m_num_hits = 0;
+
+    //! number of lookups which compiled a new plan
+    int64_t m_num_misses = 0;
+
+    //! number of evicted plans
+    int64_t m_num_evictions = 0;
+
+    //! memory arena of newly compiled plans, nullptr if every plan owns its intermediate data
+    std::shared_ptr< backend::MemoryArena > m_arena;
+
+    //! protects the cache
+    mutable std::mutex m_mutex;
+
+    /**
+     * Evicts least recently used plans until the memory bound is met.
+     * The most recently used plan is never evicted.
+     **/
+    void evict();
+
+  public:
+    /**
+     * Constructor.
+     *
+     * @param i_num_bytes_max maximum number of bytes held by the cached plans.
+     **/
+    PlanCache( int64_t i_num_bytes_max = 1073741824 );
+
+    /**
+     * Gets the process-wide cache.
+     * The environment variable EINSUM_IR_PLAN_CACHE_BYTES overwrites the default memory bound.
+     *
+     * @return process-wide cache.
+     **/
+    static PlanCache & get_instance();
+
+    /**
+     * Derives the key of an einsum expression.
+     * The key includes the compile modes which are currently set through the environment.
+     *
+     * @param i_num_dims number of dimensions.
+     * @param i_dim_sizes sizes of the dimensions.
+     * @param i_num_conts number of binary contractions.
+     * @param i_string_num_dims sizes of the substrings describing the input tensors and output tensor.
+     * @param i_string_dim_ids einsum string containing the dimension ids.
+     * @param i_path contraction path. optional: use nullptr to derive the path in the compilation.
+     * @param i_ctype complex type of all tensors.
+     * @param i_dtype datatype of all tensors.
+     * @param i_num_threads number of threads used by the plan.
+     * @return key of the expression.
+     **/
+    static std::vector< int64_t > key( int64_t         i_num_dims,
+                                       int64_t const * i_dim_sizes,
+                                       int64_t         i_num_conts,
+                                       int64_t const * i_string_num_dims,
+                                       int64_t const * i_string_dim_ids,
+                                       int64_t const * i_path,
+                                       complex_t       i_ctype,
+                                       data_t          i_dtype,
+                                       int64_t         i_num_threads );
+
+    /**
+     * Gets a compiled plan for the given einsum expression.
+     * The plan is compiled and inserted into the cache if no cached plan exists.
+     *
+     * @param i_num_dims number of dimensions.
+     * @param i_dim_sizes sizes of the dimensions.
+     * @param i_num_conts number of binary contractions.
+     * @param i_string_num_dims sizes of the substrings describing the input tensors and output tensor.
+     * @param i_string_dim_ids einsum string containing the dimension ids.
+     * @param i_path contraction path. optional: use nullptr to derive the path in the compilation.
+     * @param i_ctype complex type of all tensors.
+     * @param i_dtype datatype of all tensors.
+     * @param o_plan will be set to the compiled plan.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t get( int64_t                             i_num_dims,
+               int64_t                     const * i_dim_sizes,
+               int64_t                             i_num_conts,
+               int64_t                     const * i_string_num_dims,
+               int64_t                     const * i_string_dim_ids,
+               int64_t                     const * i_path,
+               complex_t                           i_ctype,
+               data_t                              i_dtype,
+               std::shared_ptr< ExpressionPlan > & o_plan );
+
+    /**
+     * Sets the maximum number of bytes held by the cached plans and evicts plans if required.
+     *
+     * @param i_num_bytes_max maximum number of bytes.
+     **/
+    void set_num_bytes_max( int64_t i_num_bytes_max );
+
+    /**
+     * Sets a memory arena which is shared by all plans compiled afterwards.
+     * Plans borrow their intermediate data from the arena at evaluation time,
+     * i.e., the memory is sized to the largest plan times the number of concurrent evaluations instead of the sum of all plans.
+     * The arena's memory counts once towards the memory bound of the cache.
+     * Evictions do not shrink the arena, i.e., if the arena alone exceeds the bound, only the most recently used plan is kept.
+     *
+     * @param i_arena memory arena, nullptr if every plan owns its intermediate data.
+     **/
+    void set_memory_arena( std::shared_ptr< backend::MemoryArena > i_arena );
+
+    /**
+     * Removes all plans from the cache and resets the counters.
+     **/
+    void clear();
+
+    /**
+     * Gets the number of cached plans.
+     *
+     * @return number of cached plans.
+     **/
+    int64_t get_num_plans() const;
+
+    /**
+     * Gets the number of bytes held by the cached plans and the attached arena.
+     *
+     * @return number of bytes.
+     **/
+    int64_t get_num_bytes() const;
+
+    /**
+     * Gets the number of lookups which returned a cached plan.
+     *
+     * @return number of hits.
+     **/
+    int64_t get_num_hits() const;
+
+    /**
+     * Gets the number of lookups which compiled a new plan.
+     *
+     * @return number of misses.
+     **/
+    int64_t get_num_misses() const;
+
+    /**
+     * Gets the number of evicted plans.
+     *
+     * @return number of evictions.
+     **/
+    int64_t get_num_evictions() const;
+};
+
+#endif
@@ -0,0 +1,271 @@
+#include "catch.hpp"
+#include "PlanCache.h"
+#include <cstdlib>
+#include <string>
+
+TEST_CASE( "Plans of the cache are reused and evaluated on changing data.", "[plan_cache]" ) {
+  // ab,bc,cd->ad
+  int64_t l_dim_sizes[4] = { 3, 4, 5, 6 };
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  0, 3 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  einsum_ir::frontend::PlanCache l_cache;
+
+  std::shared_ptr< einsum_ir::frontend::ExpressionPlan > l_plan_0;
+  REQUIRE( l_cache.get( 4,
+                        l_dim_sizes,
+                        2,
+                        l_string_num_dims,
+                        l_string_dim_ids,
+                        l_path,
+                        einsum_ir::REAL_ONLY,
+                        einsum_ir::FP32,
+                        l_plan_0 ) == einsum_ir::SUCCESS );
+  REQUIRE( l_cache.get_num_misses() == 1 );
+  REQUIRE( l_cache.get_num_hits() == 0 );
+
+  // same expression, provided through different arrays
+  int64_t l_dim_sizes_copy[4] = { 3, 4, 5, 6 };
+  std::shared_ptr< einsum_ir::frontend::ExpressionPlan > l_plan_1;
+  REQUIRE( l_cache.get( 4,
+                        l_dim_sizes_copy,
+                        2,
+                        l_string_num_dims,
+                        l_string_dim_ids,
+                        l_path,
+                        einsum_ir::REAL_ONLY,
+                        einsum_ir::FP32,
+                        l_plan_1 ) == einsum_ir::SUCCESS );
+  REQUIRE( l_cache.get_num_misses() == 1 );
+  REQUIRE( l_cache.get_num_hits() == 1 );
+  REQUIRE( l_plan_0 == l_plan_1 );
+
+  // different path, sizes or data type result in new plans
+  std::shared_ptr< einsum_ir::frontend::ExpressionPlan > l_plan_2;
+  REQUIRE( l_cache.get( 4,
+                        l_dim_sizes,
+                        2,
+                        l_string_num_dims,
+                        l_string_dim_ids,
+                        nullptr,
+                        einsum_ir::REAL_ONLY,
+                        einsum_ir::FP32,
+                        l_plan_2 ) == einsum_ir::SUCCESS );
+  l_dim_sizes_copy[3] = 7;
+  REQUIRE( l_cache.get( 4,
+                        l_dim_sizes_copy,
+                        2,
+                        l_string_num_dims,
+                        l_string_dim_ids,
+                        l_path,
+                        einsum_ir::REAL_ONLY,
+                        einsum_ir::FP32,
+                        l_plan_2 ) == einsum_ir::SUCCESS );
+  REQUIRE( l_cache.get( 4,
+                        l_dim_sizes,
+                        2,
+                        l_string_num_dims,
+                        l_string_dim_ids,
+                        l_path,
+                        einsum_ir::REAL_ONLY,
+                        einsum_ir::FP64,
+                        l_plan_2 ) == einsum_ir::SUCCESS );
+  REQUIRE( l_cache.get_num_misses() == 4 );
+  REQUIRE( l_cache.get_num_plans() == 4 );
+  REQUIRE( l_plan_2 != l_plan_0 );
+
+  // evaluate the shared plan on two sets of data
+  for( int64_t l_re = 0; l_re < 2; l_re++ ) {
+    float l_a[3*4];
+    float l_b[4*5];
+    float l_c[5*6];
+    float l_d[3*6] = { 0 };
+    for( int64_t l_en = 0; l_en < 3*4; l_en++ ) l_a[l_en] = (float) (l_en + l_re) / 7;
+    for( int64_t l_en = 0; l_en < 4*5; l_en++ ) l_b[l_en] = (float) (l_en - l_re) / 5;
+    for( int64_t l_en = 0; l_en < 5*6; l_en++ ) l_c[l_en] = (float) (l_en % 4) - l_re;
+
+    void * l_data_ptrs[4] = { l_a, l_b, l_c, l_d };
+    REQUIRE( l_plan_1->eval( l_data_ptrs ) == einsum_ir::SUCCESS );
+
+    for( int64_t l_a0 = 0; l_a0 < 3; l_a0++ ) {
+      for( int64_t l_d0 = 0; l_d0 < 6; l_d0++ ) {
+        float l_ref = 0;
+        for( int64_t l_b0 = 0; l_b0 < 4; l_b0++ ) {
+          for( int64_t l_c0 = 0; l_c0 < 5; l_c0++ ) {
+            l_ref += l_a[l_a0*4 + l_b0] * l_b[l_b0*5 + l_c0] * l_c[l_c0*6 + l_d0];
+          }
+        }
+        REQUIRE( l_d[l_a0*6 + l_d0] == Approx( l_ref ) );
+      }
+    }
+  }
+
+  // missing data
+  void * l_data_ptrs_missing[4] = { nullptr, nullptr, nullptr, nullptr };
+  REQUIRE( l_plan_1->eval( l_data_ptrs_missing ) == einsum_ir::NO_DATA_PTR_PROVIDED );
+}
+
+TEST_CASE( "Least recently used plans are evicted from the cache.", "[plan_cache]" ) {
+  // ab,bc,cd->ad, the intermediate tensor is held by the plan
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  0, 3 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  einsum_ir::frontend::PlanCache l_cache;
+
+  std::shared_ptr< einsum_ir::frontend::ExpressionPlan > l_plans[3];
+  for( int64_t l_pl = 0; l_pl < 3; l_pl++ ) {
+    int64_t l_dim_sizes[4] = { 16, 16, 16, 16+l_pl };
+    REQUIRE( l_cache.get( 4,
+                          l_dim_sizes,
+                          2,
+                          l_string_num_dims,
+                          l_string_dim_ids,
+                          l_path,
+                          einsum_ir::REAL_ONLY,
+                          einsum_ir::FP32,
+                          l_plans[l_pl] ) == einsum_ir::SUCCESS );
+    REQUIRE( l_plans[l_pl]->m_num_bytes > 0 );
+  }
+  REQUIRE( l_cache.get_num_plans() == 3 );
+  REQUIRE( l_cache.get_num_bytes() == l_plans[0]->m_num_bytes + l_plans[1]->m_num_bytes + l_plans[2]->m_num_bytes );
+
+  // touch the first plan, the second one is the least recently used
+  int64_t l_dim_sizes_0[4] = { 16, 16, 16, 16 };
+  std::shared_ptr< einsum_ir::frontend::ExpressionPlan > l_plan;
+  REQUIRE( l_cache.get( 4,
+                        l_dim_sizes_0,
+                        2,
+                        l_string_num_dims,
+                        l_string_dim_ids,
+                        l_path,
+                        einsum_ir::REAL_ONLY,
+                        einsum_ir::FP32,
+                        l_plan ) == einsum_ir::SUCCESS );
+  REQUIRE( l_cache.get_num_hits() == 1 );
+
+  l_cache.set_num_bytes_max( l_plans[0]->m_num_bytes + l_plans[2]->m_num_bytes );
+  REQUIRE( l_cache.get_num_plans() == 2 );
+  REQUIRE( l_cache.get_num_evictions() == 1 );
+  REQUIRE( l_cache.get_num_bytes() == l_plans[0]->m_num_bytes + l_plans[2]->m_num_bytes );
+
+  // the most recently used plan is kept, even if it exceeds the bound
+  l_cache.set_num_bytes_max( 0 );
+  REQUIRE( l_cache.get_num_plans() == 1 );
+  REQUIRE( l_cache.get_num_evictions() == 2 );
+
+  REQUIRE( l_cache.get( 4,
+                        l_dim_sizes_0,
+                        2,
+                        l_string_num_dims,
+                        l_string_dim_ids,
+                        l_path,
+                        einsum_ir::REAL_ONLY,
+                        einsum_ir::FP32,
+                        l_plan ) == einsum_ir::SUCCESS );
+  REQUIRE( l_cache.get_num_hits() == 2 );
+  REQUIRE( l_plan == l_plans[0] );
+
+  l_cache.clear();
+  REQUIRE( l_cache.get_num_plans() == 0 );
+  REQUIRE( l_cache.get_num_bytes() == 0 );
+  REQUIRE( l_cache.get_num_hits() == 0 );
+}
+
+TEST_CASE( "Plans of the cache borrow their memory from a shared arena.", "[plan_cache]" ) {
+  // ab,bc,cd->ad
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  0, 3 };
+  int64_t l_path[4] = { 0, 1,  0, 1 };
+
+  std::shared_ptr< einsum_ir::backend::MemoryArena > l_arena = std::make_shared< einsum_ir::backend::MemoryArena >();
+  einsum_ir::frontend::PlanCache l_cache;
+  l_cache.set_memory_arena( l_arena );
+
+  std::vector< float > l_a( 16*48, 1.0f );
+  std::vector< float > l_b( 48*16, 0.5f );
+  std::vector< float > l_c( 16*24, 2.0f );
+
+  for( int64_t l_pl = 0; l_pl < 3; l_pl++ ) {
+    int64_t l_dim_sizes[4] = { 16, 16*(l_pl+1), 16, 8*(l_pl+1) };
+    std::shared_ptr< einsum_ir::frontend::ExpressionPlan > l_plan;
+    REQUIRE( l_cache.get( 4,
+                          l_dim_sizes,
+                          2,
+                          l_string_num_dims,
+                          l_string_dim_ids,
+                          l_path,
+                          einsum_ir::REAL_ONLY,
+                          einsum_ir::FP32,
+                          l_plan ) == einsum_ir::SUCCESS );
+    // the intermediate tensor lives in the arena
+    REQUIRE( l_plan->m_num_bytes == 0 );
+
+    std::vector< float > l_d( 16 * l_dim_sizes[3], 0.0f );
+    void * l_data_ptrs[4] = { l_a.data(), l_b.data(), l_c.data(), l_d.data() };
+    REQUIRE( l_plan->eval( l_data_ptrs ) == einsum_ir::SUCCESS );
+    for( std::size_t l_en = 0; l_en < l_d.size(); l_en++ ) {
+      REQUIRE( l_d[l_en] == Approx( l_dim_sizes[1] * 0.5f * 16 * 2.0f ) );
+    }
+  }
+
+  REQUIRE( l_arena->get_num_slots() == 1 );
+  REQUIRE( l_arena->get_num_bytes() > 0 );
+  REQUIRE( l_cache.get_num_bytes() == l_arena->get_num_bytes() );
+
+  // the arena counts towards the memory bound
+  l_cache.set_num_bytes_max( l_arena->get_num_bytes() );
+  REQUIRE( l_cache.get_num_plans() == 3 );
+  l_cache.set_num_bytes_max( l_arena->get_num_bytes() - 1 );
+  REQUIRE( l_cache.get_num_plans() == 1 );
+  REQUIRE( l_cache.get_num_evictions() == 2 );
+}
+
+TEST_CASE( "Keys of the plan cache include the compile modes set through the environment.", "[plan_cache]" ) {
+  // ab,bc->ac
+  int64_t l_string_num_dims[3] = { 2, 2, 2 };
+  int64_t l_string_dim_ids[6] = { 0, 1,  1, 2,  0, 2 };
+  int64_t l_dim_sizes[3] = { 8, 4, 6 };
+
+  char const * l_names[4] = { "EINSUM_IR_BACKEND",
+                              "EINSUM_IR_INTER_OP",
+                              "EINSUM_IR_HUGE_PAGES",
+                              "EINSUM_IR_REORDER_DIMS" };
+  char const * l_values[4] = { "SCALAR", "1", "THP", "0" };
+
+  for( int64_t l_va = 0; l_va < 4; l_va++ ) {
+    char const * l_env = std::getenv( l_names[l_va] );
+    std::string l_env_old = l_env != nullptr ? l_env : "";
+
+    unsetenv( l_names[l_va] );
+    std::vector< int64_t > l_key_default = einsum_ir::frontend::PlanCache::key( 3,
+                                                                                 l_dim_sizes,
+                                                                                 1,
+                                                                                 l_string_num_dims,
+                                                                                 l_string_dim_ids,
+                                                                                 nullptr,
+                                                                                 einsum_ir::REAL_ONLY,
+                                                                                 einsum_ir::FP32,
+                                                                                 1 );
+
+    setenv( l_names[l_va], l_values[l_va], 1 );
+    std::vector< int64_t > l_key_env = einsum_ir::frontend::PlanCache::key( 3,
+                                                                             l_dim_sizes,
+                                                                             1,
+                                                                             l_string_num_dims,
+                                                                             l_string_dim_ids,
+                                                                             nullptr,
+                                                                             einsum_ir::REAL_ONLY,
+                                                                             einsum_ir::FP32,
+                                                                             1 );
+    REQUIRE( l_key_default != l_key_env );
+
+    if( l_env != nullptr ) {
+      setenv( l_names[l_va], l_env_old.c_str(), 1 );
+    }
+    else {
+      unsetenv( l_names[l_va] );
+    }
+  }
+}